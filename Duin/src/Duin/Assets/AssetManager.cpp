@@ -2,8 +2,78 @@
 #include "AssetManager.h"
 #include "FileTypes.h"
 #include "Duin/IO/Filesystem.h"
+#include "Duin/IO/IOStream.h"
+#include <cctype>
+#include <filesystem>
 #include <memory>
 
+static int64_t GetModifyTime(const std::string &systemPath)
+{
+    duin::fs::PathInfo info{};
+    if (!duin::fs::GetPathInfo(systemPath, &info) || info.type != duin::fs::DNFS_PATHTYPE_FILE)
+    {
+        return -1;
+    }
+    return info.modifyTime;
+}
+
+// Imports and cooks an OBJ source, or reuses its .dnmesh sibling while that is up to date.
+static duin::CookedMesh LoadCookedMesh(const std::string &path)
+{
+    std::string systemPath = duin::fs::IsVirtualPath(path) ? duin::fs::MapVirtualToSystemPath(path) : path;
+    std::filesystem::path fsPath(systemPath);
+    std::string ext = fsPath.extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return std::tolower(c); });
+
+    if (ext == ".dnmesh")
+    {
+        return duin::CookedMesh::LoadFromFile(systemPath);
+    }
+    if (ext != ".obj")
+    {
+        DN_CORE_WARN("LoadMesh - Unsupported mesh format {} ({})", ext, path);
+        return duin::CookedMesh();
+    }
+
+    std::string cookedPath = std::filesystem::path(fsPath).replace_extension(".dnmesh").string();
+    int64_t sourceTime = GetModifyTime(systemPath);
+    int64_t cookedTime = GetModifyTime(cookedPath);
+
+    duin::UUID uuid;
+    if (cookedTime >= 0)
+    {
+        duin::CookedMesh cooked = duin::CookedMesh::LoadFromFile(cookedPath);
+        if (cooked.IsValid() && cookedTime >= sourceTime)
+        {
+            return cooked;
+        }
+        if (cooked.IsValid())
+        {
+            uuid = cooked.GetUUID(); // recooking a stale file keeps its identity
+        }
+    }
+
+    duin::io::FileMapping text = duin::io::IOStream::MapFile(systemPath, duin::io::MapAdvice::Sequential);
+    if (!text.IsValid())
+    {
+        DN_CORE_WARN("LoadMesh - Failed to read {}", systemPath);
+        return duin::CookedMesh();
+    }
+    duin::MeshData data;
+    if (!duin::ImportOBJ(reinterpret_cast<const char *>(text.Data()), text.Size(), data))
+    {
+        DN_CORE_WARN("LoadMesh - No triangles in {}", systemPath);
+        return duin::CookedMesh();
+    }
+
+    duin::CookedMesh cooked = duin::CookedMesh::Cook(std::move(data), uuid);
+    if (cooked.IsValid() && !cooked.SaveToFile(cookedPath))
+    {
+        DN_CORE_WARN("LoadMesh - Could not write {}, the mesh will be recooked on next load", cookedPath);
+    }
+    return cooked;
+}
+
 static duin::fs::EnumerationResult DetectAssetCallback(void *userdata, const char *dirname, const char *fname)
 {
     if (userdata != nullptr && fname != nullptr)
@@ -45,6 +115,60 @@ bool duin::AssetManager::CatalogueAssets()
 
     return result;
 }
+std::shared_ptr<duin::Mesh> duin::AssetManager::LoadMesh(const std::string &path)
+{
+    std::lock_guard<std::mutex> lock(meshMutex);
+
+    auto pathIt = meshPaths.find(path);
+    if (pathIt != meshPaths.end())
+    {
+        auto meshIt = meshCache.find(pathIt->second);
+        if (meshIt != meshCache.end())
+        {
+            if (std::shared_ptr<Mesh> mesh = meshIt->second.lock())
+            {
+                return mesh;
+            }
+        }
+    }
+
+    CookedMesh cooked = LoadCookedMesh(path);
+    if (!cooked.IsValid())
+    {
+        return nullptr;
+    }
+
+    // A different path (e.g. the .dnmesh itself) may already have loaded this asset.
+    const UUID meshUUID = cooked.GetUUID();
+    meshPaths[path] = meshUUID;
+    std::weak_ptr<Mesh> &cached = meshCache[meshUUID];
+    if (std::shared_ptr<Mesh> mesh = cached.lock())
+    {
+        return mesh;
+    }
+
+    std::shared_ptr<Mesh> mesh = std::make_shared<Mesh>(std::move(cooked));
+    cached = mesh;
+    return mesh;
+}
+
+std::shared_ptr<duin::Mesh> duin::AssetManager::LoadMesh(const AssetRef &ref)
+{
+    if (ref.uuid && ref.IsValid())
+    {
+        std::lock_guard<std::mutex> lock(meshMutex);
+        auto meshIt = meshCache.find(*ref.uuid);
+        if (meshIt != meshCache.end())
+        {
+            if (std::shared_ptr<Mesh> mesh = meshIt->second.lock())
+            {
+                return mesh;
+            }
+        }
+    }
+    return LoadMesh(ref.rPath);
+}
+
 duin::AssetManager &duin::AssetManager::Get()
 {
     static duin::AssetManager am;
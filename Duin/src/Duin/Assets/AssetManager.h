@@ -2,6 +2,11 @@
 #include "Duin/Core/Utils/UUID.h"
 
 #include "Asset.h"
+#include "AssetRef.h"
+#include "Mesh.h"
+#include <memory>
+#include <mutex>
+#include <string>
 #include <unordered_map>
 
 namespace duin
@@ -17,13 +22,26 @@ class AssetManager
     UUID GetUUID();
     bool CatalogueAssets();
 
-    // Generate and share meshes
+    /**
+     * @brief Loads a mesh, sharing it with every other holder of the same asset UUID.
+     *
+     * Accepts a cooked .dnmesh or an .obj source. A source is imported and
+     * cooked once; the result is written next to it as <name>.dnmesh and reused
+     * while it is newer than the source. The mesh stays cached for as long as
+     * someone holds the returned pointer. Returns nullptr on failure.
+     */
+    std::shared_ptr<Mesh> LoadMesh(const std::string &path);
+    std::shared_ptr<Mesh> LoadMesh(const AssetRef &ref);
 
   private:
     UUID uuid;
     std::string basePath;
     std::unordered_map<duin::UUID, std::shared_ptr<duin::Asset>> assetMap;
 
+    std::mutex meshMutex;
+    std::unordered_map<duin::UUID, std::weak_ptr<Mesh>> meshCache;
+    std::unordered_map<std::string, duin::UUID> meshPaths;
+
 };
 
 } // namespace duin
@@ -8,7 +8,7 @@
 
 namespace duin
 {
-const std::array<FileExtension, 50> AllExtensions = {{// Image Extensions
+const std::array<FileExtension, 51> AllExtensions = {{// Image Extensions
                                                       {"png", FS_FILETYPE_IMAGE_EXT, FS_FILEEXT_PNG},
                                                       {"jpg", FS_FILETYPE_IMAGE_EXT, FS_FILEEXT_JPG},
                                                       {"jpeg", FS_FILETYPE_IMAGE_EXT, FS_FILEEXT_JPEG},
@@ -52,6 +52,7 @@ const std::array<FileExtension, 50> AllExtensions = {{// Image Extensions
                                                       {"max", FS_FILETYPE_MODEL_EXT, FS_FILEEXT_MAX},
                                                       {"mb", FS_FILETYPE_MODEL_EXT, FS_FILEEXT_MB},
                                                       {"stl", FS_FILETYPE_MODEL_EXT, FS_FILEEXT_STL},
+                                                      {"dnmesh", FS_FILETYPE_MODEL_EXT, FS_FILEEXT_DNMESH},
 
                                                       // Text Extensions
                                                       {"txt", FS_FILETYPE_TEXT_EXT, FS_FILEEXT_TXT},
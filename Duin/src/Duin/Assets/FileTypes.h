@@ -71,6 +71,7 @@ typedef enum FileExt
     FS_FILEEXT_MAX,
     FS_FILEEXT_MB,
     FS_FILEEXT_STL,
+    FS_FILEEXT_DNMESH,
 
     // Text Extensions
     FS_FILEEXT_TXT,
@@ -106,5 +107,5 @@ struct PathInfo
 
 PathInfo GetPathInfo(const std::string& path);
 
-extern const std::array<FileExtension, 50> AllExtensions;
+extern const std::array<FileExtension, 51> AllExtensions;
 } // namespace duin
\ No newline at end of file
@@ -1,7 +1,908 @@
 #include "dnpch.h"
 #include "Mesh.h"
 
+#include "Duin/Core/Debug/DNLog.h"
+#include "Duin/IO/Filesystem.h"
+#include "Duin/IO/IOStream.h"
+#include "Duin/Render/Renderer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+
 namespace duin
 {
 
+// ---------------------------------------------------------------------------
+// Cooked file layout
+// ---------------------------------------------------------------------------
+
+namespace
+{
+// Little-endian, read with memcpy. The vertex block follows the header and the
+// index block follows the vertices, padded to 4 bytes.
+struct MeshBinHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint64_t uuid;
+    float boundsCenter[3];
+    float boundsExtent[3];
+    uint32_t vertexCount;
+    uint32_t indexCount;
+    uint32_t indexSize; // 2 or 4
+    uint32_t pad;
+    uint64_t verticesOffset;
+    uint64_t indicesOffset;
+};
+
+static_assert(sizeof(MeshBinHeader) == 72, "Cooked mesh header layout changed; bump CookedMesh::VERSION");
+static_assert(sizeof(PackedMeshVertex) == 16, "Packed mesh vertex layout changed; bump CookedMesh::VERSION");
+
+constexpr float SNORM16_MAX = 32767.0f;
+
+// Subtracts instead of adding, so a corrupt 64-bit offset cannot wrap around the check.
+bool FitsIn(uint64_t offset, uint64_t length, size_t size)
+{
+    return offset <= size && length <= size - offset;
+}
+
+int16_t ToSnorm16(float value)
+{
+    value = std::clamp(value, -1.0f, 1.0f);
+    return static_cast<int16_t>(std::lround(value * SNORM16_MAX));
+}
+
+float FromSnorm16(int16_t value)
+{
+    return std::max(static_cast<float>(value) / SNORM16_MAX, -1.0f);
+}
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Encodings
+// ---------------------------------------------------------------------------
+
+uint16_t FloatToHalf(float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    uint32_t sign = (bits >> 16) & 0x8000;
+    uint32_t rawExponent = (bits >> 23) & 0xFF;
+    uint32_t mantissa = bits & 0x7FFFFF;
+
+    if (rawExponent == 0xFF)
+    {
+        return static_cast<uint16_t>(sign | 0x7C00 | (mantissa ? 0x200 : 0)); // inf / nan
+    }
+
+    int32_t exponent = static_cast<int32_t>(rawExponent) - 127 + 15;
+    if (exponent >= 31)
+    {
+        return static_cast<uint16_t>(sign | 0x7C00); // overflow to inf
+    }
+    if (exponent <= 0)
+    {
+        if (exponent < -10)
+        {
+            return static_cast<uint16_t>(sign); // underflow to zero
+        }
+        // Subnormal half: shift the implicit bit in, round to nearest even.
+        mantissa |= 0x800000;
+        uint32_t shift = static_cast<uint32_t>(14 - exponent);
+        uint32_t half = mantissa >> shift;
+        uint32_t remainder = mantissa & ((1u << shift) - 1);
+        uint32_t midpoint = 1u << (shift - 1);
+        if (remainder > midpoint || (remainder == midpoint && (half & 1)))
+        {
+            ++half;
+        }
+        return static_cast<uint16_t>(sign | half);
+    }
+
+    uint32_t half = sign | (static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13);
+    uint32_t remainder = mantissa & 0x1FFF;
+    if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1)))
+    {
+        ++half; // a carry into the exponent is still the correctly rounded value
+    }
+    return static_cast<uint16_t>(half);
+}
+
+float HalfToFloat(uint16_t value)
+{
+    uint32_t sign = static_cast<uint32_t>(value & 0x8000) << 16;
+    uint32_t exponent = (value >> 10) & 0x1F;
+    uint32_t mantissa = value & 0x3FF;
+
+    uint32_t bits;
+    if (exponent == 0)
+    {
+        float magnitude = std::ldexp(static_cast<float>(mantissa), -24);
+        return sign ? -magnitude : magnitude;
+    }
+    else if (exponent == 31)
+    {
+        bits = sign | 0x7F800000 | (mantissa << 13);
+    }
+    else
+    {
+        bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    }
+
+    float result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+void EncodeOctahedral(Vector3 normal, int16_t out[2])
+{
+    float l1 = std::fabs(normal.x) + std::fabs(normal.y) + std::fabs(normal.z);
+    if (l1 <= 0.0f)
+    {
+        out[0] = 0;
+        out[1] = 0;
+        return;
+    }
+
+    float x = normal.x / l1;
+    float y = normal.y / l1;
+    if (normal.z < 0.0f)
+    {
+        // Fold the lower hemisphere over the diagonals.
+        float foldedX = (1.0f - std::fabs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+        float foldedY = (1.0f - std::fabs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+        x = foldedX;
+        y = foldedY;
+    }
+    out[0] = ToSnorm16(x);
+    out[1] = ToSnorm16(y);
+}
+
+Vector3 DecodeOctahedral(const int16_t in[2])
+{
+    float x = FromSnorm16(in[0]);
+    float y = FromSnorm16(in[1]);
+    float z = 1.0f - std::fabs(x) - std::fabs(y);
+    float t = std::max(-z, 0.0f);
+    x += x >= 0.0f ? -t : t;
+    y += y >= 0.0f ? -t : t;
+
+    float length = std::sqrt(x * x + y * y + z * z);
+    return Vector3(x / length, y / length, z / length);
+}
+
+// ---------------------------------------------------------------------------
+// OBJ import
+// ---------------------------------------------------------------------------
+
+namespace
+{
+struct ObjCorner
+{
+    int position = 0;
+    int uv = 0;
+    int normal = 0;
+
+    bool operator==(const ObjCorner &other) const
+    {
+        return position == other.position && uv == other.uv && normal == other.normal;
+    }
+};
+
+struct ObjCornerHash
+{
+    size_t operator()(const ObjCorner &c) const
+    {
+        return std::hash<uint64_t>()((static_cast<uint64_t>(static_cast<uint32_t>(c.position)) << 32) ^
+                                     (static_cast<uint64_t>(static_cast<uint32_t>(c.uv)) << 16) ^
+                                     static_cast<uint32_t>(c.normal));
+    }
+};
+
+// OBJ indices are 1-based; negative ones count back from the end. Returns 0-based or -1.
+int ResolveObjIndex(long index, size_t count)
+{
+    if (index > 0)
+    {
+        return static_cast<size_t>(index) <= count ? static_cast<int>(index - 1) : -1;
+    }
+    if (index < 0)
+    {
+        long resolved = static_cast<long>(count) + index;
+        return resolved >= 0 ? static_cast<int>(resolved) : -1;
+    }
+    return -1;
+}
+} // namespace
+
+bool ImportOBJ(const char *text, size_t size, MeshData &out)
+{
+    out.vertices.clear();
+    out.indices.clear();
+
+    std::string source(text, size); // strtof needs a terminator
+    std::vector<Vector3> positions;
+    std::vector<Vector2> uvs;
+    std::vector<Vector3> normals;
+    std::unordered_map<ObjCorner, uint32_t, ObjCornerHash> cornerToVertex;
+    std::vector<int> vertexPosition; // position index of each output vertex, for generated normals
+    bool missingNormals = false;
+
+    const char *cursor = source.c_str();
+    const char *end = cursor + source.size();
+    std::vector<uint32_t> face;
+    while (cursor < end)
+    {
+        const char *lineEnd = static_cast<const char *>(std::memchr(cursor, '\n', end - cursor));
+        if (!lineEnd)
+        {
+            lineEnd = end;
+        }
+
+        const char *p = cursor;
+        while (p < lineEnd && (*p == ' ' || *p == '\t'))
+        {
+            ++p;
+        }
+
+        if (p + 1 < lineEnd && p[0] == 'v' && p[1] == ' ')
+        {
+            char *next = nullptr;
+            float x = std::strtof(p + 2, &next);
+            float y = std::strtof(next, &next);
+            float z = std::strtof(next, &next);
+            positions.emplace_back(x, y, z);
+        }
+        else if (p + 2 < lineEnd && p[0] == 'v' && p[1] == 't' && p[2] == ' ')
+        {
+            char *next = nullptr;
+            float u = std::strtof(p + 3, &next);
+            float v = std::strtof(next, &next);
+            uvs.emplace_back(u, v);
+        }
+        else if (p + 2 < lineEnd && p[0] == 'v' && p[1] == 'n' && p[2] == ' ')
+        {
+            char *next = nullptr;
+            float x = std::strtof(p + 3, &next);
+            float y = std::strtof(next, &next);
+            float z = std::strtof(next, &next);
+            normals.emplace_back(x, y, z);
+        }
+        else if (p + 1 < lineEnd && p[0] == 'f' && p[1] == ' ')
+        {
+            face.clear();
+            const char *q = p + 2;
+            while (q < lineEnd)
+            {
+                while (q < lineEnd && (*q == ' ' || *q == '\t' || *q == '\r'))
+                {
+                    ++q;
+                }
+                if (q >= lineEnd)
+                {
+                    break;
+                }
+
+                // v, v/vt, v//vn or v/vt/vn
+                char *next = nullptr;
+                ObjCorner corner;
+                corner.position = ResolveObjIndex(std::strtol(q, &next, 10), positions.size());
+                corner.uv = -1;
+                corner.normal = -1;
+                if (*next == '/')
+                {
+                    ++next;
+                    if (*next != '/')
+                    {
+                        corner.uv = ResolveObjIndex(std::strtol(next, &next, 10), uvs.size());
+                    }
+                    if (*next == '/')
+                    {
+                        ++next;
+                        corner.normal = ResolveObjIndex(std::strtol(next, &next, 10), normals.size());
+                    }
+                }
+                if (next == q || corner.position < 0)
+                {
+                    DN_CORE_WARN("ImportOBJ - Invalid face corner, face skipped.");
+                    face.clear();
+                    break;
+                }
+                q = next;
+                while (q < lineEnd && *q != ' ' && *q != '\t' && *q != '\r')
+                {
+                    ++q;
+                }
+
+                auto [it, inserted] = cornerToVertex.try_emplace(corner, static_cast<uint32_t>(out.vertices.size()));
+                if (inserted)
+                {
+                    MeshVertex vertex;
+                    vertex.position = positions[corner.position];
+                    vertex.uv = corner.uv >= 0 ? uvs[corner.uv] : Vector2(0.0f, 0.0f);
+                    vertex.normal = corner.normal >= 0 ? normals[corner.normal] : Vector3();
+                    missingNormals |= corner.normal < 0;
+                    out.vertices.push_back(vertex);
+                    vertexPosition.push_back(corner.position);
+                }
+                face.push_back(it->second);
+            }
+
+            // Fan triangulation
+            for (size_t i = 2; i < face.size(); ++i)
+            {
+                out.indices.push_back(face[0]);
+                out.indices.push_back(face[i - 1]);
+                out.indices.push_back(face[i]);
+            }
+        }
+
+        cursor = lineEnd + 1;
+    }
+
+    if (missingNormals)
+    {
+        // Smooth normals: face normals weighted by the corner angle, summed per position,
+        // so the result does not depend on how polygons were split into triangles.
+        std::vector<Vector3> accumulated(positions.size());
+        for (size_t i = 0; i + 2 < out.indices.size(); i += 3)
+        {
+            Vector3 corners[3] = {out.vertices[out.indices[i]].position, out.vertices[out.indices[i + 1]].position,
+                                  out.vertices[out.indices[i + 2]].position};
+            Vector3 n = Vector3Normalize(
+                Vector3CrossProduct(Vector3Subtract(corners[1], corners[0]), Vector3Subtract(corners[2], corners[0])));
+            for (size_t k = 0; k < 3; ++k)
+            {
+                Vector3 e0 = Vector3Normalize(Vector3Subtract(corners[(k + 1) % 3], corners[k]));
+                Vector3 e1 = Vector3Normalize(Vector3Subtract(corners[(k + 2) % 3], corners[k]));
+                float cosine = std::clamp(e0.x * e1.x + e0.y * e1.y + e0.z * e1.z, -1.0f, 1.0f);
+                Vector3 &sum = accumulated[vertexPosition[out.indices[i + k]]];
+                sum = Vector3Add(sum, Vector3Scale(n, std::acos(cosine)));
+            }
+        }
+        for (size_t v = 0; v < out.vertices.size(); ++v)
+        {
+            MeshVertex &vertex = out.vertices[v];
+            if (Vector3Length(vertex.normal) == 0.0f)
+            {
+                vertex.normal = Vector3Normalize(accumulated[vertexPosition[v]]);
+            }
+        }
+    }
+
+    return !out.indices.empty();
+}
+
+// ---------------------------------------------------------------------------
+// Vertex cache optimization
+// ---------------------------------------------------------------------------
+//
+// Tom Forsyth, "Linear-Speed Vertex Cache Optimisation". Every vertex is
+// scored by its position in a simulated LRU cache and by how many triangles
+// still use it; the next triangle emitted is the best-scoring one among those
+// touching the cache.
+
+namespace
+{
+constexpr int FORSYTH_CACHE_SIZE = 32;
+constexpr float FORSYTH_LAST_TRIANGLE_SCORE = 0.75f;
+constexpr float FORSYTH_CACHE_DECAY_POWER = 1.5f;
+constexpr float FORSYTH_VALENCE_BOOST_SCALE = 2.0f;
+constexpr float FORSYTH_VALENCE_BOOST_POWER = 0.5f;
+
+float ForsythVertexScore(int cachePosition, uint32_t remainingTriangles)
+{
+    if (remainingTriangles == 0)
+    {
+        return -1.0f;
+    }
+
+    float score = 0.0f;
+    if (cachePosition >= 0)
+    {
+        if (cachePosition < 3)
+        {
+            score = FORSYTH_LAST_TRIANGLE_SCORE;
+        }
+        else
+        {
+            const float scaler = 1.0f / (FORSYTH_CACHE_SIZE - 3);
+            score = std::pow(1.0f - (cachePosition - 3) * scaler, FORSYTH_CACHE_DECAY_POWER);
+        }
+    }
+    score += FORSYTH_VALENCE_BOOST_SCALE *
+             std::pow(static_cast<float>(remainingTriangles), -FORSYTH_VALENCE_BOOST_POWER);
+    return score;
+}
+} // namespace
+
+void OptimizeVertexCache(uint32_t *indices, size_t indexCount, size_t vertexCount)
+{
+    size_t triangleCount = indexCount / 3;
+    if (triangleCount < 2 || vertexCount == 0)
+    {
+        return;
+    }
+
+    // Vertex -> triangle adjacency (CSR layout).
+    std::vector<uint32_t> remaining(vertexCount, 0);
+    for (size_t i = 0; i < triangleCount * 3; ++i)
+    {
+        ++remaining[indices[i]];
+    }
+    std::vector<uint32_t> adjacencyOffset(vertexCount + 1, 0);
+    for (size_t v = 0; v < vertexCount; ++v)
+    {
+        adjacencyOffset[v + 1] = adjacencyOffset[v] + remaining[v];
+    }
+    std::vector<uint32_t> adjacency(triangleCount * 3);
+    {
+        std::vector<uint32_t> fill(adjacencyOffset.begin(), adjacencyOffset.end() - 1);
+        for (size_t t = 0; t < triangleCount; ++t)
+        {
+            for (size_t k = 0; k < 3; ++k)
+            {
+                adjacency[fill[indices[t * 3 + k]]++] = static_cast<uint32_t>(t);
+            }
+        }
+    }
+
+    std::vector<int> cachePosition(vertexCount, -1);
+    std::vector<float> vertexScore(vertexCount);
+    for (size_t v = 0; v < vertexCount; ++v)
+    {
+        vertexScore[v] = ForsythVertexScore(-1, remaining[v]);
+    }
+
+    std::vector<float> triangleScore(triangleCount);
+    std::vector<uint8_t> emitted(triangleCount, 0);
+    for (size_t t = 0; t < triangleCount; ++t)
+    {
+        triangleScore[t] = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] +
+                           vertexScore[indices[t * 3 + 2]];
+    }
+
+    std::vector<uint32_t> output;
+    output.reserve(triangleCount * 3);
+    std::vector<uint32_t> cache;
+    std::vector<uint32_t> nextCache;
+    cache.reserve(FORSYTH_CACHE_SIZE + 3);
+    nextCache.reserve(FORSYTH_CACHE_SIZE + 3);
+
+    size_t scanCursor = 0;
+    size_t best = 0;
+    for (size_t t = 1; t < triangleCount; ++t)
+    {
+        if (triangleScore[t] > triangleScore[best])
+        {
+            best = t;
+        }
+    }
+
+    for (size_t emittedCount = 0; emittedCount < triangleCount; ++emittedCount)
+    {
+        if (best == SIZE_MAX)
+        {
+            // Nothing in the cache has triangles left; take the next unemitted one.
+            while (emitted[scanCursor])
+            {
+                ++scanCursor;
+            }
+            best = scanCursor;
+        }
+
+        const uint32_t *tri = indices + best * 3;
+        emitted[best] = 1;
+        output.insert(output.end(), tri, tri + 3);
+
+        // Remove the triangle from its vertices' adjacency lists.
+        for (size_t k = 0; k < 3; ++k)
+        {
+            uint32_t v = tri[k];
+            uint32_t *list = adjacency.data() + adjacencyOffset[v];
+            uint32_t count = remaining[v];
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                if (list[i] == best)
+                {
+                    list[i] = list[count - 1];
+                    break;
+                }
+            }
+            --remaining[v];
+        }
+
+        // New cache: the triangle's vertices first, then the old entries.
+        nextCache.assign(tri, tri + 3);
+        for (uint32_t v : cache)
+        {
+            if (v != tri[0] && v != tri[1] && v != tri[2])
+            {
+                nextCache.push_back(v);
+            }
+        }
+        for (uint32_t v : cache)
+        {
+            cachePosition[v] = -1;
+        }
+        if (nextCache.size() > FORSYTH_CACHE_SIZE)
+        {
+            // Evicted vertices fall back to valence-only scores.
+            for (size_t i = FORSYTH_CACHE_SIZE; i < nextCache.size(); ++i)
+            {
+                uint32_t v = nextCache[i];
+                vertexScore[v] = ForsythVertexScore(-1, remaining[v]);
+                for (uint32_t a = 0; a < remaining[v]; ++a)
+                {
+                    uint32_t t = adjacency[adjacencyOffset[v] + a];
+                    triangleScore[t] = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] +
+                                       vertexScore[indices[t * 3 + 2]];
+                }
+            }
+            nextCache.resize(FORSYTH_CACHE_SIZE);
+        }
+        cache.swap(nextCache);
+
+        for (size_t i = 0; i < cache.size(); ++i)
+        {
+            uint32_t v = cache[i];
+            cachePosition[v] = static_cast<int>(i);
+            vertexScore[v] = ForsythVertexScore(static_cast<int>(i), remaining[v]);
+        }
+
+        // Rescore the triangles around the cache and pick the best of them.
+        best = SIZE_MAX;
+        float bestScore = -1.0f;
+        for (uint32_t v : cache)
+        {
+            for (uint32_t a = 0; a < remaining[v]; ++a)
+            {
+                uint32_t t = adjacency[adjacencyOffset[v] + a];
+                float score = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] +
+                              vertexScore[indices[t * 3 + 2]];
+                triangleScore[t] = score;
+                if (score > bestScore)
+                {
+                    bestScore = score;
+                    best = t;
+                }
+            }
+        }
+    }
+
+    std::memcpy(indices, output.data(), output.size() * sizeof(uint32_t));
+}
+
+size_t OptimizeVertexFetch(MeshData &mesh)
+{
+    constexpr uint32_t UNUSED = std::numeric_limits<uint32_t>::max();
+    std::vector<uint32_t> remap(mesh.vertices.size(), UNUSED);
+    std::vector<MeshVertex> vertices;
+    vertices.reserve(mesh.vertices.size());
+
+    for (uint32_t &index : mesh.indices)
+    {
+        if (remap[index] == UNUSED)
+        {
+            remap[index] = static_cast<uint32_t>(vertices.size());
+            vertices.push_back(mesh.vertices[index]);
+        }
+        index = remap[index];
+    }
+
+    mesh.vertices.swap(vertices);
+    return mesh.vertices.size();
 }
+
+float ComputeACMR(const uint32_t *indices, size_t indexCount, size_t vertexCount, size_t cacheSize)
+{
+    if (indexCount < 3)
+    {
+        return 0.0f;
+    }
+
+    // FIFO cache: a vertex is resident if it entered within the last cacheSize misses.
+    std::vector<size_t> entered(vertexCount, 0);
+    size_t misses = 0;
+    for (size_t i = 0; i < indexCount; ++i)
+    {
+        uint32_t v = indices[i];
+        if (entered[v] == 0 || misses + 1 - entered[v] > cacheSize)
+        {
+            ++misses;
+            entered[v] = misses;
+        }
+    }
+    return static_cast<float>(misses) / static_cast<float>(indexCount / 3);
+}
+
+// ---------------------------------------------------------------------------
+// CookedMesh
+// ---------------------------------------------------------------------------
+
+const PackedMeshVertex *CookedMesh::GetVertices() const
+{
+    return bytes_ ? reinterpret_cast<const PackedMeshVertex *>(bytes_.get() + verticesOffset_) : nullptr;
+}
+
+const void *CookedMesh::GetIndices() const
+{
+    return bytes_ ? bytes_.get() + indicesOffset_ : nullptr;
+}
+
+uint32_t CookedMesh::GetIndex(uint32_t i) const
+{
+    const void *indices = GetIndices();
+    return index32_ ? static_cast<const uint32_t *>(indices)[i] : static_cast<const uint16_t *>(indices)[i];
+}
+
+CookedMesh CookedMesh::Cook(MeshData mesh, UUID uuid)
+{
+    if (mesh.indices.empty() || mesh.indices.size() % 3 != 0)
+    {
+        DN_CORE_WARN("CookedMesh::Cook - Expected a non-empty triangle list, got {} indices.", mesh.indices.size());
+        return CookedMesh();
+    }
+    for (uint32_t index : mesh.indices)
+    {
+        if (index >= mesh.vertices.size())
+        {
+            DN_CORE_WARN("CookedMesh::Cook - Index {} out of range ({} vertices).", index, mesh.vertices.size());
+            return CookedMesh();
+        }
+    }
+
+    OptimizeVertexCache(mesh.indices.data(), mesh.indices.size(), mesh.vertices.size());
+    OptimizeVertexFetch(mesh);
+
+    Vector3 min = mesh.vertices[0].position;
+    Vector3 max = min;
+    for (const MeshVertex &vertex : mesh.vertices)
+    {
+        min = Vector3Min(min, vertex.position);
+        max = Vector3Max(max, vertex.position);
+    }
+    Vector3 center = Vector3Scale(Vector3Add(min, max), 0.5f);
+    Vector3 extent = Vector3Scale(Vector3Subtract(max, min), 0.5f);
+    // A flat axis still needs a non-zero scale to dequantize.
+    extent = Vector3(std::max(extent.x, 1e-6f), std::max(extent.y, 1e-6f), std::max(extent.z, 1e-6f));
+
+    const uint32_t vertexCount = static_cast<uint32_t>(mesh.vertices.size());
+    const uint32_t indexCount = static_cast<uint32_t>(mesh.indices.size());
+    const bool index32 = vertexCount > std::numeric_limits<uint16_t>::max();
+    const uint32_t indexSize = index32 ? 4 : 2;
+
+    MeshBinHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.uuid = static_cast<uint64_t>(uuid);
+    header.boundsCenter[0] = center.x;
+    header.boundsCenter[1] = center.y;
+    header.boundsCenter[2] = center.z;
+    header.boundsExtent[0] = extent.x;
+    header.boundsExtent[1] = extent.y;
+    header.boundsExtent[2] = extent.z;
+    header.vertexCount = vertexCount;
+    header.indexCount = indexCount;
+    header.indexSize = indexSize;
+    header.verticesOffset = sizeof(MeshBinHeader);
+    header.indicesOffset = (header.verticesOffset + uint64_t(vertexCount) * sizeof(PackedMeshVertex) + 3) & ~uint64_t(3);
+    const size_t size = static_cast<size_t>(header.indicesOffset + uint64_t(indexCount) * indexSize);
+
+    std::shared_ptr<uint8_t> bytes(new uint8_t[size](), std::default_delete<uint8_t[]>());
+    std::memcpy(bytes.get(), &header, sizeof(header));
+
+    PackedMeshVertex *packed = reinterpret_cast<PackedMeshVertex *>(bytes.get() + header.verticesOffset);
+    for (uint32_t v = 0; v < vertexCount; ++v)
+    {
+        const MeshVertex &vertex = mesh.vertices[v];
+        packed[v].position[0] = ToSnorm16((vertex.position.x - center.x) / extent.x);
+        packed[v].position[1] = ToSnorm16((vertex.position.y - center.y) / extent.y);
+        packed[v].position[2] = ToSnorm16((vertex.position.z - center.z) / extent.z);
+        packed[v].position[3] = static_cast<int16_t>(SNORM16_MAX);
+        EncodeOctahedral(vertex.normal, packed[v].normal);
+        packed[v].uv[0] = FloatToHalf(vertex.uv.x);
+        packed[v].uv[1] = FloatToHalf(vertex.uv.y);
+    }
+
+    uint8_t *indices = bytes.get() + header.indicesOffset;
+    if (index32)
+    {
+        std::memcpy(indices, mesh.indices.data(), size_t(indexCount) * sizeof(uint32_t));
+    }
+    else
+    {
+        uint16_t *indices16 = reinterpret_cast<uint16_t *>(indices);
+        for (uint32_t i = 0; i < indexCount; ++i)
+        {
+            indices16[i] = static_cast<uint16_t>(mesh.indices[i]);
+        }
+    }
+
+    return FromBytes(std::shared_ptr<const uint8_t>(std::move(bytes)), size);
+}
+
+CookedMesh CookedMesh::FromBytes(std::shared_ptr<const uint8_t> bytes, size_t size)
+{
+    if (!bytes || size < sizeof(MeshBinHeader))
+    {
+        DN_CORE_WARN("CookedMesh::FromBytes - Data too small for a cooked mesh ({} bytes).", size);
+        return CookedMesh();
+    }
+    if (reinterpret_cast<uintptr_t>(bytes.get()) % alignof(uint32_t) != 0)
+    {
+        return FromBytes(bytes.get(), size); // copies into an aligned buffer
+    }
+
+    MeshBinHeader header;
+    std::memcpy(&header, bytes.get(), sizeof(header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0)
+    {
+        DN_CORE_WARN("CookedMesh::FromBytes - Not a cooked mesh.");
+        return CookedMesh();
+    }
+    if (header.version != VERSION)
+    {
+        DN_CORE_WARN("CookedMesh::FromBytes - Unsupported version {} (expected {}).", header.version, VERSION);
+        return CookedMesh();
+    }
+
+    const uint64_t verticesSize = uint64_t(header.vertexCount) * sizeof(PackedMeshVertex);
+    const uint64_t indicesSize = uint64_t(header.indexCount) * header.indexSize;
+    // The last sum cannot wrap: both ranges are known to lie inside the data by then.
+    if ((header.indexSize != 2 && header.indexSize != 4) || header.indexCount % 3 != 0 ||
+        header.verticesOffset < sizeof(MeshBinHeader) || header.verticesOffset % 2 != 0 ||
+        header.indicesOffset % header.indexSize != 0 || !FitsIn(header.verticesOffset, verticesSize, size) ||
+        !FitsIn(header.indicesOffset, indicesSize, size) ||
+        header.indicesOffset < header.verticesOffset + verticesSize)
+    {
+        DN_CORE_WARN("CookedMesh::FromBytes - Corrupt or truncated cooked mesh.");
+        return CookedMesh();
+    }
+
+    CookedMesh mesh;
+    mesh.bytes_ = std::move(bytes);
+    mesh.size_ = size;
+    mesh.uuid_ = UUID(header.uuid);
+    mesh.boundsCenter_ = Vector3(header.boundsCenter[0], header.boundsCenter[1], header.boundsCenter[2]);
+    mesh.boundsExtent_ = Vector3(header.boundsExtent[0], header.boundsExtent[1], header.boundsExtent[2]);
+    mesh.vertexCount_ = header.vertexCount;
+    mesh.indexCount_ = header.indexCount;
+    mesh.index32_ = header.indexSize == 4;
+    mesh.verticesOffset_ = header.verticesOffset;
+    mesh.indicesOffset_ = header.indicesOffset;
+
+    // Out-of-range indices would read past the vertex buffer on the GPU.
+    for (uint32_t i = 0; i < mesh.indexCount_; ++i)
+    {
+        if (mesh.GetIndex(i) >= mesh.vertexCount_)
+        {
+            DN_CORE_WARN("CookedMesh::FromBytes - Index {} out of range.", i);
+            return CookedMesh();
+        }
+    }
+    return mesh;
+}
+
+CookedMesh CookedMesh::FromBytes(const void *data, size_t size)
+{
+    if (!data)
+    {
+        return CookedMesh();
+    }
+    std::shared_ptr<uint8_t> bytes(new uint8_t[size], std::default_delete<uint8_t[]>());
+    std::memcpy(bytes.get(), data, size);
+    return FromBytes(std::shared_ptr<const uint8_t>(std::move(bytes)), size);
+}
+
+CookedMesh CookedMesh::LoadFromFile(const std::string &path)
+{
+    std::string resolvedPath = fs::IsVirtualPath(path) ? fs::MapVirtualToSystemPath(path) : path;
+
+    size_t size = 0;
+    void *data = io::IOStream::LoadFile(resolvedPath, &size);
+    if (!data)
+    {
+        DN_CORE_WARN("CookedMesh::LoadFromFile - Failed to read {}", resolvedPath);
+        return CookedMesh();
+    }
+
+    // Adopt the loaded buffer: the vertex and index blocks are used in place.
+    std::shared_ptr<const uint8_t> bytes(static_cast<const uint8_t *>(data), [](const uint8_t *p) {
+        io::IOStream::FreeLoadedData(const_cast<uint8_t *>(p));
+    });
+    return FromBytes(std::move(bytes), size);
+}
+
+bool CookedMesh::SaveToFile(const std::string &path) const
+{
+    if (!IsValid())
+    {
+        return false;
+    }
+    std::string resolvedPath = fs::IsVirtualPath(path) ? fs::MapVirtualToSystemPath(path) : path;
+    return io::IOStream::SaveFile(resolvedPath, bytes_.get(), size_);
+}
+
+MeshData CookedMesh::Decode() const
+{
+    MeshData mesh;
+    if (!IsValid())
+    {
+        return mesh;
+    }
+
+    const PackedMeshVertex *packed = GetVertices();
+    mesh.vertices.resize(vertexCount_);
+    for (uint32_t v = 0; v < vertexCount_; ++v)
+    {
+        MeshVertex &vertex = mesh.vertices[v];
+        vertex.position = Vector3(boundsCenter_.x + FromSnorm16(packed[v].position[0]) * boundsExtent_.x,
+                                  boundsCenter_.y + FromSnorm16(packed[v].position[1]) * boundsExtent_.y,
+                                  boundsCenter_.z + FromSnorm16(packed[v].position[2]) * boundsExtent_.z);
+        vertex.normal = DecodeOctahedral(packed[v].normal);
+        vertex.uv = Vector2(HalfToFloat(packed[v].uv[0]), HalfToFloat(packed[v].uv[1]));
+    }
+
+    mesh.indices.resize(indexCount_);
+    for (uint32_t i = 0; i < indexCount_; ++i)
+    {
+        mesh.indices[i] = GetIndex(i);
+    }
+    return mesh;
+}
+
+// ---------------------------------------------------------------------------
+// Mesh
+// ---------------------------------------------------------------------------
+
+Mesh::Mesh(CookedMesh cooked) : cooked_(std::move(cooked))
+{
+    if (!cooked_.IsValid() || !IsRenderContextAvailable())
+    {
+        return;
+    }
+
+    // Copied: bgfx uploads on a later frame, and the mesh may be released before that.
+    vbh_ = RHICreateVertexBuffer(cooked_.GetVertices(), cooked_.GetVertexCount() * sizeof(PackedMeshVertex),
+                                 RHIVertexFormat::PackedMesh, RHIBufferData::Copy);
+    ibh_ = RHICreateIndexBuffer(cooked_.GetIndices(), cooked_.GetIndexCount(), cooked_.HasIndex32(),
+                                RHIBufferData::Copy);
+}
+
+Mesh::~Mesh()
+{
+    if (!IsRenderContextAvailable())
+    {
+        return;
+    }
+    if (vbh_.IsValid())
+    {
+        RHIDestroyVertexBuffer(vbh_);
+    }
+    if (ibh_.IsValid())
+    {
+        RHIDestroyIndexBuffer(ibh_);
+    }
+}
+
+void Mesh::GetDequantizeMatrix(float *out16) const
+{
+    Vector3 center = cooked_.GetBoundsCenter();
+    Vector3 extent = cooked_.GetBoundsExtent();
+    std::memset(out16, 0, sizeof(float) * 16);
+    out16[0] = extent.x;
+    out16[5] = extent.y;
+    out16[10] = extent.z;
+    out16[12] = center.x;
+    out16[13] = center.y;
+    out16[14] = center.z;
+    out16[15] = 1.0f;
+}
+
+} // namespace duin
@@ -1,6 +1,221 @@
+/**
+ * @file Mesh.h
+ * @brief Mesh assets: import, cooking and GPU upload.
+ * @ingroup Assets
+ *
+ * Source geometry (Wavefront OBJ) is imported once into MeshData, optimized
+ * for the post-transform vertex cache and cooked into an engine-native
+ * binary: positions quantized to 16 bits inside the mesh bounds, normals
+ * octahedral-encoded, UVs as half floats and 16-bit indices whenever the
+ * vertex count allows. A cooked file is loaded with a single read and its
+ * vertex and index blocks are handed to the RHI without conversion.
+ *
+ * @code
+ * std::shared_ptr<duin::Mesh> rock = duin::AssetManager::Get().LoadMesh("res://models/rock.obj");
+ * duin::DrawMesh(*rock, position, rotation, scale);
+ * @endcode
+ */
+
 #pragma once
 
+#include "Duin/Core/Maths/DuinMaths.h"
+#include "Duin/Core/Utils/UUID.h"
+#include "Duin/Render/RHI.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
 namespace duin
 {
 
-}
+/** @brief Uncompressed vertex, as imported. */
+struct MeshVertex
+{
+    Vector3 position;
+    Vector3 normal;
+    Vector2 uv;
+};
+
+/** @brief Imported geometry: an indexed triangle list. */
+struct MeshData
+{
+    std::vector<MeshVertex> vertices;
+    std::vector<uint32_t> indices;
+};
+
+/**
+ * @brief Cooked vertex, 16 bytes.
+ *
+ * Matches RHIVertexFormat::PackedMesh. Positions are snorm16 relative to the
+ * mesh bounds (the renderer folds the bounds into the model matrix), the
+ * normal is an octahedral snorm16 pair and the UV a pair of half floats.
+ */
+struct PackedMeshVertex
+{
+    int16_t position[4]; // w is always 32767 (1.0)
+    int16_t normal[2];
+    uint16_t uv[2];
+};
+
+/**
+ * @brief A cooked mesh: header fields plus the vertex and index blocks, in one buffer.
+ *
+ * The buffer has exactly the layout of a cooked file, so saving writes it as
+ * is and loading adopts the bytes read from disk.
+ */
+class CookedMesh
+{
+  public:
+    static constexpr char MAGIC[4] = {'D', 'N', 'M', 'S'};
+    static constexpr uint32_t VERSION = 1;
+
+    bool IsValid() const
+    {
+        return bytes_ != nullptr;
+    }
+
+    UUID GetUUID() const
+    {
+        return uuid_;
+    }
+    Vector3 GetBoundsCenter() const
+    {
+        return boundsCenter_;
+    }
+    /** @brief Half size of the bounds on each axis. */
+    Vector3 GetBoundsExtent() const
+    {
+        return boundsExtent_;
+    }
+    uint32_t GetVertexCount() const
+    {
+        return vertexCount_;
+    }
+    uint32_t GetIndexCount() const
+    {
+        return indexCount_;
+    }
+    bool HasIndex32() const
+    {
+        return index32_;
+    }
+
+    const PackedMeshVertex *GetVertices() const;
+    /** @brief uint16_t or uint32_t indices, see HasIndex32(). */
+    const void *GetIndices() const;
+    uint32_t GetIndex(uint32_t i) const;
+
+    const uint8_t *GetBytes() const
+    {
+        return bytes_.get();
+    }
+    size_t GetSize() const
+    {
+        return size_;
+    }
+
+    /**
+     * @brief Optimizes, quantizes and packs imported geometry.
+     *
+     * Triangles are reordered for the vertex cache and vertices for fetch
+     * locality (unused vertices are dropped) before packing.
+     */
+    static CookedMesh Cook(MeshData mesh, UUID uuid);
+
+    /** @brief Validates and adopts a cooked file image. Returns an invalid mesh on error. */
+    static CookedMesh FromBytes(std::shared_ptr<const uint8_t> bytes, size_t size);
+    static CookedMesh FromBytes(const void *data, size_t size);
+
+    static CookedMesh LoadFromFile(const std::string &path);
+    bool SaveToFile(const std::string &path) const;
+
+    /** @brief Reconstructs float geometry (e.g. for collision shapes). */
+    MeshData Decode() const;
+
+  private:
+    std::shared_ptr<const uint8_t> bytes_;
+    size_t size_ = 0;
+    UUID uuid_ = UUID::INVALID;
+    Vector3 boundsCenter_;
+    Vector3 boundsExtent_;
+    uint32_t vertexCount_ = 0;
+    uint32_t indexCount_ = 0;
+    bool index32_ = false;
+    uint64_t verticesOffset_ = 0;
+    uint64_t indicesOffset_ = 0;
+};
+
+/**
+ * @brief GPU-resident mesh. Owns its buffers; created through AssetManager::LoadMesh.
+ */
+class Mesh
+{
+  public:
+    explicit Mesh(CookedMesh cooked);
+    ~Mesh();
+
+    Mesh(const Mesh &) = delete;
+    Mesh &operator=(const Mesh &) = delete;
+
+    UUID GetUUID() const
+    {
+        return cooked_.GetUUID();
+    }
+    const CookedMesh &GetCooked() const
+    {
+        return cooked_;
+    }
+    RHIVertexBufferHandle GetVertexBuffer() const
+    {
+        return vbh_;
+    }
+    RHIIndexBufferHandle GetIndexBuffer() const
+    {
+        return ibh_;
+    }
+    bool IsValid() const
+    {
+        return vbh_.IsValid() && ibh_.IsValid();
+    }
+
+    /**
+     * @brief Matrix (RHI layout) mapping quantized positions back into mesh space.
+     *
+     * Prepend it to the model matrix: world = dequantize * model.
+     */
+    void GetDequantizeMatrix(float *out16) const;
+
+  private:
+    CookedMesh cooked_; // CPU-side data; the RHI buffers hold their own copy
+    RHIVertexBufferHandle vbh_;
+    RHIIndexBufferHandle ibh_;
+};
+
+/**
+ * @name Mesh processing
+ * Building blocks of CookedMesh::Cook, exposed for tools and tests.
+ * @{
+ */
+
+/** @brief Parses Wavefront OBJ text (v/vt/vn/f; polygons are fanned). Returns false if no triangles were read. */
+bool ImportOBJ(const char *text, size_t size, MeshData &out);
+
+/** @brief Reorders triangles for the post-transform vertex cache (Forsyth's linear-speed algorithm). */
+void OptimizeVertexCache(uint32_t *indices, size_t indexCount, size_t vertexCount);
+
+/** @brief Reorders vertices by first use and drops unreferenced ones. Returns the new vertex count. */
+size_t OptimizeVertexFetch(MeshData &mesh);
+
+/** @brief Average cache miss ratio (misses per triangle) for a FIFO cache of cacheSize vertices. */
+float ComputeACMR(const uint32_t *indices, size_t indexCount, size_t vertexCount, size_t cacheSize = 16);
+
+void EncodeOctahedral(Vector3 normal, int16_t out[2]);
+Vector3 DecodeOctahedral(const int16_t in[2]);
+uint16_t FloatToHalf(float value);
+float HalfToFloat(uint16_t value);
+/** @} */
+
+} // namespace duin
@@ -7,6 +7,7 @@
 #include "Duin/Core/Events/EngineInput.h"
 #include "Duin/Core/Events/Input.h"
 #include "Duin/Render/Renderer.h"
+#include "Duin/IO/AsyncIOStream.h"
 
 #define SDL_MAIN_HANDLED
 
@@ -56,6 +57,9 @@ static double physicsFrameTime = 0.0;
 static double renderFrameTime = 0.0;
 static int TARGET_RENDER_FRAMERATE = 60;
 static int TARGET_PHYSICS_FRAMERATE = 60;
+// Ticks owed beyond this are dropped so a long stall cannot snowball into ever longer frames.
+static int MAX_PHYSICS_STEPS_PER_FRAME = 8;
+static double physicsInterpolationAlpha = 0.0;
 
 // ---------------------------------------------------------------------------
 // Window state
@@ -77,6 +81,8 @@ static duin::Signal<> postReadySignal;
 static duin::Signal<duin::Event> postInputSignal;
 static duin::Signal<double> postUpdateSignal;
 static duin::Signal<double> postPhysicsUpdateSignal;
+static duin::Signal<double> postPhysicsStepSignal;
+static duin::Signal<> preDrawSignal;
 static duin::Signal<> postDrawSignal;
 static duin::Signal<> postDrawUISignal;
 static duin::Signal<> preFrameSignal;
@@ -146,6 +152,26 @@ void duin::SetFramerate(int framerate)
     TARGET_RENDER_FRAMERATE = framerate;
 }
 
+void duin::SetPhysicsFramerate(int framerate)
+{
+    if (framerate <= 0)
+    {
+        DN_CORE_WARN("Physics framerate must be positive, got {}", framerate);
+        return;
+    }
+    TARGET_PHYSICS_FRAMERATE = framerate;
+}
+
+int duin::GetPhysicsFramerate()
+{
+    return TARGET_PHYSICS_FRAMERATE;
+}
+
+float duin::GetPhysicsInterpolationAlpha()
+{
+    return (float)physicsInterpolationAlpha;
+}
+
 void duin::DrawPhysicsFPS(float x, float y)
 {
     static constexpr size_t bufferSize = 60; // Buffer size (approx. 1 second at 60 FPS)
@@ -341,6 +367,16 @@ std::shared_ptr<duin::ScopedConnection> duin::QueuePostPhysicsUpdateCallback(std
     return postPhysicsUpdateSignal.ConnectScoped(std::move(f));
 }
 
+std::shared_ptr<duin::ScopedConnection> duin::QueuePostPhysicsStepCallback(std::function<void(double)> f)
+{
+    return postPhysicsStepSignal.ConnectScoped(std::move(f));
+}
+
+std::shared_ptr<duin::ScopedConnection> duin::QueuePreDrawCallback(std::function<void()> f)
+{
+    return preDrawSignal.ConnectScoped(std::move(f));
+}
+
 std::shared_ptr<duin::ScopedConnection> duin::QueuePostDrawCallback(std::function<void()> f)
 {
     return postDrawSignal.ConnectScoped(std::move(f));
@@ -398,6 +434,11 @@ void duin::Application::SetHeadless(bool headless)
 {
     headlessMode = headless;
 }
+
+void duin::Application::SetHeadlessRendering(bool enabled)
+{
+    headlessRendering = enabled;
+}
 #endif /* DN_HEADLESS */
 
 // --- Initialization (shared / testing) ---
@@ -440,22 +481,31 @@ void duin::Application::RunPhysics(double &physicsCurrentTime, double &physicsPr
 {
     physicsCurrentTime = duin::GetTicks();
     double physicsDeltaTime = physicsCurrentTime - physicsPreviousTime;
-    physicsAccumTime += physicsDeltaTime;
+    physicsPreviousTime = physicsCurrentTime;
+
     double physicsTimeStep = (1.0 / (double)TARGET_PHYSICS_FRAMERATE);
+    physicsAccumTime += physicsDeltaTime;
+    if (physicsAccumTime > physicsTimeStep * MAX_PHYSICS_STEPS_PER_FRAME)
+    {
+        physicsAccumTime = physicsTimeStep * MAX_PHYSICS_STEPS_PER_FRAME;
+    }
+
     while (physicsAccumTime >= physicsTimeStep)
     {
-        physicsPreviousTime = physicsCurrentTime;
         physicsAccumTime -= physicsTimeStep;
 
         physicsFrameTime = physicsTimeStep;
         ++physicsFrameCount;
 
         if (isPhysicsPaused)
-            return; // TODO Debugging, refactor
+            break; // TODO Debugging, refactor
+
+        PhysicsStep(physicsTimeStep);
 
-        PhysicsStep(physicsDeltaTime);
-        
     } // End of Physics
+
+    // Rendering runs this far past the last tick; the remainder carries over to the next frame.
+    physicsInterpolationAlpha = isPhysicsPaused ? 1.0 : physicsAccumTime / physicsTimeStep;
 }
 
 void duin::Application::PhysicsStep(double frametime)
@@ -493,6 +543,7 @@ void duin::Application::EnginePostReady()
 
 void duin::Application::EnginePreFrame()
 {
+    io::AsyncIOStream::PumpGlobal(io::AsyncIOPhase::PreFrame);
     preFrameSignal.Emit();
 }
 
@@ -524,6 +575,7 @@ void duin::Application::EnginePostUpdate(double delta)
 {
     rootGameObject->ObjectUpdate(delta);
     postUpdateSignal.Emit(delta);
+    io::AsyncIOStream::PumpGlobal(io::AsyncIOPhase::PostUpdate);
 }
 
 void duin::Application::EnginePhysicsUpdate(double delta)
@@ -540,10 +592,12 @@ void duin::Application::EnginePostPhysicsUpdate(double delta)
     postPhysicsUpdateSignal.Emit(delta);
 
     duin::PhysicsServer::Get().StepPhysics(delta);
+    postPhysicsStepSignal.Emit(delta);
 }
 
 void duin::Application::EngineDraw()
 {
+    preDrawSignal.Emit();
 }
 
 void duin::Application::Draw()
@@ -595,6 +649,7 @@ void duin::Application::EnginePostDebug()
 
 void duin::Application::EnginePostFrame()
 {
+    io::AsyncIOStream::PumpGlobal(io::AsyncIOPhase::PostFrame);
     postFrameSignal.Emit();
 }
 
@@ -42,6 +42,22 @@ bool IsUpdatePaused();
 
 /** @brief Sets the target framerate. @param framerate Target frames per second. */
 void SetFramerate(int framerate);
+/**
+ * @brief Sets the fixed physics tick rate. @param framerate Ticks per second (60 by default).
+ *
+ * Rendering stays smooth at low tick rates for entities with a RenderTransform,
+ * which is interpolated between the last two ticks.
+ */
+void SetPhysicsFramerate(int framerate);
+/** @brief Returns the fixed physics tick rate. */
+int GetPhysicsFramerate();
+/**
+ * @brief Fraction of a physics tick that has elapsed since the last one, in [0, 1).
+ *
+ * Valid from the end of the physics ticks until the next frame's. Used to blend
+ * the previous and current physics states when drawing.
+ */
+float GetPhysicsInterpolationAlpha();
 /** @brief Draws physics FPS at screen position. */
 void DrawPhysicsFPS(float x, float y);
 /** @brief Draws render FPS at screen position. */
@@ -99,6 +115,10 @@ std::shared_ptr<ScopedConnection> QueuePostReadyCallback(std::function<void(void
 std::shared_ptr<ScopedConnection> QueuePostInputCallback(std::function<void(Event)> f);
 std::shared_ptr<ScopedConnection> QueuePostUpdateCallback(std::function<void(double)>);
 std::shared_ptr<ScopedConnection> QueuePostPhysicsUpdateCallback(std::function<void(double)>);
+/** @brief Runs right after the PhysicsServer has stepped, once per physics tick. */
+std::shared_ptr<ScopedConnection> QueuePostPhysicsStepCallback(std::function<void(double)>);
+/** @brief Runs once per frame after the physics ticks, before Draw(). */
+std::shared_ptr<ScopedConnection> QueuePreDrawCallback(std::function<void()>);
 std::shared_ptr<ScopedConnection> QueuePostDrawCallback(std::function<void()>);
 std::shared_ptr<ScopedConnection> QueuePostDrawUICallback(std::function<void()>);
 std::shared_ptr<ScopedConnection> QueuePreFrameCallback(std::function<void()>);
@@ -124,7 +144,7 @@ std::shared_ptr<ScopedConnection> QueueExitCallback(std::function<void()>);
  * 3. Main loop:
  *    - OnEvent() - input events
  *    - Update() - per-frame logic (variable timestep)
- *    - PhysicsUpdate() - fixed timestep (60 Hz default)
+ *    - PhysicsUpdate() - fixed timestep (60 Hz default, see SetPhysicsFramerate())
  *    - Draw() - 3D rendering
  *    - DrawUI() - ImGui rendering
  * 4. Exit() - cleanup
@@ -163,6 +183,14 @@ class DAPI Application
 #ifdef DN_HEADLESS
     /** @brief Enables headless mode (no window/ImGui). Call before Run() or InitSDL(). */
     void SetHeadless(bool headless);
+    /**
+     * @brief Runs the 3D render path while headless, on the recording RHI backend.
+     *
+     * Draw calls reach the RHI command stream (see RHIGetCommandStream) instead
+     * of a GPU, for renderer benchmarks and command-stream tests. UI phases are
+     * skipped. Call before Run().
+     */
+    void SetHeadlessRendering(bool enabled);
 #endif /* DN_HEADLESS */
 
 #ifdef DN_TESTING
@@ -256,6 +284,7 @@ class DAPI Application
   private:
 #ifdef DN_HEADLESS
     bool headlessMode = false;
+    bool headlessRendering = false;
 #endif /* DN_HEADLESS */
 
     std::string windowName = "Game";
@@ -280,6 +309,9 @@ class DAPI Application
     void RunUpdate(double delta);
     void RunPhysics(double &physicsCurrentTime, double &physicsPreviousTime, double &physicsAccumTime);
     void RunRender();
+#ifdef DN_HEADLESS
+    void RunHeadlessRender();
+#endif /* DN_HEADLESS */
 
     void PhysicsStep(double frametime);
 };
@@ -14,23 +14,25 @@ void duin::Application::Run()
 
     InitSDL();
 
-    std::function<HWND(void)> renderThreadCapture = [&]() -> HWND {
+    std::function<void *(void)> renderThreadCapture = [&]() -> void * {
         if (headlessMode)
-            return (::HWND) nullptr;
+            return nullptr;
 
-        return (::HWND)::SDL_GetPointerProperty(
+        return ::SDL_GetPointerProperty(
             ::SDL_GetWindowProperties(sdlWindow), SDL_PROP_WINDOW_WIN32_HWND_POINTER, NULL);
     };
 
+    const bool recording = headlessMode && headlessRendering;
     RHIStart(
         RHI_VIEW_3D,
-        headlessMode ? 0 : WINDOW_WIDTH,
-        headlessMode ? 0 : WINDOW_HEIGHT,
+        (headlessMode && !recording) ? 0 : WINDOW_WIDTH,
+        (headlessMode && !recording) ? 0 : WINDOW_HEIGHT,
         renderThreadCapture,
-        headlessMode);
+        headlessMode,
+        recording ? RHIBackend::Recording : RHIBackend::Default);
     InitImGui();
 
-    if (!headlessMode)
+    if (!headlessMode || recording)
     {
         duin::InitRenderer();
         duin::SetRenderContextAvailable(true);
@@ -49,7 +51,7 @@ void duin::Application::Run()
 
     DN_CORE_INFO("Shutting down Rendering dependencies...");
 
-    if (!headlessMode)
+    if (!headlessMode || headlessRendering)
         duin::SetRenderContextAvailable(false);
 
     ShutdownImGui();
@@ -154,9 +156,12 @@ void duin::Application::ProcessEvents()
 
 void duin::Application::RunRender()
 {
-    // TODO change this to run headless with fake rendering
     if (headlessMode)
+    {
+        if (headlessRendering)
+            RunHeadlessRender();
         return;
+    }
 
     // Update render rect on window resizing
     int displayWidth, displayHeight;
@@ -197,6 +202,27 @@ void duin::Application::RunRender()
     duin::ExecuteRenderPipeline();
 }
 
+// Draw phases only: there is no window to resize and no ImGui context to draw UI into.
+void duin::Application::RunHeadlessRender()
+{
+    RHISetViewRect(RHI_VIEW_3D, 0, 0, (uint16_t)WINDOW_WIDTH, (uint16_t)WINDOW_HEIGHT);
+    RHITouch(RHI_VIEW_3D);
+
+    ++renderFrameCount;
+    duin::Camera *camera = duin::GetActiveCamera();
+    if (camera)
+        duin::BeginDraw3D(*camera);
+
+    EngineDraw();
+    Draw();
+    EnginePostDraw();
+
+    if (camera)
+        duin::EndDraw3D();
+
+    duin::ExecuteRenderPipeline();
+}
+
 bool duin::Application::ProcessFrame(
     double &deltaTime, double &physicsCurrentTime, double &physicsPreviousTime, double &physicsAccumTime)
 {
@@ -61,9 +61,9 @@ void duin::Application::InitRHI()
         RHI_VIEW_3D,
         WINDOW_WIDTH, 
         WINDOW_HEIGHT, 
-        [&]() {
-            return (::HWND)::SDL_GetPointerProperty(::SDL_GetWindowProperties(sdlWindow),
-                                                SDL_PROP_WINDOW_WIN32_HWND_POINTER, NULL);
+        [&]() -> void * {
+            return ::SDL_GetPointerProperty(::SDL_GetWindowProperties(sdlWindow),
+                                            SDL_PROP_WINDOW_WIN32_HWND_POINTER, NULL);
         },
         false // not headless
     );
@@ -0,0 +1,204 @@
+#include "dnpch.h"
+#include "MathsBatch.h"
+
+#include <xmmintrin.h>
+#if defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+namespace duin
+{
+
+static_assert(sizeof(Matrix) == 16 * sizeof(float), "Matrix must be 16 packed floats");
+static_assert(sizeof(Quaternion) == 4 * sizeof(float), "Quaternion must be 4 packed floats");
+
+// ---------------------------------------------------------------------------
+// Scalar fallbacks
+// ---------------------------------------------------------------------------
+
+static void ComposeTRS(const Vector3 &t, const Quaternion &q, const Vector3 &s, float *o)
+{
+    float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+    float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+    float xw = q.x * q.w, yw = q.y * q.w, zw = q.z * q.w;
+
+    o[0] = (1.0f - 2.0f * (yy + zz)) * s.x;
+    o[1] = 2.0f * (xy - zw) * s.y;
+    o[2] = 2.0f * (xz + yw) * s.z;
+    o[3] = t.x;
+
+    o[4] = 2.0f * (xy + zw) * s.x;
+    o[5] = (1.0f - 2.0f * (xx + zz)) * s.y;
+    o[6] = 2.0f * (yz - xw) * s.z;
+    o[7] = t.y;
+
+    o[8] = 2.0f * (xz - yw) * s.x;
+    o[9] = 2.0f * (yz + xw) * s.y;
+    o[10] = (1.0f - 2.0f * (xx + yy)) * s.z;
+    o[11] = t.z;
+
+    o[12] = 0.0f;
+    o[13] = 0.0f;
+    o[14] = 0.0f;
+    o[15] = 1.0f;
+}
+
+static void MultiplyRows(const __m128 (&p)[4][4], const float *l, float *o)
+{
+    __m128 l0 = _mm_loadu_ps(l + 0);
+    __m128 l1 = _mm_loadu_ps(l + 4);
+    __m128 l2 = _mm_loadu_ps(l + 8);
+    __m128 l3 = _mm_loadu_ps(l + 12);
+
+    for (int r = 0; r < 4; ++r)
+    {
+        __m128 row = _mm_mul_ps(p[r][0], l0);
+        row = _mm_add_ps(row, _mm_mul_ps(p[r][1], l1));
+        row = _mm_add_ps(row, _mm_mul_ps(p[r][2], l2));
+        row = _mm_add_ps(row, _mm_mul_ps(p[r][3], l3));
+        _mm_storeu_ps(o + r * 4, row);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// TRS composition, four entities per iteration
+// ---------------------------------------------------------------------------
+
+void MatrixComposeTRSBatch(const Vector3 *positions, const Quaternion *rotations, const Vector3 *scales, Matrix *out,
+                           size_t count)
+{
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 two = _mm_set1_ps(2.0f);
+    const __m128 lastRow = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        // AoS quaternions -> SoA lanes
+        __m128 x = _mm_loadu_ps(&rotations[i + 0].x);
+        __m128 y = _mm_loadu_ps(&rotations[i + 1].x);
+        __m128 z = _mm_loadu_ps(&rotations[i + 2].x);
+        __m128 w = _mm_loadu_ps(&rotations[i + 3].x);
+        _MM_TRANSPOSE4_PS(x, y, z, w);
+
+        const Vector3 *s = scales + i;
+        const Vector3 *t = positions + i;
+        __m128 sx = _mm_setr_ps(s[0].x, s[1].x, s[2].x, s[3].x);
+        __m128 sy = _mm_setr_ps(s[0].y, s[1].y, s[2].y, s[3].y);
+        __m128 sz = _mm_setr_ps(s[0].z, s[1].z, s[2].z, s[3].z);
+        __m128 tx = _mm_setr_ps(t[0].x, t[1].x, t[2].x, t[3].x);
+        __m128 ty = _mm_setr_ps(t[0].y, t[1].y, t[2].y, t[3].y);
+        __m128 tz = _mm_setr_ps(t[0].z, t[1].z, t[2].z, t[3].z);
+
+        __m128 xx = _mm_mul_ps(x, x), yy = _mm_mul_ps(y, y), zz = _mm_mul_ps(z, z);
+        __m128 xy = _mm_mul_ps(x, y), xz = _mm_mul_ps(x, z), yz = _mm_mul_ps(y, z);
+        __m128 xw = _mm_mul_ps(x, w), yw = _mm_mul_ps(y, w), zw = _mm_mul_ps(z, w);
+
+        // Rotation columns scaled per axis, one register per matrix element across four entities
+        __m128 m00 = _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz))), sx);
+        __m128 m01 = _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xy, zw)), sy);
+        __m128 m02 = _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xz, yw)), sz);
+
+        __m128 m10 = _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xy, zw)), sx);
+        __m128 m11 = _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz))), sy);
+        __m128 m12 = _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(yz, xw)), sz);
+
+        __m128 m20 = _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xz, yw)), sx);
+        __m128 m21 = _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(yz, xw)), sy);
+        __m128 m22 = _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy))), sz);
+
+        // SoA -> one stored row per entity
+        _MM_TRANSPOSE4_PS(m00, m01, m02, tx);
+        _MM_TRANSPOSE4_PS(m10, m11, m12, ty);
+        _MM_TRANSPOSE4_PS(m20, m21, m22, tz);
+
+        const __m128 rows[4][3] = {{m00, m10, m20}, {m01, m11, m21}, {m02, m12, m22}, {tx, ty, tz}};
+        for (int e = 0; e < 4; ++e)
+        {
+            float *o = reinterpret_cast<float *>(&out[i + e]);
+            _mm_storeu_ps(o + 0, rows[e][0]);
+            _mm_storeu_ps(o + 4, rows[e][1]);
+            _mm_storeu_ps(o + 8, rows[e][2]);
+            _mm_storeu_ps(o + 12, lastRow);
+        }
+    }
+
+    for (; i < count; ++i)
+    {
+        ComposeTRS(positions[i], rotations[i], scales[i], reinterpret_cast<float *>(&out[i]));
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Parent * local, four entities per iteration
+// ---------------------------------------------------------------------------
+
+void MatrixMultiplyBatch(const Matrix &parent, const Matrix *local, Matrix *out, size_t count)
+{
+    const float *p = reinterpret_cast<const float *>(&parent);
+
+    __m128 pb[4][4];
+    for (int r = 0; r < 4; ++r)
+    {
+        for (int k = 0; k < 4; ++k)
+        {
+            pb[r][k] = _mm_set1_ps(p[r * 4 + k]);
+        }
+    }
+
+    size_t i = 0;
+#if defined(__AVX__)
+    __m256 pw[4][4];
+    for (int r = 0; r < 4; ++r)
+    {
+        for (int k = 0; k < 4; ++k)
+        {
+            pw[r][k] = _mm256_set1_ps(p[r * 4 + k]);
+        }
+    }
+
+    for (; i + 4 <= count; i += 4)
+    {
+        for (size_t pair = 0; pair < 4; pair += 2)
+        {
+            const float *la = reinterpret_cast<const float *>(&local[i + pair]);
+            const float *lb = reinterpret_cast<const float *>(&local[i + pair + 1]);
+            float *oa = reinterpret_cast<float *>(&out[i + pair]);
+            float *ob = reinterpret_cast<float *>(&out[i + pair + 1]);
+
+            // Row k of entity a in the low lane, row k of entity b in the high lane
+            __m256 l[4];
+            for (int k = 0; k < 4; ++k)
+            {
+                l[k] = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(la + k * 4)),
+                                            _mm_loadu_ps(lb + k * 4), 1);
+            }
+
+            for (int r = 0; r < 4; ++r)
+            {
+                __m256 row = _mm256_mul_ps(pw[r][0], l[0]);
+                row = _mm256_add_ps(row, _mm256_mul_ps(pw[r][1], l[1]));
+                row = _mm256_add_ps(row, _mm256_mul_ps(pw[r][2], l[2]));
+                row = _mm256_add_ps(row, _mm256_mul_ps(pw[r][3], l[3]));
+                _mm_storeu_ps(oa + r * 4, _mm256_castps256_ps128(row));
+                _mm_storeu_ps(ob + r * 4, _mm256_extractf128_ps(row, 1));
+            }
+        }
+    }
+#else
+    for (; i + 4 <= count; i += 4)
+    {
+        MultiplyRows(pb, reinterpret_cast<const float *>(&local[i + 0]), reinterpret_cast<float *>(&out[i + 0]));
+        MultiplyRows(pb, reinterpret_cast<const float *>(&local[i + 1]), reinterpret_cast<float *>(&out[i + 1]));
+        MultiplyRows(pb, reinterpret_cast<const float *>(&local[i + 2]), reinterpret_cast<float *>(&out[i + 2]));
+        MultiplyRows(pb, reinterpret_cast<const float *>(&local[i + 3]), reinterpret_cast<float *>(&out[i + 3]));
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        MultiplyRows(pb, reinterpret_cast<const float *>(&local[i]), reinterpret_cast<float *>(&out[i]));
+    }
+}
+
+} // namespace duin
@@ -0,0 +1,41 @@
+/**
+ * @file MathsBatch.h
+ * @brief SIMD batch kernels for composing world matrices.
+ * @ingroup Core_Maths
+ *
+ * Matrices use the DuinMaths layout: semantically column-major, stored as
+ * four contiguous rows. A row of (A * B) is therefore a linear combination
+ * of the rows of B, which lets each kernel stream whole rows through SSE
+ * registers without transposing the right-hand operand.
+ *
+ * The AVX path (two matrices per 256-bit register) is selected at compile
+ * time when __AVX__ is defined (e.g. vectorextensions "AVX2" in premake);
+ * otherwise the SSE path is used. Both process four entities per iteration
+ * and fall back to scalar code for the tail.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#include "DuinMaths.h"
+
+namespace duin
+{
+
+/**
+ * @brief Builds T * R * S affine matrices for count entities.
+ *
+ * Rotations are expected to be unit quaternions.
+ */
+void MatrixComposeTRSBatch(const Vector3 *positions, const Quaternion *rotations, const Vector3 *scales, Matrix *out,
+                           size_t count);
+
+/**
+ * @brief Computes out[i] = parent * local[i] for count matrices.
+ *
+ * Equivalent to MatrixMultiply(local[i], parent). out may alias local.
+ */
+void MatrixMultiplyBatch(const Matrix &parent, const Matrix *local, Matrix *out, size_t count);
+
+} // namespace duin
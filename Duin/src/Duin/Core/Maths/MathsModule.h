@@ -5,4 +5,5 @@
  */
 
 #include "DuinMaths.h"
+#include "MathsBatch.h"
 #include "PhysXConversions.h"
@@ -86,64 +86,95 @@ class ScopedConnection
 
 // ─── SignalImpl ───────────────────────────────────────────────────────────────
 
+/**
+ * Listener storage is a generation-indexed slot map. The UUID handed out by
+ * Connect() encodes the slot index, the slot generation and a per-signal salt,
+ * so Disconnect() is O(1) and a stale or foreign UUID is rejected.
+ *
+ * Slots live in fixed-size pages that never move, so Emit() calls listeners in
+ * place even when a listener connects new ones. Slots disconnected during an
+ * emission are only destroyed and recycled once the outermost Emit() returns.
+ */
 template <typename... types>
 class SignalImpl
 {
   public:
-    using Listener = std::pair<UUID, std::function<void(types...)>>;
+    using Callback = std::function<void(types...)>;
+    using Thunk = void (*)(void *, types...);
 
     ~SignalImpl()
     {
-        for (auto &[id, weakConn] : scopedConnections_)
+        for (size_t i = 0; i < slotCount_; ++i)
         {
-            if (auto conn = weakConn.lock())
+            Slot &slot = SlotAt(static_cast<uint32_t>(i));
+            if (!slot.alive)
+                continue;
+            if (auto conn = slot.scoped.lock())
                 conn->Invalidate();
         }
     }
 
-    SignalImpl() = default;
+    SignalImpl()
+    {
+        salt_ = static_cast<uint16_t>(static_cast<uint64_t>(UUID()) >> 48);
+        if (salt_ == 0)
+            salt_ = 1;
+    }
+
     SignalImpl(const SignalImpl &) = delete;
     SignalImpl &operator=(const SignalImpl &) = delete;
     SignalImpl(SignalImpl &&) = delete;
     SignalImpl &operator=(SignalImpl &&) = delete;
 
-    UUID Connect(std::function<void(types...)> callback)
+    UUID Connect(Callback callback)
     {
-        UUID uuid;
-        callbacks_.emplace_back(uuid, std::move(callback));
-        return uuid;
+        uint32_t index = AcquireSlot();
+        SlotAt(index).function = std::move(callback);
+        return Activate(index);
     }
 
-    std::shared_ptr<ScopedConnection> ConnectScoped(std::shared_ptr<SignalImpl> self,
-                                                    std::function<void(types...)> callback)
+    /** @brief Connects a raw function trampoline; no std::function is involved. */
+    UUID Connect(Thunk thunk, void *object)
     {
-        UUID id = Connect(std::move(callback));
-        std::weak_ptr<SignalImpl> weakSelf = self;
-        auto conn = std::shared_ptr<ScopedConnection>(new ScopedConnection(id, [weakSelf, id]() {
-            if (auto impl = weakSelf.lock())
-                impl->Disconnect(id);
-        }));
-        scopedConnections_.emplace_back(id, std::weak_ptr<ScopedConnection>(conn));
-        return conn;
+        uint32_t index = AcquireSlot();
+        Slot &slot = SlotAt(index);
+        slot.thunk = thunk;
+        slot.object = object;
+        return Activate(index);
+    }
+
+    std::shared_ptr<ScopedConnection> ConnectScoped(std::shared_ptr<SignalImpl> self, Callback callback)
+    {
+        return MakeScoped(self, Connect(std::move(callback)));
+    }
+
+    std::shared_ptr<ScopedConnection> ConnectScoped(std::shared_ptr<SignalImpl> self, Thunk thunk, void *object)
+    {
+        return MakeScoped(self, Connect(thunk, object));
     }
 
     void Disconnect(UUID uuid)
     {
-        for (auto &[id, weakConn] : scopedConnections_)
+        uint32_t index;
+        if (!Resolve(uuid, index))
+            return;
+
+        Slot &slot = SlotAt(index);
+        if (auto conn = slot.scoped.lock())
+            conn->Invalidate();
+
+        Kill(index);
+        if (emitDepth_ > 0)
         {
-            if (id == uuid)
-            {
-                if (auto conn = weakConn.lock())
-                    conn->Invalidate();
-                break;
-            }
+            // The listener may be running right now; destroy it after the emission.
+            pendingRelease_.push_back(index);
         }
-        std::erase_if(scopedConnections_, [&](const auto &p) { return p.first == uuid; });
-
-        if (emitExecuting_)
-            eraseQueue_.push_back(uuid);
         else
-            std::erase_if(callbacks_, [&](const Listener &l) { return l.first == uuid; });
+        {
+            Release(index);
+            if (staleEntries_ * 2 > order_.size())
+                CompactOrder();
+        }
     }
 
     void Disconnect(std::weak_ptr<ScopedConnection> sc)
@@ -160,92 +191,221 @@ class SignalImpl
 
     void DisconnectAll()
     {
-        for (auto &[id, weakConn] : scopedConnections_)
+        for (const Handle &handle : order_)
         {
-            if (auto conn = weakConn.lock())
+            Slot &slot = SlotAt(handle.index);
+            if (!slot.alive || slot.generation != handle.generation)
+                continue;
+            if (auto conn = slot.scoped.lock())
                 conn->Invalidate();
+
+            Kill(handle.index);
+            if (emitDepth_ > 0)
+                pendingRelease_.push_back(handle.index);
+            else
+                Release(handle.index);
         }
-        scopedConnections_.clear();
 
-        if (emitExecuting_)
-            queueEraseAll_ = true;
-        else
-            callbacks_.clear();
+        if (emitDepth_ == 0)
+            CompactOrder();
     }
 
     bool Emit(types... args)
     {
-        DN_CORE_WARN_IF(emitExecuting_,
+        DN_CORE_WARN_IF(emitDepth_ > 0,
                          "Recursive infinite emission detected! Do not re-emit signal while it is still emitting");
-        //DN_CORE_ASSERT(!emitExecuting_,
-        //               "Recursive infinite emission detected! Do not re-emit signal while it is still emitting");
 
-        if (!emitExecuting_)
+        if (emitDepth_ == 0)
         {
             recursionLimitHit = false;
         }
 
-        ++recursiveEmissionCount;
-        if (recursiveEmissionCount >= 30)
+        if (emitDepth_ + 1 >= 30)
         {
             DN_CORE_FATAL("Recursive emission exceeded 30! Preventing recursion loop.");
-            --recursiveEmissionCount;
             recursionLimitHit = true;
             return false;
         }
 
-        emitExecuting_ = true;
+        EmitScope scope(*this);
 
-        for (size_t i = 0; i < callbacks_.size(); i++)
+        // Listeners connected during this emission are first called by the next one.
+        size_t count = order_.size();
+        for (size_t i = 0; i < count; ++i)
         {
-            auto [id, fn] = callbacks_[i];
-            if (fn)
-                fn(args...);
+            Handle handle = order_[i];
+            Slot &slot = SlotAt(handle.index);
+            if (!slot.alive || slot.generation != handle.generation)
+                continue;
+
+            if (slot.thunk)
+                slot.thunk(slot.object, args...);
+            else if (slot.function)
+                slot.function(args...);
             else
-                Disconnect(id);
+                Disconnect(Encode(handle.index, handle.generation));
         }
 
-        emitExecuting_ = false;
+        return !recursionLimitHit;
+    }
+
+    size_t GetListenerCount() const
+    {
+        return liveCount_;
+    }
+
+  private:
+    static constexpr uint32_t PAGE_SIZE = 64;
+    static constexpr uint32_t INDEX_BITS = 24;
+    static constexpr uint32_t INDEX_MASK = (1u << INDEX_BITS) - 1;
+    static constexpr uint32_t GENERATION_MASK = (1u << 24) - 1;
 
-        if (queueEraseAll_)
+    struct Slot
+    {
+        Callback function;
+        Thunk thunk = nullptr;
+        void *object = nullptr;
+        std::weak_ptr<ScopedConnection> scoped;
+        uint32_t generation = 0;
+        bool alive = false;
+    };
+
+    struct Handle
+    {
+        uint32_t index;
+        uint32_t generation;
+    };
+
+    struct EmitScope
+    {
+        SignalImpl &impl;
+        explicit EmitScope(SignalImpl &impl) : impl(impl)
         {
-            callbacks_.clear();
-            queueEraseAll_ = false;
+            ++impl.emitDepth_;
         }
-        else
+        ~EmitScope()
         {
-            EraseQueue();
+            // Also runs when a listener throws, so the signal stays usable.
+            if (--impl.emitDepth_ == 0)
+                impl.FlushPending();
         }
+    };
+
+    std::vector<std::unique_ptr<Slot[]>> pages_;
+    std::vector<Handle> order_; // Connection order; may hold stale handles until compacted
+    std::vector<uint32_t> freeSlots_;
+    std::vector<uint32_t> pendingRelease_;
+    size_t slotCount_ = 0;
+    size_t liveCount_ = 0;
+    size_t staleEntries_ = 0;
+    uint16_t salt_ = 1;
+
+    size_t emitDepth_ = 0;
+    bool recursionLimitHit = false;
 
-        bool res = recursionLimitHit;
+    Slot &SlotAt(uint32_t index)
+    {
+        return pages_[index / PAGE_SIZE][index % PAGE_SIZE];
+    }
 
-        --recursiveEmissionCount;
-        return !res;
+    uint32_t AcquireSlot()
+    {
+        if (!freeSlots_.empty())
+        {
+            uint32_t index = freeSlots_.back();
+            freeSlots_.pop_back();
+            return index;
+        }
+
+        DN_CORE_ASSERT(slotCount_ <= INDEX_MASK, "Signal listener slots exhausted!");
+        if (slotCount_ % PAGE_SIZE == 0)
+            pages_.push_back(std::make_unique<Slot[]>(PAGE_SIZE));
+        return static_cast<uint32_t>(slotCount_++);
     }
 
-    size_t GetListenerCount() const
+    UUID Activate(uint32_t index)
     {
-        return callbacks_.size();
+        Slot &slot = SlotAt(index);
+        slot.alive = true;
+        ++liveCount_;
+        order_.push_back({index, slot.generation});
+        return Encode(index, slot.generation);
     }
 
-  private:
-    std::vector<Listener> callbacks_;
-    std::vector<std::pair<UUID, std::weak_ptr<ScopedConnection>>> scopedConnections_;
-    std::vector<UUID> eraseQueue_;
+    std::shared_ptr<ScopedConnection> MakeScoped(const std::shared_ptr<SignalImpl> &self, UUID id)
+    {
+        std::weak_ptr<SignalImpl> weakSelf = self;
+        auto conn = std::shared_ptr<ScopedConnection>(new ScopedConnection(id, [weakSelf, id]() {
+            if (auto impl = weakSelf.lock())
+                impl->Disconnect(id);
+        }));
 
-    bool emitExecuting_ = false;
-    bool queueEraseAll_ = false;
-    bool recursionLimitHit = false;
-    size_t recursiveEmissionCount = 0;
+        uint32_t index;
+        if (Resolve(id, index))
+            SlotAt(index).scoped = conn;
+        return conn;
+    }
 
-    void EraseQueue()
+    UUID Encode(uint32_t index, uint32_t generation) const
     {
-        // O(N^2) 'cause why not
-        for (auto &uuid : eraseQueue_)
-        {
-            std::erase_if(callbacks_, [uuid](const Listener &l) { return l.first == uuid; });
-        }
-        eraseQueue_.clear();
+        return UUID((static_cast<uint64_t>(salt_) << 48) | (static_cast<uint64_t>(generation) << INDEX_BITS) |
+                    static_cast<uint64_t>(index));
+    }
+
+    /** @brief Maps a UUID back to a live slot of this signal. */
+    bool Resolve(UUID uuid, uint32_t &index)
+    {
+        uint64_t value = static_cast<uint64_t>(uuid);
+        if (static_cast<uint16_t>(value >> 48) != salt_)
+            return false;
+
+        index = static_cast<uint32_t>(value & INDEX_MASK);
+        uint32_t generation = static_cast<uint32_t>(value >> INDEX_BITS) & GENERATION_MASK;
+        if (index >= slotCount_)
+            return false;
+
+        const Slot &slot = SlotAt(index);
+        return slot.alive && slot.generation == generation;
+    }
+
+    /** @brief Marks a slot dead; its handle stops resolving immediately. */
+    void Kill(uint32_t index)
+    {
+        Slot &slot = SlotAt(index);
+        slot.alive = false;
+        slot.generation = (slot.generation + 1) & GENERATION_MASK;
+        --liveCount_;
+        ++staleEntries_;
+    }
+
+    /** @brief Destroys the listener and makes the slot reusable. */
+    void Release(uint32_t index)
+    {
+        Slot &slot = SlotAt(index);
+        slot.function = nullptr;
+        slot.thunk = nullptr;
+        slot.object = nullptr;
+        slot.scoped.reset();
+        freeSlots_.push_back(index);
+    }
+
+    void FlushPending()
+    {
+        for (uint32_t index : pendingRelease_)
+            Release(index);
+        pendingRelease_.clear();
+
+        if (staleEntries_ > 0)
+            CompactOrder();
+    }
+
+    void CompactOrder()
+    {
+        std::erase_if(order_, [this](const Handle &handle) {
+            const Slot &slot = SlotAt(handle.index);
+            return !slot.alive || slot.generation != handle.generation;
+        });
+        staleEntries_ = 0;
     }
 };
 
@@ -256,6 +416,7 @@ class SignalImpl
  *
  * A type-safe signal/slot system supporting multiple listeners.
  * Listeners are identified by UUIDs and can be connected, disconnected, and notified with arbitrary arguments.
+ * A listener UUID is only meaningful to the signal that returned it.
  * NOT THREAD-SAFE!
  *
  * Move-only: moving a Signal preserves all existing ScopedConnections.
@@ -273,8 +434,6 @@ template <typename... types>
 class Signal
 {
   public:
-    using Listener = std::pair<UUID, std::function<void(types...)>>;
-
     Signal() : impl_(std::make_shared<SignalImpl<types...>>())
     {
     }
@@ -301,6 +460,36 @@ class Signal
         return impl_->Connect(std::move(callback));
     }
 
+    /**
+     * @brief Connects a free function known at compile time, without a std::function.
+     *
+     * @code
+     * void OnResize(int w, int h);
+     * sig.Connect<&OnResize>();
+     * @endcode
+     */
+    template <auto Fn>
+    UUID Connect()
+    {
+        return impl_->Connect(&InvokeFunction<Fn>, nullptr);
+    }
+
+    /**
+     * @brief Connects a member function of @p instance, without a std::function.
+     *
+     * The signal stores a raw pointer: disconnect before @p instance is destroyed
+     * (or use ConnectScoped).
+     *
+     * @code
+     * sig.Connect<&Player::OnDamage>(this);
+     * @endcode
+     */
+    template <auto Method, typename T>
+    UUID Connect(T *instance)
+    {
+        return impl_->Connect(&InvokeMethod<Method, T>, ErasePointer(instance));
+    }
+
     /**
      * @brief Connects a listener and returns a shared_ptr<ScopedConnection> that auto-disconnects.
      *
@@ -314,6 +503,13 @@ class Signal
         return impl_->ConnectScoped(impl_, std::move(callback));
     }
 
+    /** @brief Scoped variant of Connect<&Method>(instance). */
+    template <auto Method, typename T>
+    std::shared_ptr<ScopedConnection> ConnectScoped(T *instance)
+    {
+        return impl_->ConnectScoped(impl_, &InvokeMethod<Method, T>, ErasePointer(instance));
+    }
+
     /**
      * @brief Disconnects a listener by UUID.
      *
@@ -369,6 +565,24 @@ class Signal
     }
 
   private:
+    template <auto Fn>
+    static void InvokeFunction(void *, types... args)
+    {
+        std::invoke(Fn, args...);
+    }
+
+    template <auto Method, typename T>
+    static void InvokeMethod(void *object, types... args)
+    {
+        std::invoke(Method, static_cast<T *>(object), args...);
+    }
+
+    template <typename T>
+    static void *ErasePointer(T *instance)
+    {
+        return const_cast<void *>(static_cast<const void *>(instance));
+    }
+
     UUID uuid_;
     std::shared_ptr<SignalImpl<types...>> impl_ = nullptr;
 };
@@ -0,0 +1,263 @@
+/**
+ * @file FixedAccumulator.h
+ * @brief Small vector with inline capacity that spills into a FrameArena.
+ * @ingroup Core_Utils
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "FrameArena.h"
+
+namespace duin
+{
+
+/**
+ * @brief Per-tick accumulator for ECS components (forces, velocity impulses, ...).
+ *
+ * The first N values live inline. Pushing more copies everything into a
+ * FrameArena buffer, so the contents stay contiguous and the accumulator can
+ * sit directly in a flecs column without per-entity heap traffic.
+ *
+ * Spilled values are only valid until the arena is reset (GameWorld resets
+ * its arena after the post-physics phase). An accumulator that is still
+ * spilled after a reset is empty.
+ *
+ * Moving hands the spill buffer over. A copy never shares it: a spilled
+ * accumulator is copied into a new buffer from the same arena.
+ *
+ * Serialized as a plain array. Wrap it in a named component, e.g.
+ * @code
+ * struct InputForces { duin::FixedAccumulator<duin::Vector3, 8> vec; };
+ * @endcode
+ */
+template <typename T, size_t N>
+class FixedAccumulator
+{
+    static_assert(N > 0, "FixedAccumulator needs an inline capacity");
+    static_assert(std::is_trivially_copyable_v<T>, "FixedAccumulator stores trivially copyable values");
+
+  public:
+    FixedAccumulator() = default;
+
+    FixedAccumulator(const FixedAccumulator &other)
+    {
+        CopyFrom(other);
+    }
+
+    FixedAccumulator &operator=(const FixedAccumulator &other)
+    {
+        if (this != &other)
+        {
+            CopyFrom(other);
+        }
+        return *this;
+    }
+
+    FixedAccumulator(FixedAccumulator &&other) noexcept
+        : inline_(other.inline_), spill_(other.spill_), arena_(other.arena_), size_(other.size_),
+          spillCapacity_(other.spillCapacity_), spillGeneration_(other.spillGeneration_)
+    {
+        other.Clear();
+    }
+
+    FixedAccumulator &operator=(FixedAccumulator &&other) noexcept
+    {
+        if (this != &other)
+        {
+            inline_ = other.inline_;
+            spill_ = other.spill_;
+            arena_ = other.arena_;
+            size_ = other.size_;
+            spillCapacity_ = other.spillCapacity_;
+            spillGeneration_ = other.spillGeneration_;
+            other.Clear();
+        }
+        return *this;
+    }
+
+    /** @brief Appends a value. Returns false when the inline storage is full. */
+    bool TryPush(const T &value)
+    {
+        DropStaleSpill();
+        if (size_ >= N)
+        {
+            return false;
+        }
+        inline_[size_++] = value;
+        return true;
+    }
+
+    /** @brief Appends a value, spilling into the arena once the inline storage is full. */
+    void Push(const T &value, FrameArena &arena)
+    {
+        DropStaleSpill();
+        if (size_ < N && !spill_)
+        {
+            inline_[size_++] = value;
+            return;
+        }
+        if (!spill_ || arena_ != &arena || size_ >= spillCapacity_)
+        {
+            Grow(arena);
+        }
+        spill_[size_++] = value;
+    }
+
+    void Clear()
+    {
+        size_ = 0;
+        spill_ = nullptr;
+        spillCapacity_ = 0;
+        arena_ = nullptr;
+    }
+
+    size_t Size() const
+    {
+        return IsSpillValid() || !spill_ ? size_ : 0;
+    }
+
+    bool Empty() const
+    {
+        return Size() == 0;
+    }
+
+    static constexpr size_t InlineCapacity()
+    {
+        return N;
+    }
+
+    /** @brief True when the values currently live in the arena. */
+    bool IsSpilled() const
+    {
+        return IsSpillValid();
+    }
+
+    const T *Data() const
+    {
+        return IsSpillValid() ? spill_ : inline_.data();
+    }
+
+    T *Data()
+    {
+        return IsSpillValid() ? spill_ : inline_.data();
+    }
+
+    std::span<const T> Items() const
+    {
+        return std::span<const T>(Data(), Size());
+    }
+
+    std::span<T> Items()
+    {
+        return std::span<T>(Data(), Size());
+    }
+
+    const T &operator[](size_t index) const
+    {
+        return Data()[index];
+    }
+
+    T &operator[](size_t index)
+    {
+        return Data()[index];
+    }
+
+    const T *begin() const
+    {
+        return Data();
+    }
+
+    const T *end() const
+    {
+        return Data() + Size();
+    }
+
+    T *begin()
+    {
+        return Data();
+    }
+
+    T *end()
+    {
+        return Data() + Size();
+    }
+
+    using ReflectionType = std::vector<T>;
+    /** @brief Builds from serialized values. Only the first N are kept, as no arena is available. */
+    FixedAccumulator(const ReflectionType &values)
+    {
+        for (const T &value : values)
+        {
+            if (!TryPush(value))
+            {
+                break;
+            }
+        }
+    }
+    ReflectionType reflection() const
+    {
+        return ReflectionType(begin(), end());
+    }
+
+  private:
+    bool IsSpillValid() const
+    {
+        return spill_ && arena_->GetGeneration() == spillGeneration_;
+    }
+
+    // Once spilled, writes only reach the arena copy, so the inline values are out of date.
+    void DropStaleSpill()
+    {
+        if (spill_ && !IsSpillValid())
+        {
+            Clear();
+        }
+    }
+
+    void CopyFrom(const FixedAccumulator &other)
+    {
+        Clear();
+        if (!other.IsSpillValid())
+        {
+            size_ = static_cast<uint32_t>(other.Size());
+            std::copy(other.Data(), other.Data() + size_, inline_.begin());
+            return;
+        }
+
+        spillCapacity_ = other.spillCapacity_;
+        spill_ = other.arena_->AllocateArray<T>(spillCapacity_);
+        std::copy(other.spill_, other.spill_ + other.size_, spill_);
+        arena_ = other.arena_;
+        spillGeneration_ = other.spillGeneration_;
+        size_ = other.size_;
+    }
+
+    void Grow(FrameArena &arena)
+    {
+        uint32_t capacity = spillCapacity_ ? spillCapacity_ * 2 : static_cast<uint32_t>(N * 2);
+        T *buffer = arena.AllocateArray<T>(capacity);
+        std::copy(Data(), Data() + size_, buffer);
+
+        spill_ = buffer;
+        spillCapacity_ = capacity;
+        arena_ = &arena;
+        spillGeneration_ = arena.GetGeneration();
+    }
+
+    std::array<T, N> inline_{};
+    T *spill_ = nullptr;
+    FrameArena *arena_ = nullptr;
+    uint32_t size_ = 0;
+    uint32_t spillCapacity_ = 0;
+    uint32_t spillGeneration_ = 0;
+};
+
+} // namespace duin
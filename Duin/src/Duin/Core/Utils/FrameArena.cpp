@@ -0,0 +1,65 @@
+#include "dnpch.h"
+#include "FrameArena.h"
+
+namespace duin
+{
+
+FrameArena::FrameArena(size_t blockSize) : blockSize_(blockSize)
+{
+}
+
+FrameArena::~FrameArena()
+{
+}
+
+void *FrameArena::Allocate(size_t size, size_t alignment)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    while (blockIndex_ < blocks_.size())
+    {
+        Block &block = blocks_[blockIndex_];
+        uintptr_t base = reinterpret_cast<uintptr_t>(block.data.get());
+        uintptr_t aligned = (base + offset_ + alignment - 1) & ~(uintptr_t(alignment) - 1);
+        size_t end = static_cast<size_t>(aligned - base) + size;
+        if (end <= block.size)
+        {
+            offset_ = end;
+            return reinterpret_cast<void *>(aligned);
+        }
+
+        // Move on to the next retained block (or allocate a new one below).
+        usedInPreviousBlocks_ += offset_;
+        ++blockIndex_;
+        offset_ = 0;
+    }
+
+    Block block;
+    block.size = size + alignment > blockSize_ ? size + alignment : blockSize_;
+    block.data = std::make_unique<std::byte[]>(block.size);
+    blocks_.push_back(std::move(block));
+    blockIndex_ = blocks_.size() - 1;
+
+    Block &fresh = blocks_.back();
+    uintptr_t base = reinterpret_cast<uintptr_t>(fresh.data.get());
+    uintptr_t aligned = (base + alignment - 1) & ~(uintptr_t(alignment) - 1);
+    offset_ = static_cast<size_t>(aligned - base) + size;
+    return reinterpret_cast<void *>(aligned);
+}
+
+void FrameArena::Reset()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    blockIndex_ = 0;
+    offset_ = 0;
+    usedInPreviousBlocks_ = 0;
+    generation_.fetch_add(1, std::memory_order_acq_rel);
+}
+
+size_t FrameArena::GetBytesUsed() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return usedInPreviousBlocks_ + offset_;
+}
+
+} // namespace duin
@@ -0,0 +1,72 @@
+/**
+ * @file FrameArena.h
+ * @brief Bump allocator for data that only lives until the next Reset().
+ * @ingroup Core_Utils
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace duin
+{
+
+/**
+ * @brief Block-based bump allocator, reset wholesale once per frame.
+ *
+ * Blocks are kept across resets, so a steady-state frame does not touch the
+ * heap. Allocate() is thread-safe (a mutex guards the bump pointer; it is
+ * meant for the rare overflow case, not as a general allocator). Reset() is
+ * not, and bumps the generation so holders can detect stale pointers.
+ */
+class FrameArena
+{
+  public:
+    explicit FrameArena(size_t blockSize = 64 * 1024);
+    ~FrameArena();
+
+    FrameArena(const FrameArena &) = delete;
+    FrameArena &operator=(const FrameArena &) = delete;
+
+    void *Allocate(size_t size, size_t alignment);
+
+    template <typename T>
+    T *AllocateArray(size_t count)
+    {
+        return static_cast<T *>(Allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    /** @brief Invalidates every allocation and starts a new generation. */
+    void Reset();
+
+    /** @brief Incremented by every Reset(). Allocations are valid while it is unchanged. */
+    uint32_t GetGeneration() const
+    {
+        return generation_.load(std::memory_order_acquire);
+    }
+
+    /** @brief Bytes handed out since the last Reset(). */
+    size_t GetBytesUsed() const;
+
+  private:
+    struct Block
+    {
+        std::unique_ptr<std::byte[]> data;
+        size_t size = 0;
+    };
+
+    std::vector<Block> blocks_;
+    size_t blockIndex_ = 0;
+    size_t offset_ = 0;
+    size_t usedInPreviousBlocks_ = 0;
+    size_t blockSize_;
+    std::atomic<uint32_t> generation_{1};
+    mutable std::mutex mutex_;
+};
+
+} // namespace duin
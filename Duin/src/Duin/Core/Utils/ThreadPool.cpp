@@ -0,0 +1,165 @@
+#include "dnpch.h"
+#include "ThreadPool.h"
+
+namespace duin
+{
+
+namespace
+{
+thread_local const ThreadPool *tlsPool = nullptr;
+thread_local size_t tlsIndex = 0;
+} // namespace
+
+ThreadPool &ThreadPool::Get()
+{
+    static ThreadPool pool(std::thread::hardware_concurrency() > 1 ? std::thread::hardware_concurrency() - 1 : 0);
+    return pool;
+}
+
+ThreadPool::ThreadPool(size_t workerCount)
+{
+    queues_.reserve(workerCount + 1);
+    for (size_t i = 0; i <= workerCount; ++i)
+    {
+        queues_.push_back(std::make_unique<WorkQueue>());
+    }
+
+    workers_.reserve(workerCount);
+    for (size_t i = 1; i <= workerCount; ++i)
+    {
+        workers_.emplace_back([this, i]() { WorkerLoop(i); });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+
+    for (std::thread &t : workers_)
+    {
+        t.join();
+    }
+}
+
+size_t ThreadPool::GetWorkerCount() const
+{
+    return workers_.size();
+}
+
+size_t ThreadPool::GetThreadCount() const
+{
+    return workers_.size() + 1;
+}
+
+size_t ThreadPool::GetCurrentThreadIndex() const
+{
+    return tlsPool == this ? tlsIndex : 0;
+}
+
+void ThreadPool::Submit(TaskGroup &group, std::function<void()> task)
+{
+    if (workers_.empty())
+    {
+        task();
+        return;
+    }
+
+    group.pending_.fetch_add(1, std::memory_order_relaxed);
+
+    WorkQueue &queue = *queues_[GetCurrentThreadIndex()];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(Task{std::move(task), &group});
+    }
+    queued_.fetch_add(1, std::memory_order_release);
+
+    // Taking the sleep mutex orders this notify after any worker that is
+    // between checking queued_ and going to sleep.
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+    }
+    wake_.notify_one();
+}
+
+void ThreadPool::Wait(TaskGroup &group)
+{
+    size_t index = GetCurrentThreadIndex();
+    while (!group.IsDone())
+    {
+        if (!TryRunOne(index))
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void ThreadPool::WorkerLoop(size_t index)
+{
+    tlsPool = this;
+    tlsIndex = index;
+
+    while (true)
+    {
+        if (TryRunOne(index))
+        {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        wake_.wait(lock, [this]() { return stop_ || queued_.load(std::memory_order_acquire) > 0; });
+        if (stop_)
+        {
+            return;
+        }
+    }
+}
+
+bool ThreadPool::TryRunOne(size_t index)
+{
+    Task task;
+    if (!PopOwn(index, task) && !Steal(index, task))
+    {
+        return false;
+    }
+    queued_.fetch_sub(1, std::memory_order_relaxed);
+
+    task.fn();
+    task.group->pending_.fetch_sub(1, std::memory_order_acq_rel);
+    return true;
+}
+
+bool ThreadPool::PopOwn(size_t index, Task &out)
+{
+    WorkQueue &queue = *queues_[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty())
+    {
+        return false;
+    }
+    out = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool ThreadPool::Steal(size_t thief, Task &out)
+{
+    size_t count = queues_.size();
+    for (size_t offset = 1; offset < count; ++offset)
+    {
+        WorkQueue &queue = *queues_[(thief + offset) % count];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty())
+        {
+            out = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace duin
@@ -0,0 +1,141 @@
+/**
+ * @file ThreadPool.h
+ * @brief Work-stealing worker pool shared by the engine.
+ * @ingroup Core_Utils
+ *
+ * Each worker owns a task deque. Tasks submitted from a worker go to the back
+ * of its own deque and are popped LIFO; idle workers steal from the front of
+ * other deques. Threads outside the pool (normally the main thread) submit to
+ * a shared deque and help execute tasks while they wait on a TaskGroup.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace duin
+{
+
+/**
+ * @brief Completion counter for a batch of tasks.
+ *
+ * Pass the same group to every Submit() of a batch, then call
+ * ThreadPool::Wait() on it. A group must outlive its pending tasks.
+ */
+class TaskGroup
+{
+  public:
+    bool IsDone() const
+    {
+        return pending_.load(std::memory_order_acquire) == 0;
+    }
+
+  private:
+    friend class ThreadPool;
+    std::atomic<size_t> pending_{0};
+};
+
+class ThreadPool
+{
+  public:
+    /**
+     * @brief Engine-wide pool, started on first use with one worker per
+     * hardware thread minus one (the main thread also executes tasks).
+     */
+    static ThreadPool &Get();
+
+    explicit ThreadPool(size_t workerCount);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    /** @brief Number of background worker threads. */
+    size_t GetWorkerCount() const;
+
+    /** @brief Number of threads that can execute tasks: workers plus the waiting thread. */
+    size_t GetThreadCount() const;
+
+    /**
+     * @brief Index of the calling thread within this pool.
+     *
+     * Workers are 1..GetWorkerCount(); any other thread reports 0. Stable for
+     * the lifetime of the thread, so it can be used to pick per-thread slots.
+     */
+    size_t GetCurrentThreadIndex() const;
+
+    /** @brief Queues a task. The group's pending count is raised before returning. */
+    void Submit(TaskGroup &group, std::function<void()> task);
+
+    /** @brief Blocks until every task of the group has finished, running queued tasks meanwhile. */
+    void Wait(TaskGroup &group);
+
+    /**
+     * @brief Splits [0, count) into chunks of at most grainSize and runs
+     * fn(begin, end) for each chunk across the pool. Returns when all chunks are done.
+     */
+    template <typename Func>
+    void ParallelFor(size_t count, size_t grainSize, Func &&fn)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+        if (grainSize == 0)
+        {
+            grainSize = 1;
+        }
+        if (workers_.empty() || count <= grainSize)
+        {
+            fn(size_t(0), count);
+            return;
+        }
+
+        TaskGroup group;
+        size_t begin = grainSize; // first chunk is kept for the calling thread
+        for (; begin < count; begin += grainSize)
+        {
+            size_t end = begin + grainSize < count ? begin + grainSize : count;
+            Submit(group, [&fn, begin, end]() { fn(begin, end); });
+        }
+        fn(size_t(0), grainSize);
+        Wait(group);
+    }
+
+  private:
+    struct Task
+    {
+        std::function<void()> fn;
+        TaskGroup *group = nullptr;
+    };
+
+    struct WorkQueue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void WorkerLoop(size_t index);
+    bool TryRunOne(size_t index);
+    bool PopOwn(size_t index, Task &out);
+    bool Steal(size_t thief, Task &out);
+
+    // queues_[0] is shared by threads outside the pool, queues_[i] belongs to worker i.
+    std::vector<std::unique_ptr<WorkQueue>> queues_;
+    std::vector<std::thread> workers_;
+
+    std::atomic<size_t> queued_{0};
+    std::mutex sleepMutex_;
+    std::condition_variable wake_;
+    bool stop_ = false;
+};
+
+} // namespace duin
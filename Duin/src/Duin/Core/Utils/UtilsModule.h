@@ -8,3 +8,6 @@
 #include "UUID.h"
 #include "SerialisationManager.h"
 #include "LookupVector.h"
+#include "ThreadPool.h"
+#include "FrameArena.h"
+#include "FixedAccumulator.h"
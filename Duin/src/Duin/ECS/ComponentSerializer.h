@@ -3,11 +3,20 @@
 #include <rfl.hpp>
 #include <rfl/json.hpp>
 #include <rfl/type_name_t.hpp>
+#include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
 #include <unordered_map>
 #include <functional>
+#include <memory>
+#include <new>
 #include <string>
+#include <type_traits>
 #include "./DECS/Entity.h"
 #include "Duin/Core/Debug/DNLog.h"
+#include "Duin/IO/JSONGeneric.h"
+#include "Duin/IO/JSONReflectWriter.h"
+#include "Duin/IO/JSONValue.h"
 
 namespace duin
 {
@@ -24,6 +33,31 @@ class ComponentSerializer
     using DeserializeFn = std::function<void(Entity e, void *component_ptr, const std::string &json)>;
     using DeserializeAddFn = std::function<void(Entity e, const std::string &type)>;
     using DeserializeRemoveFn = std::function<void(Entity e, const std::string &type)>;
+    // RapidJSON variants: written straight into a writer or DOM, read back from a parsed node
+    using WriteFn = std::function<bool(const void *component_ptr, rapidjson::Writer<rapidjson::StringBuffer> &writer,
+                                       std::string *structName)>;
+    using WriteNodeFn = std::function<bool(const void *component_ptr, rapidjson::Document &handler)>;
+    using DeserializeGenericFn = std::function<bool(Entity e, const rfl::Generic &value)>;
+
+    /**
+     * @brief Describes how to decode a component into caller-owned storage.
+     *
+     * Used by bulk instantiation: payloads are decoded on worker threads into
+     * contiguous per-type buffers, which flecs then copies into the table.
+     */
+    struct StagingType
+    {
+        std::string typeName;
+        size_t size = 0;
+        size_t alignment = 0;
+        bool isTag = false;
+        std::function<uint64_t(flecs::world &world)> id;
+        // Constructs a T at dst. Falls back to a default T and returns false when json cannot be read.
+        std::function<bool(void *dst, const std::string &json)> construct;
+        // As construct, from an already parsed RapidJSON node.
+        std::function<bool(void *dst, const rapidjson::Value &json)> constructFromJSON;
+        std::function<void(void *ptr)> destroy;
+    };
 
     bool IsRegistered(const std::string &typeName) const
     {
@@ -54,7 +88,18 @@ class ComponentSerializer
                 unqualifiedName = fullReflectionTypeName.substr(lastColonPos + 1);
             }
 
-            typeAliases_[unqualifiedName] = typeName;
+            // Template reflection types (e.g. FixedAccumulator<T, N>) share an unqualified
+            // name across instantiations; an ambiguous alias would resolve to the wrong type.
+            auto existing = typeAliases_.find(unqualifiedName);
+            if (existing != typeAliases_.end() && existing->second != typeName)
+            {
+                DN_CORE_WARN("Reflection type alias {} is ambiguous ({} and {}); wrap the type in a named component.",
+                             unqualifiedName, existing->second, typeName);
+            }
+            else
+            {
+                typeAliases_[unqualifiedName] = typeName;
+            }
             // DN_CORE_INFO("Registered type alias: {} -> {}", unqualifiedName, typeName);
         }
 
@@ -72,6 +117,12 @@ class ComponentSerializer
             }
         };
 
+        writers_[typeName] = [](const void *ptr, rapidjson::Writer<rapidjson::StringBuffer> &writer,
+                                std::string *structName) { return WriteComponent<T>(ptr, writer, structName); };
+        nodeWriters_[typeName] = [](const void *ptr, rapidjson::Document &handler) {
+            return WriteComponent<T>(ptr, handler, nullptr);
+        };
+
         // PlainDeserialize function - simply adds component type, does not set data
         plainDeserializers_[typeName] = [](Entity e, const std::string &type) { e.Add<T>(); };
 
@@ -80,6 +131,10 @@ class ComponentSerializer
         if (isTag)
         {
             deserializers_[typeName] = [](Entity e, void *ptr, const std::string &json) { e.Add<T>(); };
+            genericDeserializers_[typeName] = [](Entity e, const rfl::Generic &value) {
+                e.Add<T>();
+                return true;
+            };
         }
         else /* Component */
         {
@@ -96,6 +151,15 @@ class ComponentSerializer
                         e.Set<T>(component);
                     }
                 };
+                genericDeserializers_[typeName] = [](Entity e, const rfl::Generic &value) {
+                    auto result = rfl::from_generic<typename T::ReflectionType>(value);
+                    if (!result)
+                    {
+                        return false;
+                    }
+                    e.Set<T>(T(result.value()));
+                    return true;
+                };
             }
             else
             {
@@ -110,11 +174,84 @@ class ComponentSerializer
                         delete typed_ptr;
                     }
                 };
+                genericDeserializers_[typeName] = [](Entity e, const rfl::Generic &value) {
+                    auto result = rfl::from_generic<T>(value);
+                    if (!result)
+                    {
+                        return false;
+                    }
+                    e.Set<T>(result.value());
+                    return true;
+                };
             }
         }
 
         // Removal function
         remove_[typeName] = [](Entity e, const std::string &typeName) { e.Remove<T>(); };
+
+        // Staging description. Types that cannot be default constructed are left to the per-entity path.
+        StagingType staging;
+        staging.typeName = typeName;
+        staging.isTag = isTag;
+        staging.id = [](flecs::world &w) -> uint64_t { return w.id<T>().raw_id(); };
+        if (!isTag)
+        {
+            if constexpr (std::is_default_constructible_v<T>)
+            {
+                staging.size = sizeof(T);
+                staging.alignment = alignof(T);
+                staging.construct = [](void *dst, const std::string &json) -> bool {
+                    if constexpr (requires { typename T::ReflectionType; })
+                    {
+                        auto result = rfl::json::read<typename T::ReflectionType>(json);
+                        if (result)
+                        {
+                            new (dst) T(result.value());
+                            return true;
+                        }
+                    }
+                    else
+                    {
+                        auto result = rfl::json::read<T>(json);
+                        if (result)
+                        {
+                            new (dst) T(std::move(result.value()));
+                            return true;
+                        }
+                    }
+                    new (dst) T();
+                    return false;
+                };
+                staging.constructFromJSON = [](void *dst, const rapidjson::Value &json) -> bool {
+                    rfl::Generic value = JSONToGeneric(json);
+                    if constexpr (requires { typename T::ReflectionType; })
+                    {
+                        auto result = rfl::from_generic<typename T::ReflectionType>(value);
+                        if (result)
+                        {
+                            new (dst) T(result.value());
+                            return true;
+                        }
+                    }
+                    else
+                    {
+                        auto result = rfl::from_generic<T>(value);
+                        if (result)
+                        {
+                            new (dst) T(std::move(result.value()));
+                            return true;
+                        }
+                    }
+                    new (dst) T();
+                    return false;
+                };
+                staging.destroy = [](void *ptr) { std::destroy_at(static_cast<T *>(ptr)); };
+            }
+        }
+        if (isTag || staging.construct)
+        {
+            staging_[typeName] = std::move(staging);
+        }
     }
 
     std::string Serialize(const std::string &typeName, const void *componentPtr) const
@@ -144,6 +281,70 @@ class ComponentSerializer
         }
     }
 
+    /**
+     * @brief Writes the component (the default value when componentPtr is null) into a RapidJSON writer.
+     * @param structName If set, receives the struct name written as the "type" member.
+     * @return False if the type is unknown or the writer rejected the value.
+     */
+    bool Serialize(const std::string &typeName, const void *componentPtr,
+                   rapidjson::Writer<rapidjson::StringBuffer> &writer, std::string *structName = nullptr) const
+    {
+        auto it = writers_.find(typeName);
+        if (it == writers_.end())
+        {
+            return false;
+        }
+        return it->second(componentPtr, writer, structName);
+    }
+
+    /** @brief Writes the component into a JSONValue node, allocating from the node's document. */
+    bool Serialize(const std::string &typeName, const void *componentPtr, JSONValue &node) const
+    {
+        auto it = nodeWriters_.find(typeName);
+        if (it == nodeWriters_.end())
+        {
+            return false;
+        }
+        // The document only lends its SAX handler; the values are allocated from the node's document.
+        rapidjson::Document built(&node.GetAllocator());
+        bool written = false;
+        auto generate = [&](rapidjson::Document &handler) {
+            written = it->second(componentPtr, handler);
+            return written;
+        };
+        built.Populate(generate);
+        if (!written)
+        {
+            DN_CORE_WARN("ComponentSerializer::Serialize - Failed to write component: {}", typeName);
+            return false;
+        }
+        node.GetRJSONValue() = built.Move();
+        return true;
+    }
+
+    /** @brief Sets the component on the entity from an already parsed RapidJSON node. */
+    bool Deserialize(Entity e, const std::string &typeName, const rapidjson::Value &json)
+    {
+        auto it = genericDeserializers_.find(ResolveTypeName(typeName));
+        if (it == genericDeserializers_.end())
+        {
+            return false;
+        }
+        if (!it->second(e, JSONToGeneric(json)))
+        {
+            DN_CORE_WARN("ComponentSerializer::Deserialize - Failed to read component: {}", typeName);
+            return false;
+        }
+        return true;
+    }
+
+    /** @brief Staging description of a component or tag, or nullptr if it must be set per entity. */
+    const StagingType *GetStagingType(const std::string &typeName) const
+    {
+        auto it = staging_.find(ResolveTypeName(typeName));
+        return it != staging_.end() ? &it->second : nullptr;
+    }
+
     void SetComponentByString(Entity e, const std::string &typeName)
     {
         std::string resolvedTypeName = typeName;
@@ -201,10 +402,31 @@ class ComponentSerializer
     }
 
   private:
+    template <typename T, typename Handler>
+    static bool WriteComponent(const void *ptr, Handler &handler, std::string *structName)
+    {
+        if (ptr == nullptr) /* Tag */
+        {
+            const T tag;
+            return WriteReflectedJSON<rfl::AddStructName<"type">>(tag, handler, structName);
+        }
+        return WriteReflectedJSON<rfl::AddStructName<"type">>(*static_cast<const T *>(ptr), handler, structName);
+    }
+
+    const std::string &ResolveTypeName(const std::string &typeName) const
+    {
+        auto aliasIt = typeAliases_.find(typeName);
+        return aliasIt != typeAliases_.end() ? aliasIt->second : typeName;
+    }
+
     std::unordered_map<std::string, SerializeFn> serializers_;
     std::unordered_map<std::string, DeserializeFn> deserializers_;
     std::unordered_map<std::string, DeserializeAddFn> plainDeserializers_;
     std::unordered_map<std::string, DeserializeRemoveFn> remove_;
+    std::unordered_map<std::string, WriteFn> writers_;
+    std::unordered_map<std::string, WriteNodeFn> nodeWriters_;
+    std::unordered_map<std::string, DeserializeGenericFn> genericDeserializers_;
+    std::unordered_map<std::string, StagingType> staging_;
     std::unordered_map<std::string, std::string> typeAliases_; // Maps reflection type name to component name
 };
 
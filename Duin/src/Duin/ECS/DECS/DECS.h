@@ -6,3 +6,4 @@
 #include "Entity.h"
 #include "Component.h"
 #include "Query.h"
+#include "System.h"
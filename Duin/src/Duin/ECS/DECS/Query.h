@@ -1,8 +1,15 @@
 #pragma once
 
 #include <flecs.h>
+#include <array>
 #include <memory>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
 #include "Duin/Core/Debug/DNLog.h"
+#include "Duin/Core/Utils/ThreadPool.h"
 
 namespace duin
 {
@@ -81,6 +88,38 @@ class Iter
         return iter_->entities[row];
     }
 
+    /**
+     * @brief Entity ids of the current table, one per row.
+     * @return Span of Count() entity ids.
+     */
+    std::span<const uint64_t> Entities() const
+    {
+        return std::span<const uint64_t>(iter_->entities, iter_->count);
+    }
+
+    /**
+     * @brief Contiguous component data of a field for the current table.
+     * @tparam T Component type; use const T for readonly terms.
+     * @param index The field index.
+     * @return Count() elements for fields matched on self, a single element for
+     *         fields matched on another entity (e.g. a parent), or an empty span
+     *         when an optional field is not set or the field is a tag.
+     */
+    template <typename T>
+    std::span<T> Field(int8_t index) const
+    {
+        if (!ecs_field_is_set(iter_, index))
+        {
+            return {};
+        }
+        T *data = static_cast<T *>(ecs_field_w_size(iter_, sizeof(T), index));
+        if (!data)
+        {
+            return {};
+        }
+        return std::span<T>(data, ecs_field_is_self(iter_, index) ? static_cast<size_t>(iter_->count) : 1);
+    }
+
     /**
      * @brief Check if field is matched on self.
      * @param index The field index.
@@ -316,6 +355,12 @@ class QueryBuilder
         return *this;
     }
 
+    QueryBuilder<Components...> &Self()
+    {
+        flecsQueryBuilder.self();
+        return *this;
+    }
+
     QueryBuilder<Components...> &Parent()
     {
         flecsQueryBuilder.parent();
@@ -433,19 +478,92 @@ class Query
     }
 
     /**
-     * @brief Iterate the query using a duin iterator and callback.
-     * Automatically wraps flecs::iter into duin::Iter for the callback.
+     * @brief Each() on a stage, for use from systems running in parallel.
+     * Entities passed to the callback are bound to the stage, so structural
+     * changes made through them are deferred until the stage is merged.
+     * Defined in Query_impl.hpp.
+     */
+    template <typename Func>
+    void Each(World &stage, Func &&func) const;
+
+    /**
+     * @brief Span type handed to table-level callbacks for a query term.
+     * Optional terms (T*) map to std::span<T>, which is empty when unset.
+     */
+    template <typename C>
+    using FieldSpan = std::span<std::remove_pointer_t<C>>;
+
+    /**
+     * @brief Iterate the query once per matched table.
      * @tparam Func The callback function type.
-     * @param func The callback to invoke for each iteration.
+     * @param func The callback to invoke for each table.
      *
-     * The callback receives (duin::Iter&, Components*...)
+     * The callback receives (duin::Iter&, FieldSpan<Components>...), one span
+     * per query term in template order. See Iter::Field() for span sizes.
      */
     template <typename Func>
     void Iter(Func &&func) const
     {
-        assert(false);
+        if (!IsValid())
+            return;
+        rawQuery.run([&func](flecs::iter &flecsIter) { IterTables(flecsIter, func); });
     }
 
+    /**
+     * @brief Iter() on a stage, for use from systems running in parallel.
+     * Defined in Query_impl.hpp.
+     */
+    template <typename Func>
+    void Iter(World &stage, Func &&func) const;
+
+    /**
+     * @brief Table-level iteration split across a ThreadPool.
+     * @param grainSize Rows per task. Large tables are split, small ones batched.
+     * @param func Receives (std::span<const uint64_t> entities, FieldSpan<Components>...)
+     *             for a sub-range of one table. Called concurrently.
+     *
+     * Matched tables are collected on the calling thread, then the row ranges
+     * are processed in parallel. The callback may write the components it is
+     * handed but must not add, remove or delete anything; use a stage or
+     * Defer for structural changes afterwards.
+     */
+    template <typename Func>
+    void IterParallel(size_t grainSize, Func &&func, ThreadPool &pool = ThreadPool::Get()) const
+    {
+        if (!IsValid())
+            return;
+        std::vector<ParallelChunk> chunks;
+        rawQuery.run([&chunks](flecs::iter &flecsIter) { CollectChunks(flecsIter, chunks); });
+        DispatchChunks(chunks, grainSize, pool, func);
+    }
+
+    /**
+     * @brief IterParallel() on a stage. Defined in Query_impl.hpp.
+     */
+    template <typename Func>
+    void IterParallel(World &stage, size_t grainSize, Func &&func, ThreadPool &pool = ThreadPool::Get()) const;
+
+    /**
+     * @brief Per-entity iteration split across a ThreadPool.
+     * @param grainSize Rows per task.
+     * @param func Receives (Components&...) for one row; optional terms are
+     *             passed as pointers (nullptr when unset). Called concurrently.
+     *
+     * Same rules as IterParallel(). No duin::Entity is built per row; use
+     * IterParallel() when entity ids are needed.
+     */
+    template <typename Func>
+    void EachParallel(size_t grainSize, Func &&func, ThreadPool &pool = ThreadPool::Get()) const
+    {
+        IterParallel(grainSize, RowInvoker<Func>{func}, pool);
+    }
+
+    /**
+     * @brief EachParallel() on a stage. Defined in Query_impl.hpp.
+     */
+    template <typename Func>
+    void EachParallel(World &stage, size_t grainSize, Func &&func, ThreadPool &pool = ThreadPool::Get()) const;
+
     /**
      * @brief Run the query with a single callback invoked once per matching table.
      * Automatically wraps flecs::iter into duin::Iter for the callback.
@@ -470,6 +588,13 @@ class Query
         });
     }
 
+    /**
+     * @brief Run() on a stage, for use from systems running in parallel.
+     * Defined in Query_impl.hpp.
+     */
+    template <typename Func>
+    void Run(World &stage, Func &&func) const;
+
     /**
      * @brief Get count of entities matching the query.
      * @return Number of matching entities.
@@ -506,6 +631,153 @@ class Query
   private:
     friend class World;
     friend class Entity;
+
+    static constexpr size_t FieldCount = sizeof...(Components);
+
+    // Table snapshot taken on the calling thread before parallel dispatch.
+    struct ParallelChunk
+    {
+        const uint64_t *entities = nullptr;
+        size_t count = 0;
+        std::array<void *, FieldCount> fields{};
+        std::array<bool, FieldCount> self{};
+    };
+
+    template <typename Func>
+    static void IterTables(flecs::iter &flecsIter, Func &func)
+    {
+        duin::Iter it(flecsIter);
+        while (it.Next())
+        {
+            InvokeTable(it, func, std::index_sequence_for<Components...>{});
+        }
+    }
+
+    template <typename Func, size_t... I>
+    static void InvokeTable(duin::Iter &it, Func &func, std::index_sequence<I...>)
+    {
+        func(it, it.template Field<std::remove_pointer_t<Components>>(static_cast<int8_t>(I))...);
+    }
+
+    static void CollectChunks(flecs::iter &flecsIter, std::vector<ParallelChunk> &chunks)
+    {
+        duin::Iter it(flecsIter);
+        while (it.Next())
+        {
+            ParallelChunk chunk;
+            chunk.entities = it.Entities().data();
+            chunk.count = it.Count();
+            CollectFields(it, chunk, std::index_sequence_for<Components...>{});
+            chunks.push_back(chunk);
+        }
+    }
+
+    template <size_t... I>
+    static void CollectFields(duin::Iter &it, ParallelChunk &chunk, std::index_sequence<I...>)
+    {
+        ((chunk.fields[I] = const_cast<void *>(static_cast<const void *>(
+              it.template Field<std::remove_pointer_t<Components>>(static_cast<int8_t>(I)).data())),
+          chunk.self[I] = it.IsSelf(static_cast<int8_t>(I))),
+         ...);
+    }
+
+    template <size_t I>
+    static auto ChunkField(const ParallelChunk &chunk, size_t offset, size_t count)
+    {
+        using Element = std::remove_pointer_t<std::tuple_element_t<I, std::tuple<Components...>>>;
+        Element *data = static_cast<Element *>(chunk.fields[I]);
+        if (!data)
+        {
+            return std::span<Element>();
+        }
+        return chunk.self[I] ? std::span<Element>(data + offset, count) : std::span<Element>(data, 1);
+    }
+
+    template <typename Func, size_t... I>
+    static void InvokeRange(const ParallelChunk &chunk, size_t offset, size_t count, Func &func,
+                            std::index_sequence<I...>)
+    {
+        func(std::span<const uint64_t>(chunk.entities + offset, count), ChunkField<I>(chunk, offset, count)...);
+    }
+
+    template <typename Func>
+    static void DispatchChunks(const std::vector<ParallelChunk> &chunks, size_t grainSize, ThreadPool &pool,
+                               Func &func)
+    {
+        struct Range
+        {
+            size_t chunk, offset, count;
+        };
+        if (grainSize == 0)
+        {
+            grainSize = 1;
+        }
+
+        // Split big tables into grain-sized ranges, then batch consecutive small
+        // ranges so every task holds roughly grainSize rows.
+        std::vector<Range> ranges;
+        std::vector<size_t> taskStarts;
+        size_t pendingRows = 0;
+        for (size_t c = 0; c < chunks.size(); ++c)
+        {
+            for (size_t offset = 0; offset < chunks[c].count; offset += grainSize)
+            {
+                size_t count = chunks[c].count - offset < grainSize ? chunks[c].count - offset : grainSize;
+                if (pendingRows == 0)
+                {
+                    taskStarts.push_back(ranges.size());
+                }
+                ranges.push_back(Range{c, offset, count});
+                pendingRows += count;
+                if (pendingRows >= grainSize)
+                {
+                    pendingRows = 0;
+                }
+            }
+        }
+        taskStarts.push_back(ranges.size());
+
+        pool.ParallelFor(taskStarts.size() - 1, 1, [&](size_t begin, size_t end) {
+            for (size_t t = begin; t < end; ++t)
+            {
+                for (size_t r = taskStarts[t]; r < taskStarts[t + 1]; ++r)
+                {
+                    const Range &range = ranges[r];
+                    InvokeRange(chunks[range.chunk], range.offset, range.count, func,
+                                std::index_sequence_for<Components...>{});
+                }
+            }
+        });
+    }
+
+    template <typename C, typename Span>
+    static decltype(auto) RowArg(const Span &span, size_t row, size_t count)
+    {
+        if constexpr (std::is_pointer_v<C>)
+        {
+            return span.empty() ? static_cast<C>(nullptr) : &span[span.size() == count ? row : 0];
+        }
+        else
+        {
+            return static_cast<C &>(span[span.size() == count ? row : 0]);
+        }
+    }
+
+    template <typename Func>
+    struct RowInvoker
+    {
+        Func &func;
+
+        void operator()(std::span<const uint64_t> entities, FieldSpan<Components>... fields) const
+        {
+            size_t count = entities.size();
+            for (size_t row = 0; row < count; ++row)
+            {
+                func(RowArg<Components>(fields, row, count)...);
+            }
+        }
+    };
+
     flecs::query<Components...> rawQuery;
     World *world_ = nullptr;
 };
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "Query.h"
+#include "Entity.h"
+#include "World.h"
+
+namespace duin
+{
+
+// ========== Template Method Implementations that require World definition ==========
+
+template <typename... Components>
+template <typename Func>
+void Query<Components...>::Each(World &stage, Func &&func) const
+{
+    if (!IsValid())
+        return;
+    rawQuery.iter(stage.GetFlecsWorld())
+        .each([&func, &stage](flecs::entity flecsEntity,
+                              std::conditional_t<std::is_pointer_v<Components>, Components, Components &>...comps) {
+            Entity duinEntity;
+            duinEntity.flecsEntity = flecsEntity;
+            duinEntity.world = &stage;
+            func(duinEntity, comps...);
+        });
+}
+
+template <typename... Components>
+template <typename Func>
+void Query<Components...>::Run(World &stage, Func &&func) const
+{
+    if (!IsValid())
+        return;
+    rawQuery.iter(stage.GetFlecsWorld()).run([&func](flecs::iter &flecsIter) {
+        duin::Iter duinIter(flecsIter);
+        func(duinIter);
+    });
+}
+
+template <typename... Components>
+template <typename Func>
+void Query<Components...>::Iter(World &stage, Func &&func) const
+{
+    if (!IsValid())
+        return;
+    rawQuery.iter(stage.GetFlecsWorld()).run([&func](flecs::iter &flecsIter) { IterTables(flecsIter, func); });
+}
+
+template <typename... Components>
+template <typename Func>
+void Query<Components...>::IterParallel(World &stage, size_t grainSize, Func &&func, ThreadPool &pool) const
+{
+    if (!IsValid())
+        return;
+    std::vector<ParallelChunk> chunks;
+    rawQuery.iter(stage.GetFlecsWorld()).run([&chunks](flecs::iter &flecsIter) { CollectChunks(flecsIter, chunks); });
+    DispatchChunks(chunks, grainSize, pool, func);
+}
+
+template <typename... Components>
+template <typename Func>
+void Query<Components...>::EachParallel(World &stage, size_t grainSize, Func &&func, ThreadPool &pool) const
+{
+    IterParallel(stage, grainSize, RowInvoker<Func>{func}, pool);
+}
+
+} // namespace duin
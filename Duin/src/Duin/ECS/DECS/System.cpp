@@ -0,0 +1,322 @@
+#include "dnpch.h"
+#include "System.h"
+#include "World.h"
+#include "Duin/Core/Debug/DNLog.h"
+#include "Duin/Core/Utils/ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+
+namespace duin
+{
+
+namespace
+{
+// Keeps the world readonly for one phase, and ends it even if a system throws.
+class ReadonlyScope
+{
+  public:
+    ReadonlyScope(flecs::world &world, bool multiThreaded) : world_(world)
+    {
+        world_.readonly_begin(multiThreaded);
+    }
+    ~ReadonlyScope()
+    {
+        world_.readonly_end();
+    }
+    ReadonlyScope(const ReadonlyScope &) = delete;
+    ReadonlyScope &operator=(const ReadonlyScope &) = delete;
+
+  private:
+    flecs::world &world_;
+};
+} // namespace
+
+size_t SystemBuilder::Run(SystemCallback callback)
+{
+    desc_.callback = std::move(callback);
+    return world_.RegisterSystem(std::move(desc_));
+}
+
+SystemScheduler::SystemScheduler(World &world) : world_(world)
+{
+}
+
+SystemScheduler::~SystemScheduler()
+{
+}
+
+size_t SystemScheduler::Register(SystemDesc desc)
+{
+    PhaseGraph &graph = phases_[static_cast<size_t>(desc.phase)];
+    graph.dirty = true;
+
+    systems_.push_back(std::move(desc));
+    return systems_.size() - 1;
+}
+
+void SystemScheduler::Clear()
+{
+    systems_.clear();
+    for (PhaseGraph &graph : phases_)
+    {
+        graph = PhaseGraph{};
+    }
+    // Stages point into the flecs world; drop them before the world is reset.
+    stages_.clear();
+}
+
+size_t SystemScheduler::GetSystemCount(SystemPhase phase) const
+{
+    size_t count = 0;
+    for (const SystemDesc &desc : systems_)
+    {
+        if (desc.phase == phase)
+        {
+            ++count;
+        }
+    }
+    return count;
+}
+
+static bool Intersects(const std::vector<uint64_t> &a, const std::vector<uint64_t> &b)
+{
+    for (uint64_t id : a)
+    {
+        if (std::find(b.begin(), b.end(), id) != b.end())
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool SystemScheduler::Conflicts(const SystemDesc &a, const SystemDesc &b)
+{
+    bool aUndeclared = a.reads.empty() && a.writes.empty();
+    bool bUndeclared = b.reads.empty() && b.writes.empty();
+    if (aUndeclared || bUndeclared)
+    {
+        return true;
+    }
+
+    return Intersects(a.writes, b.writes) || Intersects(a.writes, b.reads) || Intersects(b.writes, a.reads);
+}
+
+void SystemScheduler::BuildGraph(PhaseGraph &graph)
+{
+    SystemPhase phase = static_cast<SystemPhase>(&graph - phases_.data());
+
+    graph.systems.clear();
+    for (size_t i = 0; i < systems_.size(); ++i)
+    {
+        if (systems_[i].phase == phase)
+        {
+            graph.systems.push_back(i);
+        }
+    }
+
+    size_t n = graph.systems.size();
+    graph.dependents.assign(n, {});
+    graph.dependencyCount.assign(n, 0);
+
+    auto addEdge = [&graph](size_t from, size_t to) {
+        std::vector<size_t> &out = graph.dependents[from];
+        if (std::find(out.begin(), out.end(), to) == out.end())
+        {
+            out.push_back(to);
+            graph.dependencyCount[to]++;
+        }
+    };
+
+    for (size_t j = 0; j < n; ++j)
+    {
+        const SystemDesc &later = systems_[graph.systems[j]];
+        for (size_t i = 0; i < j; ++i)
+        {
+            if (Conflicts(systems_[graph.systems[i]], later))
+            {
+                addEdge(i, j);
+            }
+        }
+        for (const std::string &name : later.after)
+        {
+            bool found = false;
+            for (size_t i = 0; i < n; ++i)
+            {
+                if (i != j && systems_[graph.systems[i]].name == name)
+                {
+                    addEdge(i, j);
+                    found = true;
+                }
+            }
+            if (!found)
+            {
+                DN_CORE_WARN("System '{}' runs after unknown system '{}'.", later.name, name);
+            }
+        }
+    }
+
+    // Kahn's algorithm; ties resolve in registration order.
+    graph.order.clear();
+    std::vector<uint32_t> remaining = graph.dependencyCount;
+    std::vector<size_t> ready;
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (remaining[i] == 0)
+        {
+            ready.push_back(i);
+        }
+    }
+    while (!ready.empty())
+    {
+        auto it = std::min_element(ready.begin(), ready.end());
+        size_t node = *it;
+        ready.erase(it);
+        graph.order.push_back(node);
+        for (size_t dep : graph.dependents[node])
+        {
+            if (--remaining[dep] == 0)
+            {
+                ready.push_back(dep);
+            }
+        }
+    }
+
+    if (graph.order.size() != n)
+    {
+        // An After() cycle. Fall back to registration order with a straight chain.
+        DN_CORE_WARN("System dependency cycle detected; running phase {} serially.", static_cast<int>(phase));
+        graph.dependents.assign(n, {});
+        graph.dependencyCount.assign(n, 0);
+        graph.order.clear();
+        for (size_t i = 0; i < n; ++i)
+        {
+            graph.order.push_back(i);
+            if (i + 1 < n)
+            {
+                graph.dependents[i].push_back(i + 1);
+                graph.dependencyCount[i + 1] = 1;
+            }
+        }
+    }
+
+    graph.dirty = false;
+}
+
+void SystemScheduler::EnsureStages(size_t count)
+{
+    if (stages_.size() == count)
+    {
+        return;
+    }
+
+    stages_.clear();
+    flecs::world &flecsWorld = world_.GetFlecsWorld();
+    flecsWorld.set_stage_count(static_cast<int32_t>(count));
+    for (size_t i = 0; i < count; ++i)
+    {
+        stages_.push_back(std::make_unique<World>(flecsWorld.get_stage(static_cast<int32_t>(i))));
+    }
+}
+
+void SystemScheduler::RunNode(const PhaseGraph &graph, size_t node, double delta, ThreadPool &pool)
+{
+    size_t threadIndex = pool.GetCurrentThreadIndex();
+    SystemContext ctx(world_, *stages_[threadIndex], delta, threadIndex);
+    systems_[graph.systems[node]].callback(ctx);
+}
+
+void SystemScheduler::Run(SystemPhase phase, double delta, ThreadPool &pool)
+{
+    PhaseGraph &graph = phases_[static_cast<size_t>(phase)];
+    if (graph.dirty)
+    {
+        BuildGraph(graph);
+    }
+    size_t n = graph.systems.size();
+    if (n == 0)
+    {
+        return;
+    }
+
+    flecs::world &flecsWorld = world_.GetFlecsWorld();
+    if (flecsWorld.is_deferred() || flecsWorld.is_readonly())
+    {
+        DN_CORE_WARN("RunSystems called while the world is deferred or readonly; skipping phase {}.",
+                     static_cast<int>(phase));
+        return;
+    }
+
+    EnsureStages(pool.GetThreadCount());
+
+    bool parallel = pool.GetWorkerCount() > 0 && n > 1;
+    ReadonlyScope readonly(flecsWorld, parallel);
+
+    // A throwing system must not unwind past tasks that still reference this frame:
+    // the rest of the phase runs as usual and the first exception is rethrown at the end.
+    std::exception_ptr failure;
+    std::mutex failureMutex;
+    auto runGuarded = [&](size_t node) {
+        try
+        {
+            RunNode(graph, node, delta, pool);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(failureMutex);
+            if (!failure)
+            {
+                failure = std::current_exception();
+            }
+        }
+    };
+
+    if (!parallel)
+    {
+        for (size_t node : graph.order)
+        {
+            runGuarded(node);
+        }
+    }
+    else
+    {
+        std::unique_ptr<std::atomic<uint32_t>[]> remaining(new std::atomic<uint32_t>[n]);
+        for (size_t i = 0; i < n; ++i)
+        {
+            remaining[i].store(graph.dependencyCount[i], std::memory_order_relaxed);
+        }
+
+        TaskGroup group;
+        std::function<void(size_t)> launch = [&](size_t node) {
+            pool.Submit(group, [&, node]() {
+                runGuarded(node);
+                for (size_t dep : graph.dependents[node])
+                {
+                    if (remaining[dep].fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    {
+                        launch(dep);
+                    }
+                }
+            });
+        };
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            if (graph.dependencyCount[i] == 0)
+            {
+                launch(i);
+            }
+        }
+        pool.Wait(group);
+    }
+
+    if (failure)
+    {
+        std::rethrow_exception(failure);
+    }
+}
+
+} // namespace duin
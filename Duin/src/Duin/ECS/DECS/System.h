@@ -0,0 +1,214 @@
+/**
+ * @file System.h
+ * @brief Registered ECS systems and the parallel phase scheduler.
+ * @ingroup ECS
+ *
+ * A system declares which components it reads and writes. For every phase the
+ * scheduler builds a dependency graph in which two systems are ordered (by
+ * registration order, or an explicit After()) only if one writes a component
+ * the other reads or writes. Independent systems run concurrently on the
+ * engine ThreadPool.
+ *
+ * While a phase runs the world is in readonly mode. Each system receives a
+ * per-thread stage through SystemContext: iterate queries on it and make
+ * structural changes through it. Those changes are merged when the phase ends.
+ *
+ * @code
+ * auto q = world.QueryBuilder<Velocity3D, const Mass>().Cached().Build();
+ * world.System("Drag")
+ *     .Phase(SystemPhase::PostPhysicsUpdate)
+ *     .Read<Mass>()
+ *     .Write<Velocity3D>()
+ *     .Run([q](SystemContext &ctx) {
+ *         q.Each(ctx.Stage(), [](duin::Entity e, Velocity3D &v, const Mass &m) { ... });
+ *     });
+ * @endcode
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <flecs.h>
+
+namespace duin
+{
+class World;
+class ThreadPool;
+
+/** @brief Engine hook a system runs in; mirrors the GameWorld post-phase callbacks. */
+enum class SystemPhase
+{
+    PostUpdate = 0,
+    PostPhysicsUpdate,
+    PostDraw,
+    PostDrawUI,
+    Count
+};
+
+/** @brief Per-invocation state handed to a system callback. */
+class SystemContext
+{
+  public:
+    SystemContext(World &world, World &stage, double delta, size_t threadIndex)
+        : world_(world), stage_(stage), delta_(delta), threadIndex_(threadIndex)
+    {
+    }
+
+    /** @brief The world that owns the system. Readonly while the phase runs; its FrameArena is shared. */
+    World &GetWorld() const
+    {
+        return world_;
+    }
+
+    /** @brief Stage of the executing thread. Use for query iteration and deferred commands. */
+    World &Stage() const
+    {
+        return stage_;
+    }
+
+    double GetDelta() const
+    {
+        return delta_;
+    }
+
+    /** @brief Index of the executing thread; 0 is the thread that called RunSystems(). */
+    size_t GetThreadIndex() const
+    {
+        return threadIndex_;
+    }
+
+  private:
+    World &world_;
+    World &stage_;
+    double delta_;
+    size_t threadIndex_;
+};
+
+using SystemCallback = std::function<void(SystemContext &)>;
+
+struct SystemDesc
+{
+    std::string name;
+    SystemPhase phase = SystemPhase::PostUpdate;
+    std::vector<uint64_t> reads;
+    std::vector<uint64_t> writes;
+    std::vector<std::string> after;
+    SystemCallback callback;
+};
+
+/**
+ * @brief Fluent builder returned by World::System(). Run() registers the system.
+ */
+class SystemBuilder
+{
+  public:
+    SystemBuilder(World &world, flecs::world &flecsWorld, const std::string &name)
+        : world_(world), flecsWorld_(flecsWorld)
+    {
+        desc_.name = name;
+    }
+
+    SystemBuilder &Phase(SystemPhase phase)
+    {
+        desc_.phase = phase;
+        return *this;
+    }
+
+    /** @brief Declares components the system only reads. */
+    template <typename... Comps>
+    SystemBuilder &Read()
+    {
+        (desc_.reads.push_back(flecsWorld_.id<Comps>().raw_id()), ...);
+        return *this;
+    }
+
+    /** @brief Declares components the system writes, adds or removes. */
+    template <typename... Comps>
+    SystemBuilder &Write()
+    {
+        (desc_.writes.push_back(flecsWorld_.id<Comps>().raw_id()), ...);
+        return *this;
+    }
+
+    SystemBuilder &Read(uint64_t id)
+    {
+        desc_.reads.push_back(id);
+        return *this;
+    }
+
+    SystemBuilder &Write(uint64_t id)
+    {
+        desc_.writes.push_back(id);
+        return *this;
+    }
+
+    /** @brief Forces this system to run after the named system of the same phase. */
+    SystemBuilder &After(const std::string &name)
+    {
+        desc_.after.push_back(name);
+        return *this;
+    }
+
+    /** @brief Registers the system and returns its index. */
+    size_t Run(SystemCallback callback);
+
+  private:
+    World &world_;
+    flecs::world &flecsWorld_;
+    SystemDesc desc_;
+};
+
+/**
+ * @brief Owns the registered systems of one World and runs them per phase.
+ */
+class SystemScheduler
+{
+  public:
+    SystemScheduler(World &world);
+    ~SystemScheduler();
+
+    size_t Register(SystemDesc desc);
+    void Clear();
+
+    /**
+     * @brief Runs every system of the phase and blocks until all have finished.
+     *
+     * A system that declares no reads and no writes is treated as touching
+     * everything and never overlaps another system of its phase.
+     * If a system throws, the rest of the phase still runs and the first
+     * exception is rethrown once every system has finished.
+     */
+    void Run(SystemPhase phase, double delta, ThreadPool &pool);
+
+    size_t GetSystemCount(SystemPhase phase) const;
+
+    /** @brief True when the two systems may not run at the same time. */
+    static bool Conflicts(const SystemDesc &a, const SystemDesc &b);
+
+  private:
+    struct PhaseGraph
+    {
+        std::vector<size_t> systems;               // indices into systems_
+        std::vector<std::vector<size_t>> dependents; // per local node
+        std::vector<uint32_t> dependencyCount;       // per local node
+        std::vector<size_t> order;                   // topological order of local nodes
+        bool dirty = true;
+    };
+
+    void BuildGraph(PhaseGraph &graph);
+    void EnsureStages(size_t count);
+    void RunNode(const PhaseGraph &graph, size_t node, double delta, ThreadPool &pool);
+
+    World &world_;
+    std::vector<SystemDesc> systems_;
+    std::array<PhaseGraph, static_cast<size_t>(SystemPhase::Count)> phases_;
+    std::vector<std::unique_ptr<World>> stages_;
+};
+
+} // namespace duin
@@ -2,6 +2,8 @@
 #include "DECS.h"
 #include "Entity.h"
 #include "Query.h"
+#include "System.h"
+#include "Duin/Core/Utils/ThreadPool.h"
 
 duin::World::World()
 {
@@ -117,6 +119,42 @@ duin::Entity duin::World::MakeAlive(uint64_t id)
     return e;
 }
 
+duin::SystemBuilder duin::World::System(const std::string &name)
+{
+    return duin::SystemBuilder(*this, flecsWorld, name);
+}
+
+size_t duin::World::RegisterSystem(duin::SystemDesc desc)
+{
+    if (!scheduler_)
+    {
+        scheduler_ = std::make_unique<duin::SystemScheduler>(*this);
+    }
+    return scheduler_->Register(std::move(desc));
+}
+
+void duin::World::RunSystems(duin::SystemPhase phase, double delta)
+{
+    if (!scheduler_)
+    {
+        return;
+    }
+    scheduler_->Run(phase, delta, duin::ThreadPool::Get());
+}
+
+void duin::World::ClearSystems()
+{
+    if (scheduler_)
+    {
+        scheduler_->Clear();
+    }
+}
+
+duin::FrameArena &duin::World::GetFrameArena()
+{
+    return frameArena_;
+}
+
 std::string duin::World::ExportRegisteredComponentMeta()
 {
     return std::string();
@@ -3,7 +3,10 @@
 #include <flecs.h>
 #include "../ComponentSerializer.h"
 #include "Query.h"
+#include "System.h"
+#include "Duin/Core/Utils/FrameArena.h"
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 #include <flecs/addons/cpp/entity.hpp>
@@ -236,6 +239,37 @@ class World
         return duin::Entity::ID(this, f_id);
     }
 
+    /**
+     * @brief Start registering a system. Finish with SystemBuilder::Run().
+     * @param name Name used by After() and in diagnostics.
+     */
+    SystemBuilder System(const std::string &name);
+
+    /**
+     * @brief Register a fully described system.
+     * @return Index of the system.
+     */
+    size_t RegisterSystem(SystemDesc desc);
+
+    /**
+     * @brief Run all systems of a phase on the engine ThreadPool, blocking until done.
+     * @param phase The phase to run.
+     * @param delta Time step passed to each system.
+     */
+    void RunSystems(SystemPhase phase, double delta);
+
+    /**
+     * @brief Unregister every system. Must be called before the flecs world is reset.
+     */
+    void ClearSystems();
+
+    /**
+     * @brief Per-world scratch memory for data that only lives for one tick,
+     * such as spilled FixedAccumulator contents. Reset by the owner (GameWorld
+     * resets it after the post-physics phase).
+     */
+    FrameArena &GetFrameArena();
+
     std::string ExportRegisteredComponentMeta();
 
     /**
@@ -248,14 +282,17 @@ class World
 
   private:
     friend class Entity;
+    FrameArena frameArena_;
     flecs::world flecsWorld;
+    // Created on first registration; declared after flecsWorld so its stages are released first.
+    std::unique_ptr<SystemScheduler> scheduler_;
 
-    // Prevent copying
+    // Prevent copying and moving; the scheduler keeps a reference to its world.
     World(const World &) = delete;
     World &operator=(const World &) = delete;
-
-    // Allow moving
-    World(World &&) = default;
-    World &operator=(World &&) = default;
+    World(World &&) = delete;
+    World &operator=(World &&) = delete;
 };
 } // namespace duin
+
+#include "Query_impl.hpp"
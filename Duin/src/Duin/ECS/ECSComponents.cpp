@@ -18,6 +18,8 @@ void RegisterComponents(duin::World &world)
     world.Component<ECSComponent::Velocity2D>();
 
     world.Component<ECSComponent::Transform3D>();
+    world.Component<ECSComponent::GlobalTransform>();
+    world.Component<ECSComponent::RenderTransform>();
     world.Component<ECSComponent::Position3D>();
     world.Component<ECSComponent::Rotation3D>();
     world.Component<ECSComponent::Scale3D>();
@@ -26,6 +28,9 @@ void RegisterComponents(duin::World &world)
     world.Component<ECSComponent::CubeComponent>();
 
     world.Component<ECSComponent::PhysicsStaticCubeComponent>();
+    world.Component<ECSComponent::PhysicsBody>();
+    world.Component<ECSComponent::ContactBegin>();
+    world.Component<ECSComponent::ContactEnd>();
 
     world.Component<ECSComponent::DebugCapsuleComponent>();
     world.Component<ECSComponent::DebugCubeComponent>();
@@ -41,6 +46,8 @@ void RegisterComponents(duin::World &world)
     inspector.RegisterComponent<ECSComponent::Scale2D>("Scale2D");
     inspector.RegisterComponent<ECSComponent::Velocity2D>("Velocity2D");
     inspector.RegisterComponent<ECSComponent::Transform3D>("Transform3D");
+    inspector.RegisterComponent<ECSComponent::GlobalTransform>("GlobalTransform");
+    inspector.RegisterComponent<ECSComponent::RenderTransform>("RenderTransform");
     inspector.RegisterComponent<ECSComponent::Position3D>("Position3D");
     inspector.RegisterComponent<ECSComponent::Rotation3D>("Rotation3D");
     inspector.RegisterComponent<ECSComponent::Scale3D>("Scale3D");
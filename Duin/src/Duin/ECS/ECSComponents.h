@@ -272,7 +272,8 @@ struct Scale3D
  * efficient cache invalidation.
  *
  * Local values are relative to parent. Use GetGlobal/SetGlobal methods
- * for world-space operations.
+ * for world-space operations. GameWorld::PropagateTransforms() refreshes
+ * every global cache once per frame, parents before children.
  */
 struct Transform3D
 {
@@ -360,6 +361,16 @@ struct Transform3D
     bool globalPositionCacheDirtyFlag = true;
     bool globalScaleCacheDirtyFlag = true;
     bool globalRotationCacheDirtyFlag = true;
+    // Stamp handed out by the owning GameWorld each time the global cache is rebuilt,
+    // and the parent's stamp the cache was built from. A child whose parentStamp no
+    // longer matches its parent's globalStamp is stale, even if its own flags are clean.
+    uint64_t globalStamp = 0;
+    uint64_t parentStamp = 0;
+
+    bool IsGlobalCacheDirty() const
+    {
+        return globalPositionCacheDirtyFlag || globalScaleCacheDirtyFlag || globalRotationCacheDirtyFlag;
+    }
 
     void UpdateGlobalPositionCache(Vector3 newGlobalPosition)
     {
@@ -381,6 +392,93 @@ struct Transform3D
 
 };
 
+/**
+ * @struct GlobalTransform
+ * @brief World-space affine matrix derived from Transform3D.
+ *
+ * Written by GameWorld::PropagateTransforms() for every entity that has both
+ * a Transform3D and a GlobalTransform. Kept in its own column so renderers and
+ * physics can stream matrices without touching the TRS data or its caches.
+ * Read-only for gameplay code; edit Transform3D instead.
+ */
+struct GlobalTransform
+{
+    Matrix value = MatrixIdentity();
+
+    GlobalTransform() = default;
+
+    GlobalTransform(const Matrix &value) : value(value)
+    {
+    }
+
+    struct GlobalTransformImpl
+    {
+        Matrix m;
+    };
+    using ReflectionType = GlobalTransformImpl;
+    GlobalTransform(const ReflectionType &impl) : value(impl.m)
+    {
+    }
+    ReflectionType reflection() const
+    {
+        return GlobalTransformImpl{value};
+    }
+
+  private:
+    friend class duin::GameWorld;
+
+    // Transform3D::globalStamp the matrix was built from; 0 forces a rebuild.
+    uint64_t sourceStamp = 0;
+};
+
+/**
+ * @struct RenderTransform
+ * @brief World-space matrix for drawing, interpolated between physics ticks.
+ *
+ * Physics ticks at a fixed rate, so the stepped Transform3D can lag the render
+ * clock by up to one tick. GameWorld records the global pose of every entity
+ * with a Transform3D and a RenderTransform after each tick, and before Draw()
+ * blends the last two poses by GetPhysicsInterpolationAlpha(). Renderers
+ * should prefer it over GlobalTransform when present. Read-only for gameplay
+ * code; call GameWorld::ResetInterpolation() after teleporting an entity.
+ */
+struct RenderTransform
+{
+    Matrix value = MatrixIdentity();
+
+    RenderTransform() = default;
+
+    struct RenderTransformImpl
+    {
+        Matrix m;
+    };
+    using ReflectionType = RenderTransformImpl;
+    RenderTransform(const ReflectionType &impl) : value(impl.m)
+    {
+    }
+    ReflectionType reflection() const
+    {
+        return RenderTransformImpl{value};
+    }
+
+  private:
+    friend class duin::GameWorld;
+
+    // Global poses at the last two ticks.
+    Vector3 previousPosition = Vector3Zero();
+    Quaternion previousRotation = QuaternionIdentity();
+    Vector3 previousScale = Vector3One();
+    Vector3 currentPosition = Vector3Zero();
+    Quaternion currentRotation = QuaternionIdentity();
+    Vector3 currentScale = Vector3One();
+    // Transform3D::globalStamp of the current pose; 0 until the first tick records one.
+    uint64_t snapshotStamp = 0;
+    // The two poses differ, so value changes with alpha.
+    bool blending = false;
+    // value does not reflect the poses yet.
+    bool dirty = true;
+};
+
 /** @} */
 
 /**
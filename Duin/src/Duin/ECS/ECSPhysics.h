@@ -17,7 +17,7 @@ namespace ECSComponent
 
 /**
  * @name Physics Body Components
- * Wrappers for PhysX body types.
+ * Bodies simulated by the PhysicsServer.
  * @{
  */
 
@@ -27,6 +27,63 @@ struct PhysicsStaticCubeComponent
 {
     std::shared_ptr<PhysicsStaticCubeComponent> cube;
 };
+
+/**
+ * @brief Rigid body in the PhysicsServer, kept in sync with the entity's Transform3D.
+ *
+ * Added by GameWorld::AddPhysicsBody() together with the matching PxStatic,
+ * PxKinematic or PxDynamic tag; the body is destroyed when the component is removed.
+ * Before each step the world pushes kinematic bodies whose transform changed.
+ * After it, only bodies Jolt reports as active are read back, so sleeping
+ * bodies cost nothing. A dynamic body owns its transform: the simulated pose
+ * overwrites Transform3D (and Velocity3D, if present) every step it is awake.
+ */
+struct PhysicsBody
+{
+    JPH::BodyID bodyID;
+    PhysicsMotionType motionType = PhysicsMotionType::Dynamic;
+
+  private:
+    friend class duin::GameWorld;
+
+    // Transform3D::globalStamp last sent to a kinematic body.
+    uint64_t pushedStamp = 0;
+    // A kinematic body keeps the velocity of its last move; one more push with an
+    // unchanged target brings it to rest.
+    bool kinematicMoving = false;
+};
+
+/** @brief The other side of a contact, seen from the entity holding it. */
+struct PhysicsContact
+{
+    /** @brief Entity id of the other body, or 0 if it is not a body of this world. */
+    uint64_t other = 0;
+    JPH::BodyID otherBody;
+    /** @brief World-space point of first contact; zero in ContactEnd. */
+    Vector3 position = Vector3Zero();
+    /** @brief Points from this entity towards the other body; zero in ContactEnd. */
+    Vector3 normal = Vector3Zero();
+    /** @brief One of the bodies is a sensor (a trigger overlap rather than a collision). */
+    bool isSensor = false;
+};
+
+/**
+ * @brief Bodies that started touching this entity's body during the last physics tick.
+ *
+ * Added by GameWorld::DispatchContactEvents() after each step and removed again at
+ * the next one, so a system matching it runs once per new contact. Each body pair
+ * begins once however many of its shapes touch, and not again while it persists.
+ */
+struct ContactBegin
+{
+    std::vector<PhysicsContact> contacts;
+};
+
+/** @brief Bodies that stopped touching this entity's body during the last physics tick. See ContactBegin. */
+struct ContactEnd
+{
+    std::vector<PhysicsContact> contacts;
+};
 /** @} */
 
 /**
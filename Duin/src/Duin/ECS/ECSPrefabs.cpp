@@ -39,7 +39,10 @@ void RegisterPrefabs(duin::World &world)
         .SetPair<ECSComponent::Rotation2D, ECSTag::Global>(ECSComponent::Rotation2D{0.0f})
         .SetPair<ECSComponent::Scale2D, ECSTag::Global>(ECSComponent::Scale2D{0.0f, 0.0f});
 
-    Node3D = world.Prefab("Node3D").IsA(Node).Set<ECSComponent::Transform3D>(ECSComponent::Transform3D{});
+    Node3D = world.Prefab("Node3D")
+                 .IsA(Node)
+                 .Set<ECSComponent::Transform3D>(ECSComponent::Transform3D{})
+                 .Set<ECSComponent::GlobalTransform>(ECSComponent::GlobalTransform{});
 
     PhysicsStaticBody = world.Prefab("PhysicsStaticBody")
                             .IsA(Node3D)
@@ -7,6 +7,8 @@
 #include "Duin/Render/Renderer.h"
 #include "PrefabRegistry.h"
 #include "Duin/Core/Debug/DNLog.h"
+#include "Duin/Core/Maths/MathsBatch.h"
+#include <algorithm>
 #include <functional>
 
 namespace duin
@@ -47,6 +49,9 @@ void GameWorld::Initialize(bool connectSignals)
         connPostUpdate_ = QueuePostUpdateCallback([this](double delta) { PostUpdateQueryExecution(delta); });
         connPostPhysicsUpdate_ =
             QueuePostPhysicsUpdateCallback([this](double delta) { PostPhysicsUpdateQueryExecution(delta); });
+        connPostPhysicsStep_ =
+            QueuePostPhysicsStepCallback([this](double delta) { PostPhysicsStepQueryExecution(delta); });
+        connPreDraw_ = QueuePreDrawCallback([this]() { PreDrawQueryExecution(); });
         connPostDraw_ = QueuePostDrawCallback([this]() { PostDrawQueryExecution(); });
         connPostDrawUI_ = QueuePostDrawUICallback([this]() { PostDrawUIQueryExecution(); });
     }
@@ -70,30 +75,55 @@ void GameWorld::ActivateCameraEntity(duin::Entity entity)
 
 void GameWorld::PostUpdateQueryExecution(double delta)
 {
+    RunSystems(SystemPhase::PostUpdate, delta);
+    PropagateTransforms();
 }
 
 void GameWorld::PostPhysicsUpdateQueryExecution(double delta)
 {
+    RunSystems(SystemPhase::PostPhysicsUpdate, delta);
+    PropagateTransforms();
+    PushPhysicsBodies();
 
     Progress(); // TODO testing for remote viewing
+
+    // Per-tick accumulators have been consumed by now; recycle their spill memory.
+    GetFrameArena().Reset();
 }
 
-void GameWorld::PostDrawQueryExecution()
+void GameWorld::PostPhysicsStepQueryExecution(double delta)
+{
+    PullPhysicsBodies();
+    DispatchContactEvents();
+    PropagateTransforms();
+    SnapshotRenderTransforms();
+}
+
+void GameWorld::PreDrawQueryExecution()
 {
+    InterpolateRenderTransforms(GetPhysicsInterpolationAlpha());
+}
 
+void GameWorld::PostDrawQueryExecution()
+{
+    RunSystems(SystemPhase::PostDraw, 0.0);
 }
 
 void GameWorld::PostDrawUIQueryExecution()
 {
+    RunSystems(SystemPhase::PostDrawUI, 0.0);
 }
 
 void GameWorld::Clear()
 {
-    // Clear the query cache before resetting the world — queries hold pointers
+    // Clear the query cache and systems before resetting the world — both hold pointers
     // into the old ecs_world_t* and must not outlive it.
     ClearQueryCache();
+    ClearSystems();
 
+    // The OnRemove observer destroys the bodies while the world is torn down.
     this->GetFlecsWorld().reset();
+    physicsBodyObserver_ = false;
 }
 
 void GameWorld::Reset(bool connectSignals)
@@ -135,19 +165,17 @@ void GameWorld::SetGlobalTransform(duin::Entity e, ECSComponent::Transform3D tx)
         return;
     }
 
-    duin::Entity parent = e.Parent();
-    if (parent.IsValid() && parent.Has<ECSComponent::Transform3D>())
+    const ECSComponent::Transform3D *parentTx = ResolveGlobalTransform(e.Parent());
+    if (parentTx)
     {
-        ECSComponent::Transform3D parentGlobal = GetGlobalTransform(parent);
-
-        Vector3 offset = Vector3Subtract(tx.GetPosition(), parentGlobal.GetPosition());
-        Quaternion invParentRot = QuaternionInvert(parentGlobal.GetRotation());
+        Vector3 offset = Vector3Subtract(tx.GetPosition(), parentTx->globalPositionCache);
+        Quaternion invParentRot = QuaternionInvert(parentTx->globalRotationCache);
         Vector3 localPosUnscaled = Vector3RotateByQuaternion(offset, invParentRot);
-        Vector3 localPos = Vector3Divide(localPosUnscaled, parentGlobal.GetScale());
+        Vector3 localPos = Vector3Divide(localPosUnscaled, parentTx->globalScaleCache);
 
-        Vector3 localScale = Vector3Divide(tx.GetScale(), parentGlobal.GetScale());
+        Vector3 localScale = Vector3Divide(tx.GetScale(), parentTx->globalScaleCache);
 
-        Quaternion localRot = QuaternionMultiply(QuaternionInvert(parentGlobal.GetRotation()), tx.GetRotation());
+        Quaternion localRot = QuaternionMultiply(invParentRot, tx.GetRotation());
 
         comp->SetPosition(localPos);
         comp->SetScale(localScale);
@@ -162,6 +190,9 @@ void GameWorld::SetGlobalTransform(duin::Entity e, ECSComponent::Transform3D tx)
     comp->UpdateGlobalPositionCache(tx.GetPosition());
     comp->UpdateGlobalScaleCache(tx.GetScale());
     comp->UpdateGlobalRotationCache(tx.GetRotation());
+    // The cache was written directly, so hand out a fresh stamp to make descendants rebuild.
+    comp->parentStamp = parentTx ? parentTx->globalStamp : 0;
+    comp->globalStamp = ++transformStamp_;
 }
 
 ECSComponent::Transform3D GameWorld::GetGlobalTransform(duin::Entity e)
@@ -170,39 +201,13 @@ ECSComponent::Transform3D GameWorld::GetGlobalTransform(duin::Entity e)
     {
         return ECSComponent::Transform3D();
     }
-    ECSComponent::Transform3D *tx = e.TryGetMut<ECSComponent::Transform3D>();
+    ECSComponent::Transform3D *tx = ResolveGlobalTransform(e);
     if (!tx)
     {
         return ECSComponent::Transform3D();
     }
 
-    duin::Entity parent = e.Parent();
-    if (parent.IsValid() && parent.Has<ECSComponent::Transform3D>())
-    {
-        ECSComponent::Transform3D parentGlobal = GetGlobalTransform(parent);
-
-        Vector3 scaledLocalPos = Vector3Multiply(tx->GetPosition(), parentGlobal.GetScale());
-        Vector3 rotatedPos = Vector3RotateByQuaternion(scaledLocalPos, parentGlobal.GetRotation());
-        Vector3 globalPos = Vector3Add(parentGlobal.GetPosition(), rotatedPos);
-
-        Vector3 globalScale = Vector3Multiply(parentGlobal.GetScale(), tx->GetScale());
-
-        Quaternion globalRot = QuaternionMultiply(parentGlobal.GetRotation(), tx->GetRotation());
-
-        tx->UpdateGlobalPositionCache(globalPos);
-        tx->UpdateGlobalScaleCache(globalScale);
-        tx->UpdateGlobalRotationCache(globalRot);
-
-        return ECSComponent::Transform3D(globalPos, globalScale, globalRot);
-    }
-    else
-    {
-        tx->UpdateGlobalPositionCache(tx->GetPosition());
-        tx->UpdateGlobalScaleCache(tx->GetScale());
-        tx->UpdateGlobalRotationCache(tx->GetRotation());
-
-        return *tx;
-    }
+    return ECSComponent::Transform3D(tx->globalPositionCache, tx->globalScaleCache, tx->globalRotationCache);
 }
 
 void GameWorld::SetGlobalPosition(duin::Entity e, Vector3 position)
@@ -216,16 +221,13 @@ void GameWorld::SetGlobalPosition(duin::Entity e, Vector3 position)
     if (!tx)
         return;
 
-    duin::Entity parent = e.Parent();
-    if (parent.IsValid() && parent.Has<ECSComponent::Transform3D>())
+    const ECSComponent::Transform3D *parentTx = ResolveGlobalTransform(e.Parent());
+    if (parentTx)
     {
-        Vector3 parentGlobalPos = GetGlobalPosition(parent);
-        Quaternion parentGlobalRot = GetGlobalRotation(parent);
-        Vector3 parentGlobalScale = GetGlobalScale(parent);
-        Vector3 offset = Vector3Subtract(position, parentGlobalPos);
-        Quaternion invParentRot = QuaternionInvert(parentGlobalRot);
+        Vector3 offset = Vector3Subtract(position, parentTx->globalPositionCache);
+        Quaternion invParentRot = QuaternionInvert(parentTx->globalRotationCache);
         Vector3 localPosUnscaled = Vector3RotateByQuaternion(offset, invParentRot);
-        Vector3 localPos = Vector3Divide(localPosUnscaled, parentGlobalScale);
+        Vector3 localPos = Vector3Divide(localPosUnscaled, parentTx->globalScaleCache);
         tx->SetPosition(localPos);
     }
     else
@@ -242,31 +244,12 @@ Vector3 GameWorld::GetGlobalPosition(duin::Entity e)
         //DN_CORE_WARN("Entity not valid, or does not have Transform3D!");
         return Vector3Zero();
     }
-    ECSComponent::Transform3D *tx = e.TryGetMut<ECSComponent::Transform3D>();
+    ECSComponent::Transform3D *tx = ResolveGlobalTransform(e);
     if (!tx)
     {
         return Vector3Zero();
     }
 
-    if (tx->globalPositionCacheDirtyFlag)
-    {
-        duin::Entity parent = e.Parent();
-        if (!parent.IsValid() || !parent.Has<ECSComponent::Transform3D>())
-        {
-            tx->UpdateGlobalPositionCache(tx->GetPosition());
-        }
-        else
-        {
-            Vector3 parentGlobalPos = GetGlobalPosition(parent);
-            Quaternion parentGlobalRot = GetGlobalRotation(parent);
-            Vector3 parentGlobalScale = GetGlobalScale(parent);
-            Vector3 scaledLocalPos = Vector3Multiply(tx->GetPosition(), parentGlobalScale);
-            Vector3 rotatedPos = Vector3RotateByQuaternion(scaledLocalPos, parentGlobalRot);
-            Vector3 globalPos = Vector3Add(parentGlobalPos, rotatedPos);
-            tx->UpdateGlobalPositionCache(globalPos);
-        }
-    }
-
     return tx->globalPositionCache;
 }
 
@@ -282,11 +265,10 @@ void GameWorld::SetGlobalScale(duin::Entity e, Vector3 scale)
         return;
     }
 
-    duin::Entity parent = e.Parent();
-    if (parent.IsValid() && parent.Has<ECSComponent::Transform3D>())
+    const ECSComponent::Transform3D *parentTx = ResolveGlobalTransform(e.Parent());
+    if (parentTx)
     {
-        Vector3 parentGlobalScale = GetGlobalScale(parent);
-        tx->SetScale(Vector3Divide(scale, parentGlobalScale));
+        tx->SetScale(Vector3Divide(scale, parentTx->globalScaleCache));
     }
     else
     {
@@ -301,27 +283,12 @@ Vector3 GameWorld::GetGlobalScale(duin::Entity e)
     {
         return Vector3One();
     }
-    ECSComponent::Transform3D *tx = e.TryGetMut<ECSComponent::Transform3D>();
+    ECSComponent::Transform3D *tx = ResolveGlobalTransform(e);
     if (!tx)
     {
         return Vector3One();
     }
 
-    if (tx->globalScaleCacheDirtyFlag)
-    {
-        duin::Entity parent = e.Parent();
-        if (!parent.IsValid() || !parent.Has<ECSComponent::Transform3D>())
-        {
-            tx->UpdateGlobalScaleCache(tx->GetScale());
-        }
-        else
-        {
-            Vector3 parentGlobalScale = GetGlobalScale(parent);
-            Vector3 globalScale = Vector3Multiply(parentGlobalScale, tx->GetScale());
-            tx->UpdateGlobalScaleCache(globalScale);
-        }
-    }
-
     return tx->globalScaleCache;
 }
 
@@ -338,11 +305,10 @@ void GameWorld::SetGlobalRotation(duin::Entity e, Quaternion rotation)
         return;
     }
 
-    duin::Entity parent = e.Parent();
-    if (parent.IsValid() && parent.Has<ECSComponent::Transform3D>())
+    const ECSComponent::Transform3D *parentTx = ResolveGlobalTransform(e.Parent());
+    if (parentTx)
     {
-        Quaternion parentGlobalRot = GetGlobalRotation(parent);
-        Quaternion invParentRot = QuaternionInvert(parentGlobalRot);
+        Quaternion invParentRot = QuaternionInvert(parentTx->globalRotationCache);
         Quaternion localRotation = QuaternionMultiply(invParentRot, rotation);
         tx->SetRotation(localRotation);
     }
@@ -360,27 +326,632 @@ Quaternion GameWorld::GetGlobalRotation(duin::Entity e)
         DN_CORE_WARN("Entity not valid, or does not have Transform3D!");
         return QuaternionIdentity();
     }
-    ECSComponent::Transform3D *tx = e.TryGetMut<ECSComponent::Transform3D>();
+    ECSComponent::Transform3D *tx = ResolveGlobalTransform(e);
     if (!tx)
     {
         return QuaternionIdentity();
     }
 
-    if (tx->globalRotationCacheDirtyFlag)
+    return tx->globalRotationCache;
+}
+
+/*----------------------------------------------------------------------
+ * Transform propagation
+----------------------------------------------------------------------*/
+void GameWorld::PropagateTransforms()
+{
+    using ECSComponent::Transform3D;
+
+    Query<Transform3D, const Transform3D *> &q =
+        GetOrBuildQuery<Transform3D, const Transform3D *>("PropagateTransforms", [](GameWorld &w) {
+            return w.QueryBuilder<Transform3D, const Transform3D *>()
+                .TermAt(0)
+                .Self()
+                .TermAt(1)
+                .Parent()
+                .Cascade()
+                .Cached()
+                .Build();
+        });
+
+    q.Run([this](duin::Iter &it) {
+        while (it.Next())
+        {
+            flecs::iter fit = it.GetFlecsIter();
+            flecs::field<Transform3D> tx = fit.field<Transform3D>(0);
+
+            // Cascade matches the nearest ancestor with a Transform3D, but a transform chain is
+            // broken by any parent without one. ChildOf is part of the table type, so every row
+            // shares the same parent and a single check covers the whole table.
+            const Transform3D *parentTx = nullptr;
+            if (fit.is_set(1) && fit.entity(0).parent() == fit.src(1))
+            {
+                parentTx = &fit.field<const Transform3D>(1)[0];
+            }
+            uint64_t parentStamp = parentTx ? parentTx->globalStamp : 0;
+
+            for (size_t i = 0; i < it.Count(); ++i)
+            {
+                if (tx[i].IsGlobalCacheDirty() || tx[i].parentStamp != parentStamp)
+                {
+                    ComposeGlobalTransform(tx[i], parentTx);
+                }
+            }
+        }
+    });
+
+    PropagateGlobalMatrices();
+}
+
+void GameWorld::PropagateGlobalMatrices()
+{
+    using ECSComponent::GlobalTransform;
+    using ECSComponent::Transform3D;
+
+    Query<const Transform3D, GlobalTransform, const GlobalTransform *> &q =
+        GetOrBuildQuery<const Transform3D, GlobalTransform, const GlobalTransform *>(
+            "PropagateGlobalMatrices", [](GameWorld &w) {
+                return w.QueryBuilder<const Transform3D, GlobalTransform, const GlobalTransform *>()
+                    .TermAt(0)
+                    .Self()
+                    .TermAt(1)
+                    .Self()
+                    .TermAt(2)
+                    .Parent()
+                    .Cascade()
+                    .Cached()
+                    .Build();
+            });
+
+    // Stale rows are gathered into fixed-size blocks so the batch kernels always see
+    // contiguous input, whatever the mix of clean and dirty rows in a table.
+    constexpr size_t BLOCK = 64;
+    Vector3 positions[BLOCK];
+    Quaternion rotations[BLOCK];
+    Vector3 scales[BLOCK];
+    Matrix matrices[BLOCK];
+    size_t rows[BLOCK];
+
+    q.Run([&](duin::Iter &it) {
+        while (it.Next())
+        {
+            flecs::iter fit = it.GetFlecsIter();
+            flecs::field<const Transform3D> tx = fit.field<const Transform3D>(0);
+            flecs::field<GlobalTransform> gt = fit.field<GlobalTransform>(1);
+
+            // Same chain rule as the TRS pass. With a matrix parent the local TRS is composed
+            // and multiplied by the shared parent matrix (exact under non-uniform parent scale);
+            // otherwise the entity is a chain root and its global TRS cache is used directly.
+            const Matrix *parent = nullptr;
+            if (fit.is_set(2) && fit.entity(0).parent() == fit.src(2))
+            {
+                parent = &fit.field<const GlobalTransform>(2)[0].value;
+            }
+
+            size_t count = it.Count();
+            size_t i = 0;
+            while (i < count)
+            {
+                size_t n = 0;
+                for (; i < count && n < BLOCK; ++i)
+                {
+                    if (gt[i].sourceStamp == tx[i].globalStamp)
+                    {
+                        continue;
+                    }
+                    const Transform3D &t = tx[i];
+                    positions[n] = parent ? t.position_ : t.globalPositionCache;
+                    rotations[n] = parent ? t.rotation_ : t.globalRotationCache;
+                    scales[n] = parent ? t.scale_ : t.globalScaleCache;
+                    rows[n] = i;
+                    ++n;
+                }
+                if (n == 0)
+                {
+                    continue;
+                }
+
+                MatrixComposeTRSBatch(positions, rotations, scales, matrices, n);
+                if (parent)
+                {
+                    MatrixMultiplyBatch(*parent, matrices, matrices, n);
+                }
+                for (size_t j = 0; j < n; ++j)
+                {
+                    gt[rows[j]].value = matrices[j];
+                    gt[rows[j]].sourceStamp = tx[rows[j]].globalStamp;
+                }
+            }
+        }
+    });
+}
+
+ECSComponent::Transform3D *GameWorld::ResolveGlobalTransform(duin::Entity e)
+{
+    if (!e.IsValid())
+    {
+        return nullptr;
+    }
+    ECSComponent::Transform3D *tx = e.TryGetMut<ECSComponent::Transform3D>();
+    if (!tx)
+    {
+        return nullptr;
+    }
+
+    // One recursive call per ancestor; each level only recomposes when it is stale.
+    const ECSComponent::Transform3D *parentTx = ResolveGlobalTransform(e.Parent());
+    uint64_t parentStamp = parentTx ? parentTx->globalStamp : 0;
+    if (tx->IsGlobalCacheDirty() || tx->parentStamp != parentStamp)
+    {
+        ComposeGlobalTransform(*tx, parentTx);
+    }
+
+    return tx;
+}
+
+void GameWorld::ComposeGlobalTransform(ECSComponent::Transform3D &tx, const ECSComponent::Transform3D *parentTx)
+{
+    if (parentTx)
+    {
+        Vector3 scaledLocalPos = Vector3Multiply(tx.position_, parentTx->globalScaleCache);
+        Vector3 rotatedPos = Vector3RotateByQuaternion(scaledLocalPos, parentTx->globalRotationCache);
+
+        tx.UpdateGlobalPositionCache(Vector3Add(parentTx->globalPositionCache, rotatedPos));
+        tx.UpdateGlobalScaleCache(Vector3Multiply(parentTx->globalScaleCache, tx.scale_));
+        tx.UpdateGlobalRotationCache(QuaternionMultiply(parentTx->globalRotationCache, tx.rotation_));
+        tx.parentStamp = parentTx->globalStamp;
+    }
+    else
+    {
+        tx.UpdateGlobalPositionCache(tx.position_);
+        tx.UpdateGlobalScaleCache(tx.scale_);
+        tx.UpdateGlobalRotationCache(tx.rotation_);
+        tx.parentStamp = 0;
+    }
+    tx.globalStamp = ++transformStamp_;
+}
+
+/*----------------------------------------------------------------------
+ * Physics body sync
+----------------------------------------------------------------------*/
+bool GameWorld::AddPhysicsBody(duin::Entity e, const CollisionShapeDesc &shape, PhysicsMotionType motionType,
+                               JPH::ObjectLayer layer)
+{
+    if (!e.IsValid() || !e.Has<ECSComponent::Transform3D>())
+    {
+        DN_CORE_WARN("Entity not valid, or does not have Transform3D!");
+        return false;
+    }
+    if (e.Has<ECSComponent::PhysicsBody>())
+    {
+        DN_CORE_WARN("Entity {} already has a PhysicsBody!", e.GetID());
+        return false;
+    }
+
+    if (!physicsBodyObserver_)
+    {
+        GetFlecsWorld()
+            .observer<ECSComponent::PhysicsBody>()
+            .event(flecs::OnRemove)
+            .each([](ECSComponent::PhysicsBody &body) {
+                PhysicsServer::Get().DestroyBody(body.bodyID);
+                body.bodyID = JPH::BodyID();
+            });
+        physicsBodyObserver_ = true;
+    }
+
+    JPH::BodyID bodyID = PhysicsServer::Get().CreateBody(shape, motionType, GetGlobalPosition(e),
+                                                         GetGlobalRotation(e), e.GetID(), layer);
+    if (bodyID.IsInvalid())
+    {
+        return false;
+    }
+
+    ECSComponent::PhysicsBody body;
+    body.bodyID = bodyID;
+    body.motionType = motionType;
+    body.pushedStamp = ResolveGlobalTransform(e)->globalStamp;
+    e.Set<ECSComponent::PhysicsBody>(body);
+    e.AddIf<ECSTag::PxStatic>(motionType == PhysicsMotionType::Static);
+    e.AddIf<ECSTag::PxKinematic>(motionType == PhysicsMotionType::Kinematic);
+    e.AddIf<ECSTag::PxDynamic>(motionType == PhysicsMotionType::Dynamic);
+    if (motionType != PhysicsMotionType::Static && !e.Has<ECSComponent::RenderTransform>())
     {
-        duin::Entity parent = e.Parent();
-        if (!parent.IsValid() || !parent.Has<ECSComponent::Transform3D>())
+        e.Set<ECSComponent::RenderTransform>(ECSComponent::RenderTransform());
+    }
+    return true;
+}
+
+void GameWorld::RemovePhysicsBody(duin::Entity e)
+{
+    if (!e.IsValid() || !e.Has<ECSComponent::PhysicsBody>())
+    {
+        return;
+    }
+    e.Remove<ECSComponent::PhysicsBody>();
+    e.Remove<ECSTag::PxStatic>();
+    e.Remove<ECSTag::PxKinematic>();
+    e.Remove<ECSTag::PxDynamic>();
+}
+
+void GameWorld::PushPhysicsBodies()
+{
+    using ECSComponent::PhysicsBody;
+    using ECSComponent::Transform3D;
+
+    Query<const Transform3D, PhysicsBody> &q =
+        GetOrBuildQuery<const Transform3D, PhysicsBody>("PushPhysicsBodies", [](GameWorld &w) {
+            return w.QueryBuilder<const Transform3D, PhysicsBody>().With<ECSTag::PxKinematic>().Cached().Build();
+        });
+
+    // Only stamps are compared here; kinematic bodies at rest are skipped without touching Jolt.
+    kinematicTargets_.clear();
+    q.Run([this](duin::Iter &it) {
+        while (it.Next())
+        {
+            flecs::iter fit = it.GetFlecsIter();
+            flecs::field<const Transform3D> tx = fit.field<const Transform3D>(0);
+            flecs::field<PhysicsBody> body = fit.field<PhysicsBody>(1);
+
+            for (size_t i = 0; i < it.Count(); ++i)
+            {
+                bool changed = body[i].pushedStamp != tx[i].globalStamp;
+                if (!changed && !body[i].kinematicMoving)
+                {
+                    continue;
+                }
+                kinematicTargets_.push_back({body[i].bodyID, tx[i].globalPositionCache, tx[i].globalRotationCache});
+                body[i].pushedStamp = tx[i].globalStamp;
+                body[i].kinematicMoving = changed;
+            }
+        }
+    });
+
+    PhysicsServer::Get().MoveKinematicBodies(kinematicTargets_.data(), kinematicTargets_.size());
+}
+
+void GameWorld::PullPhysicsBodies()
+{
+    using ECSComponent::PhysicsBody;
+    using ECSComponent::Transform3D;
+    using ECSComponent::Velocity3D;
+
+    PhysicsServer::Get().ReadActiveBodies(bodyStates_);
+    if (bodyStates_.empty())
+    {
+        return;
+    }
+
+    // Bodies of other worlds share the PhysicsServer; keep the ones whose entity is alive
+    // here and still points back at the same body.
+    ecs_world_t *world = GetFlecsWorld().c_ptr();
+    physicsRows_.clear();
+    for (size_t i = 0; i < bodyStates_.size(); ++i)
+    {
+        ecs_entity_t id = bodyStates_[i].userData;
+        if (id == 0 || !ecs_is_alive(world, id))
+        {
+            continue;
+        }
+        const PhysicsBody *body = flecs::entity(world, id).try_get<PhysicsBody>();
+        const ecs_record_t *record = ecs_record_find(world, id);
+        if (!body || body->bodyID != bodyStates_[i].bodyID || !record || !record->table)
         {
-            tx->UpdateGlobalRotationCache(tx->GetRotation());
+            continue;
+        }
+        physicsRows_.push_back({record->table, ECS_RECORD_TO_ROW(record->row), static_cast<uint32_t>(i)});
+    }
+
+    // Write in storage order: each table's columns are fetched once and swept front to back.
+    std::sort(physicsRows_.begin(), physicsRows_.end(), [](const PhysicsRow &a, const PhysicsRow &b) {
+        return a.table != b.table ? a.table < b.table : a.row < b.row;
+    });
+
+    const ecs_id_t transformId = GetFlecsWorld().id<Transform3D>().raw_id();
+    const ecs_id_t velocityId = GetFlecsWorld().id<Velocity3D>().raw_id();
+    const ecs_table_t *table = nullptr;
+    Transform3D *transforms = nullptr;
+    Velocity3D *velocities = nullptr;
+    ecs_entity_t parent = 0;
+    const Transform3D *parentTx = nullptr;
+    for (const PhysicsRow &row : physicsRows_)
+    {
+        if (row.table != table)
+        {
+            table = row.table;
+            int32_t transformColumn = ecs_table_get_column_index(world, table, transformId);
+            int32_t velocityColumn = ecs_table_get_column_index(world, table, velocityId);
+            transforms = transformColumn >= 0
+                             ? static_cast<Transform3D *>(ecs_table_get_column(table, transformColumn, 0))
+                             : nullptr;
+            velocities = velocityColumn >= 0
+                             ? static_cast<Velocity3D *>(ecs_table_get_column(table, velocityColumn, 0))
+                             : nullptr;
+        }
+        if (!transforms)
+        {
+            continue;
+        }
+
+        const PhysicsBodyState &state = bodyStates_[row.state];
+        Transform3D *tx = &transforms[row.row];
+
+        // Bodies are simulated in world space; only children of a transformed parent need converting.
+        // Siblings are adjacent after the sort, so their parent is resolved once.
+        ecs_entity_t bodyParent = ecs_get_target(world, state.userData, EcsChildOf, 0);
+        if (bodyParent != parent)
+        {
+            parent = bodyParent;
+            parentTx = ResolveGlobalTransform(duin::Entity(parent, this));
+        }
+        if (parentTx)
+        {
+            Vector3 offset = Vector3Subtract(state.position, parentTx->globalPositionCache);
+            Quaternion invParentRot = QuaternionInvert(parentTx->globalRotationCache);
+            tx->SetPosition(Vector3Divide(Vector3RotateByQuaternion(offset, invParentRot), parentTx->globalScaleCache));
+            tx->SetRotation(QuaternionMultiply(invParentRot, state.rotation));
         }
         else
         {
-            Quaternion parentGlobalRot = GetGlobalRotation(parent);
-            Quaternion globalRot = QuaternionMultiply(parentGlobalRot, tx->GetRotation());
-            tx->UpdateGlobalRotationCache(globalRot);
+            tx->SetPosition(state.position);
+            tx->SetRotation(state.rotation);
+        }
+
+        if (velocities)
+        {
+            velocities[row.row].value = state.linearVelocity;
         }
     }
-    return tx->globalRotationCache;
+}
+
+void GameWorld::DispatchContactEvents()
+{
+    using ECSComponent::ContactBegin;
+    using ECSComponent::ContactEnd;
+    using ECSComponent::PhysicsBody;
+    using ECSComponent::PhysicsContact;
+
+    ecs_world_t *world = GetFlecsWorld().c_ptr();
+    for (uint64_t id : contactEntities_)
+    {
+        if (ecs_is_alive(world, id))
+        {
+            duin::Entity(id, this).Remove<ContactBegin>().Remove<ContactEnd>();
+        }
+    }
+    contactEntities_.clear();
+
+    std::span<const PhysicsContactEvent> events = PhysicsServer::Get().GetContactEvents();
+    if (events.empty())
+    {
+        return;
+    }
+
+    // As in PullPhysicsBodies: the body's user data must name a live entity here that still owns it.
+    auto resolve = [world](uint64_t id, JPH::BodyID bodyID) -> uint64_t {
+        if (id == 0 || !ecs_is_alive(world, id))
+        {
+            return 0;
+        }
+        const PhysicsBody *body = flecs::entity(world, id).try_get<PhysicsBody>();
+        return body && body->bodyID == bodyID ? id : 0;
+    };
+
+    auto deliver = [this](uint64_t id, PhysicsContactType type, const PhysicsContact &contact) {
+        duin::Entity e(id, this);
+        if (type == PhysicsContactType::Begin)
+        {
+            if (!e.Has<ContactBegin>())
+            {
+                e.Set<ContactBegin>(ContactBegin());
+                contactEntities_.push_back(id);
+            }
+            e.GetMut<ContactBegin>().contacts.push_back(contact);
+        }
+        else
+        {
+            if (!e.Has<ContactEnd>())
+            {
+                e.Set<ContactEnd>(ContactEnd());
+                contactEntities_.push_back(id);
+            }
+            e.GetMut<ContactEnd>().contacts.push_back(contact);
+        }
+    };
+
+    for (const PhysicsContactEvent &event : events)
+    {
+        uint64_t entity1 = resolve(event.userData1, event.body1);
+        uint64_t entity2 = resolve(event.userData2, event.body2);
+
+        PhysicsContact contact;
+        contact.position = event.position;
+        contact.isSensor = event.isSensor;
+        if (entity1 != 0)
+        {
+            contact.other = entity2;
+            contact.otherBody = event.body2;
+            contact.normal = event.normal;
+            deliver(entity1, event.type, contact);
+        }
+        if (entity2 != 0)
+        {
+            contact.other = entity1;
+            contact.otherBody = event.body1;
+            contact.normal = Vector3Negate(event.normal);
+            deliver(entity2, event.type, contact);
+        }
+    }
+}
+
+/*----------------------------------------------------------------------
+ * Render interpolation
+----------------------------------------------------------------------*/
+void GameWorld::SnapshotRenderTransforms()
+{
+    using ECSComponent::RenderTransform;
+    using ECSComponent::Transform3D;
+
+    Query<const Transform3D, RenderTransform> &q =
+        GetOrBuildQuery<const Transform3D, RenderTransform>("SnapshotRenderTransforms", [](GameWorld &w) {
+            return w.QueryBuilder<const Transform3D, RenderTransform>().Cached().Build();
+        });
+
+    q.Run([](duin::Iter &it) {
+        while (it.Next())
+        {
+            flecs::iter fit = it.GetFlecsIter();
+            flecs::field<const Transform3D> tx = fit.field<const Transform3D>(0);
+            flecs::field<RenderTransform> rt = fit.field<RenderTransform>(1);
+
+            for (size_t i = 0; i < it.Count(); ++i)
+            {
+                const Transform3D &t = tx[i];
+                RenderTransform &r = rt[i];
+                if (t.globalStamp == 0)
+                {
+                    continue;
+                }
+
+                // Unchanged since the last tick: settle on the current pose once, then stay idle.
+                if (t.globalStamp == r.snapshotStamp)
+                {
+                    if (r.blending)
+                    {
+                        r.previousPosition = r.currentPosition;
+                        r.previousRotation = r.currentRotation;
+                        r.previousScale = r.currentScale;
+                        r.blending = false;
+                        r.dirty = true;
+                    }
+                    continue;
+                }
+
+                // The first recorded pose has nothing to blend from.
+                bool first = r.snapshotStamp == 0;
+                if (!first)
+                {
+                    r.previousPosition = r.currentPosition;
+                    r.previousRotation = r.currentRotation;
+                    r.previousScale = r.currentScale;
+                }
+                r.currentPosition = t.globalPositionCache;
+                r.currentScale = t.globalScaleCache;
+                // q and -q are the same rotation; keep the one nearest the previous pose so
+                // the per-frame nlerp takes the short way round.
+                Quaternion rot = t.globalRotationCache;
+                const Quaternion &prev = r.previousRotation;
+                if (!first && rot.x * prev.x + rot.y * prev.y + rot.z * prev.z + rot.w * prev.w < 0.0f)
+                {
+                    rot = QuaternionScale(rot, -1.0f);
+                }
+                r.currentRotation = rot;
+                if (first)
+                {
+                    r.previousPosition = r.currentPosition;
+                    r.previousRotation = r.currentRotation;
+                    r.previousScale = r.currentScale;
+                }
+                r.snapshotStamp = t.globalStamp;
+                r.blending = !first;
+                r.dirty = true;
+            }
+        }
+    });
+}
+
+void GameWorld::InterpolateRenderTransforms(float alpha)
+{
+    using ECSComponent::RenderTransform;
+    using ECSComponent::Transform3D;
+
+    Query<const Transform3D, RenderTransform> &q =
+        GetOrBuildQuery<const Transform3D, RenderTransform>("InterpolateRenderTransforms", [](GameWorld &w) {
+            return w.QueryBuilder<const Transform3D, RenderTransform>().Cached().Build();
+        });
+
+    alpha = alpha < 0.0f ? 0.0f : (alpha > 1.0f ? 1.0f : alpha);
+
+    // Same blocking as PropagateGlobalMatrices, so the compose kernel sees contiguous input.
+    constexpr size_t BLOCK = 64;
+    Vector3 positions[BLOCK];
+    Quaternion rotations[BLOCK];
+    Vector3 scales[BLOCK];
+    Matrix matrices[BLOCK];
+    size_t rows[BLOCK];
+
+    q.Run([&](duin::Iter &it) {
+        while (it.Next())
+        {
+            flecs::iter fit = it.GetFlecsIter();
+            flecs::field<const Transform3D> tx = fit.field<const Transform3D>(0);
+            flecs::field<RenderTransform> rt = fit.field<RenderTransform>(1);
+
+            size_t count = it.Count();
+            size_t i = 0;
+            while (i < count)
+            {
+                size_t n = 0;
+                for (; i < count && n < BLOCK; ++i)
+                {
+                    RenderTransform &r = rt[i];
+                    if (r.snapshotStamp == 0)
+                    {
+                        // No tick recorded yet: draw where the entity is now.
+                        positions[n] = tx[i].globalPositionCache;
+                        rotations[n] = tx[i].globalRotationCache;
+                        scales[n] = tx[i].globalScaleCache;
+                    }
+                    else if (r.blending)
+                    {
+                        positions[n] = Vector3Lerp(r.previousPosition, r.currentPosition, alpha);
+                        rotations[n] = QuaternionNlerp(r.previousRotation, r.currentRotation, alpha);
+                        scales[n] = Vector3Lerp(r.previousScale, r.currentScale, alpha);
+                    }
+                    else if (r.dirty)
+                    {
+                        positions[n] = r.currentPosition;
+                        rotations[n] = r.currentRotation;
+                        scales[n] = r.currentScale;
+                    }
+                    else
+                    {
+                        continue;
+                    }
+                    rows[n] = i;
+                    ++n;
+                }
+                if (n == 0)
+                {
+                    continue;
+                }
+
+                MatrixComposeTRSBatch(positions, rotations, scales, matrices, n);
+                for (size_t j = 0; j < n; ++j)
+                {
+                    rt[rows[j]].value = matrices[j];
+                    rt[rows[j]].dirty = rt[rows[j]].snapshotStamp == 0;
+                }
+            }
+        }
+    });
+}
+
+void GameWorld::ResetInterpolation(duin::Entity e)
+{
+    if (!e.IsValid())
+    {
+        return;
+    }
+    ECSComponent::RenderTransform *rt = e.TryGetMut<ECSComponent::RenderTransform>();
+    if (!rt)
+    {
+        return;
+    }
+    ResolveGlobalTransform(e);
+    rt->snapshotStamp = 0;
+    rt->blending = false;
+    rt->dirty = true;
 }
 
 } // namespace duin
@@ -19,6 +19,7 @@
 #include <any>
 #include <memory.h>
 #include <unordered_map>
+#include <vector>
 
 #include <flecs.h>
 #include <rfl.hpp>
@@ -70,10 +71,14 @@ class GameWorld : public World
     /** @brief Sets the given entity as the active camera. */
     void ActivateCameraEntity(duin::Entity entity);
 
-    /** @brief Runs post-update queries. Called by engine. */
+    /** @brief Runs post-update systems and queries. Called by engine. */
     virtual void PostUpdateQueryExecution(double delta);
-    /** @brief Runs post-physics queries. Called by engine. */
+    /** @brief Runs post-physics systems and queries, then pushes kinematic bodies. Called by engine. */
     virtual void PostPhysicsUpdateQueryExecution(double delta);
+    /** @brief Reads back the bodies the physics step moved. Called by engine. */
+    virtual void PostPhysicsStepQueryExecution(double delta);
+    /** @brief Interpolates render transforms for this frame. Called by engine before Draw(). */
+    virtual void PreDrawQueryExecution();
     /** @brief Runs post-draw queries. Called by engine. */
     virtual void PostDrawQueryExecution();
     /** @brief Runs post-draw-UI queries. Called by engine. */
@@ -93,6 +98,75 @@ class GameWorld : public World
     void SetGlobalRotation(duin::Entity e, Quaternion rotation);
     Quaternion GetGlobalRotation(duin::Entity e);
 
+    /**
+     * @brief Refreshes the global cache of every Transform3D in one pass.
+     *
+     * Tables are visited in hierarchy depth order (cascade), so a parent's
+     * cache is always current before its children read it. Only entities whose
+     * local transform or ancestry changed are recomputed. Called by the engine
+     * after update and physics update; call manually after bulk edits.
+     */
+    void PropagateTransforms();
+
+    /**
+     * @brief Creates a PhysicsServer body at the entity's global transform and attaches a PhysicsBody.
+     *
+     * Also adds the PxStatic, PxKinematic or PxDynamic tag, and a RenderTransform for bodies
+     * that move. The entity must have a Transform3D.
+     * @param layer Object layer from the PhysicsServer's config (see PhysicsServer::GetObjectLayer());
+     *              by default NON_MOVING for static bodies and MOVING for the rest.
+     * @return False if the entity has no Transform3D, already has a body, or the body could not be created.
+     */
+    bool AddPhysicsBody(duin::Entity e, const CollisionShapeDesc &shape, PhysicsMotionType motionType,
+                        JPH::ObjectLayer layer = JPH::cObjectLayerInvalid);
+    /** @brief Removes the entity's PhysicsBody, destroying its body. */
+    void RemovePhysicsBody(duin::Entity e);
+
+    /**
+     * @brief Sends kinematic bodies whose Transform3D changed since the last push to the PhysicsServer.
+     *
+     * One query over kinematic entities and one locked batch on the Jolt side. Called by the
+     * engine after the post-physics systems, right before the step.
+     */
+    void PushPhysicsBodies();
+
+    /**
+     * @brief Writes the pose of every awake dynamic body back into its entity.
+     *
+     * Called by the engine after the step. Sleeping bodies are never visited.
+     */
+    void PullPhysicsBodies();
+
+    /**
+     * @brief Hands the last step's contact events to the entities whose bodies took part.
+     *
+     * Removes the ContactBegin and ContactEnd components left by the previous tick, then
+     * adds them to the entities named in PhysicsServer::GetContactEvents(). Only entities
+     * of this world that still own the body are told, so an entity whose body was removed
+     * gets no ContactEnd. Called by the engine after the step.
+     */
+    void DispatchContactEvents();
+
+    /**
+     * @brief Records the current global pose of every entity with a RenderTransform.
+     *
+     * The pose recorded at the previous call becomes the one blended from. Called by
+     * the engine after every physics tick, once the bodies have been read back.
+     */
+    void SnapshotRenderTransforms();
+
+    /**
+     * @brief Writes every RenderTransform as a blend of its last two recorded poses.
+     * @param alpha 0 gives the previous tick's pose, 1 the current one.
+     *
+     * Entities at rest are skipped once their matrix is up to date. Called by the
+     * engine with GetPhysicsInterpolationAlpha() before Draw().
+     */
+    void InterpolateRenderTransforms(float alpha);
+
+    /** @brief Drops the entity's recorded poses so it is drawn at its current transform, e.g. after a teleport. */
+    void ResetInterpolation(duin::Entity e);
+
   protected:
     // Query cache — queries are built on first call and reused thereafter.
     // Accessible to subclasses so they can inline their own queries.
@@ -127,12 +201,33 @@ class GameWorld : public World
     }
 
   private:
+    void PropagateGlobalMatrices();
+    ECSComponent::Transform3D *ResolveGlobalTransform(duin::Entity e);
+    void ComposeGlobalTransform(ECSComponent::Transform3D &tx, const ECSComponent::Transform3D *parentTx);
+
     std::shared_ptr<ScopedConnection> connPostUpdate_;
     std::shared_ptr<ScopedConnection> connPostPhysicsUpdate_;
+    std::shared_ptr<ScopedConnection> connPostPhysicsStep_;
+    std::shared_ptr<ScopedConnection> connPreDraw_;
     std::shared_ptr<ScopedConnection> connPostDraw_;
     std::shared_ptr<ScopedConnection> connPostDrawUI_;
 
     std::unordered_map<std::string, std::any> queryCache_;
+    uint64_t transformStamp_ = 0;
+
+    // Physics sync scratch, reused every tick.
+    std::vector<PhysicsKinematicTarget> kinematicTargets_;
+    std::vector<PhysicsBodyState> bodyStates_;
+    struct PhysicsRow
+    {
+        const ecs_table_t *table;
+        int32_t row;
+        uint32_t state; // index into bodyStates_
+    };
+    std::vector<PhysicsRow> physicsRows_;
+    // Entities given ContactBegin/ContactEnd by the last dispatch.
+    std::vector<uint64_t> contactEntities_;
+    bool physicsBodyObserver_ = false;
 };
 
 } // namespace duin
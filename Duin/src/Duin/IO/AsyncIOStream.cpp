@@ -1,2 +1,661 @@
 #include "dnpch.h"
-#include "AsyncIOStream.h"
\ No newline at end of file
+#include "AsyncIOStream.h"
+
+#include "IOStream.h"
+#include "Duin/Core/Debug/DNLog.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define DN_ASYNCIO_URING 1
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#else
+#define DN_ASYNCIO_URING 0
+#endif
+
+namespace duin::io
+{
+
+namespace
+{
+// Max-heap order: higher priority first, then lower sequence (FIFO within a priority).
+template <typename RequestPtr>
+bool RequestOrder(const RequestPtr &a, const RequestPtr &b)
+{
+    if (a->priority != b->priority)
+    {
+        return a->priority < b->priority;
+    }
+    return a->sequence > b->sequence;
+}
+
+std::atomic<bool> globalStarted{false};
+} // namespace
+
+// ---------------------------------------------------------------------------
+// io_uring
+// ---------------------------------------------------------------------------
+
+#if DN_ASYNCIO_URING
+
+// Minimal io_uring over the raw syscalls, so no liburing dependency. Only the
+// submission thread touches the rings; Wake() may be called from any thread.
+class AsyncIOStream::URing
+{
+  public:
+    ~URing()
+    {
+        if (sqes_)
+        {
+            munmap(sqes_, sqesSize_);
+        }
+        if (cqRing_)
+        {
+            munmap(cqRing_, cqRingSize_);
+        }
+        if (sqRing_)
+        {
+            munmap(sqRing_, sqRingSize_);
+        }
+        if (ringFd_ >= 0)
+        {
+            close(ringFd_);
+        }
+        if (wakeFd_ >= 0)
+        {
+            close(wakeFd_);
+        }
+    }
+
+    bool Init(uint32_t entries)
+    {
+        io_uring_params params{};
+        ringFd_ = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+        if (ringFd_ < 0)
+        {
+            return false;
+        }
+
+        sqRingSize_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cqRingSize_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        sqesSize_ = params.sq_entries * sizeof(io_uring_sqe);
+        sqRing_ = Map(sqRingSize_, IORING_OFF_SQ_RING);
+        cqRing_ = Map(cqRingSize_, IORING_OFF_CQ_RING);
+        sqes_ = static_cast<io_uring_sqe *>(Map(sqesSize_, IORING_OFF_SQES));
+        wakeFd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (!sqRing_ || !cqRing_ || !sqes_ || wakeFd_ < 0)
+        {
+            return false;
+        }
+
+        char *sq = static_cast<char *>(sqRing_);
+        sqHead_ = reinterpret_cast<unsigned *>(sq + params.sq_off.head);
+        sqTail_ = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+        sqMask_ = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+        sqArray_ = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+        sqEntries_ = params.sq_entries;
+        char *cq = static_cast<char *>(cqRing_);
+        cqHead_ = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+        cqTail_ = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+        cqMask_ = *reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+        cqes_ = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+        localTail_ = *sqTail_;
+        return true;
+    }
+
+    // Next free submission entry, zeroed, or nullptr when the ring is full.
+    io_uring_sqe *GetSqe()
+    {
+        unsigned head = __atomic_load_n(sqHead_, __ATOMIC_ACQUIRE);
+        if (localTail_ - head >= sqEntries_)
+        {
+            return nullptr;
+        }
+        unsigned index = localTail_ & sqMask_;
+        sqArray_[index] = index;
+        ++localTail_;
+        std::memset(&sqes_[index], 0, sizeof(io_uring_sqe));
+        return &sqes_[index];
+    }
+
+    // Submits the queued entries and blocks until at least one completion is available.
+    bool SubmitAndWait()
+    {
+        unsigned toSubmit = localTail_ - *sqTail_;
+        __atomic_store_n(sqTail_, localTail_, __ATOMIC_RELEASE);
+        while (true)
+        {
+            long result = syscall(__NR_io_uring_enter, ringFd_, toSubmit, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+            if (result >= 0)
+            {
+                return true;
+            }
+            if (errno != EINTR && errno != EAGAIN && errno != EBUSY)
+            {
+                DN_CORE_ERROR("AsyncIOStream: io_uring_enter failed: {}", std::strerror(errno));
+                return false;
+            }
+        }
+    }
+
+    bool PopCompletion(io_uring_cqe &out)
+    {
+        unsigned head = *cqHead_;
+        if (head == __atomic_load_n(cqTail_, __ATOMIC_ACQUIRE))
+        {
+            return false;
+        }
+        out = cqes_[head & cqMask_];
+        __atomic_store_n(cqHead_, head + 1, __ATOMIC_RELEASE);
+        return true;
+    }
+
+    // Polls the wake eventfd; its completion (user_data 0) interrupts SubmitAndWait().
+    bool ArmWake()
+    {
+        io_uring_sqe *sqe = GetSqe();
+        if (!sqe)
+        {
+            return false;
+        }
+        sqe->opcode = IORING_OP_POLL_ADD;
+        sqe->fd = wakeFd_;
+        sqe->poll_events = POLLIN;
+        sqe->user_data = 0;
+        return true;
+    }
+
+    void Wake()
+    {
+        uint64_t one = 1;
+        [[maybe_unused]] ssize_t written = write(wakeFd_, &one, sizeof(one));
+    }
+
+    void ClearWake()
+    {
+        uint64_t value = 0;
+        [[maybe_unused]] ssize_t read = ::read(wakeFd_, &value, sizeof(value));
+    }
+
+  private:
+    void *Map(size_t size, off_t offset)
+    {
+        void *ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd_, offset);
+        return ptr == MAP_FAILED ? nullptr : ptr;
+    }
+
+    int ringFd_ = -1;
+    int wakeFd_ = -1;
+    void *sqRing_ = nullptr;
+    void *cqRing_ = nullptr;
+    size_t sqRingSize_ = 0;
+    size_t cqRingSize_ = 0;
+    size_t sqesSize_ = 0;
+    io_uring_sqe *sqes_ = nullptr;
+    io_uring_cqe *cqes_ = nullptr;
+    unsigned *sqHead_ = nullptr;
+    unsigned *sqTail_ = nullptr;
+    unsigned *sqArray_ = nullptr;
+    unsigned *cqHead_ = nullptr;
+    unsigned *cqTail_ = nullptr;
+    unsigned sqMask_ = 0;
+    unsigned cqMask_ = 0;
+    unsigned sqEntries_ = 0;
+    unsigned localTail_ = 0;
+};
+
+namespace
+{
+// Single reads and writes are capped well below the 2 GiB syscall limit; longer files take several.
+constexpr size_t URING_MAX_TRANSFER = size_t(1) << 30;
+
+struct URingOp
+{
+    std::shared_ptr<void> owner; // keeps the request (and its buffer) alive while in flight
+    uint8_t *data = nullptr;
+    bool write = false;
+    int fd = -1;
+    size_t size = 0;
+    size_t offset = 0;
+    iovec iov{};
+};
+} // namespace
+
+#else
+
+class AsyncIOStream::URing
+{
+};
+
+#endif
+
+// ---------------------------------------------------------------------------
+// Service
+// ---------------------------------------------------------------------------
+
+AsyncIOStream &AsyncIOStream::Get()
+{
+    static AsyncIOStream service;
+    globalStarted.store(true, std::memory_order_release);
+    return service;
+}
+
+void AsyncIOStream::PumpGlobal(AsyncIOPhase phase)
+{
+    if (globalStarted.load(std::memory_order_acquire))
+    {
+        Get().Pump(phase);
+    }
+}
+
+AsyncIOStream::AsyncIOStream(AsyncIOBackend backend, size_t workerCount, uint32_t queueDepth)
+    : queueDepth_(std::max<uint32_t>(queueDepth, 1))
+{
+#if DN_ASYNCIO_URING
+    if (backend != AsyncIOBackend::Threads)
+    {
+        uring_ = std::make_unique<URing>();
+        if (uring_->Init(queueDepth_ + 1)) // one extra entry for the wake poll
+        {
+            backend_ = AsyncIOBackend::IOUring;
+            threads_.emplace_back(&AsyncIOStream::URingLoop, this);
+            return;
+        }
+        int error = errno;
+        uring_.reset();
+        DN_CORE_INFO("AsyncIOStream: io_uring unavailable ({}), using worker threads.", std::strerror(error));
+    }
+#else
+    if (backend == AsyncIOBackend::IOUring)
+    {
+        DN_CORE_INFO("AsyncIOStream: io_uring is Linux only, using worker threads.");
+    }
+#endif
+
+    backend_ = AsyncIOBackend::Threads;
+    workerCount = std::max<size_t>(workerCount, 1);
+    for (size_t i = 0; i < workerCount; ++i)
+    {
+        threads_.emplace_back(&AsyncIOStream::WorkerLoop, this);
+    }
+}
+
+AsyncIOStream::~AsyncIOStream()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+        for (const std::shared_ptr<Request> &request : queue_)
+        {
+            pending_.erase(request->id);
+        }
+        queue_.clear();
+    }
+    wake_.notify_all();
+    Wake();
+    for (std::thread &thread : threads_)
+    {
+        thread.join();
+    }
+}
+
+AsyncIORequestId AsyncIOStream::ReadFile(const std::string &path, AsyncIOCallback callback,
+                                         AsyncIOPriority priority, AsyncIOPhase phase)
+{
+    return Enqueue(Operation::Read, path, {}, std::move(callback), priority, phase);
+}
+
+AsyncIORequestId AsyncIOStream::WriteFile(const std::string &path, std::vector<uint8_t> data,
+                                          AsyncIOCallback callback, AsyncIOPriority priority, AsyncIOPhase phase)
+{
+    return Enqueue(Operation::Write, path, std::move(data), std::move(callback), priority, phase);
+}
+
+AsyncIORequestId AsyncIOStream::Enqueue(Operation operation, const std::string &path, std::vector<uint8_t> data,
+                                        AsyncIOCallback callback, AsyncIOPriority priority, AsyncIOPhase phase)
+{
+    if (phase >= AsyncIOPhase::Count)
+    {
+        DN_CORE_WARN("AsyncIOStream: invalid completion phase for '{}'", path);
+        return ASYNCIO_INVALID_REQUEST;
+    }
+
+    auto request = std::make_shared<Request>();
+    request->operation = operation;
+    request->priority = priority;
+    request->phase = phase;
+    request->path = path;
+    request->data = std::move(data);
+    request->callback = std::move(callback);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stop_)
+        {
+            return ASYNCIO_INVALID_REQUEST;
+        }
+        request->id = nextId_++;
+        request->sequence = nextSequence_++;
+        pending_[request->id] = request;
+        queue_.push_back(request);
+        std::push_heap(queue_.begin(), queue_.end(), RequestOrder<std::shared_ptr<Request>>);
+    }
+    wake_.notify_one();
+    Wake();
+    return request->id;
+}
+
+bool AsyncIOStream::Cancel(AsyncIORequestId id)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = pending_.find(id);
+    if (it == pending_.end())
+    {
+        return false;
+    }
+    std::shared_ptr<Request> request = it->second;
+    request->cancelled.store(true, std::memory_order_relaxed);
+
+    auto queued = std::find(queue_.begin(), queue_.end(), request);
+    if (queued != queue_.end())
+    {
+        queue_.erase(queued);
+        std::make_heap(queue_.begin(), queue_.end(), RequestOrder<std::shared_ptr<Request>>);
+        pending_.erase(it);
+        request->data.clear();
+        completed_[static_cast<size_t>(request->phase)].push_back({request, AsyncIOStatus::Cancelled, 0});
+    }
+    return true;
+}
+
+size_t AsyncIOStream::Pump(AsyncIOPhase phase)
+{
+    if (phase >= AsyncIOPhase::Count)
+    {
+        return 0;
+    }
+
+    std::vector<Completion> completions;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        completions.swap(completed_[static_cast<size_t>(phase)]);
+    }
+
+    for (Completion &completion : completions)
+    {
+        Request &request = *completion.request;
+        if (!request.callback)
+        {
+            continue;
+        }
+        AsyncIOResult result;
+        result.id = request.id;
+        result.status = completion.status;
+        result.path = std::move(request.path);
+        result.size = completion.size;
+        if (request.operation == Operation::Read && completion.status == AsyncIOStatus::Completed)
+        {
+            result.data = std::move(request.data);
+        }
+        request.callback(result);
+    }
+    return completions.size();
+}
+
+size_t AsyncIOStream::GetPendingCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pending_.size();
+}
+
+bool AsyncIOStream::PopRequest(std::shared_ptr<Request> &out, bool block)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (block)
+    {
+        wake_.wait(lock, [this]() { return stop_ || !queue_.empty(); });
+    }
+    if (queue_.empty())
+    {
+        return false;
+    }
+    std::pop_heap(queue_.begin(), queue_.end(), RequestOrder<std::shared_ptr<Request>>);
+    out = std::move(queue_.back());
+    queue_.pop_back();
+    return true;
+}
+
+void AsyncIOStream::Complete(const std::shared_ptr<Request> &request, AsyncIOStatus status, size_t size)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.erase(request->id);
+    if (request->cancelled.load(std::memory_order_relaxed))
+    {
+        status = AsyncIOStatus::Cancelled;
+        size = 0;
+    }
+    if (status != AsyncIOStatus::Completed || request->operation == Operation::Write)
+    {
+        request->data.clear();
+        request->data.shrink_to_fit();
+    }
+    completed_[static_cast<size_t>(request->phase)].push_back({request, status, size});
+}
+
+void AsyncIOStream::Wake()
+{
+#if DN_ASYNCIO_URING
+    if (uring_)
+    {
+        uring_->Wake();
+    }
+#endif
+}
+
+// ---------------------------------------------------------------------------
+// Threads backend
+// ---------------------------------------------------------------------------
+
+void AsyncIOStream::WorkerLoop()
+{
+    std::shared_ptr<Request> request;
+    while (PopRequest(request, true))
+    {
+        if (request->cancelled.load(std::memory_order_relaxed))
+        {
+            Complete(request, AsyncIOStatus::Cancelled, 0);
+            continue;
+        }
+
+        if (request->operation == Operation::Read)
+        {
+            IOStream stream = IOStream::FromFile(request->path, "rb");
+            int64_t size = stream.IsValid() ? stream.GetSize() : -1;
+            if (size < 0)
+            {
+                Complete(request, AsyncIOStatus::Failed, 0);
+                continue;
+            }
+            request->data.resize(static_cast<size_t>(size));
+            size_t offset = 0;
+            while (offset < request->data.size())
+            {
+                size_t read = stream.Read(request->data.data() + offset, request->data.size() - offset);
+                if (read == 0)
+                {
+                    break;
+                }
+                offset += read;
+            }
+            request->data.resize(offset);
+            Complete(request, AsyncIOStatus::Completed, offset);
+        }
+        else
+        {
+            IOStream stream = IOStream::FromFile(request->path, "wb");
+            size_t size = request->data.size();
+            bool written = stream.IsValid() && (size == 0 || stream.Write(request->data.data(), size) == size);
+            Complete(request, written ? AsyncIOStatus::Completed : AsyncIOStatus::Failed, written ? size : 0);
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// io_uring backend
+// ---------------------------------------------------------------------------
+
+void AsyncIOStream::URingLoop()
+{
+#if DN_ASYNCIO_URING
+    URing &ring = *uring_;
+    uint32_t inFlight = 0;
+    bool wakeArmed = false;
+
+    auto queueOp = [&ring](URingOp *op) {
+        io_uring_sqe *sqe = ring.GetSqe();
+        op->iov.iov_base = op->data + op->offset;
+        op->iov.iov_len = std::min(op->size - op->offset, URING_MAX_TRANSFER);
+        sqe->opcode = op->write ? IORING_OP_WRITEV : IORING_OP_READV;
+        sqe->fd = op->fd;
+        sqe->addr = reinterpret_cast<uint64_t>(&op->iov);
+        sqe->len = 1;
+        sqe->off = op->offset;
+        sqe->user_data = reinterpret_cast<uint64_t>(op);
+    };
+
+    // Opens the file and queues the first transfer. Returns false if the request completed immediately.
+    auto start = [&](const std::shared_ptr<Request> &request) -> bool {
+        if (request->cancelled.load(std::memory_order_relaxed))
+        {
+            Complete(request, AsyncIOStatus::Cancelled, 0);
+            return false;
+        }
+
+        bool write = request->operation == Operation::Write;
+        int fd = write ? open(request->path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644)
+                       : open(request->path.c_str(), O_RDONLY | O_CLOEXEC);
+        struct stat info{};
+        if (fd < 0 || (!write && fstat(fd, &info) != 0))
+        {
+            DN_CORE_ERROR("AsyncIOStream: cannot open '{}': {}", request->path, std::strerror(errno));
+            if (fd >= 0)
+            {
+                close(fd);
+            }
+            Complete(request, AsyncIOStatus::Failed, 0);
+            return false;
+        }
+        if (!write)
+        {
+            request->data.resize(static_cast<size_t>(info.st_size));
+        }
+        if (request->data.empty())
+        {
+            close(fd);
+            Complete(request, AsyncIOStatus::Completed, 0);
+            return false;
+        }
+
+        auto *op = new URingOp;
+        op->owner = request;
+        op->data = request->data.data();
+        op->write = write;
+        op->fd = fd;
+        op->size = request->data.size();
+        queueOp(op);
+        return true;
+    };
+
+    auto finish = [&](URingOp *op, AsyncIOStatus status) {
+        auto request = std::static_pointer_cast<Request>(op->owner);
+        close(op->fd);
+        if (status == AsyncIOStatus::Completed && !op->write)
+        {
+            request->data.resize(op->offset); // the file may have shrunk since fstat
+        }
+        Complete(request, status, status == AsyncIOStatus::Completed ? op->offset : 0);
+        delete op;
+        --inFlight;
+    };
+
+    while (true)
+    {
+        if (!wakeArmed)
+        {
+            wakeArmed = ring.ArmWake();
+        }
+
+        std::shared_ptr<Request> request;
+        while (inFlight < queueDepth_ && PopRequest(request, false))
+        {
+            if (start(request))
+            {
+                ++inFlight;
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stop_ && queue_.empty() && inFlight == 0)
+            {
+                break;
+            }
+        }
+
+        if (!ring.SubmitAndWait())
+        {
+            break;
+        }
+
+        io_uring_cqe cqe;
+        while (ring.PopCompletion(cqe))
+        {
+            if (cqe.user_data == 0)
+            {
+                ring.ClearWake();
+                wakeArmed = false;
+                continue;
+            }
+
+            auto *op = reinterpret_cast<URingOp *>(cqe.user_data);
+            if (cqe.res == -EINTR || cqe.res == -EAGAIN)
+            {
+                queueOp(op);
+            }
+            else if (cqe.res < 0)
+            {
+                DN_CORE_ERROR("AsyncIOStream: {} failed for '{}': {}", op->write ? "write" : "read",
+                              std::static_pointer_cast<Request>(op->owner)->path, std::strerror(-cqe.res));
+                finish(op, AsyncIOStatus::Failed);
+            }
+            else if (cqe.res == 0)
+            {
+                // End of file before the expected size: a short read is still a result, a stuck write is not.
+                finish(op, op->write ? AsyncIOStatus::Failed : AsyncIOStatus::Completed);
+            }
+            else
+            {
+                op->offset += static_cast<size_t>(cqe.res);
+                if (op->offset < op->size)
+                {
+                    queueOp(op);
+                }
+                else
+                {
+                    finish(op, AsyncIOStatus::Completed);
+                }
+            }
+        }
+    }
+#endif
+}
+
+} // namespace duin::io
@@ -1 +1,219 @@
+/**
+ * @file AsyncIOStream.h
+ * @brief Asynchronous, prioritized whole-file reads and writes.
+ *
+ * Requests go into a priority queue and are serviced off the main thread. On
+ * Linux the service drives an io_uring instance from one submission thread;
+ * elsewhere, or when the kernel refuses io_uring, a few blocking worker threads
+ * take its place. The workers are separate from ThreadPool so that a slow disk
+ * never stalls compute tasks.
+ *
+ * Completion callbacks never run on the I/O threads. Each request names the
+ * frame phase it completes in, and the callback runs on the thread that calls
+ * Pump() for that phase (the Application pumps every phase on the main thread).
+ *
+ * @see VirtualIOStream.h for the virtual-path (bin://, wrk://, ...) variants.
+ */
+
 #pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace duin::io
+{
+
+/** @brief Identifies a queued request. 0 is never a valid id. */
+using AsyncIORequestId = uint64_t;
+static constexpr AsyncIORequestId ASYNCIO_INVALID_REQUEST = 0;
+
+/** @brief Higher priorities leave the queue first; equal priorities keep submission order. */
+enum class AsyncIOPriority : uint8_t
+{
+    Low,
+    Normal,
+    High,
+    Critical
+};
+
+/** @brief Point of the frame at which a request's callback runs. */
+enum class AsyncIOPhase : uint8_t
+{
+    PreFrame,   ///< Before events and Update
+    PostUpdate, ///< After Update, before physics
+    PostFrame,  ///< After rendering
+    Count
+};
+
+enum class AsyncIOStatus : uint8_t
+{
+    Completed,
+    Failed,
+    Cancelled
+};
+
+/** @brief Which implementation services the queue. */
+enum class AsyncIOBackend : uint8_t
+{
+    Auto,      ///< io_uring when available, otherwise Threads
+    IOUring,   ///< Linux io_uring; falls back to Threads if it cannot be set up
+    Threads    ///< Blocking reads on dedicated worker threads
+};
+
+/**
+ * @brief Outcome of a request, handed to its callback.
+ *
+ * For reads, data holds the file contents and may be moved out by the callback.
+ * For writes, data is empty and size is the number of bytes written.
+ */
+struct AsyncIOResult
+{
+    AsyncIORequestId id = ASYNCIO_INVALID_REQUEST;
+    AsyncIOStatus status = AsyncIOStatus::Failed;
+    std::string path;
+    std::vector<uint8_t> data;
+    size_t size = 0;
+};
+
+using AsyncIOCallback = std::function<void(AsyncIOResult &result)>;
+
+/**
+ * @class AsyncIOStream
+ * @brief Request queue and backend for asynchronous file I/O.
+ *
+ * Every accepted request gets exactly one callback, including cancelled and
+ * failed ones, so callers can always release the state tied to it. Requests
+ * still pending when the service is destroyed are dropped without callbacks.
+ *
+ * Example:
+ * @code
+ * duin::io::AsyncIOStream::Get().ReadFile("level.json", [](duin::io::AsyncIOResult &result) {
+ *     if (result.status == duin::io::AsyncIOStatus::Completed)
+ *     {
+ *         // parse result.data
+ *     }
+ * }, duin::io::AsyncIOPriority::High);
+ * @endcode
+ */
+class AsyncIOStream
+{
+  public:
+    /** @brief Engine-wide service, started on first use. Pumped by the Application. */
+    static AsyncIOStream &Get();
+
+    /** @brief Pumps the engine-wide service if it has been started. */
+    static void PumpGlobal(AsyncIOPhase phase);
+
+    /**
+     * @param backend Requested implementation.
+     * @param workerCount Threads for the Threads backend.
+     * @param queueDepth Requests in flight at once for the io_uring backend.
+     */
+    explicit AsyncIOStream(AsyncIOBackend backend = AsyncIOBackend::Auto, size_t workerCount = 2,
+                           uint32_t queueDepth = 32);
+    ~AsyncIOStream();
+
+    AsyncIOStream(const AsyncIOStream &) = delete;
+    AsyncIOStream &operator=(const AsyncIOStream &) = delete;
+
+    /** @brief Reads a whole file. */
+    AsyncIORequestId ReadFile(const std::string &path, AsyncIOCallback callback,
+                              AsyncIOPriority priority = AsyncIOPriority::Normal,
+                              AsyncIOPhase phase = AsyncIOPhase::PreFrame);
+
+    /** @brief Creates or truncates a file and writes data to it. */
+    AsyncIORequestId WriteFile(const std::string &path, std::vector<uint8_t> data, AsyncIOCallback callback,
+                               AsyncIOPriority priority = AsyncIOPriority::Normal,
+                               AsyncIOPhase phase = AsyncIOPhase::PreFrame);
+
+    /**
+     * @brief Cancels a request.
+     *
+     * A queued request is removed without touching the file. One already in
+     * flight finishes its I/O but completes as Cancelled, with no data.
+     *
+     * @return false if the request is unknown or has already completed.
+     */
+    bool Cancel(AsyncIORequestId id);
+
+    /**
+     * @brief Runs the callbacks of the requests completed for a phase.
+     *
+     * Callbacks run in completion order. Ones that complete while pumping wait
+     * for the next call.
+     *
+     * @return Number of callbacks run.
+     */
+    size_t Pump(AsyncIOPhase phase);
+
+    /** @brief Requests queued or in flight, not counting completions awaiting Pump(). */
+    size_t GetPendingCount() const;
+
+    /** @brief Implementation actually in use (never Auto). */
+    AsyncIOBackend GetBackend() const
+    {
+        return backend_;
+    }
+
+  private:
+    enum class Operation : uint8_t
+    {
+        Read,
+        Write
+    };
+
+    struct Request
+    {
+        AsyncIORequestId id = ASYNCIO_INVALID_REQUEST;
+        uint64_t sequence = 0;
+        Operation operation = Operation::Read;
+        AsyncIOPriority priority = AsyncIOPriority::Normal;
+        AsyncIOPhase phase = AsyncIOPhase::PreFrame;
+        std::string path;
+        std::vector<uint8_t> data;
+        AsyncIOCallback callback;
+        std::atomic<bool> cancelled{false};
+    };
+
+    struct Completion
+    {
+        std::shared_ptr<Request> request;
+        AsyncIOStatus status = AsyncIOStatus::Failed;
+        size_t size = 0;
+    };
+
+    class URing;
+
+    AsyncIORequestId Enqueue(Operation operation, const std::string &path, std::vector<uint8_t> data,
+                             AsyncIOCallback callback, AsyncIOPriority priority, AsyncIOPhase phase);
+    bool PopRequest(std::shared_ptr<Request> &out, bool block);
+    void Complete(const std::shared_ptr<Request> &request, AsyncIOStatus status, size_t size);
+    void WorkerLoop();
+    void URingLoop();
+    void Wake();
+
+    AsyncIOBackend backend_ = AsyncIOBackend::Threads;
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    std::vector<std::shared_ptr<Request>> queue_; // binary heap, see RequestOrder
+    std::unordered_map<AsyncIORequestId, std::shared_ptr<Request>> pending_;
+    std::vector<Completion> completed_[static_cast<size_t>(AsyncIOPhase::Count)];
+    AsyncIORequestId nextId_ = 1;
+    uint64_t nextSequence_ = 0;
+    bool stop_ = false;
+
+    std::unique_ptr<URing> uring_;
+    uint32_t queueDepth_ = 32;
+    std::vector<std::thread> threads_;
+};
+
+} // namespace duin::io
@@ -10,6 +10,26 @@
 #include "IOStream.h"
 #include <Duin/Core/Debug/DNLog.h>
 
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#define DN_IOSTREAM_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace duin::io
 {
 
@@ -156,6 +176,189 @@ void IOStream::FreeLoadedData(void *data)
     SDL_free(data);
 }
 
+// --- File mapping ---
+
+#if defined(DN_IOSTREAM_MMAP)
+static int ToMadvise(MapAdvice advice)
+{
+    switch (advice)
+    {
+    case MapAdvice::Sequential: return MADV_SEQUENTIAL;
+    case MapAdvice::Random:     return MADV_RANDOM;
+    case MapAdvice::WillNeed:   return MADV_WILLNEED;
+    case MapAdvice::DontNeed:   return MADV_DONTNEED;
+    default:                    return MADV_NORMAL;
+    }
+}
+#endif
+
+FileMapping IOStream::MapFile(const std::string &file, MapAdvice advice)
+{
+    FileMapping mapping;
+
+#if defined(_WIN32)
+    DWORD flags = FILE_ATTRIBUTE_NORMAL;
+    if (advice == MapAdvice::Sequential)
+    {
+        flags |= FILE_FLAG_SEQUENTIAL_SCAN;
+    }
+    else if (advice == MapAdvice::Random)
+    {
+        flags |= FILE_FLAG_RANDOM_ACCESS;
+    }
+    HANDLE handle = CreateFileA(file.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, flags, nullptr);
+    LARGE_INTEGER fileSize{};
+    if (handle == INVALID_HANDLE_VALUE || !GetFileSizeEx(handle, &fileSize))
+    {
+        DN_CORE_ERROR("IOStream::MapFile failed for '{}': error {}", file, GetLastError());
+        if (handle != INVALID_HANDLE_VALUE)
+        {
+            CloseHandle(handle);
+        }
+        return mapping;
+    }
+    if (fileSize.QuadPart == 0)
+    {
+        CloseHandle(handle);
+        mapping.backing_ = FileMapping::Backing::Mapped;
+        return mapping;
+    }
+
+    // The view keeps the file and mapping objects alive on its own.
+    HANDLE section = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void *view = section ? MapViewOfFile(section, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (section)
+    {
+        CloseHandle(section);
+    }
+    CloseHandle(handle);
+    if (view)
+    {
+        mapping.data_ = static_cast<const uint8_t *>(view);
+        mapping.size_ = static_cast<size_t>(fileSize.QuadPart);
+        mapping.backing_ = FileMapping::Backing::Mapped;
+        mapping.Advise(advice);
+        return mapping;
+    }
+    DN_CORE_WARN("IOStream::MapFile could not map '{}' (error {}), loading it instead", file, GetLastError());
+#elif defined(DN_IOSTREAM_MMAP)
+    int fd = open(file.c_str(), O_RDONLY | O_CLOEXEC);
+    struct stat info{};
+    if (fd < 0 || fstat(fd, &info) != 0)
+    {
+        DN_CORE_ERROR("IOStream::MapFile failed for '{}': {}", file, std::strerror(errno));
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+        return mapping;
+    }
+    if (info.st_size == 0)
+    {
+        close(fd);
+        mapping.backing_ = FileMapping::Backing::Mapped;
+        return mapping;
+    }
+
+    void *view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // the mapping holds its own reference to the file
+    if (view != MAP_FAILED)
+    {
+        mapping.data_ = static_cast<const uint8_t *>(view);
+        mapping.size_ = static_cast<size_t>(info.st_size);
+        mapping.backing_ = FileMapping::Backing::Mapped;
+        mapping.Advise(advice);
+        return mapping;
+    }
+    DN_CORE_WARN("IOStream::MapFile could not map '{}' ({}), loading it instead", file, std::strerror(errno));
+#endif
+
+    size_t size = 0;
+    void *data = LoadFile(file, &size);
+    if (data)
+    {
+        mapping.data_ = static_cast<const uint8_t *>(data);
+        mapping.size_ = size;
+        mapping.backing_ = FileMapping::Backing::Loaded;
+    }
+    return mapping;
+}
+
+FileMapping::~FileMapping()
+{
+    Release();
+}
+
+FileMapping::FileMapping(FileMapping &&other) noexcept
+    : data_(other.data_), size_(other.size_), backing_(other.backing_)
+{
+    other.data_ = nullptr;
+    other.size_ = 0;
+    other.backing_ = Backing::None;
+}
+
+FileMapping &FileMapping::operator=(FileMapping &&other) noexcept
+{
+    if (this != &other)
+    {
+        Release();
+        data_ = other.data_;
+        size_ = other.size_;
+        backing_ = other.backing_;
+        other.data_ = nullptr;
+        other.size_ = 0;
+        other.backing_ = Backing::None;
+    }
+    return *this;
+}
+
+void FileMapping::Advise(MapAdvice advice, size_t offset, size_t length) const
+{
+#if defined(DN_IOSTREAM_MMAP)
+    if (backing_ != Backing::Mapped || !data_ || offset >= size_)
+    {
+        return;
+    }
+    length = std::min(length, size_ - offset);
+    uintptr_t pageSize = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    uintptr_t begin = reinterpret_cast<uintptr_t>(data_ + offset) & ~(pageSize - 1);
+    uintptr_t end = reinterpret_cast<uintptr_t>(data_ + offset + length);
+    madvise(reinterpret_cast<void *>(begin), end - begin, ToMadvise(advice));
+#elif defined(_WIN32) && _WIN32_WINNT >= 0x0602
+    if (backing_ != Backing::Mapped || !data_ || offset >= size_ || advice != MapAdvice::WillNeed)
+    {
+        return;
+    }
+    WIN32_MEMORY_RANGE_ENTRY range;
+    range.VirtualAddress = const_cast<uint8_t *>(data_ + offset);
+    range.NumberOfBytes = std::min(length, size_ - offset);
+    PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#else
+    (void)advice;
+    (void)offset;
+    (void)length;
+#endif
+}
+
+void FileMapping::Release()
+{
+    if (backing_ == Backing::Mapped && data_)
+    {
+#if defined(_WIN32)
+        UnmapViewOfFile(data_);
+#elif defined(DN_IOSTREAM_MMAP)
+        munmap(const_cast<uint8_t *>(data_), size_);
+#endif
+    }
+    else if (backing_ == Backing::Loaded)
+    {
+        IOStream::FreeLoadedData(const_cast<uint8_t *>(data_));
+    }
+    data_ = nullptr;
+    size_ = 0;
+    backing_ = Backing::None;
+}
+
 // --- Lifecycle ---
 
 IOStream::IOStream()
@@ -13,6 +13,7 @@
 
 #include <SDL3/SDL_iostream.h>
 #include <string>
+#include <cstddef>
 #include <cstdint>
 #include <cstdarg>
 
@@ -50,6 +51,89 @@ enum class IOStatus
     Writeonly  ///< Stream is write-only
 };
 
+/**
+ * @brief Expected access pattern of a FileMapping, passed to madvise (or the
+ * matching CreateFile flags on Windows).
+ */
+enum class MapAdvice
+{
+    Normal,     ///< No hint
+    Sequential, ///< Read front to back once; aggressive read-ahead
+    Random,     ///< Scattered reads; no read-ahead
+    WillNeed,   ///< Start reading the whole range in now
+    DontNeed    ///< Done with the range; its pages may be dropped
+};
+
+/**
+ * @class FileMapping
+ * @brief RAII, move-only, read-only view of a whole file.
+ *
+ * Backed by mmap on POSIX systems and MapViewOfFile on Windows, so pages are
+ * read from the page cache on first touch and never copied. Where mapping is
+ * not possible the file is loaded into memory instead; the view behaves the
+ * same either way. An empty file gives a valid view with Size() == 0.
+ *
+ * @see IOStream::MapFile
+ */
+class FileMapping
+{
+  public:
+    FileMapping() = default;
+    ~FileMapping();
+
+    FileMapping(FileMapping &&other) noexcept;
+    FileMapping &operator=(FileMapping &&other) noexcept;
+
+    FileMapping(const FileMapping &) = delete;
+    FileMapping &operator=(const FileMapping &) = delete;
+
+    /** @brief true if the file was opened, even when it is empty. */
+    bool IsValid() const
+    {
+        return backing_ != Backing::None;
+    }
+
+    /** @brief true if the view is a memory mapping rather than a loaded copy. */
+    bool IsMapped() const
+    {
+        return backing_ == Backing::Mapped;
+    }
+
+    const uint8_t *Data() const
+    {
+        return data_;
+    }
+
+    size_t Size() const
+    {
+        return size_;
+    }
+
+    /**
+     * @brief Hints the access pattern for part of the view.
+     *
+     * The range is widened to whole pages. Ignored for loaded copies and on
+     * platforms without madvise.
+     */
+    void Advise(MapAdvice advice, size_t offset = 0, size_t length = SIZE_MAX) const;
+
+  private:
+    friend class IOStream;
+
+    enum class Backing
+    {
+        None,
+        Mapped,
+        Loaded
+    };
+
+    void Release();
+
+    const uint8_t *data_ = nullptr;
+    size_t size_ = 0;
+    Backing backing_ = Backing::None;
+};
+
 /**
  * @class IOStream
  * @brief RAII, move-only wrapper around SDL3's SDL_IOStream.
@@ -205,6 +289,25 @@ class IOStream
      */
     static void FreeLoadedData(void *data);
 
+    /**
+     * @brief Map a whole file read-only into memory.
+     *
+     * @param file Path to the file to map
+     * @param advice Expected access pattern, applied to the whole view
+     * @return FileMapping of the file, or an invalid mapping on failure
+     *
+     * @note Logs DN_CORE_ERROR on failure
+     *
+     * Example:
+     * @code
+     * duin::io::FileMapping view = duin::io::IOStream::MapFile("level.json");
+     * if (view.IsValid()) {
+     *     Parse(reinterpret_cast<const char *>(view.Data()), view.Size());
+     * }
+     * @endcode
+     */
+    static FileMapping MapFile(const std::string &file, MapAdvice advice = MapAdvice::Sequential);
+
     // --- Lifecycle ---
 
     /**
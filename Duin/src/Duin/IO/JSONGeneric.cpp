@@ -0,0 +1,53 @@
+#include "dnpch.h"
+#include "JSONGeneric.h"
+
+#include <cstdint>
+
+namespace duin
+{
+
+rfl::Generic JSONToGeneric(const rapidjson::Value &value)
+{
+    switch (value.GetType())
+    {
+    case rapidjson::kFalseType:
+    case rapidjson::kTrueType:
+        return rfl::Generic(value.GetBool());
+    case rapidjson::kNumberType:
+        if (value.IsInt64())
+        {
+            return rfl::Generic(static_cast<int64_t>(value.GetInt64()));
+        }
+        if (value.IsUint64())
+        {
+            // Above INT64_MAX. Kept as the same bit pattern, which rfl::from_generic casts back
+            // into an unsigned field exactly; a double would lose the low bits.
+            return rfl::Generic(static_cast<int64_t>(value.GetUint64()));
+        }
+        return rfl::Generic(value.GetDouble());
+    case rapidjson::kStringType:
+        return rfl::Generic(std::string(value.GetString(), value.GetStringLength()));
+    case rapidjson::kObjectType: {
+        rfl::Generic::Object object;
+        for (auto it = value.MemberBegin(); it != value.MemberEnd(); ++it)
+        {
+            object.insert(std::string(it->name.GetString(), it->name.GetStringLength()), JSONToGeneric(it->value));
+        }
+        return rfl::Generic(std::move(object));
+    }
+    case rapidjson::kArrayType: {
+        rfl::Generic::Array array;
+        array.reserve(value.Size());
+        for (const rapidjson::Value &element : value.GetArray())
+        {
+            array.push_back(JSONToGeneric(element));
+        }
+        return rfl::Generic(std::move(array));
+    }
+    case rapidjson::kNullType:
+    default:
+        return rfl::Generic(rfl::Generic::Null);
+    }
+}
+
+} // namespace duin
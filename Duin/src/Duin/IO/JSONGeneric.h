@@ -0,0 +1,26 @@
+/**
+ * @file JSONGeneric.h
+ * @brief Reads RapidJSON nodes as reflect-cpp generic values.
+ * @ingroup IO
+ *
+ * Scene loading hands each component's parsed node to rfl::from_generic through
+ * JSONToGeneric, so a component is read without writing its node back to text.
+ * Writing goes the other way, straight from the component (see JSONReflectWriter.h).
+ *
+ * rfl::Generic has a single signed integer type: rfl::to_generic stores a uint64_t
+ * above INT64_MAX as the int64_t with the same bits, and rfl::from_generic casts it
+ * back. JSONToGeneric reads such numbers the same way, so unsigned fields load exactly.
+ */
+
+#pragma once
+
+#include <rfl.hpp>
+#include <rapidjson/document.h>
+
+namespace duin
+{
+
+/** @brief Builds a generic value from a RapidJSON node. */
+rfl::Generic JSONToGeneric(const rapidjson::Value &value);
+
+} // namespace duin
@@ -0,0 +1,238 @@
+/**
+ * @file JSONReflectWriter.h
+ * @brief Writes reflect-cpp types straight into RapidJSON.
+ * @ingroup IO
+ *
+ * JSONReflectWriter is a reflect-cpp Writer that forwards each value rfl visits to a
+ * RapidJSON SAX handler. With a rapidjson::Writer the value streams out as text;
+ * with a rapidjson::Document (through Document::Populate) it is built as a DOM node.
+ * Neither path builds an intermediate JSON string or rfl::Generic tree, and every
+ * integer is written with its own signedness.
+ */
+
+#pragma once
+
+#include <rfl.hpp>
+#include <rfl/json.hpp>
+#include <rfl/parsing/Parent.hpp>
+#include <rfl/parsing/Parser.hpp>
+#include <rapidjson/rapidjson.h>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace duin
+{
+
+/**
+ * @brief reflect-cpp Writer over a RapidJSON SAX handler (rapidjson::Writer or rapidjson::Document).
+ *
+ * If structName is set, it receives the root object's "type" member, as written by
+ * rfl::AddStructName<"type">.
+ */
+template <class Handler>
+class JSONReflectWriter
+{
+  public:
+    struct OutputArrayType
+    {
+        rapidjson::SizeType count = 0;
+    };
+    struct OutputObjectType
+    {
+        rapidjson::SizeType count = 0;
+    };
+    struct OutputVarType
+    {
+    };
+
+    explicit JSONReflectWriter(Handler &handler, std::string *structName = nullptr)
+        : handler_(&handler), structName_(structName)
+    {
+    }
+
+    OutputArrayType array_as_root(const size_t) const noexcept
+    {
+        return StartArray();
+    }
+
+    OutputObjectType object_as_root(const size_t) const noexcept
+    {
+        return StartObject();
+    }
+
+    OutputVarType null_as_root() const noexcept
+    {
+        Check(handler_->Null());
+        return {};
+    }
+
+    template <class T>
+    OutputVarType value_as_root(const T &var) const noexcept
+    {
+        WriteValue(var);
+        return {};
+    }
+
+    OutputArrayType add_array_to_array(const size_t, OutputArrayType *parent) const noexcept
+    {
+        ++parent->count;
+        return StartArray();
+    }
+
+    OutputArrayType add_array_to_object(const std::string_view &name, const size_t,
+                                        OutputObjectType *parent) const noexcept
+    {
+        WriteKey(name, parent);
+        return StartArray();
+    }
+
+    OutputObjectType add_object_to_array(const size_t, OutputArrayType *parent) const noexcept
+    {
+        ++parent->count;
+        return StartObject();
+    }
+
+    OutputObjectType add_object_to_object(const std::string_view &name, const size_t,
+                                          OutputObjectType *parent) const noexcept
+    {
+        WriteKey(name, parent);
+        return StartObject();
+    }
+
+    template <class T>
+    OutputVarType add_value_to_array(const T &var, OutputArrayType *parent) const noexcept
+    {
+        ++parent->count;
+        WriteValue(var);
+        return {};
+    }
+
+    template <class T>
+    OutputVarType add_value_to_object(const std::string_view &name, const T &var,
+                                      OutputObjectType *parent) const noexcept
+    {
+        WriteKey(name, parent);
+        if constexpr (std::is_same_v<std::remove_cvref_t<T>, std::string>)
+        {
+            if (structName_ != nullptr && depth_ == 1 && name == "type")
+            {
+                *structName_ = var;
+            }
+        }
+        WriteValue(var);
+        return {};
+    }
+
+    OutputVarType add_null_to_array(OutputArrayType *parent) const noexcept
+    {
+        ++parent->count;
+        Check(handler_->Null());
+        return {};
+    }
+
+    OutputVarType add_null_to_object(const std::string_view &name, OutputObjectType *parent) const noexcept
+    {
+        WriteKey(name, parent);
+        Check(handler_->Null());
+        return {};
+    }
+
+    void end_array(OutputArrayType *arr) const noexcept
+    {
+        --depth_;
+        Check(handler_->EndArray(arr->count));
+    }
+
+    void end_object(OutputObjectType *obj) const noexcept
+    {
+        --depth_;
+        Check(handler_->EndObject(obj->count));
+    }
+
+    /** @brief False if the handler rejected any event. */
+    bool Succeeded() const
+    {
+        return ok_;
+    }
+
+  private:
+    Handler *handler_;
+    std::string *structName_;
+    mutable int depth_ = 0;
+    mutable bool ok_ = true;
+
+    void Check(bool result) const noexcept
+    {
+        ok_ = ok_ && result;
+    }
+
+    OutputArrayType StartArray() const noexcept
+    {
+        ++depth_;
+        Check(handler_->StartArray());
+        return {};
+    }
+
+    OutputObjectType StartObject() const noexcept
+    {
+        ++depth_;
+        Check(handler_->StartObject());
+        return {};
+    }
+
+    void WriteKey(const std::string_view &name, OutputObjectType *parent) const noexcept
+    {
+        ++parent->count;
+        Check(handler_->Key(name.data(), static_cast<rapidjson::SizeType>(name.size()), true));
+    }
+
+    template <class T>
+    void WriteValue(const T &var) const noexcept
+    {
+        using V = std::remove_cvref_t<T>;
+        if constexpr (std::is_same_v<V, std::string>)
+        {
+            Check(handler_->String(var.c_str(), static_cast<rapidjson::SizeType>(var.size()), true));
+        }
+        else if constexpr (std::is_same_v<V, bool>)
+        {
+            Check(handler_->Bool(var));
+        }
+        else if constexpr (std::is_floating_point_v<V>)
+        {
+            Check(handler_->Double(static_cast<double>(var)));
+        }
+        else if constexpr (std::is_unsigned_v<V>)
+        {
+            Check(handler_->Uint64(static_cast<uint64_t>(var)));
+        }
+        else if constexpr (std::is_integral_v<V>)
+        {
+            Check(handler_->Int64(static_cast<int64_t>(var)));
+        }
+        else
+        {
+            static_assert(rfl::always_false_v<V>, "Unsupported type.");
+        }
+    }
+};
+
+/**
+ * @brief Writes value into handler, applying the reflect-cpp processors Ps (e.g. rfl::AddStructName).
+ * @return False if the handler rejected any event.
+ */
+template <class... Ps, class T, class Handler>
+bool WriteReflectedJSON(const T &value, Handler &handler, std::string *structName = nullptr)
+{
+    using Writer = JSONReflectWriter<Handler>;
+    using ParentType = rfl::parsing::Parent<Writer>;
+    Writer writer(handler, structName);
+    rfl::parsing::Parser<rfl::json::Reader, Writer, T, rfl::Processors<Ps...>>::write(writer, value,
+                                                                                     typename ParentType::Root{});
+    return writer.Succeeded();
+}
+
+} // namespace duin
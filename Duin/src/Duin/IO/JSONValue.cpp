@@ -11,15 +11,30 @@
 
 #include "dnpch.h"
 #include "JSONValue.h"
+#include "IOStream.h"
 #include <Duin/Core/Debug/DNLog.h>
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 #include <rapidjson/prettywriter.h>
-#include <sstream>
-#include <fstream>
+#include <new>
+#include <string_view>
 
 namespace duin
 {
+namespace
+{
+// Never written to: JSONValues referencing it swap in a document of their own first.
+const std::shared_ptr<rapidjson::Document> &EmptyDocument()
+{
+    static const std::shared_ptr<rapidjson::Document> document = [] {
+        auto doc = std::make_shared<rapidjson::Document>();
+        doc->SetObject();
+        return doc;
+    }();
+    return document;
+}
+} // namespace
+
 /* DATAVALUE */
 /**
  * @brief Parses a JSON file into a JSONValue object.
@@ -29,22 +44,18 @@ namespace duin
 JSONValue JSONValue::ParseFromFile(const std::string &filePath)
 {
     DN_CORE_INFO("Attempting to parse {} into JSONValue...", filePath);
-    JSONValue dv;
 
-    std::ifstream ifs(filePath);
-    if (!ifs)
+    io::FileMapping view = io::IOStream::MapFile(filePath, io::MapAdvice::Sequential);
+    if (!view.IsValid())
     {
         DN_CORE_ERROR("Cannot open {}!", filePath);
+        JSONValue dv;
         dv.SetObject();
         return dv;
     }
 
-    std::stringstream buffer;
-    buffer << ifs.rdbuf();
-    std::string content = buffer.str();
-    //DN_CORE_INFO("Content:\n{}", content);
-
-    return Parse(content); // Reuse Parse logic
+    const char *text = view.Data() ? reinterpret_cast<const char *>(view.Data()) : "";
+    return Parse(text, view.Size());
 }
 
 /**
@@ -53,18 +64,29 @@ JSONValue JSONValue::ParseFromFile(const std::string &filePath)
  * @return Parsed JSONValue object.
  */
 JSONValue JSONValue::Parse(const std::string &string)
+{
+    return Parse(string.data(), string.size());
+}
+
+/**
+ * @brief Parses length-delimited JSON text into a JSONValue object.
+ * @param data Start of the JSON text.
+ * @param length Length of the text in bytes.
+ * @return Parsed JSONValue object.
+ */
+JSONValue JSONValue::Parse(const char *data, size_t length)
 {
     JSONValue dv;
 
     dv.jdoc_ = std::make_shared<rapidjson::Document>();
-    dv.jdoc_->Parse(string.c_str());
+    dv.jdoc_->Parse(data, length);
     dv.jvalue_ = dv.jdoc_.get();
 
     // Check for parse errors
     if (dv.jdoc_->HasParseError())
     {
         DN_CORE_ERROR("JSON parsing failed at offset {}: Error code {}, Source {}", dv.jdoc_->GetErrorOffset(),
-                      static_cast<int>(dv.jdoc_->GetParseError()), string);
+                      static_cast<int>(dv.jdoc_->GetParseError()), std::string_view(data, length));
         dv.SetObject(); // Default to empty object on error
         return dv;
     }
@@ -104,9 +126,29 @@ JSONValue JSONValue::Parse(const std::string &string)
  */
 rapidjson::Value &JSONValue::GetRJSONValue()
 {
+    DetachFromEmpty();
     return *jvalue_;
 }
 
+/**
+ * @brief Returns underlying RapidJSON value for reading.
+ * @return Const reference to RapidJSON value.
+ */
+const rapidjson::Value &JSONValue::GetRJSONValue() const
+{
+    return *jvalue_;
+}
+
+/**
+ * @brief Returns the allocator of the document this value belongs to.
+ * @return Reference to the RapidJSON allocator.
+ */
+rapidjson::Document::AllocatorType &JSONValue::GetAllocator()
+{
+    DetachFromEmpty();
+    return jdoc_->GetAllocator();
+}
+
 /**
  * @brief Serializes a JSONValue to a string.
  * @param value JSONValue to serialize.
@@ -144,11 +186,34 @@ std::string JSONValue::Write(const JSONValue &value, bool prettyWrite)
  */
 JSONValue JSONValue::Invalid()
 {
-    JSONValue v;
+    JSONValue v = SharedEmpty();
     v.INVALID_ = true;
     return v;
 }
 
+/**
+ * @brief Returns a view of the shared, always-empty object used for failed lookups.
+ * @return JSONValue referencing the shared empty document.
+ */
+JSONValue JSONValue::SharedEmpty()
+{
+    const std::shared_ptr<rapidjson::Document> &emptyDocument = EmptyDocument();
+    return JSONValue(emptyDocument, emptyDocument.get());
+}
+
+/**
+ * @brief Replaces the shared empty document with a fresh one before a write.
+ */
+void JSONValue::DetachFromEmpty()
+{
+    if (jdoc_ == EmptyDocument())
+    {
+        jdoc_ = std::make_shared<rapidjson::Document>();
+        jdoc_->SetObject();
+        jvalue_ = jdoc_.get();
+    }
+}
+
 /**
  * @brief Default constructor. Creates an empty JSON object.
  */
@@ -247,6 +312,50 @@ JSONValue JSONValue::Clone() const
     return JSONValue(newDoc, newDoc.get());
 }
 
+/**
+ * @brief Creates an empty object in this value's document, not yet attached to it.
+ * @return Detached object sharing this document.
+ */
+JSONValue JSONValue::NewObject()
+{
+    return NewDetached(rapidjson::kObjectType);
+}
+
+/**
+ * @brief Creates an empty array in this value's document, not yet attached to it.
+ * @return Detached array sharing this document.
+ */
+JSONValue JSONValue::NewArray()
+{
+    return NewDetached(rapidjson::kArrayType);
+}
+
+/**
+ * @brief Allocates a detached value of the given type in this document's memory pool.
+ * @param type RapidJSON type of the new value.
+ * @return Detached JSONValue sharing this document.
+ */
+JSONValue JSONValue::NewDetached(rapidjson::Type type)
+{
+    DetachFromEmpty();
+    // The pool hands out aligned memory and frees it with the document; values in it
+    // need no destructor since all their storage comes from the same pool.
+    void *memory = jdoc_->GetAllocator().Malloc(sizeof(rapidjson::Value));
+    JSONValue child(jdoc_, new (memory) rapidjson::Value(type));
+    child.DETACHED_ = true;
+    return child;
+}
+
+/**
+ * @brief True if dv can be moved into this value's document without copying.
+ * @param dv Candidate value.
+ * @return True if dv is detached, shares this document and is not this value.
+ */
+bool JSONValue::CanAdopt(const JSONValue &dv) const
+{
+    return dv.DETACHED_ && dv.jdoc_ == jdoc_ && dv.jvalue_ != jvalue_;
+}
+
 /**
  * @brief Checks if the JSONValue is valid for reading.
  * @return True if valid.
@@ -304,29 +413,30 @@ JSONValue JSONValue::GetMember(const std::string &member) const
         if (!jvalue_->IsObject())
         {
             DN_CORE_WARN("JSONValue is not an Object!");
-            return JSONValue();
+            return SharedEmpty();
         }
         if (!jvalue_->HasMember(member.c_str()))
         {
             DN_CORE_WARN("JSONValue does not contain member {}!", member);
-            return JSONValue();
+            return SharedEmpty();
         }
         rapidjson::Value &value = (*jvalue_)[member.c_str()];
         return JSONValue(jdoc_, &value);
     }
     DN_CORE_WARN("JSONValue is empty!");
-    return JSONValue();
+    return SharedEmpty();
 }
 
 /**
- * @brief Adds a member to the object.
+ * @brief Adds a deep copy of dv as a member of the object.
  * @param key Member name.
  * @param dv Value to add.
  * @param allowDuplicates If false, removes existing member first.
  * @return Reference to this JSONValue.
  */
-JSONValue &JSONValue::AddMember(const std::string &key, JSONValue dv, bool allowDuplicates)
+JSONValue &JSONValue::AddMember(const std::string &key, const JSONValue &dv, bool allowDuplicates)
 {
+    DetachFromEmpty();
     if (!jvalue_->IsObject())
     {
         DN_CORE_WARN("JSONValue not an Object, cannot add nested member!");
@@ -341,13 +451,45 @@ JSONValue &JSONValue::AddMember(const std::string &key, JSONValue dv, bool allow
     rapidjson::Value name(key.c_str(), static_cast<rapidjson::SizeType>(key.size()), jdoc_->GetAllocator());
 
     rapidjson::Value nodeCopy;
-    nodeCopy.CopyFrom(dv.GetRJSONValue(), jdoc_->GetAllocator());
+    nodeCopy.CopyFrom(*dv.jvalue_, jdoc_->GetAllocator());
 
     jvalue_->AddMember(std::move(name), std::move(nodeCopy), jdoc_->GetAllocator());
 
     return *this;
 }
 
+/**
+ * @brief Adds a member to the object, moving dv in when it shares this document.
+ * @param key Member name.
+ * @param dv Value to add.
+ * @param allowDuplicates If false, removes existing member first.
+ * @return Reference to this JSONValue.
+ */
+JSONValue &JSONValue::AddMember(const std::string &key, JSONValue &&dv, bool allowDuplicates)
+{
+    if (!CanAdopt(dv))
+    {
+        return AddMember(key, static_cast<const JSONValue &>(dv), allowDuplicates);
+    }
+    if (!jvalue_->IsObject())
+    {
+        DN_CORE_WARN("JSONValue not an Object, cannot add nested member!");
+        return *this;
+    }
+
+    if (!allowDuplicates)
+    {
+        RemoveMember(key.c_str());
+    }
+
+    rapidjson::Value name(key.c_str(), static_cast<rapidjson::SizeType>(key.size()), jdoc_->GetAllocator());
+    jvalue_->AddMember(std::move(name), std::move(*dv.jvalue_), jdoc_->GetAllocator());
+
+    dv.jvalue_ = &(jvalue_->MemberEnd() - 1)->value;
+    dv.DETACHED_ = false;
+    return *this;
+}
+
 /**
  * @brief Removes a member from the object.
  * @param keyStr Member name.
@@ -812,6 +954,7 @@ JSONValue::ConstDataIterator JSONValue::FindMember(const std::string &member) co
  */
 JSONValue JSONValue::SetObject()
 {
+    DetachFromEmpty();
     jvalue_->SetObject();
     return *this;
 }
@@ -823,6 +966,7 @@ JSONValue JSONValue::SetObject()
  */
 JSONValue JSONValue::SetInt(int x)
 {
+    DetachFromEmpty();
     jvalue_->SetInt(x);
     return *this;
 }
@@ -834,6 +978,7 @@ JSONValue JSONValue::SetInt(int x)
  */
 JSONValue JSONValue::SetString(const std::string &text)
 {
+    DetachFromEmpty();
     jvalue_->SetString(text.c_str(), static_cast<rapidjson::SizeType>(text.size()), jdoc_->GetAllocator());
     return *this;
 }
@@ -845,6 +990,7 @@ JSONValue JSONValue::SetString(const std::string &text)
  */
 JSONValue JSONValue::SetDouble(double x)
 {
+    DetachFromEmpty();
     jvalue_->SetDouble(x);
     return *this;
 }
@@ -856,6 +1002,7 @@ JSONValue JSONValue::SetDouble(double x)
  */
 JSONValue JSONValue::SetBool(bool b)
 {
+    DetachFromEmpty();
     jvalue_->SetBool(b);
     return *this;
 }
@@ -866,16 +1013,17 @@ JSONValue JSONValue::SetBool(bool b)
  */
 JSONValue JSONValue::SetArray()
 {
+    DetachFromEmpty();
     jvalue_->SetArray();
     return *this;
 }
 
 /**
- * @brief Adds a shallow copy of dv to array-type JSONValue.
+ * @brief Adds a deep copy of dv to array-type JSONValue.
  * @param dv Value to add.
  * @return Reference to this JSONValue.
  */
-JSONValue &JSONValue::PushBack(JSONValue dv)
+JSONValue &JSONValue::PushBack(const JSONValue &dv)
 {
     if (!jvalue_->IsArray())
     {
@@ -884,11 +1032,34 @@ JSONValue &JSONValue::PushBack(JSONValue dv)
     }
     auto &alloc = jdoc_->GetAllocator();
     rapidjson::Value node;
-    node.CopyFrom(dv.GetRJSONValue(), alloc);
+    node.CopyFrom(*dv.jvalue_, alloc);
     jvalue_->PushBack(std::move(node), alloc);
     return *this;
 }
 
+/**
+ * @brief Adds dv to array-type JSONValue, moving it in when it shares this document.
+ * @param dv Value to add.
+ * @return Reference to this JSONValue.
+ */
+JSONValue &JSONValue::PushBack(JSONValue &&dv)
+{
+    if (!CanAdopt(dv))
+    {
+        return PushBack(static_cast<const JSONValue &>(dv));
+    }
+    if (!jvalue_->IsArray())
+    {
+        DN_CORE_WARN("JSONValue is not an array!");
+        return *this;
+    }
+    jvalue_->PushBack(std::move(*dv.jvalue_), jdoc_->GetAllocator());
+
+    dv.jvalue_ = &(*jvalue_)[jvalue_->Size() - 1];
+    dv.DETACHED_ = false;
+    return *this;
+}
+
 /**
  * @brief Accesses a member by name.
  * @param member Member name.
@@ -901,18 +1072,18 @@ JSONValue JSONValue::operator[](const std::string &member)
         if (!jvalue_->IsObject())
         {
             DN_CORE_WARN("JSONValue is not an Object!");
-            return JSONValue();
+            return SharedEmpty();
         }
         if (!jvalue_->HasMember(member.c_str()))
         {
             DN_CORE_WARN("JSONValue does not contain member {}!", member);
-            return JSONValue();
+            return SharedEmpty();
         }
         rapidjson::Value &value = (*jvalue_)[member.c_str()];
         return JSONValue(jdoc_, &value);
     }
     DN_CORE_WARN("JSONValue is empty!");
-    return JSONValue();
+    return SharedEmpty();
 }
 
 /**
@@ -933,11 +1104,11 @@ JSONValue JSONValue::operator[](int idx)
         else
         {
             DN_CORE_WARN("JSONValue not array, cannot dereference!");
-            return JSONValue();
+            return SharedEmpty();
         }
     };
     DN_CORE_WARN("JSONValue is empty!");
-    return JSONValue();
+    return SharedEmpty();
 }
 
 /**
@@ -1025,7 +1196,7 @@ JSONValue JSONValue::DataIterator::GetValue()
         return value;
     }
     DN_CORE_WARN("DataIterator not valid!");
-    return JSONValue();
+    return SharedEmpty();
 }
 
 /**
@@ -1039,7 +1210,7 @@ JSONValue JSONValue::DataIterator::operator*() const
         return JSONValue(readDocument_, &(*it_));
     }
     DN_CORE_WARN("DataIterator invalid, cannot dereference!");
-    return JSONValue();
+    return SharedEmpty();
 }
 
 /**
@@ -1129,7 +1300,7 @@ const JSONValue JSONValue::ConstDataIterator::GetValue()
         return value;
     }
     DN_CORE_WARN("ConstDataIterator not valid!");
-    return JSONValue();
+    return SharedEmpty();
 }
 
 /**
@@ -1143,7 +1314,7 @@ JSONValue JSONValue::ConstDataIterator::operator*() const
         return JSONValue(readDocument_, &(*it_));
     }
     DN_CORE_WARN("ConstDataIterator invalid, cannot dereference!");
-    return JSONValue();
+    return SharedEmpty();
 }
 
 /**
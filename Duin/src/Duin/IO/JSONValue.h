@@ -188,6 +188,10 @@ class JSONValue
 
     /**
      * @brief Parses a JSON file into a JSONValue object.
+     *
+     * The file is memory-mapped and parsed straight from the mapping, without
+     * reading it into an intermediate string.
+     *
      * @param data JSON filepath to parse.
      * @return Parsed JSONValue object.
      */
@@ -200,6 +204,14 @@ class JSONValue
      */
     static JSONValue Parse(const std::string &string);
 
+    /**
+     * @brief Parses JSON text that is not NUL-terminated, such as a FileMapping view.
+     * @param data Start of the JSON text.
+     * @param length Length of the text in bytes.
+     * @return Parsed JSONValue object. The text is not referenced after parsing.
+     */
+    static JSONValue Parse(const char *data, size_t length);
+
     /**
      * @brief Serializes a JSONValue to a string.
      * @param value JSONValue to serialize.
@@ -210,6 +222,9 @@ class JSONValue
 
     /**
      * @brief Returns an invalid JSONValue instance.
+     *
+     * Shares a static empty document instead of allocating one.
+     *
      * @return Invalid JSONValue.
      */
     static JSONValue Invalid();
@@ -251,6 +266,18 @@ class JSONValue
      */
     rapidjson::Value &GetRJSONValue();
 
+    /**
+     * @brief Returns underlying RapidJSON value for reading.
+     * @return Const reference to RapidJSON value.
+     */
+    const rapidjson::Value &GetRJSONValue() const;
+
+    /**
+     * @brief Returns the allocator of the document this value belongs to.
+     * @return Reference to the RapidJSON allocator.
+     */
+    rapidjson::Document::AllocatorType &GetAllocator();
+
     /**
      * @brief Serializes this JSONValue to a string.
      * @return JSON string.
@@ -263,6 +290,24 @@ class JSONValue
      */
     JSONValue Clone() const;
 
+    /**
+     * @brief Creates an empty object in this value's document, not yet attached to it.
+     *
+     * The child uses the document's allocator, so adding it with AddMember(key, std::move(child))
+     * or PushBack(std::move(child)) moves it into place instead of deep-copying it. Until then it
+     * lives, unreachable, in the document's memory pool.
+     *
+     * @return Detached object sharing this document.
+     */
+    JSONValue NewObject();
+
+    /**
+     * @brief Creates an empty array in this value's document, not yet attached to it.
+     * @see NewObject()
+     * @return Detached array sharing this document.
+     */
+    JSONValue NewArray();
+
     /**
      * @brief Checks if the JSONValue is valid for reading.
      * @return True if valid.
@@ -284,13 +329,27 @@ class JSONValue
     JSONValue GetMember(const std::string &member) const;
 
     /**
-     * @brief Adds a member to the object.
+     * @brief Adds a deep copy of dv as a member of the object.
      * @param key Member name.
      * @param dv Value to add.
      * @param allowDuplicates If false, removes existing member first.
      * @return Reference to this JSONValue.
      */
-    JSONValue &AddMember(const std::string &key, JSONValue dv, bool allowDuplicates = false);
+    JSONValue &AddMember(const std::string &key, const JSONValue &dv, bool allowDuplicates = false);
+
+    /**
+     * @brief Adds a member to the object, moving dv in when it was created by NewObject()/NewArray()
+     * on this document.
+     *
+     * Other values are deep-copied, as with the const overload. After a move, dv refers to the
+     * added member.
+     *
+     * @param key Member name.
+     * @param dv Value to add.
+     * @param allowDuplicates If false, removes existing member first.
+     * @return Reference to this JSONValue.
+     */
+    JSONValue &AddMember(const std::string &key, JSONValue &&dv, bool allowDuplicates = false);
 
     /**
      * @brief Removes a member from the object.
@@ -392,11 +451,22 @@ class JSONValue
     bool Empty() const;
 
     /**
-     * @brief Adds a shallow copy of dv to array-type JSONValue.
+     * @brief Adds a deep copy of dv to array-type JSONValue.
+     * @param dv Value to add.
+     * @return Reference to this JSONValue.
+     */
+    JSONValue &PushBack(const JSONValue &dv);
+
+    /**
+     * @brief Adds dv to array-type JSONValue, moving it in when it was created by
+     * NewObject()/NewArray() on this document.
+     *
+     * Other values are deep-copied. After a move, dv refers to the new element.
+     *
      * @param dv Value to add.
      * @return Reference to this JSONValue.
      */
-    JSONValue &PushBack(JSONValue dv);
+    JSONValue &PushBack(JSONValue &&dv);
 
     /**
      * @brief Gets the capacity of the array.
@@ -474,6 +544,7 @@ class JSONValue
     template <typename T>
     JSONValue &AddMember(const std::string &key, T val, bool allowDuplicates = false) // Add Key:Value member to object
     {
+        DetachFromEmpty();
         if (!jvalue_->IsObject())
         {
             DN_CORE_WARN("JSONValue not an Object, cannot add member!");
@@ -523,7 +594,7 @@ class JSONValue
             return *this;
         }
         DN_CORE_WARN("JSONValue is not an array!");
-        return JSONValue();
+        return SharedEmpty();
     }
 
     /**
@@ -583,9 +654,33 @@ class JSONValue
 
   private:
     bool INVALID_ = false;                      ///< True if this JSONValue is invalid.
+    bool DETACHED_ = false;                     ///< True if made by NewObject/NewArray and not yet added.
     std::shared_ptr<rapidjson::Document> jdoc_; ///< Underlying RapidJSON document.
     rapidjson::Value *jvalue_;                  ///< Pointer to RapidJSON value.
 
+    /**
+     * @brief Returns a view of the shared, always-empty object used for failed lookups.
+     *
+     * Mutating calls on such a view first give it a document of its own (DetachFromEmpty),
+     * so the shared object is never written to.
+     */
+    static JSONValue SharedEmpty();
+
+    /**
+     * @brief Replaces the shared empty document with a fresh one before a write.
+     */
+    void DetachFromEmpty();
+
+    /**
+     * @brief Allocates a detached value of the given type in this document's memory pool.
+     */
+    JSONValue NewDetached(rapidjson::Type type);
+
+    /**
+     * @brief True if dv can be moved into this value's document without copying.
+     */
+    bool CanAdopt(const JSONValue &dv) const;
+
     /**
      * @brief Internal constructor for subvalue referencing.
      * @param document Shared pointer to RapidJSON document.
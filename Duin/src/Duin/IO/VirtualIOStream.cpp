@@ -28,6 +28,17 @@ void *LoadFile(const std::string &virtualPath, size_t *datasize)
     return io::IOStream::LoadFile(resolved, datasize);
 }
 
+io::FileMapping MapFile(const std::string &virtualPath, io::MapAdvice advice)
+{
+    std::string resolved = fs::MapVirtualToSystemPath(virtualPath);
+    if (fs::IsPathInvalid(resolved))
+    {
+        DN_CORE_ERROR("vio::MapFile: invalid virtual path '{}'", virtualPath);
+        return io::FileMapping();
+    }
+    return io::IOStream::MapFile(resolved, advice);
+}
+
 bool SaveFile(const std::string &virtualPath, const void *data, size_t datasize)
 {
     std::string resolved = fs::MapVirtualToSystemPath(virtualPath);
@@ -44,4 +55,29 @@ void FreeLoadedData(void *data)
     io::IOStream::FreeLoadedData(data);
 }
 
+io::AsyncIORequestId ReadFileAsync(const std::string &virtualPath, io::AsyncIOCallback callback,
+                                   io::AsyncIOPriority priority, io::AsyncIOPhase phase)
+{
+    std::string resolved = fs::MapVirtualToSystemPath(virtualPath);
+    if (fs::IsPathInvalid(resolved))
+    {
+        DN_CORE_ERROR("vio::ReadFileAsync: invalid virtual path '{}'", virtualPath);
+        return io::ASYNCIO_INVALID_REQUEST;
+    }
+    return io::AsyncIOStream::Get().ReadFile(resolved, std::move(callback), priority, phase);
+}
+
+io::AsyncIORequestId WriteFileAsync(const std::string &virtualPath, std::vector<uint8_t> data,
+                                    io::AsyncIOCallback callback, io::AsyncIOPriority priority,
+                                    io::AsyncIOPhase phase)
+{
+    std::string resolved = fs::MapVirtualToSystemPath(virtualPath);
+    if (fs::IsPathInvalid(resolved))
+    {
+        DN_CORE_ERROR("vio::WriteFileAsync: invalid virtual path '{}'", virtualPath);
+        return io::ASYNCIO_INVALID_REQUEST;
+    }
+    return io::AsyncIOStream::Get().WriteFile(resolved, std::move(data), std::move(callback), priority, phase);
+}
+
 } // namespace duin::vio
@@ -14,7 +14,9 @@
 #pragma once
 
 #include <Duin/IO/IOStream.h>
+#include <Duin/IO/AsyncIOStream.h>
 #include <string>
+#include <vector>
 
 namespace duin::vio
 {
@@ -48,6 +50,20 @@ io::IOStream FromFile(const std::string &virtualPath, const std::string &mode);
  */
 void *LoadFile(const std::string &virtualPath, size_t *datasize);
 
+/**
+ * @brief Map a virtual file read-only into memory.
+ *
+ * Resolves the virtual path to a system path, then maps the whole file.
+ *
+ * @param virtualPath Virtual path to the file (e.g., "bin://scenes/level.json")
+ * @param advice Expected access pattern, applied to the whole view
+ * @return FileMapping of the file, or an invalid mapping on failure
+ *
+ * @see io::IOStream::MapFile
+ * @see fs::MapVirtualToSystemPath
+ */
+io::FileMapping MapFile(const std::string &virtualPath, io::MapAdvice advice = io::MapAdvice::Sequential);
+
 /**
  * @brief Save data to a virtual file path.
  *
@@ -75,4 +91,40 @@ bool SaveFile(const std::string &virtualPath, const void *data, size_t datasize)
  */
 void FreeLoadedData(void *data);
 
+/**
+ * @brief Read a whole virtual file without blocking.
+ *
+ * Resolves the virtual path, then queues the read on the engine-wide
+ * io::AsyncIOStream. The callback runs on the main thread during `phase`.
+ *
+ * @param virtualPath Virtual path to the file (e.g., "bin://scenes/level.json")
+ * @param callback Receives the file contents, or a Failed/Cancelled status
+ * @param priority Position in the I/O queue
+ * @param phase Frame phase in which the callback runs
+ * @return Request id for io::AsyncIOStream::Cancel(), or ASYNCIO_INVALID_REQUEST if the
+ *         path is invalid (the callback is then never called)
+ *
+ * @see io::AsyncIOStream::ReadFile
+ */
+io::AsyncIORequestId ReadFileAsync(const std::string &virtualPath, io::AsyncIOCallback callback,
+                                   io::AsyncIOPriority priority = io::AsyncIOPriority::Normal,
+                                   io::AsyncIOPhase phase = io::AsyncIOPhase::PreFrame);
+
+/**
+ * @brief Write a whole virtual file without blocking.
+ *
+ * @param virtualPath Virtual path to the file (e.g., "usr://saves/slot0.bin")
+ * @param data Bytes to write; the request owns them until it completes
+ * @param callback Receives the outcome, may be empty
+ * @param priority Position in the I/O queue
+ * @param phase Frame phase in which the callback runs
+ * @return Request id, or ASYNCIO_INVALID_REQUEST if the path is invalid
+ *
+ * @see io::AsyncIOStream::WriteFile
+ */
+io::AsyncIORequestId WriteFileAsync(const std::string &virtualPath, std::vector<uint8_t> data,
+                                    io::AsyncIOCallback callback = {},
+                                    io::AsyncIOPriority priority = io::AsyncIOPriority::Normal,
+                                    io::AsyncIOPhase phase = io::AsyncIOPhase::PreFrame);
+
 } // namespace duin::vio
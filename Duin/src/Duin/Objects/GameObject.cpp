@@ -313,6 +313,7 @@ void duin::GameObject::EnableOnEvent(bool enable)
     if (impl)
     {
         impl->onEventEnabled = enable;
+        impl->InvalidateDispatchList();
     }
 }
 
@@ -321,6 +322,7 @@ void duin::GameObject::EnableUpdate(bool enable)
     if (impl)
     {
         impl->updateEnabled = enable;
+        impl->InvalidateDispatchList();
     }
 }
 
@@ -329,6 +331,7 @@ void duin::GameObject::EnablePhysicsUpdate(bool enable)
     if (impl)
     {
         impl->physicsUpdateEnabled = enable;
+        impl->InvalidateDispatchList();
     }
 }
 
@@ -337,6 +340,7 @@ void duin::GameObject::EnableDraw(bool enable)
     if (impl)
     {
         impl->drawEnabled = enable;
+        impl->InvalidateDispatchList();
     }
 }
 
@@ -345,6 +349,7 @@ void duin::GameObject::EnableDrawUI(bool enable)
     if (impl)
     {
         impl->drawUIEnabled = enable;
+        impl->InvalidateDispatchList();
     }
 }
 
@@ -353,6 +358,7 @@ void duin::GameObject::EnableDebug(bool enable)
     if (impl)
     {
         impl->debugEnabled = enable;
+        impl->InvalidateDispatchList();
     }
 }
 
@@ -361,9 +367,27 @@ void duin::GameObject::EnableChildren(bool enable)
     if (impl)
     {
         impl->childrenEnabled = enable;
+        impl->InvalidateDispatchList();
     }
 }
 
+void duin::GameObject::EnableFlatDispatch(bool enable)
+{
+    if (impl)
+    {
+        impl->SetFlatDispatch(enable);
+    }
+}
+
+bool duin::GameObject::IsFlatDispatchEnabled() const
+{
+    if (impl)
+    {
+        return impl->IsFlatDispatch();
+    }
+    return false;
+}
+
 bool duin::GameObject::IsOnEventEnabled() const
 {
     if (impl)
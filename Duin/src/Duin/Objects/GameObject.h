@@ -167,6 +167,16 @@ class GameObject
     void EnableChildren(bool enable);
     /** @} */
 
+    /**
+     * @brief Dispatches this subtree from a flat, depth-first list instead of recursing.
+     *
+     * Meant for large, mostly static hierarchies such as the root object. The
+     * callback order and enable rules are unchanged. Children added, removed or
+     * re-enabled from inside a callback take effect from the next frame.
+     */
+    void EnableFlatDispatch(bool enable);
+    bool IsFlatDispatchEnabled() const;
+
     /**
      * @name Query Callback State
      * Check which callbacks are currently enabled.
@@ -3,6 +3,8 @@
 #include "GameObject.h"
 #include "Duin/Core/Debug/DNLog.h"
 
+#include <bit>
+
 duin::GameObjectImpl::GameObjectImpl(GameObject *owner) : owner(owner), uuid(UUID())
 {
     DN_CORE_INFO("Construct GameObjectImpl");
@@ -29,8 +31,10 @@ bool duin::GameObjectImpl::IsReady() const
 
 void duin::GameObjectImpl::AddChild(std::shared_ptr<GameObjectImpl> childImpl, std::shared_ptr<GameObject> childOwner)
 {
+    childImpl->parentImpl = this;
     childImpls.push_back(std::move(childImpl));
     childOwners.push_back(std::move(childOwner));
+    InvalidateDispatchList();
 }
 
 void duin::GameObjectImpl::RemoveChild(const std::shared_ptr<GameObjectImpl> &childImpl)
@@ -42,6 +46,7 @@ void duin::GameObjectImpl::RemoveChild(const std::shared_ptr<GameObjectImpl> &ch
             childImpls.erase(childImpls.begin() + i);
             childOwners.erase(childOwners.begin() + i);
             childImpl->parentImpl = nullptr;
+            InvalidateDispatchList();
             return;
         }
     }
@@ -78,8 +83,40 @@ void duin::GameObjectImpl::DispatchReady()
     isReady = true;
 }
 
+template <typename Fn>
+void duin::GameObjectImpl::ForEachFlat(DispatchPhase phase, Fn &&fn)
+{
+    struct DepthGuard
+    {
+        uint32_t &depth;
+        ~DepthGuard()
+        {
+            --depth;
+        }
+    } guard{++dispatchDepth};
+
+    const std::vector<uint64_t> &bits = dispatchList->enabled[phase];
+    GameObjectImpl *const *nodes = dispatchList->nodes.data();
+    for (size_t word = 0; word < bits.size(); ++word)
+    {
+        uint64_t set = bits[word];
+        while (set)
+        {
+            size_t index = word * 64 + static_cast<size_t>(std::countr_zero(set));
+            set &= set - 1;
+            fn(*nodes[index]);
+        }
+    }
+}
+
 void duin::GameObjectImpl::DispatchOnEvent(Event event)
 {
+    if (PrepareDispatchList())
+    {
+        ForEachFlat(PHASE_ON_EVENT, [&event](GameObjectImpl &node) { node.NotifyOnEvent(event); });
+        return;
+    }
+
     if (childrenEnabled)
     {
         for (auto &child : childImpls)
@@ -91,13 +128,17 @@ void duin::GameObjectImpl::DispatchOnEvent(Event event)
         }
     }
 
-    OnObjectOnEvent.Emit(event);
-    if (owner)
-        owner->OnEvent(event);
+    NotifyOnEvent(event);
 }
 
 void duin::GameObjectImpl::DispatchUpdate(double delta)
 {
+    if (PrepareDispatchList())
+    {
+        ForEachFlat(PHASE_UPDATE, [delta](GameObjectImpl &node) { node.NotifyUpdate(delta); });
+        return;
+    }
+
     if (childrenEnabled)
     {
         for (auto &child : childImpls)
@@ -109,13 +150,17 @@ void duin::GameObjectImpl::DispatchUpdate(double delta)
         }
     }
 
-    OnObjectUpdate.Emit(delta);
-    if (owner)
-        owner->Update(delta);
+    NotifyUpdate(delta);
 }
 
 void duin::GameObjectImpl::DispatchPhysicsUpdate(double delta)
 {
+    if (PrepareDispatchList())
+    {
+        ForEachFlat(PHASE_PHYSICS_UPDATE, [delta](GameObjectImpl &node) { node.NotifyPhysicsUpdate(delta); });
+        return;
+    }
+
     if (childrenEnabled)
     {
         for (auto &child : childImpls)
@@ -127,13 +172,17 @@ void duin::GameObjectImpl::DispatchPhysicsUpdate(double delta)
         }
     }
 
-    OnObjectPhysicsUpdate.Emit(delta);
-    if (owner)
-        owner->PhysicsUpdate(delta);
+    NotifyPhysicsUpdate(delta);
 }
 
 void duin::GameObjectImpl::DispatchDraw()
 {
+    if (PrepareDispatchList())
+    {
+        ForEachFlat(PHASE_DRAW, [](GameObjectImpl &node) { node.NotifyDraw(); });
+        return;
+    }
+
     if (childrenEnabled)
     {
         for (auto &child : childImpls)
@@ -145,13 +194,17 @@ void duin::GameObjectImpl::DispatchDraw()
         }
     }
 
-    OnObjectDraw.Emit();
-    if (owner)
-        owner->Draw();
+    NotifyDraw();
 }
 
 void duin::GameObjectImpl::DispatchDrawUI()
 {
+    if (PrepareDispatchList())
+    {
+        ForEachFlat(PHASE_DRAW_UI, [](GameObjectImpl &node) { node.NotifyDrawUI(); });
+        return;
+    }
+
     if (childrenEnabled)
     {
         for (auto &child : childImpls)
@@ -163,13 +216,17 @@ void duin::GameObjectImpl::DispatchDrawUI()
         }
     }
 
-    OnObjectDrawUI.Emit();
-    if (owner)
-        owner->DrawUI();
+    NotifyDrawUI();
 }
 
 void duin::GameObjectImpl::DispatchDebug()
 {
+    if (PrepareDispatchList())
+    {
+        ForEachFlat(PHASE_DEBUG, [](GameObjectImpl &node) { node.NotifyDebug(); });
+        return;
+    }
+
     if (childrenEnabled)
     {
         for (auto &child : childImpls)
@@ -181,7 +238,140 @@ void duin::GameObjectImpl::DispatchDebug()
         }
     }
 
+    NotifyDebug();
+}
+
+void duin::GameObjectImpl::NotifyOnEvent(const Event &event)
+{
+    OnObjectOnEvent.Emit(event);
+    if (owner)
+        owner->OnEvent(event);
+}
+
+void duin::GameObjectImpl::NotifyUpdate(double delta)
+{
+    OnObjectUpdate.Emit(delta);
+    if (owner)
+        owner->Update(delta);
+}
+
+void duin::GameObjectImpl::NotifyPhysicsUpdate(double delta)
+{
+    OnObjectPhysicsUpdate.Emit(delta);
+    if (owner)
+        owner->PhysicsUpdate(delta);
+}
+
+void duin::GameObjectImpl::NotifyDraw()
+{
+    OnObjectDraw.Emit();
+    if (owner)
+        owner->Draw();
+}
+
+void duin::GameObjectImpl::NotifyDrawUI()
+{
+    OnObjectDrawUI.Emit();
+    if (owner)
+        owner->DrawUI();
+}
+
+void duin::GameObjectImpl::NotifyDebug()
+{
     OnObjectDebug.Emit();
     if (owner)
         owner->Debug();
 }
+
+void duin::GameObjectImpl::SetFlatDispatch(bool enable)
+{
+    if (enable && !dispatchList)
+    {
+        dispatchList = std::make_unique<DispatchList>();
+        dispatchDirty = true;
+    }
+    else if (!enable && dispatchDepth == 0)
+    {
+        dispatchList.reset();
+    }
+    else if (!enable)
+    {
+        DN_CORE_WARN("Cannot disable flat dispatch while it is running.");
+    }
+}
+
+bool duin::GameObjectImpl::IsFlatDispatch() const
+{
+    return dispatchList != nullptr;
+}
+
+void duin::GameObjectImpl::InvalidateDispatchList()
+{
+    for (GameObjectImpl *node = this; node; node = node->parentImpl)
+    {
+        node->dispatchDirty = true;
+    }
+}
+
+size_t duin::GameObjectImpl::GetDispatchListSize() const
+{
+    return dispatchList ? dispatchList->nodes.size() : 0;
+}
+
+uint8_t duin::GameObjectImpl::GetPhaseMask() const
+{
+    return static_cast<uint8_t>((onEventEnabled ? 1u << PHASE_ON_EVENT : 0u) |
+                                (updateEnabled ? 1u << PHASE_UPDATE : 0u) |
+                                (physicsUpdateEnabled ? 1u << PHASE_PHYSICS_UPDATE : 0u) |
+                                (drawEnabled ? 1u << PHASE_DRAW : 0u) | (drawUIEnabled ? 1u << PHASE_DRAW_UI : 0u) |
+                                (debugEnabled ? 1u << PHASE_DEBUG : 0u));
+}
+
+bool duin::GameObjectImpl::PrepareDispatchList()
+{
+    if (!dispatchList)
+        return false;
+
+    if (dispatchDirty)
+    {
+        // A dispatch issued from inside a running pass must not reallocate the list
+        // under it; that nested call takes the recursive path instead.
+        if (dispatchDepth > 0)
+            return false;
+
+        dispatchList->nodes.clear();
+        dispatchList->keepAlive.clear();
+        for (auto &bits : dispatchList->enabled)
+            bits.clear();
+
+        // The root's own enable flags are checked by its parent, not by itself.
+        AppendDispatchNodes(this, static_cast<uint8_t>((1u << PHASE_COUNT) - 1));
+        dispatchDirty = false;
+    }
+    return true;
+}
+
+void duin::GameObjectImpl::AppendDispatchNodes(GameObjectImpl *node, uint8_t mask)
+{
+    // Children first, matching the recursive dispatch order.
+    uint8_t childMask = node->childrenEnabled ? mask : 0;
+    for (auto &child : node->childImpls)
+    {
+        if (child)
+        {
+            dispatchList->keepAlive.push_back(child);
+            AppendDispatchNodes(child.get(), childMask & child->GetPhaseMask());
+        }
+    }
+
+    size_t index = dispatchList->nodes.size();
+    dispatchList->nodes.push_back(node);
+    for (uint8_t phase = 0; phase < PHASE_COUNT; ++phase)
+    {
+        auto &bits = dispatchList->enabled[phase];
+        if (bits.size() * 64 <= index)
+            bits.push_back(0);
+        if (mask & (1u << phase))
+            bits[index / 64] |= uint64_t(1) << (index % 64);
+    }
+}
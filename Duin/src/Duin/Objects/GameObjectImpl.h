@@ -4,9 +4,11 @@
 #include "Duin/Core/Events/Event.h"
 #include "Duin/Core/Signals/SignalsModule.h"
 
+#include <array>
 #include <vector>
 #include <memory>
 #include <algorithm>
+#include <cstdint>
 
 namespace duin
 {
@@ -38,6 +40,19 @@ class GameObjectImpl : public std::enable_shared_from_this<GameObjectImpl>
     void DispatchDrawUI();
     void DispatchDebug();
 
+    /**
+     * Opt-in flat dispatch. The subtree is kept as a contiguous depth-first
+     * (children first) list with one enabled bitset per phase, so the per-frame
+     * Dispatch* calls become a linear pass instead of a recursive walk. The list
+     * is rebuilt lazily after add/remove/enable changes anywhere in the subtree.
+     * Changes made from inside a callback apply from the next dispatch.
+     */
+    void SetFlatDispatch(bool enable);
+    bool IsFlatDispatch() const;
+    /** Marks the flat list of every ancestor (and this object) for rebuild. */
+    void InvalidateDispatchList();
+    size_t GetDispatchListSize() const;
+
     UUID uuid;
     GameObject *owner = nullptr;
     GameObjectImpl *parentImpl = nullptr;
@@ -63,6 +78,43 @@ class GameObjectImpl : public std::enable_shared_from_this<GameObjectImpl>
     bool drawUIEnabled = true;
     bool debugEnabled = true;
     bool childrenEnabled = true;
+
+  private:
+    enum DispatchPhase : uint8_t
+    {
+        PHASE_ON_EVENT = 0,
+        PHASE_UPDATE,
+        PHASE_PHYSICS_UPDATE,
+        PHASE_DRAW,
+        PHASE_DRAW_UI,
+        PHASE_DEBUG,
+        PHASE_COUNT
+    };
+
+    struct DispatchList
+    {
+        std::vector<GameObjectImpl *> nodes;
+        std::vector<std::shared_ptr<GameObjectImpl>> keepAlive; // Descendants stay valid during a pass
+        std::array<std::vector<uint64_t>, PHASE_COUNT> enabled;
+    };
+
+    uint8_t GetPhaseMask() const;
+    bool PrepareDispatchList();
+    void AppendDispatchNodes(GameObjectImpl *node, uint8_t mask);
+
+    template <typename Fn>
+    void ForEachFlat(DispatchPhase phase, Fn &&fn);
+
+    void NotifyOnEvent(const Event &event);
+    void NotifyUpdate(double delta);
+    void NotifyPhysicsUpdate(double delta);
+    void NotifyDraw();
+    void NotifyDrawUI();
+    void NotifyDebug();
+
+    std::unique_ptr<DispatchList> dispatchList;
+    bool dispatchDirty = true;
+    uint32_t dispatchDepth = 0;
 };
 
 } // namespace duin
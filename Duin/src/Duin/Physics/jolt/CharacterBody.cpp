@@ -7,6 +7,8 @@
 #include "Duin/Core/Debug/DNLog.h"
 #include "Duin/Core/Debug/DNAssert.h"
 
+#include <cmath>
+
 duin::CharacterBody::CharacterBody(CharacterBodyDesc bodyDesc, CollisionShapeDesc shapeDesc, Vector3 position)
     : bodyDesc(bodyDesc), shapeDesc(shapeDesc)
 {
@@ -59,7 +61,7 @@ void duin::CharacterBody::Initialize(duin::Vector3 position)
         JPH::RVec3(position.x, position.y, position.z),
         JPH::Quat::sIdentity(),
         0,
-        &PhysicsServer::Get().physicsSystem);
+        PhysicsServer::Get().physicsSystem.get());
     DN_CORE_ASSERT(character != nullptr, "Failed to create JPH::CharacterVirtual!");
 
     DN_CORE_INFO("CharacterBody initialized.");
@@ -147,10 +149,10 @@ void duin::CharacterBody::Move(duin::Vector3 displacement, double delta)
 
     character->ExtendedUpdate(
         (float)delta,
-        -character->GetUp() * server.physicsSystem.GetGravity().Length(),
+        -character->GetUp() * server.physicsSystem->GetGravity().Length(),
         update_settings,
-        server.physicsSystem.GetDefaultBroadPhaseLayerFilter(Layers::MOVING),
-        server.physicsSystem.GetDefaultLayerFilter(Layers::MOVING),
+        server.physicsSystem->GetDefaultBroadPhaseLayerFilter(Layers::MOVING),
+        server.physicsSystem->GetDefaultLayerFilter(Layers::MOVING),
         {},
         {},
         *server.tempAllocator);
@@ -173,5 +175,21 @@ void duin::CharacterBody::OnObstacleHit()
 
 int duin::CharacterBody::OnFloorShapeCast(double delta)
 {
-    return 0;
+    DN_CORE_ASSERT(character != nullptr, "Character is not initialized!");
+
+    PhysicsServer &server = PhysicsServer::Get();
+
+    // Sweep the character's own shape a little below its feet, further when it is falling.
+    float castDistance = 0.05f + std::max(0.0f, -currentVelocity.y) * (float)delta;
+    PhysicsShapeCast cast;
+    cast.origin = FromJPHRVec3(character->GetCenterOfMassPosition());
+    cast.rotation = FromJPHQuat(character->GetRotation());
+    cast.direction = Vector3(0.0f, -castDistance, 0.0f);
+
+    PhysicsQueryHit hit;
+    if (server.CastShapes(character->GetShape(), std::span(&cast, 1), std::span(&hit, 1)) == 0)
+    {
+        return 0;
+    }
+    return hit.normal.y >= std::cos(JPH::DegreesToRadians(bodyDesc.maxSlopeAngle)) ? 1 : 0;
 }
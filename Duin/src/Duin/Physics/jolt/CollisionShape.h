@@ -100,6 +100,7 @@ class CollisionShape
 
   private:
     friend class CharacterBody;
+    friend class PhysicsServer;
 
     CollisionShapeDesc shapeDesc;
     JPH::Shape *shapePtr = nullptr;
@@ -1,96 +1,158 @@
 #pragma once
 
+#include <Jolt/Jolt.h>
+#include <Jolt/Physics/Collision/BroadPhase/BroadPhaseLayer.h>
+#include <Jolt/Physics/Collision/ObjectLayer.h>
+#include <Jolt/Physics/Collision/ContactListener.h>
+#include <Jolt/Physics/Body/BodyActivationListener.h>
+#include <Jolt/Physics/Body/Body.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "PhysicsConfig.h"
+#include "PhysicsContacts.h"
+
 namespace duin
 {
 
+// The built-in layers every PhysicsLayerTable starts with.
 namespace Layers
 {
 static constexpr JPH::ObjectLayer NON_MOVING = 0;
 static constexpr JPH::ObjectLayer MOVING = 1;
-static constexpr JPH::ObjectLayer NUM_LAYERS = 2;
 }; // namespace Layers
 
 namespace BroadPhaseLayers
 {
 static constexpr JPH::BroadPhaseLayer NON_MOVING(0);
 static constexpr JPH::BroadPhaseLayer MOVING(1);
-static constexpr JPH::uint NUM_LAYERS(2);
 }; // namespace BroadPhaseLayers
 
+// The three interfaces below copy what they need out of a PhysicsLayerTable when
+// the server is initialized. Jolt calls them from every broadphase and narrowphase
+// job, so each answer is a lookup or a mask test.
+
 class BPLayerInterfaceImpl final : public JPH::BroadPhaseLayerInterface
 {
   public:
     BPLayerInterfaceImpl()
     {
-        mObjectToBroadPhase[Layers::NON_MOVING] = BroadPhaseLayers::NON_MOVING;
-        mObjectToBroadPhase[Layers::MOVING] = BroadPhaseLayers::MOVING;
+        Configure(PhysicsLayerTable());
+    }
+
+    void Configure(const PhysicsLayerTable &table)
+    {
+        mNumBroadPhaseLayers = static_cast<JPH::uint>(table.GetBroadPhaseLayerCount());
+        mObjectToBroadPhase.clear();
+        for (size_t i = 0; i < table.GetObjectLayerCount(); ++i)
+        {
+            JPH::ObjectLayer layer = static_cast<JPH::ObjectLayer>(i);
+            mObjectToBroadPhase.push_back(
+                JPH::BroadPhaseLayer(static_cast<JPH::BroadPhaseLayer::Type>(table.GetBroadPhaseLayer(layer))));
+        }
+        mBroadPhaseNames.clear();
+        for (size_t i = 0; i < table.GetBroadPhaseLayerCount(); ++i)
+        {
+            mBroadPhaseNames.push_back(table.GetBroadPhaseLayerName(i));
+        }
     }
 
     virtual JPH::uint GetNumBroadPhaseLayers() const override
     {
-        return BroadPhaseLayers::NUM_LAYERS;
+        return mNumBroadPhaseLayers;
     }
 
     virtual JPH::BroadPhaseLayer GetBroadPhaseLayer(JPH::ObjectLayer inLayer) const override
     {
-        JPH_ASSERT(inLayer < Layers::NUM_LAYERS);
+        JPH_ASSERT(inLayer < mObjectToBroadPhase.size());
         return mObjectToBroadPhase[inLayer];
     }
 
 #if defined(JPH_EXTERNAL_PROFILE) || defined(JPH_PROFILE_ENABLED)
     virtual const char *GetBroadPhaseLayerName(JPH::BroadPhaseLayer inLayer) const override
     {
-        switch ((JPH::BroadPhaseLayer::Type)inLayer)
+        JPH::BroadPhaseLayer::Type index = (JPH::BroadPhaseLayer::Type)inLayer;
+        if (index >= mBroadPhaseNames.size())
         {
-        case (JPH::BroadPhaseLayer::Type)BroadPhaseLayers::NON_MOVING:
-            return "NON_MOVING";
-        case (JPH::BroadPhaseLayer::Type)BroadPhaseLayers::MOVING:
-            return "MOVING";
-        default:
             JPH_ASSERT(false);
             return "INVALID";
         }
+        return mBroadPhaseNames[index].c_str();
     }
 #endif // JPH_EXTERNAL_PROFILE || JPH_PROFILE_ENABLED
 
   private:
-    JPH::BroadPhaseLayer mObjectToBroadPhase[Layers::NUM_LAYERS];
+    JPH::uint mNumBroadPhaseLayers = 0;
+    std::vector<JPH::BroadPhaseLayer> mObjectToBroadPhase;
+    std::vector<std::string> mBroadPhaseNames;
 };
 
 class ObjectVsBroadPhaseLayerFilterImpl : public JPH::ObjectVsBroadPhaseLayerFilter
 {
   public:
-    virtual bool ShouldCollide(JPH::ObjectLayer inLayer1, JPH::BroadPhaseLayer inLayer2) const override
+    ObjectVsBroadPhaseLayerFilterImpl()
+    {
+        Configure(PhysicsLayerTable());
+    }
+
+    void Configure(const PhysicsLayerTable &table)
     {
-        switch (inLayer1)
+        mMasks.assign(table.GetObjectLayerCount(), 0);
+        for (size_t i = 0; i < table.GetObjectLayerCount(); ++i)
         {
-        case Layers::NON_MOVING:
-            return inLayer2 == BroadPhaseLayers::MOVING;
-        case Layers::MOVING:
-            return true;
-        default:
-            JPH_ASSERT(false);
-            return false;
+            for (size_t bp = 0; bp < table.GetBroadPhaseLayerCount(); ++bp)
+            {
+                if (table.ShouldCollideBroadPhase(static_cast<JPH::ObjectLayer>(i), bp))
+                {
+                    mMasks[i] |= uint64_t(1) << bp;
+                }
+            }
         }
     }
+
+    virtual bool ShouldCollide(JPH::ObjectLayer inLayer1, JPH::BroadPhaseLayer inLayer2) const override
+    {
+        JPH_ASSERT(inLayer1 < mMasks.size());
+        return (mMasks[inLayer1] >> (JPH::BroadPhaseLayer::Type)inLayer2) & 1;
+    }
+
+  private:
+    std::vector<uint64_t> mMasks;
 };
 
 class ObjectLayerPairFilterImpl : public JPH::ObjectLayerPairFilter
 {
   public:
-    virtual bool ShouldCollide(JPH::ObjectLayer inObject1, JPH::ObjectLayer inObject2) const override
+    ObjectLayerPairFilterImpl()
+    {
+        Configure(PhysicsLayerTable());
+    }
+
+    void Configure(const PhysicsLayerTable &table)
     {
-        switch (inObject1)
+        mMasks.assign(table.GetObjectLayerCount(), 0);
+        for (size_t a = 0; a < table.GetObjectLayerCount(); ++a)
         {
-        case Layers::NON_MOVING:
-            return inObject2 == Layers::MOVING;
-        case Layers::MOVING:
-            return true;
-        default:
-            JPH_ASSERT(false);
-            return false;
+            for (size_t b = 0; b < table.GetObjectLayerCount(); ++b)
+            {
+                if (table.ShouldCollide(static_cast<JPH::ObjectLayer>(a), static_cast<JPH::ObjectLayer>(b)))
+                {
+                    mMasks[a] |= uint64_t(1) << b;
+                }
+            }
         }
     }
+
+    virtual bool ShouldCollide(JPH::ObjectLayer inObject1, JPH::ObjectLayer inObject2) const override
+    {
+        JPH_ASSERT(inObject1 < mMasks.size() && inObject2 < mMasks.size());
+        return (mMasks[inObject1] >> inObject2) & 1;
+    }
+
+  private:
+    std::vector<uint64_t> mMasks;
 };
 
 class MyBodyActivationListener : public JPH::BodyActivationListener
@@ -107,16 +169,21 @@ class MyBodyActivationListener : public JPH::BodyActivationListener
     }
 };
 
+// Called from Jolt's narrowphase jobs. Added and removed contacts are queued without
+// locking; persisted ones are already known to the server, so they return at once.
 class MyContactListener : public JPH::ContactListener
 {
   public:
+    PhysicsContactQueue &GetQueue()
+    {
+        return queue;
+    }
+
     // See: ContactListener
     virtual JPH::ValidateResult OnContactValidate(
         const JPH::Body &inBody1, const JPH::Body &inBody2, JPH::RVec3Arg inBaseOffset,
         const JPH::CollideShapeResult &inCollisionResult) override
     {
-        //std::cout << "Contact validate callback" << std::endl;
-
         // Allows you to ignore a contact before it is created (using layers to not make objects collide is cheaper!)
         return JPH::ValidateResult::AcceptAllContactsForThisBodyPair;
     }
@@ -125,20 +192,38 @@ class MyContactListener : public JPH::ContactListener
         const JPH::Body &inBody1, const JPH::Body &inBody2, const JPH::ContactManifold &inManifold,
         JPH::ContactSettings &ioSettings) override
     {
-        //std::cout << "A contact was added" << std::endl;
+        PhysicsContactRecord record;
+        record.kind = PhysicsContactRecord::Kind::Added;
+        record.isSensor = inBody1.IsSensor() || inBody2.IsSensor();
+        record.body1 = inBody1.GetID();
+        record.body2 = inBody2.GetID();
+        record.userData1 = inBody1.GetUserData();
+        record.userData2 = inBody2.GetUserData();
+        JPH::RVec3 point = inManifold.GetWorldSpaceContactPointOn1(0);
+        record.position = Vector3((float)point.GetX(), (float)point.GetY(), (float)point.GetZ());
+        record.normal = Vector3(inManifold.mWorldSpaceNormal.GetX(), inManifold.mWorldSpaceNormal.GetY(),
+                                inManifold.mWorldSpaceNormal.GetZ());
+        queue.Push(record);
     }
 
     virtual void OnContactPersisted(
         const JPH::Body &inBody1, const JPH::Body &inBody2, const JPH::ContactManifold &inManifold,
         JPH::ContactSettings &ioSettings) override
     {
-        //std::cout << "A contact was persisted" << std::endl;
     }
 
+    // The bodies may already be gone here, hence ids instead of bodies.
     virtual void OnContactRemoved(const JPH::SubShapeIDPair &inSubShapePair) override
     {
-        //std::cout << "A contact was removed" << std::endl;
+        PhysicsContactRecord record;
+        record.kind = PhysicsContactRecord::Kind::Removed;
+        record.body1 = inSubShapePair.GetBody1ID();
+        record.body2 = inSubShapePair.GetBody2ID();
+        queue.Push(record);
     }
+
+  private:
+    PhysicsContactQueue queue;
 };
 
-} // namespace duin
\ No newline at end of file
+} // namespace duin
@@ -14,4 +14,24 @@ inline JPH::Vec3 ToJPHVec3(Vector3 vec)
 {
     return JPH::Vec3(vec.x, vec.y, vec.z);
 }
+
+inline Vector3 FromJPHRVec3(JPH::RVec3 vec)
+{
+    return Vector3((float)vec.GetX(), (float)vec.GetY(), (float)vec.GetZ());
+}
+
+inline JPH::RVec3 ToJPHRVec3(Vector3 vec)
+{
+    return JPH::RVec3(vec.x, vec.y, vec.z);
+}
+
+inline Quaternion FromJPHQuat(JPH::Quat quat)
+{
+    return Quaternion(quat.GetX(), quat.GetY(), quat.GetZ(), quat.GetW());
+}
+
+inline JPH::Quat ToJPHQuat(Quaternion quat)
+{
+    return JPH::Quat(quat.x, quat.y, quat.z, quat.w);
+}
 } // namespace duin
\ No newline at end of file
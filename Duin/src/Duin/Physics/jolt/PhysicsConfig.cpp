@@ -0,0 +1,200 @@
+#include "dnpch.h"
+#include "PhysicsConfig.h"
+#include "JoltCollisionSolverInterfaces.h"
+#include "Duin/IO/ConfigValue.h"
+#include "Duin/Core/Debug/DNLog.h"
+
+namespace duin
+{
+
+namespace
+{
+// Reads a positive integer key into out; absent or invalid keys leave it untouched.
+bool ReadCount(ConfigValue &config, const std::string &key, uint32_t &out)
+{
+    if (!config.Contains(key))
+    {
+        return false;
+    }
+    int64_t value = config.Find<int64_t>(key);
+    if (value <= 0 || value > UINT32_MAX)
+    {
+        DN_CORE_WARN("PhysicsConfig::FromConfig - {} must be a positive integer, got {}", key, value);
+        return false;
+    }
+    out = static_cast<uint32_t>(value);
+    return true;
+}
+} // namespace
+
+PhysicsLayerTable::PhysicsLayerTable()
+{
+    AddObjectLayer("NON_MOVING", "NON_MOVING");
+    AddObjectLayer("MOVING", "MOVING");
+    SetCollision(Layers::NON_MOVING, Layers::MOVING, true);
+    SetCollision(Layers::MOVING, Layers::MOVING, true);
+}
+
+size_t PhysicsLayerTable::AddBroadPhaseLayer(const std::string &name)
+{
+    for (size_t i = 0; i < broadPhaseNames_.size(); ++i)
+    {
+        if (broadPhaseNames_[i] == name)
+        {
+            return i;
+        }
+    }
+    if (broadPhaseNames_.size() >= MAX_LAYERS)
+    {
+        DN_CORE_WARN("PhysicsLayerTable - cannot add broadphase layer {}, the limit is {}", name, MAX_LAYERS);
+        return MAX_LAYERS;
+    }
+    broadPhaseNames_.push_back(name);
+    return broadPhaseNames_.size() - 1;
+}
+
+JPH::ObjectLayer PhysicsLayerTable::AddObjectLayer(const std::string &name, const std::string &broadPhaseLayer)
+{
+    if (FindObjectLayer(name) != JPH::cObjectLayerInvalid)
+    {
+        DN_CORE_WARN("PhysicsLayerTable - object layer {} already exists", name);
+        return JPH::cObjectLayerInvalid;
+    }
+    if (layerNames_.size() >= MAX_LAYERS)
+    {
+        DN_CORE_WARN("PhysicsLayerTable - cannot add object layer {}, the limit is {}", name, MAX_LAYERS);
+        return JPH::cObjectLayerInvalid;
+    }
+    size_t broadPhase = AddBroadPhaseLayer(broadPhaseLayer);
+    if (broadPhase == MAX_LAYERS)
+    {
+        return JPH::cObjectLayerInvalid;
+    }
+
+    layerNames_.push_back(name);
+    layerBroadPhase_.push_back(static_cast<uint8_t>(broadPhase));
+    collisionMasks_.push_back(0);
+    return static_cast<JPH::ObjectLayer>(layerNames_.size() - 1);
+}
+
+void PhysicsLayerTable::SetCollision(JPH::ObjectLayer a, JPH::ObjectLayer b, bool collide)
+{
+    if (a >= layerNames_.size() || b >= layerNames_.size())
+    {
+        DN_CORE_WARN("PhysicsLayerTable::SetCollision - layer out of range ({}, {})", a, b);
+        return;
+    }
+    if (collide)
+    {
+        collisionMasks_[a] |= uint64_t(1) << b;
+        collisionMasks_[b] |= uint64_t(1) << a;
+    }
+    else
+    {
+        collisionMasks_[a] &= ~(uint64_t(1) << b);
+        collisionMasks_[b] &= ~(uint64_t(1) << a);
+    }
+}
+
+JPH::ObjectLayer PhysicsLayerTable::FindObjectLayer(const std::string &name) const
+{
+    for (size_t i = 0; i < layerNames_.size(); ++i)
+    {
+        if (layerNames_[i] == name)
+        {
+            return static_cast<JPH::ObjectLayer>(i);
+        }
+    }
+    return JPH::cObjectLayerInvalid;
+}
+
+bool PhysicsLayerTable::ShouldCollideBroadPhase(JPH::ObjectLayer layer, size_t broadPhaseLayer) const
+{
+    uint64_t mask = collisionMasks_[layer];
+    for (size_t other = 0; mask != 0; ++other, mask >>= 1)
+    {
+        if ((mask & 1) && layerBroadPhase_[other] == broadPhaseLayer)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+PhysicsConfig PhysicsConfig::FromConfig(ConfigValue config)
+{
+    PhysicsConfig result;
+    if (!config.IsTable())
+    {
+        DN_CORE_WARN("PhysicsConfig::FromConfig - expected a table, using defaults");
+        return result;
+    }
+
+    ReadCount(config, "max_bodies", result.maxBodies);
+    ReadCount(config, "num_body_mutexes", result.numBodyMutexes);
+    ReadCount(config, "max_body_pairs", result.maxBodyPairs);
+    ReadCount(config, "max_contact_constraints", result.maxContactConstraints);
+    uint32_t tempAllocatorMB = 0;
+    if (ReadCount(config, "temp_allocator_mb", tempAllocatorMB))
+    {
+        result.tempAllocatorSize = static_cast<size_t>(tempAllocatorMB) * 1024 * 1024;
+    }
+    if (config.Contains("threads"))
+    {
+        result.threadCount = static_cast<int>(config.Find<int64_t>("threads"));
+    }
+
+    // Listing the broadphase layers up front fixes their order; layers may also name new ones.
+    if (config.Contains("broadphase_layers"))
+    {
+        for (const std::string &name : config.Find<std::vector<std::string>>("broadphase_layers"))
+        {
+            result.layers.AddBroadPhaseLayer(name);
+        }
+    }
+
+    if (!config.Contains("layers"))
+    {
+        return result;
+    }
+
+    // Layers are all added before any collision is set, so collides_with may name a later one.
+    std::vector<toml::value> layers = config.Find<std::vector<toml::value>>("layers");
+    std::vector<JPH::ObjectLayer> added(layers.size(), JPH::cObjectLayerInvalid);
+    for (size_t i = 0; i < layers.size(); ++i)
+    {
+        ConfigValue layer(layers[i]);
+        if (!layer.IsTable() || !layer.Contains("name"))
+        {
+            DN_CORE_WARN("PhysicsConfig::FromConfig - layer {} has no name, skipped", i);
+            continue;
+        }
+        std::string name = layer.Find<std::string>("name");
+        std::string broadPhase = layer.Contains("broadphase") ? layer.Find<std::string>("broadphase") : name;
+        added[i] = result.layers.AddObjectLayer(name, broadPhase);
+    }
+
+    for (size_t i = 0; i < layers.size(); ++i)
+    {
+        ConfigValue layer(layers[i]);
+        if (added[i] == JPH::cObjectLayerInvalid || !layer.Contains("collides_with"))
+        {
+            continue;
+        }
+        for (const std::string &other : layer.Find<std::vector<std::string>>("collides_with"))
+        {
+            JPH::ObjectLayer otherLayer = result.layers.FindObjectLayer(other);
+            if (otherLayer == JPH::cObjectLayerInvalid)
+            {
+                DN_CORE_WARN("PhysicsConfig::FromConfig - layer {} collides with unknown layer {}",
+                             result.layers.GetObjectLayerName(added[i]), other);
+                continue;
+            }
+            result.layers.SetCollision(added[i], otherLayer, true);
+        }
+    }
+
+    return result;
+}
+
+} // namespace duin
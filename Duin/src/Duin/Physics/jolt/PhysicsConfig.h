@@ -0,0 +1,154 @@
+/**
+ * @file PhysicsConfig.h
+ * @brief Capacities and collision layers the PhysicsServer is initialized with.
+ *
+ * Every body lives in an object layer. Each object layer maps to a broadphase
+ * layer (one tree of the broadphase), and a symmetric table says which object
+ * layers collide. Broadphase pairs are rejected with a single mask test, so
+ * keep layers that never meet in separate broadphase layers.
+ *
+ * The table always starts with two built-in layers: NON_MOVING (static bodies)
+ * and MOVING (everything else), each in its own broadphase layer. MOVING
+ * collides with both; NON_MOVING only with MOVING.
+ *
+ * Example project config:
+ * @code{.toml}
+ * [physics]
+ * max_bodies = 32768
+ * max_body_pairs = 65536
+ * max_contact_constraints = 16384
+ * temp_allocator_mb = 64
+ * threads = 6
+ * broadphase_layers = ["NON_MOVING", "MOVING", "DEBRIS", "SENSOR"]
+ *
+ * [[physics.layers]]
+ * name = "DEBRIS"
+ * broadphase = "DEBRIS"
+ * collides_with = ["NON_MOVING"]
+ *
+ * [[physics.layers]]
+ * name = "TRIGGER"
+ * broadphase = "SENSOR"
+ * collides_with = ["MOVING"]
+ * @endcode
+ */
+
+#pragma once
+
+#include <Jolt/Jolt.h>
+#include <Jolt/Physics/Collision/ObjectLayer.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace duin
+{
+
+class ConfigValue;
+
+/**
+ * @class PhysicsLayerTable
+ * @brief Object layers, the broadphase layer of each, and which pairs collide.
+ *
+ * Collision is stored as one bit mask per object layer, so both the object pair
+ * test and the object-vs-broadphase test are a shift and an and.
+ */
+class PhysicsLayerTable
+{
+  public:
+    /** @brief Most object layers, and most broadphase layers, a table can hold. */
+    static constexpr size_t MAX_LAYERS = 64;
+
+    /** @brief Builds the table with the built-in NON_MOVING and MOVING layers. */
+    PhysicsLayerTable();
+
+    /**
+     * @brief Adds a broadphase layer, or finds it if the name is taken.
+     * @return Its index, or MAX_LAYERS if the table is full.
+     */
+    size_t AddBroadPhaseLayer(const std::string &name);
+
+    /**
+     * @brief Adds an object layer in the named broadphase layer, which is created if needed.
+     *
+     * The new layer collides with nothing until SetCollision() is called.
+     * @return The new layer, or JPH::cObjectLayerInvalid if the name is taken or the table is full.
+     */
+    JPH::ObjectLayer AddObjectLayer(const std::string &name, const std::string &broadPhaseLayer);
+
+    /** @brief Sets whether two object layers collide, in both directions. */
+    void SetCollision(JPH::ObjectLayer a, JPH::ObjectLayer b, bool collide);
+
+    /** @return The layer with this name, or JPH::cObjectLayerInvalid. */
+    JPH::ObjectLayer FindObjectLayer(const std::string &name) const;
+
+    bool ShouldCollide(JPH::ObjectLayer a, JPH::ObjectLayer b) const
+    {
+        return (collisionMasks_[a] >> b) & 1;
+    }
+
+    /** @brief True if the object layer collides with any object layer in the broadphase layer. */
+    bool ShouldCollideBroadPhase(JPH::ObjectLayer layer, size_t broadPhaseLayer) const;
+
+    size_t GetObjectLayerCount() const
+    {
+        return layerNames_.size();
+    }
+    size_t GetBroadPhaseLayerCount() const
+    {
+        return broadPhaseNames_.size();
+    }
+    size_t GetBroadPhaseLayer(JPH::ObjectLayer layer) const
+    {
+        return layerBroadPhase_[layer];
+    }
+    const std::string &GetObjectLayerName(JPH::ObjectLayer layer) const
+    {
+        return layerNames_[layer];
+    }
+    const std::string &GetBroadPhaseLayerName(size_t broadPhaseLayer) const
+    {
+        return broadPhaseNames_[broadPhaseLayer];
+    }
+
+  private:
+    std::vector<std::string> layerNames_;
+    std::vector<uint8_t> layerBroadPhase_;
+    std::vector<uint64_t> collisionMasks_;
+    std::vector<std::string> broadPhaseNames_;
+};
+
+/**
+ * @struct PhysicsConfig
+ * @brief Everything PhysicsServer::Initialize() sizes or builds.
+ *
+ * The defaults match the engine's original hardcoded setup.
+ */
+struct PhysicsConfig
+{
+    /** @brief Bodies that can exist at once. */
+    uint32_t maxBodies = 1024;
+    /** @brief Mutexes guarding body access; 0 lets Jolt pick. */
+    uint32_t numBodyMutexes = 0;
+    /** @brief Broadphase pairs that can be queued per step. */
+    uint32_t maxBodyPairs = 1024;
+    /** @brief Contact constraints that can be solved per step. */
+    uint32_t maxContactConstraints = 1024;
+    /** @brief Bytes of scratch memory reserved for each step. */
+    size_t tempAllocatorSize = 10 * 1024 * 1024;
+    /** @brief Worker threads for the step; negative uses one less than the hardware threads. */
+    int threadCount = -1;
+    PhysicsLayerTable layers;
+
+    /**
+     * @brief Reads a config from the [physics] table of a project config.
+     *
+     * Missing keys keep their defaults. Unknown layer names are warned about and skipped.
+     * @param config The [physics] table itself, e.g. projectConfig.At("physics").
+     */
+    static PhysicsConfig FromConfig(ConfigValue config);
+};
+
+} // namespace duin
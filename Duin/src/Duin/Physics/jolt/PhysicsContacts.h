@@ -0,0 +1,153 @@
+/**
+ * @file PhysicsContacts.h
+ * @brief Contact events of the PhysicsServer and the queue Jolt's workers fill during a step.
+ *
+ * Jolt reports contacts per sub-shape pair, from its job threads, in the middle of
+ * the solver. The listener only appends a record to a PhysicsContactQueue there;
+ * after the step the server folds the records into one Begin and one End per
+ * body pair (see PhysicsServer::GetContactEvents()).
+ */
+
+#pragma once
+
+#include "Duin/Core/Maths/DuinMaths.h"
+#include <Jolt/Jolt.h>
+#include <Jolt/Physics/Body/BodyID.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <vector>
+
+namespace duin
+{
+
+enum class PhysicsContactType : uint8_t
+{
+    /** @brief Two bodies started touching. */
+    Begin,
+    /** @brief Two bodies stopped touching, or one of them was removed. */
+    End
+};
+
+/** @brief One body pair starting or stopping contact during the last step. */
+struct PhysicsContactEvent
+{
+    PhysicsContactType type = PhysicsContactType::Begin;
+    JPH::BodyID body1;
+    JPH::BodyID body2;
+    uint64_t userData1 = 0;
+    uint64_t userData2 = 0;
+    /** @brief World-space point of first contact on body1; zero for End. */
+    Vector3 position = Vector3Zero();
+    /** @brief Contact normal pointing from body1 to body2; zero for End. */
+    Vector3 normal = Vector3Zero();
+    /** @brief One of the bodies is a sensor, so nothing was solved. */
+    bool isSensor = false;
+};
+
+/** @brief What a Jolt worker saw for one sub-shape pair. Persisted contacts are never recorded. */
+struct PhysicsContactRecord
+{
+    enum class Kind : uint8_t
+    {
+        Added,
+        Removed
+    };
+
+    Kind kind = Kind::Added;
+    bool isSensor = false;
+    JPH::BodyID body1;
+    JPH::BodyID body2;
+    uint64_t userData1 = 0;
+    uint64_t userData2 = 0;
+    Vector3 position = Vector3Zero();
+    Vector3 normal = Vector3Zero();
+};
+
+/**
+ * @class PhysicsContactQueue
+ * @brief Multi-producer buffer of contact records, lock-free until it fills up.
+ *
+ * Producers claim a slot with one atomic increment and write it; there is no
+ * lock and no allocation on the push path. The single consumer reads the records
+ * only after PhysicsSystem::Update() returned, whose job barrier orders every
+ * write before the read. Records that do not fit go to a mutex-guarded overflow
+ * vector instead, so none is lost; Clear() then grows the slots so the next step
+ * stays on the lock-free path.
+ */
+class PhysicsContactQueue
+{
+  public:
+    explicit PhysicsContactQueue(size_t capacity = 1024) : slots(capacity)
+    {
+    }
+
+    /** @brief Resizes the buffer and drops its records. Not thread safe; call between steps. */
+    void Reset(size_t capacity)
+    {
+        slots.assign(capacity, PhysicsContactRecord());
+        overflow.clear();
+        writeIndex.store(0, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Appends a record from any thread.
+     * @return False if the slots were full and the record went to the overflow vector.
+     */
+    bool Push(const PhysicsContactRecord &record)
+    {
+        size_t index = writeIndex.fetch_add(1, std::memory_order_relaxed);
+        if (index >= slots.size())
+        {
+            std::lock_guard<std::mutex> lock(overflowMutex);
+            overflow.push_back(record);
+            return false;
+        }
+        slots[index] = record;
+        return true;
+    }
+
+    /** @brief Records written to the slots since the last Clear(), in the order the slots were claimed. */
+    std::span<const PhysicsContactRecord> Pending() const
+    {
+        return {slots.data(), std::min(writeIndex.load(std::memory_order_relaxed), slots.size())};
+    }
+
+    /**
+     * @brief Records that did not fit in the slots since the last Clear(). Every one was
+     * claimed after the last slot, so reading Pending() then Overflow() keeps each body
+     * pair's records in order.
+     */
+    std::span<const PhysicsContactRecord> Overflow() const
+    {
+        return overflow;
+    }
+
+    size_t GetCapacity() const
+    {
+        return slots.size();
+    }
+
+    /** @brief Empties the buffer, growing the slots first if any record overflowed. Consumer only. */
+    void Clear()
+    {
+        size_t written = writeIndex.load(std::memory_order_relaxed);
+        if (written > slots.size())
+        {
+            slots.resize(std::max(written, slots.size() * 2));
+        }
+        overflow.clear();
+        writeIndex.store(0, std::memory_order_relaxed);
+    }
+
+  private:
+    std::vector<PhysicsContactRecord> slots;
+    std::atomic<size_t> writeIndex{0};
+    std::vector<PhysicsContactRecord> overflow;
+    std::mutex overflowMutex;
+};
+
+} // namespace duin
@@ -0,0 +1,71 @@
+/**
+ * @file PhysicsQuery.h
+ * @brief Inputs, outputs and filters of the PhysicsServer's batched scene queries.
+ *
+ * Queries write into caller-owned spans, so a caller that keeps its buffers
+ * between ticks never allocates. Large batches are split across the physics
+ * job system; each result slot is written by exactly one job.
+ */
+
+#pragma once
+
+#include "Duin/Core/Maths/DuinMaths.h"
+#include <Jolt/Jolt.h>
+#include <Jolt/Physics/Body/BodyID.h>
+
+#include <cstdint>
+
+namespace duin
+{
+
+/** @brief A ray from origin to origin + direction; the length of direction is the cast distance. */
+struct PhysicsRay
+{
+    Vector3 origin;
+    Vector3 direction;
+};
+
+/** @brief A sweep of the batch's shape from a pose along direction (whose length is the distance). */
+struct PhysicsShapeCast
+{
+    Vector3 origin;
+    Quaternion rotation = QuaternionIdentity();
+    Vector3 direction;
+};
+
+/** @brief Closest hit of one ray or shape cast. */
+struct PhysicsQueryHit
+{
+    /** @brief Body hit; invalid when nothing was hit. */
+    JPH::BodyID bodyID;
+    /** @brief User data of the body (the entity id for ECS bodies). */
+    uint64_t userData = 0;
+    /** @brief Fraction of direction travelled before the hit, in [0, 1]. */
+    float fraction = 1.0f;
+    /** @brief World-space contact point. */
+    Vector3 position = Vector3Zero();
+    /** @brief World-space surface normal of the body hit, facing the query. */
+    Vector3 normal = Vector3Zero();
+
+    bool IsHit() const
+    {
+        return !bodyID.IsInvalid();
+    }
+};
+
+/**
+ * @brief Which bodies a query may hit.
+ *
+ * Layers are bit masks indexed by broadphase layer and object layer (see
+ * PhysicsLayerTable); a body is considered only if both of its bits are set.
+ * Whole broadphase layers are skipped before any of their bodies are visited.
+ */
+struct PhysicsQueryFilter
+{
+    uint64_t broadPhaseLayers = ~uint64_t(0);
+    uint64_t objectLayers = ~uint64_t(0);
+    /** @brief A body never reported, e.g. the querying character's own body. */
+    JPH::BodyID ignoreBody;
+};
+
+} // namespace duin
@@ -1,11 +1,26 @@
 #include "dnpch.h"
 #include "PhysicsServer.h"
 
+#include "JoltConversions.h"
 #include "Duin/Core/Debug/DNLog.h"
 #include "Duin/Core/Debug/DNAssert.h"
 
 #include <Jolt/Physics/Body/BodyCreationSettings.h>
+#include <Jolt/Physics/Body/BodyLock.h>
+#include <Jolt/Physics/Body/BodyLockMulti.h>
+#include <Jolt/Physics/Body/BodyFilter.h>
+#include <Jolt/Physics/Collision/BroadPhase/BroadPhaseQuery.h>
+#include <Jolt/Physics/Collision/CastResult.h>
+#include <Jolt/Physics/Collision/CollisionCollectorImpl.h>
+#include <Jolt/Physics/Collision/NarrowPhaseQuery.h>
+#include <Jolt/Physics/Collision/RayCast.h>
+#include <Jolt/Physics/Collision/ShapeCast.h>
 #include <Jolt/Physics/Collision/Shape/PlaneShape.h>
+#include <Jolt/Geometry/AABox.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
 
 JPH_SUPPRESS_WARNINGS
 
@@ -26,6 +41,80 @@ static bool AssertFailedImpl(const char *inExpression, const char *inMessage, co
     return true;
 };
 
+namespace
+{
+// Query filters over the PhysicsQueryFilter masks.
+class MaskBroadPhaseLayerFilter final : public JPH::BroadPhaseLayerFilter
+{
+  public:
+    explicit MaskBroadPhaseLayerFilter(uint64_t mask) : mask(mask)
+    {
+    }
+
+    bool ShouldCollide(JPH::BroadPhaseLayer inLayer) const override
+    {
+        return (mask >> (JPH::BroadPhaseLayer::Type)inLayer) & 1;
+    }
+
+  private:
+    uint64_t mask;
+};
+
+class MaskObjectLayerFilter final : public JPH::ObjectLayerFilter
+{
+  public:
+    explicit MaskObjectLayerFilter(uint64_t mask) : mask(mask)
+    {
+    }
+
+    bool ShouldCollide(JPH::ObjectLayer inLayer) const override
+    {
+        return inLayer < 64 && ((mask >> inLayer) & 1);
+    }
+
+  private:
+    uint64_t mask;
+};
+
+// Writes broadphase hits straight into the caller's span and stops once it is full.
+class BodySpanCollector final : public JPH::CollideShapeBodyCollector
+{
+  public:
+    BodySpanCollector(std::span<JPH::BodyID> out, JPH::BodyID ignore) : out(out), ignore(ignore)
+    {
+    }
+
+    void AddHit(const JPH::BodyID &inBodyID) override
+    {
+        if (inBodyID == ignore)
+        {
+            return;
+        }
+        out[count++] = inBodyID;
+        if (count == out.size())
+        {
+            ForceEarlyOut();
+        }
+    }
+
+    size_t count = 0;
+
+  private:
+    std::span<JPH::BodyID> out;
+    JPH::BodyID ignore;
+};
+
+// Fills the fields of a hit that need the body itself.
+void ReadHitBody(const JPH::BodyLockInterface &locks, JPH::BodyID bodyID, duin::PhysicsQueryHit &hit)
+{
+    JPH::BodyLockRead lock(locks, bodyID);
+    if (lock.Succeeded())
+    {
+        hit.userData = lock.GetBody().GetUserData();
+    }
+}
+} // namespace
+
 duin::PhysicsServer &duin::PhysicsServer::Get()
 {
     static duin::PhysicsServer server;
@@ -43,42 +132,91 @@ duin::PhysicsServer::~PhysicsServer()
 
 JPH::BodyInterface &duin::PhysicsServer::BodyInterface()
 {
-    return physicsSystem.GetBodyInterface();
+    return physicsSystem->GetBodyInterface();
 }
 
-void duin::PhysicsServer::Initialize()
+duin::PhysicsServerError duin::PhysicsServer::Initialize(const PhysicsConfig &newConfig)
 {
-    JPH::RegisterDefaultAllocator();
+    if (physicsSystem && physicsSystem->GetNumBodies() > 0)
+    {
+        DN_CORE_ERROR("PhysicsServer::Initialize - {} bodies still exist, keeping the current setup",
+                      physicsSystem->GetNumBodies());
+        return INIT_FAILED;
+    }
+    if (newConfig.maxBodies == 0 || newConfig.maxBodyPairs == 0 || newConfig.maxContactConstraints == 0 ||
+        newConfig.tempAllocatorSize == 0)
+    {
+        DN_CORE_ERROR("PhysicsServer::Initialize - capacities and the temp allocator size must be positive");
+        return INIT_FAILED;
+    }
+
+    // Jolt's globals outlive any one simulation.
+    static bool joltRegistered = false;
+    if (!joltRegistered)
+    {
+        JPH::RegisterDefaultAllocator();
+
+        JPH::Trace = TraceImpl;
+        JPH_IF_ENABLE_ASSERTS(JPH::AssertFailed = AssertFailedImpl;)
+
+        JPH::Factory::sInstance = new JPH::Factory();
+        JPH::RegisterTypes();
+
+        debugRenderer.Initialize();
+        JPH::DebugRenderer::sInstance = &debugRenderer.core;
+        joltRegistered = true;
+    }
 
-    JPH::Trace = TraceImpl;
-    JPH_IF_ENABLE_ASSERTS(JPH::AssertFailed = AssertFailedImpl;)
+    // The old system references the layer interfaces and allocators, so it goes first.
+    physicsSystem.reset();
+    config = newConfig;
 
-    JPH::Factory::sInstance = new JPH::Factory();
-    JPH::RegisterTypes();
+    broadPhaseLayerInterface.Configure(config.layers);
+    objectVsBroadphaseLayerFilter.Configure(config.layers);
+    objectVsObjectLayerFilter.Configure(config.layers);
 
-    tempAllocator = std::make_unique<JPH::TempAllocatorImpl>(10 * 1024 * 1024);
-    jobSystem = std::make_unique<JPH::JobSystemThreadPool>(
-        JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers, std::thread::hardware_concurrency() - 1);
+    int threadCount = config.threadCount;
+    if (threadCount < 0)
+    {
+        threadCount = std::max(0, (int)std::thread::hardware_concurrency() - 1);
+    }
+    tempAllocator = std::make_unique<JPH::TempAllocatorImpl>((JPH::uint)config.tempAllocatorSize);
+    jobSystem = std::make_unique<JPH::JobSystemThreadPool>(JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers,
+                                                           threadCount);
 
-    physicsSystem.Init(
-        /* inMaxBodies */ cMaxBodies,
-        /* inNumBodyMutexes */ cNumBodyMutexes,
-        /* inMaxBodyPairs */ cMaxBodyPairs,
-        /* inMaxContactConstraints */ cMaxContactConstraints,
+    physicsSystem = std::make_unique<JPH::PhysicsSystem>();
+    physicsSystem->Init(
+        /* inMaxBodies */ config.maxBodies,
+        /* inNumBodyMutexes */ config.numBodyMutexes,
+        /* inMaxBodyPairs */ config.maxBodyPairs,
+        /* inMaxContactConstraints */ config.maxContactConstraints,
         /* inBroadPhaseLayerInterface */ broadPhaseLayerInterface,
         /* inObjectVsBroadPhaseLayerFilter */ objectVsBroadphaseLayerFilter,
         /* inObjectLayerPairFilter */ objectVsObjectLayerFilter);
 
-    bodyInterface = &physicsSystem.GetBodyInterface();
+    bodyInterface = &physicsSystem->GetBodyInterface();
 
-    debugRenderer.Initialize();
-    JPH::DebugRenderer::sInstance = &debugRenderer.core;
+    // A step with one collision step adds and removes each contact constraint at most once.
+    // Longer ticks run several and may not fit; those records take the queue's overflow path.
+    contactListener.GetQueue().Reset(2 * (size_t)config.maxContactConstraints);
+    activeContacts.clear();
+    sleepingPairs.clear();
+    contactEvents.clear();
+    destroyedContactEvents.clear();
 
     // TODO %optional%
-    physicsSystem.SetBodyActivationListener(&bodyActivationListener);
-    physicsSystem.SetContactListener(&contactListener);
+    physicsSystem->SetBodyActivationListener(&bodyActivationListener);
+    physicsSystem->SetContactListener(&contactListener);
 
-    DN_CORE_INFO("PhysicsServer initialized.");
+    DN_CORE_INFO("PhysicsServer initialized: {} bodies, {} object layers, {} broadphase layers, {} threads.",
+                 config.maxBodies, config.layers.GetObjectLayerCount(), config.layers.GetBroadPhaseLayerCount(),
+                 threadCount);
+    return SUCCESS;
+}
+
+JPH::ObjectLayer duin::PhysicsServer::GetObjectLayer(const std::string &name) const
+{
+    return config.layers.FindObjectLayer(name);
 }
 
 void duin::PhysicsServer::Clean()
@@ -87,14 +225,477 @@ void duin::PhysicsServer::Clean()
 
 void duin::PhysicsServer::StepPhysics(double delta)
 {
-    physicsSystem.Update(cDeltaTime, cCollisionSteps, tempAllocator.get(), jobSystem.get());
+    if (delta > 0.0)
+    {
+        stepDeltaTime = (float)delta;
+    }
+    // Jolt is tuned for 60 Hz collision steps; longer ticks are split to match.
+    int collisionSteps = std::max(1, (int)std::ceil(stepDeltaTime * 60.0f - 0.01f));
+    physicsSystem->Update(stepDeltaTime, collisionSteps, tempAllocator.get(), jobSystem.get());
+    DrainContacts();
+}
+
+void duin::PhysicsServer::DrainContacts()
+{
+    contactEvents.clear();
+    // Ends of pairs whose body was destroyed since the last step come first.
+    contactEvents.swap(destroyedContactEvents);
+    PhysicsContactQueue &queue = contactListener.GetQueue();
+    if (!queue.Overflow().empty())
+    {
+        DN_CORE_WARN("PhysicsServer::StepPhysics - contact queue full, {} contacts overflowed; growing it",
+                     queue.Overflow().size());
+    }
+
+    // Overflow records were claimed after every slot, so each pair's records stay in order.
+    for (const PhysicsContactRecord &record : queue.Pending())
+    {
+        FoldContactRecord(record);
+    }
+    for (const PhysicsContactRecord &record : queue.Overflow())
+    {
+        FoldContactRecord(record);
+    }
+
+    queue.Clear();
+    ExpireSleepingContacts();
+}
+
+// Static bodies are never active, so only a non-static inactive body counts as asleep.
+bool duin::PhysicsServer::IsSleeping(JPH::BodyID bodyID) const
+{
+    return bodyInterface->IsAdded(bodyID) && bodyInterface->GetMotionType(bodyID) != JPH::EMotionType::Static &&
+           !bodyInterface->IsActive(bodyID);
+}
+
+// A woken pair whose parked contacts were not re-added within two steps has come apart.
+// The grace step covers a body woken mid-step, whose contacts Jolt only re-adds on the next one.
+void duin::PhysicsServer::ExpireSleepingContacts()
+{
+    size_t kept = 0;
+    for (uint64_t key : sleepingPairs)
+    {
+        auto it = activeContacts.find(key);
+        if (it == activeContacts.end())
+        {
+            continue;
+        }
+        ContactPair &pair = it->second;
+        if (pair.sleepingContacts == 0)
+        {
+            pair.inSleepingPairs = false;
+            continue;
+        }
+        if (IsSleeping(JPH::BodyID((uint32_t)(key >> 32))) || IsSleeping(JPH::BodyID((uint32_t)key)))
+        {
+            pair.awakeDrains = 0;
+            sleepingPairs[kept++] = key;
+            continue;
+        }
+        if (++pair.awakeDrains < 2)
+        {
+            sleepingPairs[kept++] = key;
+            continue;
+        }
+
+        pair.sleepingContacts = 0;
+        pair.inSleepingPairs = false;
+        if (pair.subShapeContacts == 0)
+        {
+            AddContactEnd(contactEvents, key, pair);
+            activeContacts.erase(it);
+        }
+    }
+    sleepingPairs.resize(kept);
+}
+
+void duin::PhysicsServer::AddContactEnd(std::vector<PhysicsContactEvent> &events, uint64_t key,
+                                        const ContactPair &pair)
+{
+    PhysicsContactEvent &event = events.emplace_back();
+    event.type = PhysicsContactType::End;
+    event.body1 = JPH::BodyID((uint32_t)(key >> 32));
+    event.body2 = JPH::BodyID((uint32_t)key);
+    event.userData1 = pair.userData1;
+    event.userData2 = pair.userData2;
+    event.isSensor = pair.isSensor;
+}
+
+// Jolt keeps body1/body2 in the same order for a pair's added and removed callbacks.
+void duin::PhysicsServer::FoldContactRecord(const PhysicsContactRecord &record)
+{
+    uint64_t key = ((uint64_t)record.body1.GetIndexAndSequenceNumber() << 32) |
+                   record.body2.GetIndexAndSequenceNumber();
+
+    if (record.kind == PhysicsContactRecord::Kind::Added)
+    {
+        ContactPair &pair = activeContacts[key];
+        if (pair.sleepingContacts > 0)
+        {
+            // A woken body re-adds the contacts it parked; the pair never ended.
+            --pair.sleepingContacts;
+            ++pair.subShapeContacts;
+            return;
+        }
+        if (pair.subShapeContacts++ > 0)
+        {
+            return;
+        }
+        pair.userData1 = record.userData1;
+        pair.userData2 = record.userData2;
+        pair.isSensor = record.isSensor;
+
+        PhysicsContactEvent &event = contactEvents.emplace_back();
+        event.type = PhysicsContactType::Begin;
+        event.body1 = record.body1;
+        event.body2 = record.body2;
+        event.userData1 = record.userData1;
+        event.userData2 = record.userData2;
+        event.position = record.position;
+        event.normal = record.normal;
+        event.isSensor = record.isSensor;
+        return;
+    }
+
+    auto it = activeContacts.find(key);
+    if (it == activeContacts.end() || it->second.subShapeContacts == 0)
+    {
+        return;
+    }
+    ContactPair &pair = it->second;
+    // Jolt also removes the contacts of a body that falls asleep. Both bodies are still
+    // added, so park the contact until the body wakes instead of ending the pair.
+    if (bodyInterface->IsAdded(record.body1) && bodyInterface->IsAdded(record.body2) &&
+        (IsSleeping(record.body1) || IsSleeping(record.body2)))
+    {
+        --pair.subShapeContacts;
+        ++pair.sleepingContacts;
+        pair.awakeDrains = 0;
+        if (!pair.inSleepingPairs)
+        {
+            pair.inSleepingPairs = true;
+            sleepingPairs.push_back(key);
+        }
+        return;
+    }
+    if (--pair.subShapeContacts > 0 || pair.sleepingContacts > 0)
+    {
+        return;
+    }
+    AddContactEnd(contactEvents, key, pair);
+    activeContacts.erase(it);
+}
+
+JPH::BodyID duin::PhysicsServer::CreateBody(const CollisionShapeDesc &shapeDesc, PhysicsMotionType motionType,
+                                            const Vector3 &position, const Quaternion &rotation, uint64_t userData,
+                                            JPH::ObjectLayer layer)
+{
+    // The shape is only referenced once a body holds it; the Ref frees it on the early returns.
+    CollisionShape shape(shapeDesc);
+    JPH::RefConst<JPH::Shape> joltShape = shape.GetJoltShape<JPH::Shape>();
+    if (joltShape == nullptr)
+    {
+        DN_CORE_WARN("PhysicsServer::CreateBody - could not build the collision shape!");
+        return JPH::BodyID();
+    }
+    if (motionType == PhysicsMotionType::Dynamic &&
+        (shape.GetType() == CollisionShapeType::Plane || shape.GetType() == CollisionShapeType::TriangleMesh))
+    {
+        DN_CORE_WARN("PhysicsServer::CreateBody - plane and triangle mesh shapes cannot be dynamic!");
+        return JPH::BodyID();
+    }
+
+    if (layer != JPH::cObjectLayerInvalid && layer >= config.layers.GetObjectLayerCount())
+    {
+        DN_CORE_WARN("PhysicsServer::CreateBody - unknown object layer {}!", layer);
+        return JPH::BodyID();
+    }
+
+    JPH::EMotionType joltMotion = JPH::EMotionType::Dynamic;
+    JPH::ObjectLayer defaultLayer = Layers::MOVING;
+    switch (motionType)
+    {
+    case PhysicsMotionType::Static:
+        joltMotion = JPH::EMotionType::Static;
+        defaultLayer = Layers::NON_MOVING;
+        break;
+    case PhysicsMotionType::Kinematic:
+        joltMotion = JPH::EMotionType::Kinematic;
+        break;
+    case PhysicsMotionType::Dynamic:
+        break;
+    }
+    if (layer == JPH::cObjectLayerInvalid)
+    {
+        layer = defaultLayer;
+    }
+
+    JPH::BodyCreationSettings settings(joltShape, JPH::RVec3(position.x, position.y, position.z),
+                                       ToJPHQuat(rotation).Normalized(), joltMotion, layer);
+    settings.mUserData = userData;
+
+    JPH::EActivation activation =
+        motionType == PhysicsMotionType::Static ? JPH::EActivation::DontActivate : JPH::EActivation::Activate;
+    JPH::BodyID bodyID = BodyInterface().CreateAndAddBody(settings, activation);
+    if (bodyID.IsInvalid())
+    {
+        DN_CORE_WARN("PhysicsServer::CreateBody - body limit reached!");
+    }
+    return bodyID;
+}
+
+void duin::PhysicsServer::DestroyBody(JPH::BodyID bodyID)
+{
+    if (bodyID.IsInvalid())
+    {
+        return;
+    }
+
+    // Jolt reports no removal for contacts parked by sleep, so end every pair with this body here.
+    // Removals Jolt still reports for it find no pair and are ignored.
+    uint32_t id = bodyID.GetIndexAndSequenceNumber();
+    for (auto it = activeContacts.begin(); it != activeContacts.end();)
+    {
+        if ((uint32_t)(it->first >> 32) != id && (uint32_t)it->first != id)
+        {
+            ++it;
+            continue;
+        }
+        AddContactEnd(destroyedContactEvents, it->first, it->second);
+        it = activeContacts.erase(it);
+    }
+
+    BodyInterface().RemoveBody(bodyID);
+    BodyInterface().DestroyBody(bodyID);
+}
+
+void duin::PhysicsServer::MoveKinematicBodies(const PhysicsKinematicTarget *targets, size_t count)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    batchBodyIDs.resize(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        batchBodyIDs[i] = targets[i].bodyID;
+    }
+
+    // Sleeping bodies are collected and woken in one call once the locks are released;
+    // activating them while holding the body locks would deadlock.
+    size_t sleeping = 0;
+    {
+        JPH::BodyLockMultiWrite lock(physicsSystem->GetBodyLockInterface(), batchBodyIDs.data(),
+                                     static_cast<int>(count));
+        for (size_t i = 0; i < count; ++i)
+        {
+            JPH::Body *body = lock.GetBody(static_cast<int>(i));
+            if (body == nullptr || !body->IsKinematic())
+            {
+                continue;
+            }
+            body->MoveKinematic(JPH::RVec3(targets[i].position.x, targets[i].position.y, targets[i].position.z),
+                                ToJPHQuat(targets[i].rotation).Normalized(), stepDeltaTime);
+            if (!body->IsActive())
+            {
+                batchBodyIDs[sleeping++] = body->GetID();
+            }
+        }
+    }
+    if (sleeping > 0)
+    {
+        BodyInterface().ActivateBodies(batchBodyIDs.data(), static_cast<int>(sleeping));
+    }
+}
+
+void duin::PhysicsServer::ReadActiveBodies(std::vector<PhysicsBodyState> &out)
+{
+    out.clear();
+    physicsSystem->GetActiveBodies(JPH::EBodyType::RigidBody, activeBodyIDs);
+    if (activeBodyIDs.empty())
+    {
+        return;
+    }
+
+    out.reserve(activeBodyIDs.size());
+    JPH::BodyLockMultiRead lock(physicsSystem->GetBodyLockInterface(), activeBodyIDs.data(),
+                                static_cast<int>(activeBodyIDs.size()));
+    for (size_t i = 0; i < activeBodyIDs.size(); ++i)
+    {
+        const JPH::Body *body = lock.GetBody(static_cast<int>(i));
+        if (body == nullptr || !body->IsDynamic())
+        {
+            continue;
+        }
+        PhysicsBodyState &state = out.emplace_back();
+        state.bodyID = body->GetID();
+        state.userData = body->GetUserData();
+        state.position = FromJPHVec3(JPH::Vec3(body->GetPosition()));
+        state.rotation = FromJPHQuat(body->GetRotation());
+        state.linearVelocity = FromJPHVec3(body->GetLinearVelocity());
+    }
+}
+
+size_t duin::PhysicsServer::CastRays(std::span<const PhysicsRay> rays, std::span<PhysicsQueryHit> hits,
+                                     const PhysicsQueryFilter &filter)
+{
+    size_t count = std::min(rays.size(), hits.size());
+    const JPH::NarrowPhaseQuery &query = physicsSystem->GetNarrowPhaseQuery();
+    const JPH::BodyLockInterface &locks = physicsSystem->GetBodyLockInterface();
+    MaskBroadPhaseLayerFilter broadPhaseFilter(filter.broadPhaseLayers);
+    MaskObjectLayerFilter layerFilter(filter.objectLayers);
+    JPH::IgnoreSingleBodyFilter bodyFilter(filter.ignoreBody);
+    std::atomic<size_t> hitCount{0};
+
+    RunQueryJobs(count, [&](size_t begin, size_t end) {
+        size_t localHits = 0;
+        for (size_t i = begin; i < end; ++i)
+        {
+            PhysicsQueryHit &hit = hits[i];
+            hit = PhysicsQueryHit();
+
+            JPH::RRayCast ray(ToJPHRVec3(rays[i].origin), ToJPHVec3(rays[i].direction));
+            JPH::RayCastResult result;
+            if (!query.CastRay(ray, result, broadPhaseFilter, layerFilter, bodyFilter))
+            {
+                continue;
+            }
+
+            JPH::RVec3 point = ray.GetPointOnRay(result.mFraction);
+            hit.bodyID = result.mBodyID;
+            hit.fraction = result.mFraction;
+            hit.position = FromJPHRVec3(point);
+
+            // The ray only reports the sub-shape; the normal comes from the body.
+            JPH::BodyLockRead lock(locks, result.mBodyID);
+            if (lock.Succeeded())
+            {
+                const JPH::Body &body = lock.GetBody();
+                hit.userData = body.GetUserData();
+                hit.normal = FromJPHVec3(body.GetWorldSpaceSurfaceNormal(result.mSubShapeID2, point));
+            }
+            ++localHits;
+        }
+        hitCount += localHits;
+    });
+
+    return hitCount;
+}
+
+size_t duin::PhysicsServer::CastShapes(const CollisionShapeDesc &shapeDesc, std::span<const PhysicsShapeCast> casts,
+                                       std::span<PhysicsQueryHit> hits, const PhysicsQueryFilter &filter)
+{
+    CollisionShape shape(shapeDesc);
+    JPH::RefConst<JPH::Shape> joltShape = shape.GetJoltShape<JPH::Shape>();
+    if (joltShape == nullptr)
+    {
+        DN_CORE_WARN("PhysicsServer::CastShapes - could not build the collision shape!");
+        return 0;
+    }
+    return CastShapes(joltShape.GetPtr(), casts, hits, filter);
+}
+
+size_t duin::PhysicsServer::CastShapes(const JPH::Shape *shape, std::span<const PhysicsShapeCast> casts,
+                                       std::span<PhysicsQueryHit> hits, const PhysicsQueryFilter &filter)
+{
+    size_t count = std::min(casts.size(), hits.size());
+    const JPH::NarrowPhaseQuery &query = physicsSystem->GetNarrowPhaseQuery();
+    const JPH::BodyLockInterface &locks = physicsSystem->GetBodyLockInterface();
+    MaskBroadPhaseLayerFilter broadPhaseFilter(filter.broadPhaseLayers);
+    MaskObjectLayerFilter layerFilter(filter.objectLayers);
+    JPH::IgnoreSingleBodyFilter bodyFilter(filter.ignoreBody);
+    JPH::ShapeCastSettings settings;
+    std::atomic<size_t> hitCount{0};
+
+    RunQueryJobs(count, [&](size_t begin, size_t end) {
+        size_t localHits = 0;
+        for (size_t i = begin; i < end; ++i)
+        {
+            PhysicsQueryHit &hit = hits[i];
+            hit = PhysicsQueryHit();
+
+            JPH::RMat44 start = JPH::RMat44::sRotationTranslation(ToJPHQuat(casts[i].rotation).Normalized(),
+                                                                  ToJPHRVec3(casts[i].origin));
+            JPH::RShapeCast cast =
+                JPH::RShapeCast::sFromWorldTransform(shape, JPH::Vec3::sReplicate(1.0f), start,
+                                                     ToJPHVec3(casts[i].direction));
+            JPH::ClosestHitCollisionCollector<JPH::CastShapeCollector> collector;
+            query.CastShape(cast, settings, JPH::RVec3::sZero(), collector, broadPhaseFilter, layerFilter, bodyFilter);
+            if (!collector.HadHit())
+            {
+                continue;
+            }
+
+            const JPH::ShapeCastResult &result = collector.mHit;
+            hit.bodyID = result.mBodyID2;
+            hit.fraction = result.mFraction;
+            hit.position = FromJPHVec3(result.mContactPointOn2);
+            // The penetration axis points into the body hit; its surface faces the other way.
+            if (result.mPenetrationAxis.LengthSq() > 0.0f)
+            {
+                hit.normal = FromJPHVec3(-result.mPenetrationAxis.Normalized());
+            }
+            ReadHitBody(locks, result.mBodyID2, hit);
+            ++localHits;
+        }
+        hitCount += localHits;
+    });
+
+    return hitCount;
+}
+
+size_t duin::PhysicsServer::CollideAABB(const Vector3 &min, const Vector3 &max, std::span<JPH::BodyID> out,
+                                        const PhysicsQueryFilter &filter)
+{
+    if (out.empty())
+    {
+        return 0;
+    }
+    MaskBroadPhaseLayerFilter broadPhaseFilter(filter.broadPhaseLayers);
+    MaskObjectLayerFilter layerFilter(filter.objectLayers);
+    BodySpanCollector collector(out, filter.ignoreBody);
+    physicsSystem->GetBroadPhaseQuery().CollideAABox(JPH::AABox(ToJPHVec3(min), ToJPHVec3(max)), collector,
+                                                      broadPhaseFilter, layerFilter);
+    return collector.count;
+}
+
+void duin::PhysicsServer::RunQueryJobs(size_t count, const std::function<void(size_t, size_t)> &range)
+{
+    // Below this many items a job costs more to schedule than it saves.
+    constexpr size_t MIN_ITEMS_PER_JOB = 32;
+    constexpr size_t MAX_JOBS = 64;
+
+    size_t jobCount = std::min({(count + MIN_ITEMS_PER_JOB - 1) / MIN_ITEMS_PER_JOB,
+                                (size_t)std::max(1, jobSystem->GetMaxConcurrency()), MAX_JOBS});
+    if (jobCount <= 1)
+    {
+        range(0, count);
+        return;
+    }
+
+    // The calling thread runs jobs too while it waits on the barrier.
+    JPH::JobHandle handles[MAX_JOBS];
+    size_t perJob = (count + jobCount - 1) / jobCount;
+    size_t created = 0;
+    for (size_t begin = 0; begin < count; begin += perJob)
+    {
+        size_t end = std::min(count, begin + perJob);
+        handles[created++] =
+            jobSystem->CreateJob("PhysicsQuery", JPH::Color::sCyan, [&range, begin, end]() { range(begin, end); });
+    }
+
+    JPH::JobSystem::Barrier *barrier = jobSystem->CreateBarrier();
+    barrier->AddJobs(handles, (JPH::uint)created);
+    jobSystem->WaitForJobs(barrier);
+    jobSystem->DestroyBarrier(barrier);
 }
 
 void duin::PhysicsServer::DebugDrawBodies()
 {
     JPH::BodyManager::DrawSettings settings;
     JPH::DebugRenderer *r = static_cast<JPH::DebugRenderer *>(&debugRenderer.core);
-    physicsSystem.DrawBodies(settings, r);
+    physicsSystem->DrawBodies(settings, r);
 }
 
 void duin::PhysicsServer::CreatePlane(const Vector3 &normal, const float height)
@@ -3,7 +3,13 @@
 #include <cstdint>
 #include <iostream>
 #include <cstdarg>
+#include <functional>
+#include <memory>
+#include <span>
+#include <string>
 #include <thread>
+#include <unordered_map>
+#include <vector>
 
 #include <Jolt/Jolt.h>
 #include <Jolt/RegisterTypes.h>
@@ -19,7 +25,11 @@
 #include <Jolt/Core/IssueReporting.h>
 
 #include "JoltCollisionSolverInterfaces.h"
+#include "PhysicsConfig.h"
+#include "PhysicsQuery.h"
 #include "PhysicsDebugRenderer.h"
+#include "PhysicsStructs.h"
+#include "CollisionShape.h"
 
 namespace duin
 {
@@ -37,15 +47,123 @@ class CollisionShape;
 class CharacterBody;
 class PhysicsBody;
 
+/** @brief Pose a kinematic body should reach by the end of the next step. */
+struct PhysicsKinematicTarget
+{
+    JPH::BodyID bodyID;
+    Vector3 position;
+    Quaternion rotation;
+};
+
+/** @brief Simulated state of a dynamic body, read after a step. */
+struct PhysicsBodyState
+{
+    JPH::BodyID bodyID;
+    uint64_t userData = 0;
+    Vector3 position;
+    Quaternion rotation;
+    Vector3 linearVelocity;
+};
+
 class PhysicsServer
 {
   public:
     static PhysicsServer &Get();
 
-    void Initialize();
+    /**
+     * @brief Sizes the simulation and builds its collision layers.
+     *
+     * Runs with the default config the first time Get() is called. Calling it again
+     * rebuilds the simulation, which is only allowed while no bodies exist.
+     * @return INIT_FAILED if bodies still exist or the config is unusable.
+     */
+    PhysicsServerError Initialize(const PhysicsConfig &config = PhysicsConfig());
     void Clean();
+
+    const PhysicsConfig &GetConfig() const
+    {
+        return config;
+    }
+
+    /** @return The object layer with this name in the current config, or JPH::cObjectLayerInvalid. */
+    JPH::ObjectLayer GetObjectLayer(const std::string &name) const;
+    /** @brief Advances the simulation by delta seconds (the fixed tick length), then collects its contacts. */
     void StepPhysics(double delta);
 
+    /**
+     * @brief Body pairs that started or stopped touching during the last StepPhysics().
+     *
+     * Jolt reports contacts per sub-shape pair and again every step they persist;
+     * these are folded so each body pair gets one Begin when its first sub-shape
+     * contact appears and one End when its last one goes. Begins come before the
+     * Ends of the same pair. A pair that falls asleep stays in contact until its
+     * bodies wake apart or one of them is destroyed; a destroyed body's Ends come
+     * with the next step. Valid until the next step.
+     */
+    std::span<const PhysicsContactEvent> GetContactEvents() const
+    {
+        return contactEvents;
+    }
+
+    /**
+     * @brief Creates a body and adds it to the simulation.
+     * @param userData Stored on the body and returned by ReadActiveBodies (the ECS stores the entity id).
+     * @param layer Object layer; by default NON_MOVING for static bodies and MOVING for the rest.
+     * @return The new body, or an invalid id if the shape could not be built.
+     */
+    JPH::BodyID CreateBody(const CollisionShapeDesc &shapeDesc, PhysicsMotionType motionType,
+                           const Vector3 &position, const Quaternion &rotation, uint64_t userData = 0,
+                           JPH::ObjectLayer layer = JPH::cObjectLayerInvalid);
+    /** @brief Removes and destroys the body; pairs it was touching get an End in the next step's events. */
+    void DestroyBody(JPH::BodyID bodyID);
+
+    /**
+     * @brief Moves kinematic bodies towards their targets over the next step.
+     *
+     * All bodies are locked once for the whole batch; the ones that were asleep
+     * are woken together afterwards.
+     */
+    void MoveKinematicBodies(const PhysicsKinematicTarget *targets, size_t count);
+
+    /**
+     * @brief Replaces out with the state of every awake dynamic body.
+     *
+     * Only Jolt's active-body list is visited, so sleeping bodies cost nothing.
+     */
+    void ReadActiveBodies(std::vector<PhysicsBodyState> &out);
+
+    /**
+     * @name Scene queries
+     * Batched and allocation-free on the caller's side; large batches are split
+     * across the physics job system. Must not overlap StepPhysics().
+     * @{
+     */
+
+    /**
+     * @brief Casts every ray and writes its closest hit to the same index of hits.
+     * @return Number of rays that hit something. Only min(rays, hits) rays are cast.
+     */
+    size_t CastRays(std::span<const PhysicsRay> rays, std::span<PhysicsQueryHit> hits,
+                    const PhysicsQueryFilter &filter = PhysicsQueryFilter());
+
+    /**
+     * @brief Sweeps one shape along every cast and writes its closest hit to the same index of hits.
+     * @return Number of casts that hit something, or 0 if the shape could not be built.
+     */
+    size_t CastShapes(const CollisionShapeDesc &shape, std::span<const PhysicsShapeCast> casts,
+                      std::span<PhysicsQueryHit> hits, const PhysicsQueryFilter &filter = PhysicsQueryFilter());
+
+    /**
+     * @brief Collects the bodies whose bounds overlap the box.
+     *
+     * Only the broadphase is consulted, so bodies are matched by their bounding
+     * boxes. Collection stops once out is full.
+     * @return Number of ids written to out.
+     */
+    size_t CollideAABB(const Vector3 &min, const Vector3 &max, std::span<JPH::BodyID> out,
+                       const PhysicsQueryFilter &filter = PhysicsQueryFilter());
+    /** @} */
+
     void DebugDrawBodies();
 
     void CreatePlane(const Vector3& normal, const float height);
@@ -59,12 +177,9 @@ class PhysicsServer
     friend class CollisionShape;
     friend class PhysicsMaterial;
 
-    const JPH::uint cMaxBodies = 1024;
-    const JPH::uint cNumBodyMutexes = 0;
-    const JPH::uint cMaxBodyPairs = 1024;
-    const JPH::uint cMaxContactConstraints = 1024;
-    const float cDeltaTime = 1.0f / 60.0f;
-    int cCollisionSteps = 1;
+    PhysicsConfig config;
+    // Length of the last step; kinematic targets are reached over one step of this length.
+    float stepDeltaTime = 1.0f / 60.0f;
 
     PhysicsDebugRenderer debugRenderer;
 
@@ -73,17 +188,51 @@ class PhysicsServer
     BPLayerInterfaceImpl broadPhaseLayerInterface;
     ObjectVsBroadPhaseLayerFilterImpl objectVsBroadphaseLayerFilter;
     ObjectLayerPairFilterImpl objectVsObjectLayerFilter;
-    JPH::PhysicsSystem physicsSystem;
+    // Rebuilt by Initialize(); declared after the layer interfaces it references.
+    std::unique_ptr<JPH::PhysicsSystem> physicsSystem;
     JPH::BodyInterface *bodyInterface;
 
+    // Scratch buffers reused by the batch calls.
+    JPH::BodyIDVector activeBodyIDs;
+    std::vector<JPH::BodyID> batchBodyIDs;
+
     // TODO %optional%
     MyBodyActivationListener bodyActivationListener;
     MyContactListener contactListener;
 
+    // A body pair in contact: how many of its sub-shape pairs touch, and whom to tell when the last one goes.
+    struct ContactPair
+    {
+        uint32_t subShapeContacts = 0;
+        uint64_t userData1 = 0;
+        uint64_t userData2 = 0;
+        bool isSensor = false;
+        // Sub-shape contacts Jolt removed because a body fell asleep; they come back when it wakes.
+        uint32_t sleepingContacts = 0;
+        uint8_t awakeDrains = 0;
+        bool inSleepingPairs = false;
+    };
+    std::unordered_map<uint64_t, ContactPair> activeContacts;
+    std::vector<uint64_t> sleepingPairs;
+    std::vector<PhysicsContactEvent> contactEvents;
+    std::vector<PhysicsContactEvent> destroyedContactEvents;
+
     PhysicsServer();
     ~PhysicsServer();
 
     JPH::BodyInterface &BodyInterface();
+
+    // Folds the contact records of the last step into contactEvents.
+    void DrainContacts();
+    void FoldContactRecord(const PhysicsContactRecord &record);
+    void ExpireSleepingContacts();
+    bool IsSleeping(JPH::BodyID bodyID) const;
+    static void AddContactEnd(std::vector<PhysicsContactEvent> &events, uint64_t key, const ContactPair &pair);
+
+    size_t CastShapes(const JPH::Shape *shape, std::span<const PhysicsShapeCast> casts,
+                      std::span<PhysicsQueryHit> hits, const PhysicsQueryFilter &filter = PhysicsQueryFilter());
+    // Calls range(begin, end) over [0, count), split into jobs when the batch is large.
+    void RunQueryJobs(size_t count, const std::function<void(size_t, size_t)> &range);
 };
 
 } // namespace duin
@@ -1,10 +1,19 @@
 #pragma once
 
 #include "Duin/Core/Maths/DuinMaths.h"
+#include <cstdint>
 
 namespace duin
 {
 
+/** @brief How a body moves: never, along a path set by the game, or under simulation. */
+enum class PhysicsMotionType : uint8_t
+{
+    Static,
+    Kinematic,
+    Dynamic
+};
+
 typedef struct Transform3D
 {
     Vector3 translation;
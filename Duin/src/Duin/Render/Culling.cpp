@@ -0,0 +1,257 @@
+#include "dnpch.h"
+#include "Culling.h"
+
+#include <cmath>
+#include <xmmintrin.h>
+
+namespace duin
+{
+
+// ---------------------------------------------------------------------------
+// Frustum
+// ---------------------------------------------------------------------------
+
+Frustum Frustum::FromViewProjection(const float *view, const float *proj)
+{
+    // Row-vector convention: clip = p * view * proj.
+    float viewProj[16];
+    for (int r = 0; r < 4; ++r)
+    {
+        for (int c = 0; c < 4; ++c)
+        {
+            viewProj[r * 4 + c] = view[r * 4 + 0] * proj[0 * 4 + c] + view[r * 4 + 1] * proj[1 * 4 + c] +
+                                  view[r * 4 + 2] * proj[2 * 4 + c] + view[r * 4 + 3] * proj[3 * 4 + c];
+        }
+    }
+    return FromMatrix(viewProj);
+}
+
+Frustum Frustum::FromMatrix(const float *m)
+{
+    // Clip component c of a point is dot((x, y, z, 1), column c).
+    auto column = [m](int c, float *out) {
+        out[0] = m[0 * 4 + c];
+        out[1] = m[1 * 4 + c];
+        out[2] = m[2 * 4 + c];
+        out[3] = m[3 * 4 + c];
+    };
+    float cx[4], cy[4], cz[4], cw[4];
+    column(0, cx);
+    column(1, cy);
+    column(2, cz);
+    column(3, cw);
+
+    Frustum frustum;
+    for (int i = 0; i < 4; ++i)
+    {
+        frustum.planes[PLANE_LEFT][i] = cw[i] + cx[i];
+        frustum.planes[PLANE_RIGHT][i] = cw[i] - cx[i];
+        frustum.planes[PLANE_BOTTOM][i] = cw[i] + cy[i];
+        frustum.planes[PLANE_TOP][i] = cw[i] - cy[i];
+        frustum.planes[PLANE_NEAR][i] = cw[i] + cz[i];
+        frustum.planes[PLANE_FAR][i] = cw[i] - cz[i];
+    }
+
+    // Normalized planes give true distances, which the sphere test needs.
+    for (float *plane : frustum.planes)
+    {
+        float length = std::sqrt(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+        if (length > 0.0f)
+        {
+            float inv = 1.0f / length;
+            plane[0] *= inv;
+            plane[1] *= inv;
+            plane[2] *= inv;
+            plane[3] *= inv;
+        }
+    }
+    return frustum;
+}
+
+bool Frustum::TestSphere(Vector3 center, float radius) const
+{
+    for (const float *plane : planes)
+    {
+        if (plane[0] * center.x + plane[1] * center.y + plane[2] * center.z + plane[3] < -radius)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Frustum::TestAABB(Vector3 min, Vector3 max) const
+{
+    for (const float *plane : planes)
+    {
+        // The corner furthest along the plane normal.
+        float px = plane[0] >= 0.0f ? max.x : min.x;
+        float py = plane[1] >= 0.0f ? max.y : min.y;
+        float pz = plane[2] >= 0.0f ? max.z : min.z;
+        if (plane[0] * px + plane[1] * py + plane[2] * pz + plane[3] < 0.0f)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Scalar fallbacks
+// ---------------------------------------------------------------------------
+
+static bool SphereInRange(const CullingParams &params, float x, float y, float z, float r)
+{
+    if (params.maxDistance <= 0.0f)
+    {
+        return true;
+    }
+    float dx = x - params.eye.x;
+    float dy = y - params.eye.y;
+    float dz = z - params.eye.z;
+    float limit = params.maxDistance + r;
+    return dx * dx + dy * dy + dz * dz <= limit * limit;
+}
+
+static bool AABBInRange(const CullingParams &params, Vector3 min, Vector3 max)
+{
+    if (params.maxDistance <= 0.0f)
+    {
+        return true;
+    }
+    // Distance from the eye to the closest point of the box.
+    float dx = std::fmax(std::fmax(min.x - params.eye.x, 0.0f), params.eye.x - max.x);
+    float dy = std::fmax(std::fmax(min.y - params.eye.y, 0.0f), params.eye.y - max.y);
+    float dz = std::fmax(std::fmax(min.z - params.eye.z, 0.0f), params.eye.z - max.z);
+    return dx * dx + dy * dy + dz * dz <= params.maxDistance * params.maxDistance;
+}
+
+// ---------------------------------------------------------------------------
+// Batches, four bounds per iteration
+// ---------------------------------------------------------------------------
+
+static size_t StoreMask(int mask, uint8_t *visible)
+{
+    size_t passed = 0;
+    for (int lane = 0; lane < 4; ++lane)
+    {
+        uint8_t bit = static_cast<uint8_t>((mask >> lane) & 1);
+        visible[lane] = bit;
+        passed += bit;
+    }
+    return passed;
+}
+
+size_t CullSpheres(const Frustum &frustum, const CullingParams &params, const float *centerX, const float *centerY,
+                   const float *centerZ, const float *radius, size_t count, uint8_t *visible)
+{
+    const bool distanceCull = params.maxDistance > 0.0f;
+    const __m128 eyeX = _mm_set1_ps(params.eye.x);
+    const __m128 eyeY = _mm_set1_ps(params.eye.y);
+    const __m128 eyeZ = _mm_set1_ps(params.eye.z);
+    const __m128 maxDistance = _mm_set1_ps(params.maxDistance);
+    const __m128 zero = _mm_setzero_ps();
+
+    size_t passed = 0;
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 x = _mm_loadu_ps(centerX + i);
+        __m128 y = _mm_loadu_ps(centerY + i);
+        __m128 z = _mm_loadu_ps(centerZ + i);
+        __m128 r = _mm_loadu_ps(radius + i);
+        __m128 negR = _mm_sub_ps(zero, r);
+
+        __m128 inside = _mm_cmpeq_ps(zero, zero);
+        for (const float *plane : frustum.planes)
+        {
+            __m128 d = _mm_mul_ps(_mm_set1_ps(plane[0]), x);
+            d = _mm_add_ps(d, _mm_mul_ps(_mm_set1_ps(plane[1]), y));
+            d = _mm_add_ps(d, _mm_mul_ps(_mm_set1_ps(plane[2]), z));
+            d = _mm_add_ps(d, _mm_set1_ps(plane[3]));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(d, negR));
+        }
+
+        if (distanceCull)
+        {
+            __m128 dx = _mm_sub_ps(x, eyeX);
+            __m128 dy = _mm_sub_ps(y, eyeY);
+            __m128 dz = _mm_sub_ps(z, eyeZ);
+            __m128 d2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+            __m128 limit = _mm_add_ps(maxDistance, r);
+            inside = _mm_and_ps(inside, _mm_cmple_ps(d2, _mm_mul_ps(limit, limit)));
+        }
+
+        passed += StoreMask(_mm_movemask_ps(inside), visible + i);
+    }
+
+    for (; i < count; ++i)
+    {
+        bool in = frustum.TestSphere(Vector3(centerX[i], centerY[i], centerZ[i]), radius[i]) &&
+                  SphereInRange(params, centerX[i], centerY[i], centerZ[i], radius[i]);
+        visible[i] = in ? 1 : 0;
+        passed += visible[i];
+    }
+    return passed;
+}
+
+size_t CullAABBs(const Frustum &frustum, const CullingParams &params, const float *minX, const float *minY,
+                 const float *minZ, const float *maxX, const float *maxY, const float *maxZ, size_t count,
+                 uint8_t *visible)
+{
+    const bool distanceCull = params.maxDistance > 0.0f;
+    const __m128 eyeX = _mm_set1_ps(params.eye.x);
+    const __m128 eyeY = _mm_set1_ps(params.eye.y);
+    const __m128 eyeZ = _mm_set1_ps(params.eye.z);
+    const __m128 maxDistanceSq = _mm_set1_ps(params.maxDistance * params.maxDistance);
+    const __m128 zero = _mm_setzero_ps();
+
+    size_t passed = 0;
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 x0 = _mm_loadu_ps(minX + i);
+        __m128 y0 = _mm_loadu_ps(minY + i);
+        __m128 z0 = _mm_loadu_ps(minZ + i);
+        __m128 x1 = _mm_loadu_ps(maxX + i);
+        __m128 y1 = _mm_loadu_ps(maxY + i);
+        __m128 z1 = _mm_loadu_ps(maxZ + i);
+
+        __m128 inside = _mm_cmpeq_ps(zero, zero);
+        for (const float *plane : frustum.planes)
+        {
+            // The plane is uniform across lanes, so the furthest corner is picked per plane, not per lane.
+            __m128 px = plane[0] >= 0.0f ? x1 : x0;
+            __m128 py = plane[1] >= 0.0f ? y1 : y0;
+            __m128 pz = plane[2] >= 0.0f ? z1 : z0;
+            __m128 d = _mm_mul_ps(_mm_set1_ps(plane[0]), px);
+            d = _mm_add_ps(d, _mm_mul_ps(_mm_set1_ps(plane[1]), py));
+            d = _mm_add_ps(d, _mm_mul_ps(_mm_set1_ps(plane[2]), pz));
+            d = _mm_add_ps(d, _mm_set1_ps(plane[3]));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(d, zero));
+        }
+
+        if (distanceCull)
+        {
+            __m128 dx = _mm_max_ps(_mm_max_ps(_mm_sub_ps(x0, eyeX), zero), _mm_sub_ps(eyeX, x1));
+            __m128 dy = _mm_max_ps(_mm_max_ps(_mm_sub_ps(y0, eyeY), zero), _mm_sub_ps(eyeY, y1));
+            __m128 dz = _mm_max_ps(_mm_max_ps(_mm_sub_ps(z0, eyeZ), zero), _mm_sub_ps(eyeZ, z1));
+            __m128 d2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+            inside = _mm_and_ps(inside, _mm_cmple_ps(d2, maxDistanceSq));
+        }
+
+        passed += StoreMask(_mm_movemask_ps(inside), visible + i);
+    }
+
+    for (; i < count; ++i)
+    {
+        Vector3 min(minX[i], minY[i], minZ[i]);
+        Vector3 max(maxX[i], maxY[i], maxZ[i]);
+        bool in = frustum.TestAABB(min, max) && AABBInRange(params, min, max);
+        visible[i] = in ? 1 : 0;
+        passed += visible[i];
+    }
+    return passed;
+}
+
+} // namespace duin
@@ -0,0 +1,95 @@
+/**
+ * @file Culling.h
+ * @brief View frustum and distance culling.
+ * @ingroup Render_Core
+ *
+ * Bounds are tested in batches laid out as structure-of-arrays (one array per
+ * coordinate), four at a time with SSE where available. The Renderer culls
+ * every positioned draw against the frustum of the camera it was queued under;
+ * ECS systems can use the same functions to reject entities before queueing.
+ *
+ * Matrices use the RHI layout (float[16], translation in elements 12-14).
+ */
+
+#pragma once
+
+#include "Duin/Core/Maths/DuinMaths.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace duin
+{
+
+/**
+ * @struct Frustum
+ * @brief Six inward-facing planes (a, b, c, d): a point p is inside when a*p.x + b*p.y + c*p.z + d >= 0.
+ * @ingroup Render_Core
+ */
+struct Frustum
+{
+    enum Plane
+    {
+        PLANE_LEFT = 0,
+        PLANE_RIGHT,
+        PLANE_BOTTOM,
+        PLANE_TOP,
+        PLANE_NEAR,
+        PLANE_FAR,
+        PLANE_COUNT
+    };
+
+    float planes[PLANE_COUNT][4] = {};
+
+    /**
+     * @brief Extracts the planes of a view * projection product.
+     *
+     * The near plane is taken for a [-1, 1] depth range, which is also a
+     * conservative bound for [0, 1] backends.
+     */
+    static Frustum FromViewProjection(const float *view, const float *proj);
+    static Frustum FromMatrix(const float *viewProj);
+
+    bool TestSphere(Vector3 center, float radius) const;
+    bool TestAABB(Vector3 min, Vector3 max) const;
+};
+
+/**
+ * @struct CullingParams
+ * @brief Optional distance cull applied on top of the frustum test.
+ * @ingroup Render_Core
+ */
+struct CullingParams
+{
+    Vector3 eye;              ///< Camera position.
+    float maxDistance = 0.0f; ///< Bounds entirely farther than this from eye are culled. 0 disables.
+};
+
+/**
+ * @struct CullingStats
+ * @brief Counters of one frame of culling.
+ * @ingroup Render_Core
+ */
+struct CullingStats
+{
+    uint32_t tested = 0;    ///< Bounds tested.
+    uint32_t culled = 0;    ///< Bounds rejected by the frustum or distance test.
+    uint32_t submitted = 0; ///< Bounds that passed and were drawn.
+};
+
+/**
+ * @brief Tests `count` bounding spheres. Writes 1 to visible[i] for each that passes, 0 otherwise.
+ * @return The number of visible spheres.
+ */
+size_t CullSpheres(const Frustum &frustum, const CullingParams &params, const float *centerX, const float *centerY,
+                   const float *centerZ, const float *radius, size_t count, uint8_t *visible);
+
+/**
+ * @brief Tests `count` axis-aligned boxes. Writes 1 to visible[i] for each that passes, 0 otherwise.
+ * @return The number of visible boxes.
+ */
+size_t CullAABBs(const Frustum &frustum, const CullingParams &params, const float *minX, const float *minY,
+                 const float *minZ, const float *maxX, const float *maxY, const float *maxZ, size_t count,
+                 uint8_t *visible);
+
+} // namespace duin
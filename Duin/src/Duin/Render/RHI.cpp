@@ -9,16 +9,22 @@
 #include "external/imgui.h"
 
 #include "Duin/Core/Debug/DNLog.h"
+#include "Duin/IO/Filesystem.h"
 
 #include <cstdio>
 #include <cstring>
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 #include <cstdint>
 #include <bgfx/defines.h>
 #include <bx/bounds.h>
 #include <SDL3/SDL_properties.h>
 #include <SDL3/SDL_video.h>
 #include <functional>
+#include <algorithm>
+#include <mutex>
+#include <thread>
 
 namespace duin
 {
@@ -34,8 +40,37 @@ const uint32_t RHI_RESET_VSYNC = BGFX_RESET_VSYNC;
 // ---------------------------------------------------------------------------
 
 static bgfx::VertexLayout s_pcvLayout;
+static bgfx::VertexLayout s_meshLayout;
 static DebugDrawEncoder s_dde;
 
+static bool s_recording = false;
+static std::mutex s_recordMutex; // encoders may record from several threads
+static RHICommandStream s_commandStream;
+
+static void Record(const RHICommand &command, const float *data = nullptr, uint32_t count = 0)
+{
+    std::lock_guard<std::mutex> lock(s_recordMutex);
+    RHICommand &recorded = s_commandStream.commands.emplace_back(command);
+    if (data)
+    {
+        recorded.dataOffset = static_cast<uint32_t>(s_commandStream.data.size());
+        recorded.dataCount = count;
+        s_commandStream.data.insert(s_commandStream.data.end(), data, data + count);
+    }
+}
+
+static RHICommand MakeCommand(RHICommandType type, uint16_t view = 0, uint16_t handle = UINT16_MAX,
+                              uint16_t program = UINT16_MAX, uint32_t value = 0)
+{
+    RHICommand command;
+    command.type = type;
+    command.view = view;
+    command.handle = handle;
+    command.program = program;
+    command.value = value;
+    return command;
+}
+
 // Handle conversions -- both sides store a uint16_t idx, so direct copy.
 
 static bgfx::TextureHandle ToBgfx(RHITextureHandle h)
@@ -166,12 +201,27 @@ static void MatrixAsArray(const float *m, float *r)
 // Setup/Shutdown
 // ---------------------------------------------------------------------------
 
-void RHIStart(RHIViewId viewId, uint32_t width, uint32_t height, std::function<HWND(void)> renderThreadCapture, bool headless)
+void RHIStart(RHIViewId viewId, uint32_t width, uint32_t height, std::function<void *(void)> renderThreadCapture,
+              bool headless, RHIBackend backend)
 {
     bgfx::Init bgfxInit;
     bgfxInit.type = bgfx::RendererType::Count; // Automatically choose a renderer
+    // One encoder per hardware thread so ParallelDraw never runs short on a full pool.
+    bgfxInit.limits.maxEncoders = static_cast<uint16_t>(
+        std::max<uint32_t>(bgfxInit.limits.maxEncoders, std::thread::hardware_concurrency()));
 
-    if (headless)
+    s_recording = backend == RHIBackend::Recording;
+    s_commandStream.Clear();
+
+    if (s_recording)
+    {
+        bgfxInit.type = bgfx::RendererType::Noop;
+        bgfxInit.resolution.width = width;
+        bgfxInit.resolution.height = height;
+        bgfxInit.resolution.reset = BGFX_RESET_NONE;
+        bgfxInit.platformData.nwh = nullptr;
+    }
+    else if (headless)
     {
         bgfxInit.resolution.width = 0;
         bgfxInit.resolution.height = 0;
@@ -181,35 +231,56 @@ void RHIStart(RHIViewId viewId, uint32_t width, uint32_t height, std::function<H
     else
     {
         bgfx::renderFrame(); // Claim render thread before bgfx::init() spawns one
-        ::HWND hwnd = renderThreadCapture();
-        if (!hwnd)
+        void *nwh = renderThreadCapture();
+        if (!nwh)
         {
             DN_CORE_FATAL("SDL3 window handle not found!");
         }
         bgfxInit.resolution.width = width;
         bgfxInit.resolution.height = height;
         bgfxInit.resolution.reset = BGFX_RESET_VSYNC;
-        bgfxInit.platformData.nwh = hwnd;
+        bgfxInit.platformData.nwh = nwh;
     }
 
     bgfx::init(bgfxInit);
 
-    if (!headless)
+    if (!headless && !s_recording)
     {
         bgfx::setViewClear(viewId, BGFX_CLEAR_COLOR | BGFX_CLEAR_DEPTH, 0x443355FF, 1.0f, 0);
         bgfx::setViewRect(viewId, 0, 0, width, height);
     }
 
-    DN_CORE_INFO("RHI [bgfx] started (headless={}).", headless);
+    DN_CORE_INFO("RHI [bgfx] started (headless={}, recording={}).", headless, s_recording);
 }
 
 void RHIClose()
 {
     bgfx::shutdown();
+    s_recording = false;
 
     DN_CORE_INFO("RHI [bgfx] closed.");
 }
 
+// ---------------------------------------------------------------------------
+// Command capture
+// ---------------------------------------------------------------------------
+
+bool RHIIsRecording()
+{
+    return s_recording;
+}
+
+const RHICommandStream &RHIGetCommandStream()
+{
+    return s_commandStream;
+}
+
+void RHIClearCommandStream()
+{
+    std::lock_guard<std::mutex> lock(s_recordMutex);
+    s_commandStream.Clear();
+}
+
 // ---------------------------------------------------------------------------
 // Lifecycle
 // ---------------------------------------------------------------------------
@@ -221,6 +292,13 @@ void RHIInit()
         .add(bgfx::Attrib::Color0, 4, bgfx::AttribType::Uint8, true)
         .end();
 
+    // PackedMeshVertex: snorm16 position, octahedral snorm16 normal, half-float UV.
+    s_meshLayout.begin()
+        .add(bgfx::Attrib::Position, 4, bgfx::AttribType::Int16, true)
+        .add(bgfx::Attrib::TexCoord1, 2, bgfx::AttribType::Int16, true)
+        .add(bgfx::Attrib::TexCoord0, 2, bgfx::AttribType::Half)
+        .end();
+
     RHIDebugDrawInit();
 }
 
@@ -236,6 +314,10 @@ void RHIShutdown()
 
 void RHIFrame()
 {
+    if (s_recording)
+    {
+        Record(MakeCommand(RHICommandType::Frame));
+    }
     bgfx::frame();
 }
 
@@ -265,13 +347,57 @@ RHIShaderHandle RHILoadShader(const char *path)
     return FromBgfx(bgfx::createShader(mem));
 }
 
+RHIShaderHandle RHILoadEngineShader(const char *name)
+{
+    const char *dir = nullptr;
+    switch (bgfx::getRendererType())
+    {
+    case bgfx::RendererType::Noop: {
+        // Same placeholder bgfx's embedded shaders use for Noop: a header with no uniforms.
+        static const uint8_t placeholder[] = {'V', 'S', 'H', 0x5, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0};
+        return FromBgfx(bgfx::createShader(bgfx::makeRef(placeholder, sizeof(placeholder))));
+    }
+    case bgfx::RendererType::Direct3D11:
+    case bgfx::RendererType::Direct3D12:
+        dir = "dx11";
+        break;
+    case bgfx::RendererType::OpenGL:
+        dir = "glsl";
+        break;
+    case bgfx::RendererType::OpenGLES:
+        dir = "essl";
+        break;
+    case bgfx::RendererType::Metal:
+        dir = "metal";
+        break;
+    case bgfx::RendererType::Vulkan:
+        dir = "spirv";
+        break;
+    default:
+        DN_CORE_ERROR("No engine shaders for renderer {}.", bgfx::getRendererName(bgfx::getRendererType()));
+        return RHIShaderHandle();
+    }
+
+    std::string path = fs::MapVirtualToSystemPath("bin://shaders/" + std::string(dir) + "/" + name + ".bin");
+    return RHILoadShader(path.c_str());
+}
+
 RHIProgramHandle RHICreateProgram(RHIShaderHandle vsh, RHIShaderHandle fsh, bool destroyShaders)
 {
-    return FromBgfx(bgfx::createProgram(ToBgfx(vsh), ToBgfx(fsh), destroyShaders));
+    RHIProgramHandle program = FromBgfx(bgfx::createProgram(ToBgfx(vsh), ToBgfx(fsh), destroyShaders));
+    if (s_recording)
+    {
+        Record(MakeCommand(RHICommandType::CreateProgram, 0, program.idx));
+    }
+    return program;
 }
 
 void RHIDestroyProgram(RHIProgramHandle handle)
 {
+    if (s_recording)
+    {
+        Record(MakeCommand(RHICommandType::DestroyProgram, 0, handle.idx));
+    }
     bgfx::ProgramHandle bh = ToBgfx(handle);
     if (bgfx::isValid(bh))
     {
@@ -283,20 +409,51 @@ void RHIDestroyProgram(RHIProgramHandle handle)
 // Vertex / Index Buffers
 // ---------------------------------------------------------------------------
 
-RHIVertexBufferHandle RHICreateVertexBuffer(const void *data, uint32_t sizeBytes)
+static const bgfx::Memory *MakeMemory(const void *data, uint32_t sizeBytes, RHIBufferData mode)
+{
+    return mode == RHIBufferData::Copy ? bgfx::copy(data, sizeBytes) : bgfx::makeRef(data, sizeBytes);
+}
+
+RHIVertexBufferHandle RHICreateVertexBuffer(const void *data, uint32_t sizeBytes, RHIVertexFormat format,
+                                            RHIBufferData mode)
 {
-    bgfx::VertexBufferHandle vbh = bgfx::createVertexBuffer(bgfx::makeRef(data, sizeBytes), s_pcvLayout);
+    const bgfx::VertexLayout &layout = format == RHIVertexFormat::PackedMesh ? s_meshLayout : s_pcvLayout;
+    bgfx::VertexBufferHandle vbh = bgfx::createVertexBuffer(MakeMemory(data, sizeBytes, mode), layout);
+    if (s_recording)
+    {
+        Record(MakeCommand(RHICommandType::CreateVertexBuffer, 0, vbh.idx, UINT16_MAX, sizeBytes));
+    }
     return FromBgfx(vbh);
 }
 
 RHIIndexBufferHandle RHICreateIndexBuffer(const uint16_t *data, uint32_t count)
 {
     bgfx::IndexBufferHandle ibh = bgfx::createIndexBuffer(bgfx::makeRef(data, count * sizeof(uint16_t)));
+    if (s_recording)
+    {
+        Record(MakeCommand(RHICommandType::CreateIndexBuffer, 0, ibh.idx, UINT16_MAX, count));
+    }
+    return FromBgfx(ibh);
+}
+
+RHIIndexBufferHandle RHICreateIndexBuffer(const void *data, uint32_t count, bool index32, RHIBufferData mode)
+{
+    const uint32_t indexSize = index32 ? sizeof(uint32_t) : sizeof(uint16_t);
+    bgfx::IndexBufferHandle ibh = bgfx::createIndexBuffer(MakeMemory(data, count * indexSize, mode),
+                                                          index32 ? BGFX_BUFFER_INDEX32 : BGFX_BUFFER_NONE);
+    if (s_recording)
+    {
+        Record(MakeCommand(RHICommandType::CreateIndexBuffer, 0, ibh.idx, UINT16_MAX, count));
+    }
     return FromBgfx(ibh);
 }
 
 void RHIDestroyVertexBuffer(RHIVertexBufferHandle handle)
 {
+    if (s_recording)
+    {
+        Record(MakeCommand(RHICommandType::DestroyVertexBuffer, 0, handle.idx));
+    }
     bgfx::VertexBufferHandle bh = ToBgfx(handle);
     if (bgfx::isValid(bh))
     {
@@ -306,6 +463,10 @@ void RHIDestroyVertexBuffer(RHIVertexBufferHandle handle)
 
 void RHIDestroyIndexBuffer(RHIIndexBufferHandle handle)
 {
+    if (s_recording)
+    {
+        Record(MakeCommand(RHICommandType::DestroyIndexBuffer, 0, handle.idx));
+    }
     bgfx::IndexBufferHandle bh = ToBgfx(handle);
     if (bgfx::isValid(bh))
     {
@@ -329,6 +490,11 @@ RHITextureHandle RHICreateTexture2D(uint16_t width, uint16_t height)
                                                     BGFX_TEXTURE_RT | BGFX_SAMPLER_MIN_POINT | BGFX_SAMPLER_MAG_POINT |
                                                         BGFX_SAMPLER_MIP_POINT);
 
+    if (s_recording)
+    {
+        Record(MakeCommand(RHICommandType::CreateTexture, 0, tex.idx, UINT16_MAX,
+                           (static_cast<uint32_t>(width) << 16) | height));
+    }
     return FromBgfx(tex);
 }
 
@@ -336,6 +502,10 @@ RHIFrameBufferHandle RHICreateFrameBuffer(RHITextureHandle texture)
 {
     bgfx::TextureHandle tex = ToBgfx(texture);
     bgfx::FrameBufferHandle fb = bgfx::createFrameBuffer(1, &tex);
+    if (s_recording)
+    {
+        Record(MakeCommand(RHICommandType::CreateFrameBuffer, 0, fb.idx, UINT16_MAX, texture.idx));
+    }
     return FromBgfx(fb);
 }
 
@@ -368,26 +538,50 @@ uint16_t RHIGetTextureIdx(RHITextureHandle handle)
 
 void RHISetViewTransform(RHIViewId viewId, const float *view, const float *proj)
 {
+    if (s_recording)
+    {
+        float matrices[32];
+        std::memcpy(matrices, view, sizeof(float) * 16);
+        std::memcpy(matrices + 16, proj, sizeof(float) * 16);
+        Record(MakeCommand(RHICommandType::SetViewTransform, viewId), matrices, 32);
+    }
     bgfx::setViewTransform(viewId, view, proj);
 }
 
 void RHISetViewRect(RHIViewId viewId, uint16_t x, uint16_t y, uint16_t width, uint16_t height)
 {
+    if (s_recording)
+    {
+        float rect[4] = {float(x), float(y), float(width), float(height)};
+        Record(MakeCommand(RHICommandType::SetViewRect, viewId), rect, 4);
+    }
     bgfx::setViewRect(viewId, x, y, width, height);
 }
 
 void RHISetViewClear(RHIViewId viewId, uint32_t rgba, float depth, uint8_t stencil)
 {
+    if (s_recording)
+    {
+        Record(MakeCommand(RHICommandType::SetViewClear, viewId, UINT16_MAX, UINT16_MAX, rgba));
+    }
     bgfx::setViewClear(viewId, BGFX_CLEAR_COLOR | BGFX_CLEAR_DEPTH, rgba, depth, stencil);
 }
 
 void RHISetViewFrameBuffer(RHIViewId viewId, RHIFrameBufferHandle handle)
 {
+    if (s_recording)
+    {
+        Record(MakeCommand(RHICommandType::SetViewFrameBuffer, viewId, handle.idx));
+    }
     bgfx::setViewFrameBuffer(viewId, ToBgfx(handle));
 }
 
 void RHITouch(RHIViewId viewId)
 {
+    if (s_recording)
+    {
+        Record(MakeCommand(RHICommandType::Touch, viewId));
+    }
     bgfx::touch(viewId);
 }
 
@@ -395,9 +589,9 @@ void RHITouch(RHIViewId viewId)
 // Encoder
 // ---------------------------------------------------------------------------
 
-RHIEncoder *RHIBeginEncoder()
+RHIEncoder *RHIBeginEncoder(bool forThread)
 {
-    return FromEncoder(bgfx::begin(false));
+    return FromEncoder(bgfx::begin(forThread));
 }
 
 void RHIEndEncoder(RHIEncoder *enc)
@@ -408,26 +602,98 @@ void RHIEndEncoder(RHIEncoder *enc)
     }
 }
 
+uint32_t RHIGetMaxEncoders()
+{
+    return bgfx::getCaps()->limits.maxEncoders;
+}
+
 void RHIEncoderSetTransform(RHIEncoder *enc, const float *mtx)
 {
+    if (s_recording)
+    {
+        Record(MakeCommand(RHICommandType::SetTransform), mtx, 16);
+    }
     ToEncoder(enc)->setTransform(mtx);
 }
 
 void RHIEncoderSetVertexBuffer(RHIEncoder *enc, uint8_t stream, RHIVertexBufferHandle handle)
 {
+    if (s_recording)
+    {
+        Record(MakeCommand(RHICommandType::SetVertexBuffer, 0, handle.idx, UINT16_MAX, stream));
+    }
     ToEncoder(enc)->setVertexBuffer(stream, ToBgfx(handle));
 }
 
 void RHIEncoderSetIndexBuffer(RHIEncoder *enc, RHIIndexBufferHandle handle)
 {
+    if (s_recording)
+    {
+        Record(MakeCommand(RHICommandType::SetIndexBuffer, 0, handle.idx));
+    }
     ToEncoder(enc)->setIndexBuffer(ToBgfx(handle));
 }
 
 void RHIEncoderSubmit(RHIEncoder *enc, RHIViewId viewId, RHIProgramHandle program)
 {
+    if (s_recording)
+    {
+        Record(MakeCommand(RHICommandType::Submit, viewId, UINT16_MAX, program.idx));
+    }
     ToEncoder(enc)->submit(viewId, ToBgfx(program));
 }
 
+void RHIEncoderSubmit(RHIEncoder *enc, RHIViewId viewId, RHIProgramHandle program, uint32_t depth, bool preserveBuffers)
+{
+    uint8_t flags = BGFX_DISCARD_ALL;
+    if (preserveBuffers)
+    {
+        flags = static_cast<uint8_t>(flags & ~(BGFX_DISCARD_VERTEX_STREAMS | BGFX_DISCARD_INDEX_BUFFER));
+    }
+    if (s_recording)
+    {
+        Record(MakeCommand(RHICommandType::Submit, viewId, UINT16_MAX, program.idx, depth));
+    }
+    ToEncoder(enc)->submit(viewId, ToBgfx(program), depth, flags);
+}
+
+void RHIEncoderDiscard(RHIEncoder *enc)
+{
+    if (s_recording)
+    {
+        Record(MakeCommand(RHICommandType::Discard));
+    }
+    ToEncoder(enc)->discard(BGFX_DISCARD_ALL);
+}
+
+// ---------------------------------------------------------------------------
+// Instancing
+// ---------------------------------------------------------------------------
+
+bool RHIIsInstancingSupported()
+{
+    return (bgfx::getCaps()->supported & BGFX_CAPS_INSTANCING) != 0;
+}
+
+uint32_t RHIEncoderSetInstanceData(RHIEncoder *enc, const void *data, uint32_t count, uint16_t stride)
+{
+    uint32_t available = bgfx::getAvailInstanceDataBuffer(count, stride);
+    if (available == 0)
+    {
+        return 0;
+    }
+
+    bgfx::InstanceDataBuffer idb;
+    bgfx::allocInstanceDataBuffer(&idb, available, stride);
+    std::memcpy(idb.data, data, static_cast<size_t>(available) * stride);
+    ToEncoder(enc)->setInstanceDataBuffer(&idb);
+    if (s_recording)
+    {
+        Record(MakeCommand(RHICommandType::SetInstanceData, 0, UINT16_MAX, UINT16_MAX, available));
+    }
+    return available;
+}
+
 // ---------------------------------------------------------------------------
 // Matrix Math
 // ---------------------------------------------------------------------------
@@ -1,10 +1,10 @@
 #pragma once
 
 #include <cstdint>
-#include <Windows.h>
 #include <functional>
 #include <ctype.h>
 #include "Duin/Core/Maths/DuinMaths.h"
+#include "RHICommandStream.h"
 
 struct ImDrawData; // global ImGui type forward declaration
 
@@ -75,11 +75,31 @@ static constexpr RHIViewId RHI_VIEW_IMGUI = 255;
 // Setup/Shutdown
 // ---------------------------------------------------------------------------
 
-void RHIStart(RHIViewId viewId, uint32_t width, uint32_t height, 
-              std::function<HWND(void)> renderThreadCapture,
-              bool headless = false);
+// Default picks the platform renderer. Recording runs the bgfx Noop renderer (no window or GPU needed)
+// and logs every call into the RHI command stream.
+enum class RHIBackend
+{
+    Default,
+    Recording
+};
+
+// renderThreadCapture returns the native window handle (HWND on Windows). It is not called when
+// headless or recording.
+void RHIStart(RHIViewId viewId, uint32_t width, uint32_t height,
+              std::function<void *(void)> renderThreadCapture,
+              bool headless = false,
+              RHIBackend backend = RHIBackend::Default);
 void RHIClose();
 
+// ---------------------------------------------------------------------------
+// Command capture (RHIBackend::Recording)
+// ---------------------------------------------------------------------------
+
+bool                    RHIIsRecording();
+// Not synchronized with encoding threads; read it between frames.
+const RHICommandStream &RHIGetCommandStream();
+void                    RHIClearCommandStream();
+
 // ---------------------------------------------------------------------------
 // Lifecycle
 // ---------------------------------------------------------------------------
@@ -93,6 +113,10 @@ void RHIFrame();
 // ---------------------------------------------------------------------------
 
 RHIShaderHandle  RHILoadShader(const char *path);
+// Loads an engine shader by name (e.g. "vs_cubes") from bin://shaders/<renderer>/, where the build copies
+// Duin/src/Duin/Resources/shaders. The Noop renderer, and so the Recording backend, gets bgfx's placeholder
+// shader instead, so every engine program exists there without compiled binaries.
+RHIShaderHandle  RHILoadEngineShader(const char *name);
 RHIProgramHandle RHICreateProgram(RHIShaderHandle vsh, RHIShaderHandle fsh, bool destroyShaders);
 void             RHIDestroyProgram(RHIProgramHandle handle);
 
@@ -100,8 +124,27 @@ void             RHIDestroyProgram(RHIProgramHandle handle);
 // Vertex / Index Buffers
 // ---------------------------------------------------------------------------
 
-RHIVertexBufferHandle RHICreateVertexBuffer(const void *data, uint32_t sizeBytes);
+// PosColor is PosColorVertex (RenderGeometry.h); PackedMesh is PackedMeshVertex (Assets/Mesh.h).
+enum class RHIVertexFormat
+{
+    PosColor,
+    PackedMesh
+};
+
+// Reference suits static data: it must stay alive until the buffer is destroyed. Data that may be
+// released first (e.g. a loaded asset) is copied.
+enum class RHIBufferData
+{
+    Reference,
+    Copy
+};
+
+RHIVertexBufferHandle RHICreateVertexBuffer(const void *data, uint32_t sizeBytes,
+                                            RHIVertexFormat format = RHIVertexFormat::PosColor,
+                                            RHIBufferData mode = RHIBufferData::Reference);
 RHIIndexBufferHandle  RHICreateIndexBuffer(const uint16_t *data, uint32_t count);
+RHIIndexBufferHandle  RHICreateIndexBuffer(const void *data, uint32_t count, bool index32,
+                                           RHIBufferData mode = RHIBufferData::Reference);
 void                  RHIDestroyVertexBuffer(RHIVertexBufferHandle handle);
 void                  RHIDestroyIndexBuffer(RHIIndexBufferHandle handle);
 
@@ -129,13 +172,32 @@ void RHITouch(RHIViewId viewId);
 // Encoder (command submission)
 // ---------------------------------------------------------------------------
 
-RHIEncoder *RHIBeginEncoder();
+// forThread requests a separate encoder, on any thread; otherwise the API thread gets its shared
+// default encoder. Returns nullptr when none is free.
+RHIEncoder *RHIBeginEncoder(bool forThread = false);
 void        RHIEndEncoder(RHIEncoder *enc);
+// Number of encoders that may be open at once, including the API thread's.
+uint32_t    RHIGetMaxEncoders();
 
 void RHIEncoderSetTransform(RHIEncoder *enc, const float *mtx);
 void RHIEncoderSetVertexBuffer(RHIEncoder *enc, uint8_t stream, RHIVertexBufferHandle handle);
 void RHIEncoderSetIndexBuffer(RHIEncoder *enc, RHIIndexBufferHandle handle);
 void RHIEncoderSubmit(RHIEncoder *enc, RHIViewId viewId, RHIProgramHandle program);
+// preserveBuffers keeps the vertex/index buffers bound for the next submit; all other state is reset.
+void RHIEncoderSubmit(RHIEncoder *enc, RHIViewId viewId, RHIProgramHandle program, uint32_t depth, bool preserveBuffers);
+void RHIEncoderDiscard(RHIEncoder *enc);
+
+// ---------------------------------------------------------------------------
+// Instancing
+// ---------------------------------------------------------------------------
+
+// Per-instance model matrix, read by the instanced shader as i_data0..i_data3.
+static constexpr uint16_t RHI_INSTANCE_STRIDE = 16 * sizeof(float);
+
+bool     RHIIsInstancingSupported();
+// Copies up to count instances into this frame's transient instance buffer and binds it for the next submit.
+// Returns how many instances fit (0 when the transient buffer is exhausted).
+uint32_t RHIEncoderSetInstanceData(RHIEncoder *enc, const void *data, uint32_t count, uint16_t stride);
 
 // ---------------------------------------------------------------------------
 // Matrix Math (wraps bx:: functions that depend on RHI backend caps)
@@ -0,0 +1,116 @@
+#include "dnpch.h"
+#include "RHICommandStream.h"
+
+#include <cstdio>
+
+namespace duin
+{
+
+size_t RHICommandStream::Count(RHICommandType type) const
+{
+    size_t count = 0;
+    for (const RHICommand &command : commands)
+    {
+        count += command.type == type ? 1 : 0;
+    }
+    return count;
+}
+
+const char *GetRHICommandTypeName(RHICommandType type)
+{
+    switch (type)
+    {
+    case RHICommandType::CreateVertexBuffer:
+        return "CreateVertexBuffer";
+    case RHICommandType::CreateIndexBuffer:
+        return "CreateIndexBuffer";
+    case RHICommandType::DestroyVertexBuffer:
+        return "DestroyVertexBuffer";
+    case RHICommandType::DestroyIndexBuffer:
+        return "DestroyIndexBuffer";
+    case RHICommandType::CreateProgram:
+        return "CreateProgram";
+    case RHICommandType::DestroyProgram:
+        return "DestroyProgram";
+    case RHICommandType::CreateTexture:
+        return "CreateTexture";
+    case RHICommandType::CreateFrameBuffer:
+        return "CreateFrameBuffer";
+    case RHICommandType::SetViewTransform:
+        return "SetViewTransform";
+    case RHICommandType::SetViewRect:
+        return "SetViewRect";
+    case RHICommandType::SetViewClear:
+        return "SetViewClear";
+    case RHICommandType::SetViewFrameBuffer:
+        return "SetViewFrameBuffer";
+    case RHICommandType::Touch:
+        return "Touch";
+    case RHICommandType::SetTransform:
+        return "SetTransform";
+    case RHICommandType::SetVertexBuffer:
+        return "SetVertexBuffer";
+    case RHICommandType::SetIndexBuffer:
+        return "SetIndexBuffer";
+    case RHICommandType::SetInstanceData:
+        return "SetInstanceData";
+    case RHICommandType::Submit:
+        return "Submit";
+    case RHICommandType::Discard:
+        return "Discard";
+    case RHICommandType::Frame:
+        return "Frame";
+    default:
+        return "Unknown";
+    }
+}
+
+std::string FormatRHICommandStream(const RHICommandStream &stream)
+{
+    std::string out;
+    char buffer[64];
+    for (const RHICommand &command : stream.commands)
+    {
+        out += GetRHICommandTypeName(command.type);
+
+        const RHICommand defaults;
+        if (command.view != defaults.view)
+        {
+            std::snprintf(buffer, sizeof(buffer), " view=%u", static_cast<unsigned>(command.view));
+            out += buffer;
+        }
+        if (command.handle != defaults.handle)
+        {
+            std::snprintf(buffer, sizeof(buffer), " handle=%u", static_cast<unsigned>(command.handle));
+            out += buffer;
+        }
+        if (command.program != defaults.program)
+        {
+            std::snprintf(buffer, sizeof(buffer), " program=%u", static_cast<unsigned>(command.program));
+            out += buffer;
+        }
+        if (command.value != defaults.value)
+        {
+            std::snprintf(buffer, sizeof(buffer), " value=%u", static_cast<unsigned>(command.value));
+            out += buffer;
+        }
+
+        const float *data = stream.GetData(command);
+        if (data)
+        {
+            out += " [";
+            for (uint32_t i = 0; i < command.dataCount; ++i)
+            {
+                // Adding +0 turns -0 into +0, so matrices built from sin(0) print the same everywhere.
+                double value = static_cast<double>(data[i]) + 0.0;
+                std::snprintf(buffer, sizeof(buffer), i ? " %.3f" : "%.3f", value);
+                out += buffer;
+            }
+            out += "]";
+        }
+        out += '\n';
+    }
+    return out;
+}
+
+} // namespace duin
@@ -0,0 +1,98 @@
+/**
+ * @file RHICommandStream.h
+ * @brief In-memory log of RHI calls made under the recording backend.
+ * @ingroup Render_Core
+ *
+ * When the RHI is started with RHIBackend::Recording, bgfx runs its Noop
+ * renderer (no window, no GPU) and every buffer creation, view setup and
+ * encoder call is appended to a command stream. Tests and benchmarks read it
+ * back with RHIGetCommandStream(); FormatRHICommandStream() gives a stable
+ * text form for golden comparisons.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace duin
+{
+
+enum class RHICommandType : uint8_t
+{
+    CreateVertexBuffer, ///< value: size in bytes
+    CreateIndexBuffer,  ///< value: index count
+    DestroyVertexBuffer,
+    DestroyIndexBuffer,
+    CreateProgram,      ///< handle: program
+    DestroyProgram,
+    CreateTexture,      ///< value: width << 16 | height
+    CreateFrameBuffer,  ///< handle: framebuffer, value: texture
+    SetViewTransform,   ///< data: view then projection (32 floats)
+    SetViewRect,        ///< data: x, y, width, height
+    SetViewClear,       ///< value: rgba
+    SetViewFrameBuffer, ///< handle: framebuffer
+    Touch,
+    SetTransform,       ///< data: model matrix (16 floats)
+    SetVertexBuffer,    ///< handle: buffer, value: stream
+    SetIndexBuffer,     ///< handle: buffer
+    SetInstanceData,    ///< value: instance count
+    Submit,             ///< program, value: depth
+    Discard,
+    Frame,
+    Count
+};
+
+/**
+ * @struct RHICommand
+ * @brief One recorded call. Fields a call does not use keep their defaults.
+ * @ingroup Render_Core
+ */
+struct RHICommand
+{
+    RHICommandType type = RHICommandType::Count;
+    uint16_t view = 0;
+    uint16_t handle = UINT16_MAX;
+    uint16_t program = UINT16_MAX;
+    uint32_t value = 0;
+    uint32_t dataOffset = 0; ///< First float in RHICommandStream::data.
+    uint32_t dataCount = 0;
+};
+
+/**
+ * @struct RHICommandStream
+ * @brief Recorded commands plus the float payloads (matrices, rects) they point into.
+ * @ingroup Render_Core
+ */
+struct RHICommandStream
+{
+    std::vector<RHICommand> commands;
+    std::vector<float> data;
+
+    const float *GetData(const RHICommand &command) const
+    {
+        return command.dataCount ? data.data() + command.dataOffset : nullptr;
+    }
+
+    /** @brief Number of recorded commands of a type. */
+    size_t Count(RHICommandType type) const;
+
+    void Clear()
+    {
+        commands.clear();
+        data.clear();
+    }
+};
+
+const char *GetRHICommandTypeName(RHICommandType type);
+
+/**
+ * @brief One line per command: type name followed by its non-default fields.
+ *
+ * Payload floats are printed with fixed precision so the text is stable
+ * across platforms.
+ */
+std::string FormatRHICommandStream(const RHICommandStream &stream);
+
+} // namespace duin
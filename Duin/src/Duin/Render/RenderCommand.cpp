@@ -0,0 +1,58 @@
+#include "dnpch.h"
+#include "RenderCommand.h"
+
+#include <cstring>
+
+namespace duin
+{
+
+uint64_t MakeRenderCommandKey(uint16_t viewID, uint16_t program, uint8_t geometry, float depth)
+{
+    // Non-negative floats order like their bit patterns.
+    uint32_t depthBits = 0;
+    std::memcpy(&depthBits, &depth, sizeof(depthBits));
+    return (static_cast<uint64_t>(viewID & 0xFF) << 56) | (static_cast<uint64_t>(program & 0xFFF) << 44) |
+           (static_cast<uint64_t>(geometry) << 36) | (static_cast<uint64_t>(depthBits) << 4);
+}
+
+void SortRenderCommands(std::vector<RenderCommand> &commands, std::vector<RenderCommand> &scratch)
+{
+    scratch.resize(commands.size());
+
+    uint64_t allOr = 0;
+    uint64_t allAnd = ~uint64_t(0);
+    for (const RenderCommand &cmd : commands)
+    {
+        allOr |= cmd.key;
+        allAnd &= cmd.key;
+    }
+    uint64_t varying = allOr ^ allAnd;
+
+    for (uint32_t shift = 0; shift < 64; shift += 8)
+    {
+        if (((varying >> shift) & 0xFF) == 0)
+        {
+            continue;
+        }
+
+        size_t offsets[256] = {};
+        for (const RenderCommand &cmd : commands)
+        {
+            ++offsets[(cmd.key >> shift) & 0xFF];
+        }
+        size_t sum = 0;
+        for (size_t &offset : offsets)
+        {
+            size_t bucket = offset;
+            offset = sum;
+            sum += bucket;
+        }
+        for (const RenderCommand &cmd : commands)
+        {
+            scratch[offsets[(cmd.key >> shift) & 0xFF]++] = cmd;
+        }
+        commands.swap(scratch);
+    }
+}
+
+} // namespace duin
@@ -0,0 +1,42 @@
+/**
+ * @file RenderCommand.h
+ * @brief Sort-keyed draw commands recorded by the renderer's queue.
+ * @ingroup Render_Core
+ *
+ * Everything about a draw but its transform is packed into a 64-bit key:
+ *   bits 56-63 view | 44-55 program | 36-43 geometry | 4-35 depth
+ * so sorting the keys groups draws by view, then program, then geometry,
+ * then front to back. The geometry byte holds the type in its upper six bits
+ * and the LOD level in the lower two.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace duin
+{
+
+static constexpr uint32_t NO_TRANSFORM = UINT32_MAX;
+
+/** @brief One recorded draw. */
+struct RenderCommand
+{
+    uint64_t key = 0;
+    uint32_t transform = 0; // index into the frame's transforms (in floats), or NO_TRANSFORM
+};
+
+/** @brief Packs a draw into its sort key. depth must be non-negative (e.g. a squared distance). */
+uint64_t MakeRenderCommandKey(uint16_t viewID, uint16_t program, uint8_t geometry, float depth);
+
+/**
+ * @brief Sorts commands by key, keeping the recording order of equal keys.
+ *
+ * LSD radix sort on 8-bit digits. Digits shared by every key are skipped, so a
+ * frame with one view and one program only pays for the geometry and depth bytes.
+ * scratch is resized to match and left with unspecified contents.
+ */
+void SortRenderCommands(std::vector<RenderCommand> &commands, std::vector<RenderCommand> &scratch);
+
+} // namespace duin
@@ -1,8 +1,81 @@
 #include "dnpch.h"
 #include "RenderGeometry.h"
 
+#include <cmath>
+
 namespace duin
 {
+
+static constexpr float PI_F = 3.14159265f;
+
+// Surface of revolution around Y: a pole at topY, rings of (ringY, ringR) from top to
+// bottom, and a pole at bottomY. Winding matches the hand-written primitives below.
+template <int VertSize, int TriSize> struct LatheGeometry
+{
+    PosColorVertex vertices[VertSize];
+    uint16_t triList[TriSize];
+
+    void Build(const float *ringY, const float *ringR, int ringCount, int segments, float topY, float bottomY,
+               bool colorByPosition)
+    {
+        auto color = [colorByPosition](float x, float y, float z) -> uint32_t {
+            if (!colorByPosition)
+            {
+                return 0xffffffff;
+            }
+            auto channel = [](float v) { return static_cast<uint32_t>((v * 0.5f + 0.5f) * 255.0f + 0.5f); };
+            return 0xff000000 | (channel(z) << 16) | (channel(y) << 8) | channel(x);
+        };
+
+        int v = 0;
+        vertices[v++] = {0.0f, topY, 0.0f, color(0.0f, 1.0f, 0.0f)};
+        for (int ring = 0; ring < ringCount; ++ring)
+        {
+            for (int s = 0; s < segments; ++s)
+            {
+                float theta = 2.0f * PI_F * static_cast<float>(s) / static_cast<float>(segments);
+                float x = ringR[ring] * std::cos(theta);
+                float z = ringR[ring] * std::sin(theta);
+                vertices[v++] = {x, ringY[ring], z, color(x, ringY[ring], z)};
+            }
+        }
+        const uint16_t bottomPole = static_cast<uint16_t>(v);
+        vertices[v++] = {0.0f, bottomY, 0.0f, color(0.0f, -1.0f, 0.0f)};
+
+        auto ringVertex = [segments](int ring, int s) {
+            return static_cast<uint16_t>(1 + ring * segments + (s % segments));
+        };
+        int i = 0;
+        for (int s = 0; s < segments; ++s)
+        {
+            triList[i++] = 0;
+            triList[i++] = ringVertex(0, s);
+            triList[i++] = ringVertex(0, s + 1);
+        }
+        for (int ring = 0; ring + 1 < ringCount; ++ring)
+        {
+            for (int s = 0; s < segments; ++s)
+            {
+                uint16_t a = ringVertex(ring, s);
+                uint16_t b = ringVertex(ring, s + 1);
+                uint16_t c = ringVertex(ring + 1, s);
+                uint16_t d = ringVertex(ring + 1, s + 1);
+                triList[i++] = a;
+                triList[i++] = c;
+                triList[i++] = b;
+                triList[i++] = b;
+                triList[i++] = c;
+                triList[i++] = d;
+            }
+        }
+        for (int s = 0; s < segments; ++s)
+        {
+            triList[i++] = bottomPole;
+            triList[i++] = ringVertex(ringCount - 1, s + 1);
+            triList[i++] = ringVertex(ringCount - 1, s);
+        }
+    }
+};
 BoxRenderGeometry::BoxRenderGeometry() : RenderGeometry(RenderGeometryType::BOX)
 {
 }
@@ -50,34 +123,35 @@ SphereRenderGeometry::SphereRenderGeometry(float radius) : RenderGeometry(Render
 {
 }
 
-PosColorVertex *SphereRenderGeometry::GetIdentityVertices()
+// Unit sphere: radius=1, UV-tessellated with SEGMENTS meridians and RINGS latitude bands.
+// Vertex colors follow the position so the shape reads without lighting.
+static LatheGeometry<SphereRenderGeometry::VERT_SIZE, SphereRenderGeometry::TRI_SIZE> &GetSphereGeometry()
 {
-    static PosColorVertex vertices[VERT_SIZE] = {{-1.0f, 1.0f, 1.0f, 0xff000000},   {1.0f, 1.0f, 1.0f, 0xff0000ff},
-                                                 {-1.0f, -1.0f, 1.0f, 0xff00ff00},  {1.0f, -1.0f, 1.0f, 0xff00ffff},
-                                                 {-1.0f, 1.0f, -1.0f, 0xffff0000},  {1.0f, 1.0f, -1.0f, 0xffff00ff},
-                                                 {-1.0f, -1.0f, -1.0f, 0xffffff00}, {1.0f, -1.0f, -1.0f, 0xffffffff}};
+    static LatheGeometry<SphereRenderGeometry::VERT_SIZE, SphereRenderGeometry::TRI_SIZE> geometry = [] {
+        const int rings = SphereRenderGeometry::RINGS;
+        LatheGeometry<SphereRenderGeometry::VERT_SIZE, SphereRenderGeometry::TRI_SIZE> g;
+        float ringY[rings - 1];
+        float ringR[rings - 1];
+        for (int k = 1; k < rings; ++k)
+        {
+            float phi = PI_F * static_cast<float>(k) / static_cast<float>(rings);
+            ringY[k - 1] = std::cos(phi);
+            ringR[k - 1] = std::sin(phi);
+        }
+        g.Build(ringY, ringR, rings - 1, SphereRenderGeometry::SEGMENTS, 1.0f, -1.0f, true);
+        return g;
+    }();
+    return geometry;
+}
 
-    return vertices;
+PosColorVertex *SphereRenderGeometry::GetIdentityVertices()
+{
+    return GetSphereGeometry().vertices;
 }
 
 uint16_t *SphereRenderGeometry::GetIdentityTriList()
 {
-    static uint16_t triList[TRI_SIZE] = {
-        0, 1, 2, // Triangle 1
-        1, 3, 2, // Triangle 2
-        4, 6, 5, // Triangle 3
-        5, 6, 7, // Triangle 4
-        0, 2, 4, // Triangle 5
-        4, 2, 6, // Triangle 6
-        1, 5, 3, // Triangle 7
-        5, 7, 3, // Triangle 8
-        0, 4, 1, // Triangle 9
-        4, 5, 1, // Triangle 10
-        2, 3, 6, // Triangle 11
-        6, 3, 7  // Triangle 12
-    };
-
-    return triList;
+    return GetSphereGeometry().triList;
 }
 
 CapsuleRenderGeometry::CapsuleRenderGeometry() : RenderGeometry(RenderGeometryType::CAPSULE)
@@ -90,57 +164,37 @@ CapsuleRenderGeometry::CapsuleRenderGeometry(float radius, float height)
 }
 
 // Unit capsule: radius=1, halfCylinderHeight=1, total height=4.
-// Topology: top pole → top ring → bottom ring → bottom pole.
-// 8 radial segments; caps are cone fans from the poles.
+// Topology: top pole → top hemisphere rings → bottom hemisphere rings → bottom pole;
+// the last ring of each hemisphere is the cylinder edge.
+static LatheGeometry<CapsuleRenderGeometry::VERT_SIZE, CapsuleRenderGeometry::TRI_SIZE> &GetCapsuleGeometry()
+{
+    static LatheGeometry<CapsuleRenderGeometry::VERT_SIZE, CapsuleRenderGeometry::TRI_SIZE> geometry = [] {
+        const int hemiRings = CapsuleRenderGeometry::HEMISPHERE_RINGS;
+        LatheGeometry<CapsuleRenderGeometry::VERT_SIZE, CapsuleRenderGeometry::TRI_SIZE> g;
+        float ringY[hemiRings * 2];
+        float ringR[hemiRings * 2];
+        for (int k = 1; k <= hemiRings; ++k)
+        {
+            float phi = 0.5f * PI_F * static_cast<float>(k) / static_cast<float>(hemiRings);
+            ringY[k - 1] = 1.0f + std::cos(phi);
+            ringR[k - 1] = std::sin(phi);
+            ringY[hemiRings * 2 - k] = -ringY[k - 1];
+            ringR[hemiRings * 2 - k] = ringR[k - 1];
+        }
+        g.Build(ringY, ringR, hemiRings * 2, CapsuleRenderGeometry::SEGMENTS, 2.0f, -2.0f, false);
+        return g;
+    }();
+    return geometry;
+}
+
 PosColorVertex *CapsuleRenderGeometry::GetIdentityVertices()
 {
-    static PosColorVertex vertices[VERT_SIZE] = {
-        // [0] top pole
-        { 0.0f,  2.0f,  0.0f, 0xffffffff },
-        // [1-8] top cylinder ring (y=+1, r=1)
-        { 1.000f,  1.0f,  0.000f, 0xffffffff },
-        { 0.707f,  1.0f,  0.707f, 0xffffffff },
-        { 0.000f,  1.0f,  1.000f, 0xffffffff },
-        {-0.707f,  1.0f,  0.707f, 0xffffffff },
-        {-1.000f,  1.0f,  0.000f, 0xffffffff },
-        {-0.707f,  1.0f, -0.707f, 0xffffffff },
-        { 0.000f,  1.0f, -1.000f, 0xffffffff },
-        { 0.707f,  1.0f, -0.707f, 0xffffffff },
-        // [9-16] bottom cylinder ring (y=-1, r=1)
-        { 1.000f, -1.0f,  0.000f, 0xffffffff },
-        { 0.707f, -1.0f,  0.707f, 0xffffffff },
-        { 0.000f, -1.0f,  1.000f, 0xffffffff },
-        {-0.707f, -1.0f,  0.707f, 0xffffffff },
-        {-1.000f, -1.0f,  0.000f, 0xffffffff },
-        {-0.707f, -1.0f, -0.707f, 0xffffffff },
-        { 0.000f, -1.0f, -1.000f, 0xffffffff },
-        { 0.707f, -1.0f, -0.707f, 0xffffffff },
-        // [17] bottom pole
-        { 0.0f, -2.0f,  0.0f, 0xffffffff },
-    };
-    return vertices;
+    return GetCapsuleGeometry().vertices;
 }
 
 uint16_t *CapsuleRenderGeometry::GetIdentityTriList()
 {
-    static uint16_t triList[TRI_SIZE] = {
-        // Top cap fan from pole (v0) to top ring (v1..v8)
-        0, 1, 2,   0, 2, 3,   0, 3, 4,   0, 4, 5,
-        0, 5, 6,   0, 6, 7,   0, 7, 8,   0, 8, 1,
-        // Side quads (top ring → bottom ring)
-        1,  9,  2,   2,  9, 10,
-        2, 10,  3,   3, 10, 11,
-        3, 11,  4,   4, 11, 12,
-        4, 12,  5,   5, 12, 13,
-        5, 13,  6,   6, 13, 14,
-        6, 14,  7,   7, 14, 15,
-        7, 15,  8,   8, 15, 16,
-        8, 16,  1,   1, 16,  9,
-        // Bottom cap fan from bottom ring (v9..v16) to pole (v17) — reversed winding
-        17, 10,  9,  17, 11, 10,  17, 12, 11,  17, 13, 12,
-        17, 14, 13,  17, 15, 14,  17, 16, 15,  17,  9, 16,
-    };
-    return triList;
+    return GetCapsuleGeometry().triList;
 }
 
 PlaneRenderGeometry::PlaneRenderGeometry() : RenderGeometry(RenderGeometryType::PLANE)
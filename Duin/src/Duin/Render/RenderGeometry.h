@@ -68,13 +68,14 @@ struct BoxRenderGeometry : public RenderGeometry
 struct SphereRenderGeometry : public RenderGeometry
 {
     float radius = 0.5f;
-    ;
 
     SphereRenderGeometry();
     SphereRenderGeometry(float radius);
 
-    static const int VERT_SIZE = 8;
-    static const int TRI_SIZE = 36;
+    static const int SEGMENTS = 16;
+    static const int RINGS = 12;
+    static const int VERT_SIZE = 2 + (RINGS - 1) * SEGMENTS;
+    static const int TRI_SIZE = 2 * SEGMENTS * 3 + (RINGS - 2) * SEGMENTS * 6;
 
     static PosColorVertex *GetIdentityVertices();
     static uint16_t *GetIdentityTriList();
@@ -96,8 +97,10 @@ struct CapsuleRenderGeometry : public RenderGeometry
     CapsuleRenderGeometry();
     CapsuleRenderGeometry(float radius, float height);
 
-    static const int VERT_SIZE = 18;
-    static const int TRI_SIZE  = 96;
+    static const int SEGMENTS = 16;
+    static const int HEMISPHERE_RINGS = 4;
+    static const int VERT_SIZE = 2 + 2 * HEMISPHERE_RINGS * SEGMENTS;
+    static const int TRI_SIZE  = 2 * SEGMENTS * 3 + (2 * HEMISPHERE_RINGS - 1) * SEGMENTS * 6;
 
     static PosColorVertex *GetIdentityVertices();
     static uint16_t       *GetIdentityTriList();
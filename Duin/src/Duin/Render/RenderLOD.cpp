@@ -0,0 +1,229 @@
+#include "dnpch.h"
+#include "RenderLOD.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <unordered_set>
+
+namespace duin
+{
+
+namespace
+{
+constexpr uint32_t LOD_MAX_GRID = 64;
+constexpr size_t LOD_MIN_TRIANGLES = 4;
+
+struct ClusterCell
+{
+    float sum[3] = {};
+    uint32_t count = 0;
+    uint16_t representative = 0;
+    float bestDistance = std::numeric_limits<float>::max();
+};
+
+// Vertex clustering: snap every vertex to a grid cell, let the vertex closest to the
+// cell's centroid stand in for the whole cell and drop the triangles that collapse.
+std::vector<uint16_t> ClusterIndices(const PosColorVertex *vertices, size_t vertexCount, const uint16_t *indices,
+                                     size_t indexCount, const float *min, const float *size, uint32_t grid)
+{
+    std::vector<uint32_t> vertexCell(vertexCount, UINT32_MAX);
+    std::unordered_map<uint32_t, ClusterCell> cells;
+    for (size_t i = 0; i < indexCount; ++i)
+    {
+        uint16_t v = indices[i];
+        if (vertexCell[v] != UINT32_MAX)
+        {
+            continue;
+        }
+        const float p[3] = {vertices[v].x, vertices[v].y, vertices[v].z};
+        uint32_t c[3];
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            float t = (p[axis] - min[axis]) / size[axis] * static_cast<float>(grid);
+            c[axis] = std::min(static_cast<uint32_t>(std::max(t, 0.0f)), grid - 1);
+        }
+        uint32_t cellID = c[0] + grid * (c[1] + grid * c[2]);
+        vertexCell[v] = cellID;
+
+        ClusterCell &cell = cells[cellID];
+        cell.sum[0] += p[0];
+        cell.sum[1] += p[1];
+        cell.sum[2] += p[2];
+        ++cell.count;
+    }
+
+    for (size_t v = 0; v < vertexCount; ++v)
+    {
+        if (vertexCell[v] == UINT32_MAX)
+        {
+            continue;
+        }
+        ClusterCell &cell = cells[vertexCell[v]];
+        float inv = 1.0f / static_cast<float>(cell.count);
+        float dx = vertices[v].x - cell.sum[0] * inv;
+        float dy = vertices[v].y - cell.sum[1] * inv;
+        float dz = vertices[v].z - cell.sum[2] * inv;
+        float distance = dx * dx + dy * dy + dz * dz;
+        if (distance < cell.bestDistance)
+        {
+            cell.representative = static_cast<uint16_t>(v);
+            cell.bestDistance = distance;
+        }
+    }
+
+    std::vector<uint16_t> out;
+    std::unordered_set<uint64_t> seen;
+    for (size_t i = 0; i + 2 < indexCount; i += 3)
+    {
+        uint16_t a = cells[vertexCell[indices[i]]].representative;
+        uint16_t b = cells[vertexCell[indices[i + 1]]].representative;
+        uint16_t c = cells[vertexCell[indices[i + 2]]].representative;
+        if (a == b || b == c || a == c)
+        {
+            continue;
+        }
+
+        // Identical triangles (same winding) collapse to one.
+        uint16_t rotated[3] = {a, b, c};
+        std::rotate(rotated, std::min_element(rotated, rotated + 3), rotated + 3);
+        uint64_t key = (uint64_t(rotated[0]) << 32) | (uint64_t(rotated[1]) << 16) | rotated[2];
+        if (!seen.insert(key).second)
+        {
+            continue;
+        }
+        out.insert(out.end(), {a, b, c});
+    }
+    return out;
+}
+} // namespace
+
+std::vector<std::vector<uint16_t>> GenerateLODChain(const PosColorVertex *vertices, size_t vertexCount,
+                                                    const uint16_t *indices, size_t indexCount, uint8_t maxLevels,
+                                                    float reduction)
+{
+    std::vector<std::vector<uint16_t>> levels;
+    if (!vertices || !indices || indexCount < 3 || maxLevels == 0)
+    {
+        return levels;
+    }
+    levels.emplace_back(indices, indices + indexCount);
+
+    float min[3] = {vertices[indices[0]].x, vertices[indices[0]].y, vertices[indices[0]].z};
+    float max[3] = {min[0], min[1], min[2]};
+    for (size_t i = 0; i < indexCount; ++i)
+    {
+        const PosColorVertex &v = vertices[indices[i]];
+        const float p[3] = {v.x, v.y, v.z};
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            min[axis] = std::min(min[axis], p[axis]);
+            max[axis] = std::max(max[axis], p[axis]);
+        }
+    }
+    // Nudge the size so vertices on the max face land in the last cell, not past it.
+    float size[3];
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        size[axis] = std::max(max[axis] - min[axis], 1e-6f) * 1.0001f;
+    }
+
+    // Every level clusters the original triangles, so errors do not accumulate.
+    uint32_t grid = LOD_MAX_GRID + 1;
+    while (levels.size() < maxLevels)
+    {
+        size_t previousTriangles = levels.back().size() / 3;
+        size_t target = static_cast<size_t>(static_cast<float>(previousTriangles) * reduction);
+        if (target < LOD_MIN_TRIANGLES)
+        {
+            break;
+        }
+
+        std::vector<uint16_t> level;
+        while (--grid >= 1)
+        {
+            level = ClusterIndices(vertices, vertexCount, indices, indexCount, min, size, grid);
+            if (level.size() / 3 <= target)
+            {
+                break;
+            }
+        }
+        if (grid < 1 || level.size() / 3 < LOD_MIN_TRIANGLES)
+        {
+            break;
+        }
+        levels.push_back(std::move(level));
+    }
+    return levels;
+}
+
+float ComputeScreenSize(float radius, float distance, float projScaleY)
+{
+    if (distance <= radius)
+    {
+        return 1.0f; // camera inside the bounds
+    }
+    return radius * projScaleY / distance;
+}
+
+uint8_t SelectLOD(float screenSize, uint8_t previous, uint8_t levelCount, const LODSettings &settings)
+{
+    if (levelCount <= 1)
+    {
+        return 0;
+    }
+
+    uint8_t target = 0;
+    while (target + 1 < levelCount && screenSize < settings.thresholds[target])
+    {
+        ++target;
+    }
+    if (previous == LOD_NONE || previous >= levelCount)
+    {
+        return target;
+    }
+
+    // Move one threshold at a time, and only past thresholds cleared by the margin.
+    uint8_t level = previous;
+    while (level < target && screenSize < settings.thresholds[level] * (1.0f - settings.hysteresis))
+    {
+        ++level;
+    }
+    while (level > target && screenSize > settings.thresholds[level - 1] * (1.0f + settings.hysteresis))
+    {
+        --level;
+    }
+    return level;
+}
+
+uint8_t LODSelector::Select(uint64_t key, float screenSize, uint8_t levelCount, const LODSettings &settings)
+{
+    Entry &entry = entries_[key];
+    entry.level = SelectLOD(screenSize, entry.level, levelCount, settings);
+    entry.lastFrame = frame_;
+    return entry.level;
+}
+
+void LODSelector::EndFrame()
+{
+    ++frame_;
+    for (auto it = entries_.begin(); it != entries_.end();)
+    {
+        if (frame_ - it->second.lastFrame > EVICT_AFTER_FRAMES)
+        {
+            it = entries_.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+void LODSelector::Clear()
+{
+    entries_.clear();
+    frame_ = 0;
+}
+
+} // namespace duin
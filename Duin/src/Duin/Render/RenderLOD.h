@@ -0,0 +1,98 @@
+/**
+ * @file RenderLOD.h
+ * @brief Level-of-detail chains and screen-size based LOD selection.
+ * @ingroup Render_Core
+ *
+ * A LOD chain is a list of index buffers over one shared vertex buffer, each
+ * level with roughly half the triangles of the previous one. Levels are
+ * generated by vertex clustering, so they need no extra vertex data.
+ *
+ * Selection uses the projected size of an object's bounding sphere as a
+ * fraction of the viewport height. A level only changes once the size has
+ * moved past its threshold by the hysteresis margin, so objects sitting near
+ * a threshold do not flicker between levels.
+ */
+
+#pragma once
+
+#include "RenderGeometry.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace duin
+{
+
+static constexpr uint8_t MAX_LOD_LEVELS = 4;
+static constexpr uint8_t LOD_NONE = UINT8_MAX;
+
+/**
+ * @brief Builds simplified index lists for a mesh.
+ *
+ * Level 0 is a copy of the input. Each further level keeps at most
+ * `reduction` times the triangles of the previous one; generation stops
+ * early when a level can no longer be reduced.
+ */
+std::vector<std::vector<uint16_t>> GenerateLODChain(const PosColorVertex *vertices, size_t vertexCount,
+                                                    const uint16_t *indices, size_t indexCount,
+                                                    uint8_t maxLevels = MAX_LOD_LEVELS, float reduction = 0.5f);
+
+/**
+ * @brief Projected diameter of a sphere as a fraction of the viewport height.
+ * @param projScaleY Element [5] of the projection matrix (cot(fovy / 2)).
+ */
+float ComputeScreenSize(float radius, float distance, float projScaleY);
+
+/**
+ * @struct LODSettings
+ * @brief Screen-size thresholds between consecutive levels.
+ * @ingroup Render_Core
+ *
+ * Level i is used while the screen size is below thresholds[i - 1] and at or
+ * above thresholds[i]. Thresholds must be decreasing.
+ */
+struct LODSettings
+{
+    float thresholds[MAX_LOD_LEVELS - 1] = {0.25f, 0.1f, 0.04f};
+    float hysteresis = 0.15f; ///< Relative margin around each threshold.
+};
+
+/** @brief Level for a screen size, starting from the level used last frame (or LOD_NONE). */
+uint8_t SelectLOD(float screenSize, uint8_t previous, uint8_t levelCount, const LODSettings &settings);
+
+/**
+ * @class LODSelector
+ * @brief Remembers the level chosen for each object so SelectLOD can apply hysteresis.
+ * @ingroup Render_Core
+ *
+ * Keep one per camera. Objects are identified by a caller-chosen key; entries
+ * not selected for a few frames are dropped by EndFrame().
+ */
+class LODSelector
+{
+  public:
+    uint8_t Select(uint64_t key, float screenSize, uint8_t levelCount, const LODSettings &settings);
+    void EndFrame();
+    void Clear();
+
+    size_t GetTrackedCount() const
+    {
+        return entries_.size();
+    }
+
+  private:
+    struct Entry
+    {
+        uint8_t level = LOD_NONE;
+        uint32_t lastFrame = 0;
+    };
+
+    static constexpr uint32_t EVICT_AFTER_FRAMES = 2;
+
+    std::unordered_map<uint64_t, Entry> entries_;
+    uint32_t frame_ = 0;
+};
+
+} // namespace duin
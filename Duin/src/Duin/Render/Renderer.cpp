@@ -2,13 +2,22 @@
 #include "Renderer.h"
 
 #include "Camera.h"
+#include "Culling.h"
+#include "RenderCommand.h"
 
 #include <external/imgui.h>
 
+#include "Duin/Assets/Mesh.h"
 #include "Duin/Core/Debug/DNLog.h"
 #include "Duin/Core/Application.h"
 #include "Duin/Core/Maths/MathsModule.h"
 
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <utility>
+
 namespace duin
 {
 
@@ -21,13 +30,55 @@ struct GeometryBufferHandle
     UUID uuid;
     RHIVertexBufferHandle vbh;
     RHIIndexBufferHandle ibh;
+    RHIIndexBufferHandle lods[MAX_LOD_LEVELS]; // lods[0] == ibh
+    uint8_t lodCount = 1;
+    float radius = 1.0f; // bounding sphere of the identity geometry
 
     GeometryBufferHandle() = default;
     GeometryBufferHandle(RHIVertexBufferHandle vbh_, RHIIndexBufferHandle ibh_) : vbh(vbh_), ibh(ibh_)
     {
+        lods[0] = ibh_;
     }
 };
 
+// Model matrices queued for one geometry type in one view, drawn as a single instanced submit.
+struct InstanceBatch
+{
+    RHIViewId viewID = RHI_VIEW_3D;
+    RenderGeometryType::Type type = RenderGeometryType::BOX;
+    uint8_t lod = 0;
+    std::vector<float> matrices; // 16 floats per instance
+};
+
+// One DrawMesh call. Mesh draws are grouped by view and vertex buffer before encoding.
+struct MeshCommand
+{
+    RHIViewId viewID = RHI_VIEW_3D;
+    RHIVertexBufferHandle vbh;
+    RHIIndexBufferHandle ibh;
+    uint32_t transform = 0; // index into meshTransforms (in floats)
+};
+
+// Frustum of the camera last bound to a view, used to cull the draws queued for it.
+struct ViewCulling
+{
+    Frustum frustum;
+    Vector3 eye;
+    float projScale = 0.0f; // cot(fovy / 2), zero when the view has no camera
+};
+
+static const float IDENTITY_TRANSFORM[16] = {1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f,
+                                              0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f};
+
+// Every built-in geometry fits in a sphere of radius 2 (the capsule reaches y = +-2).
+static constexpr float GEOMETRY_BOUNDING_RADIUS = 2.0f;
+
+static constexpr uint32_t LOD_GEOMETRY_BITS = 2;
+static_assert((1u << LOD_GEOMETRY_BITS) >= MAX_LOD_LEVELS, "LOD level must fit in the geometry byte");
+
+// Draws queued without an object id have no identity; hysteresis is tracked per position cell instead.
+static constexpr float LOD_KEY_CELL_SIZE = 0.5f;
+
 // ---------------------------------------------------------------------------
 // Static state
 // ---------------------------------------------------------------------------
@@ -39,9 +90,44 @@ static std::unordered_map<UUID, ShaderProgram> shaderProgramMap;
 static RHIEncoder *encoder = nullptr;
 static RenderState globalRenderState;
 static std::vector<RenderState> globalRenderStateStack;
+static UUID INSTANCED_SHADERPROGRAM_UUID = UUID{0};
+static bool instancedRenderingEnabled = true;
+static UUID MESH_SHADERPROGRAM_UUID = UUID{0};
+static std::vector<MeshCommand> meshCommands;
+static std::vector<float> meshTransforms; // 16 floats per command, dequantization folded in
+static std::map<uint32_t, InstanceBatch> instanceBatches; // keyed by view and geometry type
+static std::vector<RenderCommand> renderCommands;
+static std::vector<RenderCommand> renderCommandScratch;
+static std::vector<float> commandTransforms;
+static RenderQueueStats renderQueueStats;
+static bool cullingEnabled = true;
+static float cullDistance = 0.0f;
+static std::unordered_map<RHIViewId, ViewCulling> viewCulling;
+static CullingStats cullingStats;
+static std::vector<float> cullBounds; // SoA scratch: x, y, z, radius
+static std::vector<uint8_t> cullVisible;
+static std::vector<uint32_t> cullOffsets;
+static std::vector<size_t> cullIndices;
+static bool lodEnabled = true;
+static LODSettings lodSettings;
+static std::unordered_map<RHIViewId, LODSelector> viewLOD;       // draws keyed by position cell
+static std::unordered_map<RHIViewId, LODSelector> viewObjectLOD; // draws keyed by a caller's object id
+// Simplified index lists per geometry type. Never freed: the index buffers reference them.
+static std::vector<std::vector<std::vector<uint16_t>>> geometryLODIndices;
 
 static void CreateGeometryBuffers();
 static GeometryBufferHandle GetGeometryBufferHandle(RenderGeometryType::Type type);
+static void CreateGeometryLODs(RenderGeometryType::Type type, const PosColorVertex *vertices, size_t vertexCount,
+                               const uint16_t *indices, size_t indexCount);
+static uint8_t SelectGeometryLOD(RHIViewId viewID, RenderGeometryType::Type type, const float *mtx, uint64_t objectID);
+static void FlushInstanceBatches();
+static void RecordRenderCommand(RHIViewId viewID, RHIProgramHandle program, RenderGeometryType::Type type,
+                                const float *mtx, uint8_t lod = 0);
+static void FlushRenderCommands();
+static void FlushMeshCommands();
+static void CullRenderCommands();
+static void SetViewCulling(RHIViewId viewID, const float *view, const float *proj, const Camera *camera);
+static size_t CullTransforms(RHIViewId viewID, const float *matrices, const uint32_t *offsets, size_t count);
 
 // Row-major Matrix to column-major float[16] for RHI.
 static void MatrixToFloat16(Matrix m, float *r)
@@ -110,10 +196,8 @@ void InitRenderer()
     RHIInit();
 
     // Load default shaders
-    RHIShaderHandle vsh =
-        RHILoadShader("C:/Projects/CPP_Projects/Duin/Duin/src/Duin/Resources/shaders/dx11/vs_cubes.bin");
-    RHIShaderHandle fsh =
-        RHILoadShader("C:/Projects/CPP_Projects/Duin/Duin/src/Duin/Resources/shaders/dx11/fs_cubes.bin");
+    RHIShaderHandle vsh = RHILoadEngineShader("vs_cubes");
+    RHIShaderHandle fsh = RHILoadEngineShader("fs_cubes");
 
     // Create default shader program
     RHIProgramHandle program = RHICreateProgram(vsh, fsh, true);
@@ -121,6 +205,39 @@ void InitRenderer()
     shaderProgramMap[shaderProgram.uuid] = shaderProgram;
     DEFAULT_SHADERPROGRAM_UUID = shaderProgram.uuid;
 
+    // Instanced program: same fragment stage, model matrix read from instance data.
+    if (RHIIsInstancingSupported())
+    {
+        RHIShaderHandle ivsh = RHILoadEngineShader("vs_instancing");
+        RHIShaderHandle ifsh = RHILoadEngineShader("fs_cubes");
+        if (ivsh.IsValid() && ifsh.IsValid())
+        {
+            RHIProgramHandle instancedProgram = RHICreateProgram(ivsh, ifsh, true);
+            ShaderProgram instancedShaderProgram(ivsh, ifsh, instancedProgram);
+            shaderProgramMap[instancedShaderProgram.uuid] = instancedShaderProgram;
+            INSTANCED_SHADERPROGRAM_UUID = instancedShaderProgram.uuid;
+        }
+        else
+        {
+            DN_CORE_WARN("Instanced shader unavailable, primitives are drawn one by one.");
+        }
+    }
+
+    // Mesh program: cooked vertex format, same fragment stage.
+    RHIShaderHandle mvsh = RHILoadEngineShader("vs_mesh");
+    RHIShaderHandle mfsh = RHILoadEngineShader("fs_cubes");
+    if (mvsh.IsValid() && mfsh.IsValid())
+    {
+        RHIProgramHandle meshProgram = RHICreateProgram(mvsh, mfsh, true);
+        ShaderProgram meshShaderProgram(mvsh, mfsh, meshProgram);
+        shaderProgramMap[meshShaderProgram.uuid] = meshShaderProgram;
+        MESH_SHADERPROGRAM_UUID = meshShaderProgram.uuid;
+    }
+    else
+    {
+        DN_CORE_WARN("Mesh shader unavailable, DrawMesh is disabled.");
+    }
+
     CreateGeometryBuffers();
 
     DN_CORE_INFO("Renderer initialised.");
@@ -138,8 +255,15 @@ void ResetRenderer()
 
     for (auto &buf : geometryBufferList)
     {
+        if (!buf.vbh.IsValid())
+        {
+            continue; // no geometry of this type
+        }
         RHIDestroyVertexBuffer(buf.vbh);
-        RHIDestroyIndexBuffer(buf.ibh);
+        for (uint8_t lod = 0; lod < buf.lodCount; ++lod)
+        {
+            RHIDestroyIndexBuffer(buf.lods[lod]);
+        }
     }
     geometryBufferList.clear();
 
@@ -149,6 +273,18 @@ void ResetRenderer()
     }
     shaderProgramMap.clear();
     DEFAULT_SHADERPROGRAM_UUID = UUID{0};
+    INSTANCED_SHADERPROGRAM_UUID = UUID{0};
+    MESH_SHADERPROGRAM_UUID = UUID{0};
+    instanceBatches.clear();
+    meshCommands.clear();
+    meshTransforms.clear();
+    renderCommands.clear();
+    commandTransforms.clear();
+    renderQueueStats = RenderQueueStats{};
+    viewCulling.clear();
+    cullingStats = CullingStats{};
+    viewLOD.clear();
+    viewObjectLOD.clear();
 
     if (encoder)
     {
@@ -191,6 +327,7 @@ void BeginDraw3D(Camera &camera)
     MatrixToFloat16(viewMtx, view);
     MatrixToFloat16(projMtx, proj);
     RHISetViewTransform(viewID, view, proj);
+    SetViewCulling(viewID, view, proj, &camera);
     RHISetViewRect(viewID, 0, 0, (uint16_t)GetWindowWidth(), (uint16_t)GetWindowHeight());
     RHISetViewClear(viewID, 0x303030ff, 1.0f, 0);
 
@@ -222,6 +359,7 @@ void EndDraw3D()
             MatrixToFloat16(globalRenderState.viewMatrix, view);
             MatrixToFloat16(globalRenderState.projectionMatrix, proj);
             RHISetViewTransform(RHI_VIEW_3D, view, proj);
+            SetViewCulling(RHI_VIEW_3D, view, proj, globalRenderState.camera);
         }
     }
     else
@@ -273,6 +411,7 @@ void BeginTextureMode(RenderTexture &target)
             MatrixToFloat16(viewMtx, view);
             MatrixToFloat16(projMtx, proj);
             RHISetViewTransform(target.viewID, view, proj);
+            SetViewCulling(target.viewID, view, proj, activeCamera);
         }
     }
 
@@ -329,20 +468,15 @@ void QueueRender(const RenderGeometryType::Type type)
     RHIViewId targetViewID = globalRenderState.viewID;
     RHIProgramHandle program = shaderProgramMap[DEFAULT_SHADERPROGRAM_UUID].program;
 
-    GeometryBufferHandle buffers = GetGeometryBufferHandle(type);
-
-    RHIEncoderSetVertexBuffer(encoder, 0, buffers.vbh);
-    RHIEncoderSetIndexBuffer(encoder, buffers.ibh);
-    RHIEncoderSubmit(encoder, targetViewID, program);
+    RecordRenderCommand(targetViewID, program, type, nullptr);
 }
 
-void QueueRender(
-    const RenderGeometryType::Type type, const Vector3 position, const Quaternion rotation, const Vector3 size)
+void QueueRender(const RenderGeometryType::Type type, const Vector3 position, const Quaternion rotation,
+                 const Vector3 size, uint64_t objectID)
 {
     Vector3 eulerRotation = QuaternionToEuler(rotation);
 
     RHIViewId targetViewID = globalRenderState.viewID;
-    RHIProgramHandle program = shaderProgramMap[DEFAULT_SHADERPROGRAM_UUID].program;
 
     GeometryBufferHandle buffers = GetGeometryBufferHandle(type);
     if (!(buffers.vbh.IsValid() && buffers.ibh.IsValid()))
@@ -364,10 +498,184 @@ void QueueRender(
         position.y,
         position.z);
 
-    RHIEncoderSetTransform(encoder, mtx);
-    RHIEncoderSetVertexBuffer(encoder, 0, buffers.vbh);
-    RHIEncoderSetIndexBuffer(encoder, buffers.ibh);
-    RHIEncoderSubmit(encoder, targetViewID, program);
+    uint8_t lod = SelectGeometryLOD(targetViewID, type, mtx, objectID);
+
+    if (IsInstancedRenderingActive())
+    {
+        uint32_t key = (static_cast<uint32_t>(targetViewID) << 16) | (static_cast<uint32_t>(lod) << 8) |
+                       static_cast<uint32_t>(type);
+        InstanceBatch &batch = instanceBatches[key];
+        batch.viewID = targetViewID;
+        batch.type = type;
+        batch.lod = lod;
+        batch.matrices.insert(batch.matrices.end(), mtx, mtx + 16);
+        return;
+    }
+
+    RHIProgramHandle program = shaderProgramMap[DEFAULT_SHADERPROGRAM_UUID].program;
+    RecordRenderCommand(targetViewID, program, type, mtx, lod);
+}
+
+void DrawMesh(const Mesh &mesh, const Vector3 position, const Quaternion rotation, const Vector3 size)
+{
+    if (MESH_SHADERPROGRAM_UUID == UUID{0})
+    {
+        return;
+    }
+    if (!mesh.IsValid())
+    {
+        DN_CORE_WARN("DrawMesh - Mesh {} has no GPU buffers.", mesh.GetUUID().ToStrHex());
+        return;
+    }
+
+    Vector3 eulerRotation = QuaternionToEuler(rotation);
+    float model[16];
+    RHIComputeSRTMatrix(model, size.x, size.y, size.z, eulerRotation.x, eulerRotation.y, eulerRotation.z,
+                        position.x, position.y, position.z);
+
+    // world = dequantize * model: the dequantize matrix only scales and offsets rows 0-3.
+    float dequantize[16];
+    mesh.GetDequantizeMatrix(dequantize);
+    MeshCommand cmd;
+    cmd.viewID = globalRenderState.viewID;
+    cmd.vbh = mesh.GetVertexBuffer();
+    cmd.ibh = mesh.GetIndexBuffer();
+    cmd.transform = static_cast<uint32_t>(meshTransforms.size());
+    meshTransforms.resize(meshTransforms.size() + 16);
+    float *mtx = &meshTransforms[cmd.transform];
+    for (int row = 0; row < 4; ++row)
+    {
+        for (int col = 0; col < 4; ++col)
+        {
+            mtx[row * 4 + col] = dequantize[row * 4 + 0] * model[col] + dequantize[row * 4 + 1] * model[4 + col] +
+                                 dequantize[row * 4 + 2] * model[8 + col] + dequantize[row * 4 + 3] * model[12 + col];
+        }
+    }
+    meshCommands.push_back(cmd);
+}
+
+// ---------------------------------------------------------------------------
+// Parallel submission
+// ---------------------------------------------------------------------------
+
+void DrawEncoder::Draw(RenderGeometryType::Type type, const Vector3 position, const Quaternion rotation,
+                       const Vector3 size)
+{
+    Vector3 eulerRotation = QuaternionToEuler(rotation);
+
+    float mtx[16];
+    RHIComputeSRTMatrix(
+        mtx, size.x, size.y, size.z, eulerRotation.x, eulerRotation.y, eulerRotation.z, position.x, position.y,
+        position.z);
+    Draw(type, mtx);
+}
+
+void DrawEncoder::Draw(RenderGeometryType::Type type, const float *mtx)
+{
+    if (!encoder_)
+    {
+        return;
+    }
+
+    if (static_cast<uint32_t>(type) != boundGeometry_)
+    {
+        GeometryBufferHandle buffers = GetGeometryBufferHandle(type);
+        RHIEncoderSetVertexBuffer(encoder_, 0, buffers.vbh);
+        RHIEncoderSetIndexBuffer(encoder_, buffers.ibh);
+        boundGeometry_ = static_cast<uint32_t>(type);
+    }
+    RHIEncoderSetTransform(encoder_, mtx);
+    RHIEncoderSubmit(encoder_, viewID_, program_, 0, true);
+    ++submitCount_;
+}
+
+void ParallelDraw(size_t count, size_t grainSize, const ParallelDrawFn &fn, ThreadPool &pool)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    // Resolved up front: the program map is not safe to touch from workers.
+    RHIViewId viewID = globalRenderState.viewID;
+    RHIProgramHandle program = shaderProgramMap[DEFAULT_SHADERPROGRAM_UUID].program;
+
+    // One encoder per pool thread, indexed by thread index. Each thread only touches its own slot.
+    // The calling thread asks for its own encoder too: the API thread's default encoder
+    // may be the one the renderer is recording into, and the slots are discarded and ended below.
+    std::vector<RHIEncoder *> encoderPool(pool.GetThreadCount(), nullptr);
+    std::mutex deferredMutex;
+    std::vector<std::pair<size_t, size_t>> deferred;
+
+    auto acquire = [&](size_t threadIndex) -> RHIEncoder * {
+        RHIEncoder *&slot = encoderPool[threadIndex];
+        if (!slot)
+        {
+            slot = RHIBeginEncoder(true);
+        }
+        return slot;
+    };
+
+    // A fresh DrawEncoder per chunk, so each chunk binds its own buffers whatever ran before it.
+    pool.ParallelFor(count, grainSize, [&](size_t begin, size_t end) {
+        RHIEncoder *enc = acquire(pool.GetCurrentThreadIndex());
+        if (!enc)
+        {
+            std::lock_guard<std::mutex> lock(deferredMutex);
+            deferred.emplace_back(begin, end);
+            return;
+        }
+        DrawEncoder drawEncoder(enc, viewID, program);
+        fn(drawEncoder, begin, end);
+    });
+
+    if (!deferred.empty())
+    {
+        // Close the workers' encoders first so the calling thread can get one of them.
+        size_t self = pool.GetCurrentThreadIndex();
+        for (size_t i = 0; i < encoderPool.size(); ++i)
+        {
+            if (i != self && encoderPool[i])
+            {
+                RHIEncoderDiscard(encoderPool[i]);
+                RHIEndEncoder(encoderPool[i]);
+                encoderPool[i] = nullptr;
+            }
+        }
+
+        RHIEncoder *enc = acquire(self);
+        if (enc)
+        {
+            for (const auto &[begin, end] : deferred)
+            {
+                DrawEncoder drawEncoder(enc, viewID, program);
+                fn(drawEncoder, begin, end);
+            }
+        }
+        else
+        {
+            DN_CORE_WARN("No free encoder for ParallelDraw, {} chunks dropped.", deferred.size());
+        }
+    }
+
+    for (RHIEncoder *enc : encoderPool)
+    {
+        if (enc)
+        {
+            RHIEncoderDiscard(enc);
+            RHIEndEncoder(enc);
+        }
+    }
+}
+
+void SetInstancedRendering(bool enabled)
+{
+    instancedRenderingEnabled = enabled;
+}
+
+bool IsInstancedRenderingActive()
+{
+    return instancedRenderingEnabled && INSTANCED_SHADERPROGRAM_UUID != UUID{0};
 }
 
 void ExecuteRenderPipeline()
@@ -382,11 +690,93 @@ void ExecuteRenderPipeline()
         MatrixToFloat16(globalRenderState.viewMatrix, view);
         MatrixToFloat16(globalRenderState.projectionMatrix, proj);
         RHISetViewTransform(globalRenderState.viewID, view, proj);
+        SetViewCulling(globalRenderState.viewID, view, proj, globalRenderState.camera);
     }
 
+    renderQueueStats = RenderQueueStats{};
+    cullingStats = CullingStats{};
+    FlushRenderCommands();
+    FlushMeshCommands();
+    FlushInstanceBatches();
+    for (auto &[viewID, selector] : viewLOD)
+    {
+        selector.EndFrame();
+    }
+    for (auto &[viewID, selector] : viewObjectLOD)
+    {
+        selector.EndFrame();
+    }
     RHIFrame();
 }
 
+RenderQueueStats GetRenderQueueStats()
+{
+    return renderQueueStats;
+}
+
+void SetRenderCulling(bool enabled)
+{
+    cullingEnabled = enabled;
+}
+
+bool IsRenderCullingEnabled()
+{
+    return cullingEnabled;
+}
+
+void SetRenderCullDistance(float distance)
+{
+    cullDistance = distance;
+}
+
+float GetRenderCullDistance()
+{
+    return cullDistance;
+}
+
+CullingStats GetCullingStats()
+{
+    return cullingStats;
+}
+
+void SetRenderLOD(bool enabled)
+{
+    lodEnabled = enabled;
+}
+
+bool IsRenderLODEnabled()
+{
+    return lodEnabled;
+}
+
+void SetLODSettings(const LODSettings &settings)
+{
+    lodSettings = settings;
+}
+
+LODSettings GetLODSettings()
+{
+    return lodSettings;
+}
+
+uint8_t GetGeometryLODCount(RenderGeometryType::Type type)
+{
+    if (static_cast<size_t>(type) >= geometryBufferList.size() || !geometryBufferList[type].vbh.IsValid())
+    {
+        return 0;
+    }
+    return geometryBufferList[type].lodCount;
+}
+
+Frustum GetCameraFrustum(Camera &camera)
+{
+    float view[16];
+    float proj[16];
+    MatrixToFloat16(GetCameraViewMatrix(camera.GetImpl()), view);
+    MatrixToFloat16(GetCameraProjectionMatrix(camera.GetImpl()), proj);
+    return Frustum::FromViewProjection(view, proj);
+}
+
 void EmptyRenderStack()
 {
     globalRenderStateStack.clear();
@@ -499,6 +889,322 @@ void DrawDebugBox(const Vector3 min, const Vector3 max)
 }
 
 
+// ---------------------------------------------------------------------------
+// Culling
+// ---------------------------------------------------------------------------
+
+static void SetViewCulling(RHIViewId viewID, const float *view, const float *proj, const Camera *camera)
+{
+    ViewCulling &culling = viewCulling[viewID];
+    culling.frustum = Frustum::FromViewProjection(view, proj);
+    culling.eye = camera ? camera->GetPosition() : Vector3();
+    culling.projScale = camera ? proj[5] : 0.0f;
+}
+
+// Tests the bounding spheres of `count` model matrices (each at matrices + offsets[i], or
+// matrices + 16 * i without offsets) against the view's frustum. Fills cullVisible.
+static size_t CullTransforms(RHIViewId viewID, const float *matrices, const uint32_t *offsets, size_t count)
+{
+    cullVisible.assign(count, 1);
+    auto it = viewCulling.find(viewID);
+    if (!cullingEnabled || it == viewCulling.end() || count == 0)
+    {
+        return count;
+    }
+
+    cullBounds.resize(count * 4);
+    float *x = cullBounds.data();
+    float *y = x + count;
+    float *z = y + count;
+    float *radius = z + count;
+    for (size_t i = 0; i < count; ++i)
+    {
+        const float *mtx = matrices + (offsets ? offsets[i] : i * 16);
+        x[i] = mtx[12];
+        y[i] = mtx[13];
+        z[i] = mtx[14];
+
+        // Rows 0-2 are the scaled basis vectors; the longest bounds the scale.
+        float sx = mtx[0] * mtx[0] + mtx[1] * mtx[1] + mtx[2] * mtx[2];
+        float sy = mtx[4] * mtx[4] + mtx[5] * mtx[5] + mtx[6] * mtx[6];
+        float sz = mtx[8] * mtx[8] + mtx[9] * mtx[9] + mtx[10] * mtx[10];
+        radius[i] = GEOMETRY_BOUNDING_RADIUS * std::sqrt(std::max(sx, std::max(sy, sz)));
+    }
+
+    CullingParams params;
+    params.eye = it->second.eye;
+    params.maxDistance = cullDistance;
+    size_t visible = CullSpheres(it->second.frustum, params, x, y, z, radius, count, cullVisible.data());
+
+    cullingStats.tested += static_cast<uint32_t>(count);
+    cullingStats.culled += static_cast<uint32_t>(count - visible);
+    return visible;
+}
+
+// ---------------------------------------------------------------------------
+// Render command list
+// ---------------------------------------------------------------------------
+
+static void RecordRenderCommand(RHIViewId viewID, RHIProgramHandle program, RenderGeometryType::Type type,
+                                const float *mtx, uint8_t lod)
+{
+    RenderCommand cmd;
+    float depth = 0.0f;
+    if (mtx)
+    {
+        cmd.transform = static_cast<uint32_t>(commandTransforms.size());
+        commandTransforms.insert(commandTransforms.end(), mtx, mtx + 16);
+
+        // Squared distance to the camera.
+        if (globalRenderState.camera)
+        {
+            Vector3 eye = globalRenderState.camera->GetPosition();
+            float dx = mtx[12] - eye.x;
+            float dy = mtx[13] - eye.y;
+            float dz = mtx[14] - eye.z;
+            depth = dx * dx + dy * dy + dz * dz;
+        }
+    }
+    else
+    {
+        cmd.transform = NO_TRANSFORM;
+    }
+
+    cmd.key = MakeRenderCommandKey(viewID, program.idx, static_cast<uint8_t>((type << LOD_GEOMETRY_BITS) | lod), depth);
+    renderCommands.push_back(cmd);
+}
+
+// Drops the recorded draws whose transforms fall outside their view. The list is
+// sorted, so each view is one contiguous run and the survivors keep their order.
+static void CullRenderCommands()
+{
+    std::vector<uint32_t> &offsets = cullOffsets;
+    std::vector<size_t> &indices = cullIndices;
+    size_t write = 0;
+    size_t begin = 0;
+    while (begin < renderCommands.size())
+    {
+        RHIViewId viewID = static_cast<RHIViewId>(renderCommands[begin].key >> 56);
+        size_t end = begin;
+        offsets.clear();
+        indices.clear();
+        for (; end < renderCommands.size() && static_cast<RHIViewId>(renderCommands[end].key >> 56) == viewID; ++end)
+        {
+            if (renderCommands[end].transform != NO_TRANSFORM)
+            {
+                offsets.push_back(renderCommands[end].transform);
+                indices.push_back(end);
+            }
+        }
+        CullTransforms(viewID, commandTransforms.data(), offsets.data(), offsets.size());
+
+        size_t tested = 0;
+        for (size_t i = begin; i < end; ++i)
+        {
+            bool visible = true;
+            if (tested < indices.size() && indices[tested] == i)
+            {
+                visible = cullVisible[tested++] != 0;
+            }
+            if (visible)
+            {
+                renderCommands[write++] = renderCommands[i];
+            }
+        }
+        begin = end;
+    }
+    renderCommands.resize(write);
+}
+
+static void FlushRenderCommands()
+{
+    renderQueueStats.commands = static_cast<uint32_t>(renderCommands.size());
+    if (renderCommands.empty())
+    {
+        return;
+    }
+
+    SortRenderCommands(renderCommands, renderCommandScratch);
+    CullRenderCommands();
+    if (renderCommands.empty())
+    {
+        commandTransforms.clear();
+        return;
+    }
+
+    RHIEncoder *enc = RHIBeginEncoder();
+    uint32_t boundGeometry = UINT32_MAX;
+    for (const RenderCommand &cmd : renderCommands)
+    {
+        RHIViewId viewID = static_cast<RHIViewId>(cmd.key >> 56);
+        RHIProgramHandle program;
+        program.idx = static_cast<uint16_t>((cmd.key >> 44) & 0xFFF);
+        uint32_t geometry = static_cast<uint32_t>((cmd.key >> 36) & 0xFF);
+        uint32_t depth = static_cast<uint32_t>(cmd.key >> 4);
+
+        uint8_t lod = static_cast<uint8_t>(geometry & ((1u << LOD_GEOMETRY_BITS) - 1));
+
+        // Buffers stay bound across submits; only a geometry or LOD change rebinds them.
+        if (geometry != boundGeometry)
+        {
+            GeometryBufferHandle buffers =
+                GetGeometryBufferHandle(static_cast<RenderGeometryType::Type>(geometry >> LOD_GEOMETRY_BITS));
+            RHIEncoderSetVertexBuffer(enc, 0, buffers.vbh);
+            RHIEncoderSetIndexBuffer(enc, buffers.lods[lod]);
+            boundGeometry = geometry;
+            ++renderQueueStats.bufferBinds;
+        }
+        if (lod > 0)
+        {
+            ++renderQueueStats.reducedLOD;
+        }
+        // Only the vertex/index buffers survive the submit; every draw sets its own transform,
+        // the identity when it has none, rather than relying on what the last submit left.
+        RHIEncoderSetTransform(enc,
+                               cmd.transform != NO_TRANSFORM ? &commandTransforms[cmd.transform] : IDENTITY_TRANSFORM);
+        RHIEncoderSubmit(enc, viewID, program, depth, true);
+    }
+    cullingStats.submitted += static_cast<uint32_t>(renderCommands.size());
+    RHIEncoderDiscard(enc);
+    RHIEndEncoder(enc);
+
+    renderCommands.clear();
+    commandTransforms.clear();
+}
+
+// ---------------------------------------------------------------------------
+// Mesh commands
+// ---------------------------------------------------------------------------
+
+static void FlushMeshCommands()
+{
+    renderQueueStats.meshCommands = static_cast<uint32_t>(meshCommands.size());
+    if (meshCommands.empty())
+    {
+        return;
+    }
+
+    // Stable, so draws of the same mesh keep their submission order.
+    std::stable_sort(meshCommands.begin(), meshCommands.end(), [](const MeshCommand &a, const MeshCommand &b) {
+        return a.viewID != b.viewID ? a.viewID < b.viewID : a.vbh.idx < b.vbh.idx;
+    });
+
+    // Dequantized meshes span [-1, 1] like the built-in geometry, so the same bounds apply.
+    std::vector<uint32_t> &offsets = cullOffsets;
+    size_t write = 0;
+    size_t begin = 0;
+    while (begin < meshCommands.size())
+    {
+        RHIViewId viewID = meshCommands[begin].viewID;
+        size_t end = begin;
+        offsets.clear();
+        for (; end < meshCommands.size() && meshCommands[end].viewID == viewID; ++end)
+        {
+            offsets.push_back(meshCommands[end].transform);
+        }
+        CullTransforms(viewID, meshTransforms.data(), offsets.data(), offsets.size());
+        for (size_t i = begin; i < end; ++i)
+        {
+            if (cullVisible[i - begin])
+            {
+                meshCommands[write++] = meshCommands[i];
+            }
+        }
+        begin = end;
+    }
+    meshCommands.resize(write);
+
+    RHIProgramHandle program = shaderProgramMap[MESH_SHADERPROGRAM_UUID].program;
+    RHIEncoder *enc = RHIBeginEncoder();
+    uint16_t boundBuffer = UINT16_MAX;
+    for (const MeshCommand &cmd : meshCommands)
+    {
+        if (cmd.vbh.idx != boundBuffer)
+        {
+            RHIEncoderSetVertexBuffer(enc, 0, cmd.vbh);
+            RHIEncoderSetIndexBuffer(enc, cmd.ibh);
+            boundBuffer = cmd.vbh.idx;
+            ++renderQueueStats.bufferBinds;
+        }
+        RHIEncoderSetTransform(enc, &meshTransforms[cmd.transform]);
+        RHIEncoderSubmit(enc, cmd.viewID, program, 0, true);
+    }
+    cullingStats.submitted += static_cast<uint32_t>(meshCommands.size());
+    RHIEncoderDiscard(enc);
+    RHIEndEncoder(enc);
+
+    meshCommands.clear();
+    meshTransforms.clear();
+}
+
+// ---------------------------------------------------------------------------
+// Instanced batches
+// ---------------------------------------------------------------------------
+
+static void FlushInstanceBatches()
+{
+    if (instanceBatches.empty())
+    {
+        return;
+    }
+
+    RHIProgramHandle program = shaderProgramMap[INSTANCED_SHADERPROGRAM_UUID].program;
+    RHIEncoder *enc = RHIBeginEncoder();
+    for (auto &[key, batch] : instanceBatches)
+    {
+        // Compact the visible matrices to the front of the batch.
+        size_t count = batch.matrices.size() / 16;
+        size_t visible = CullTransforms(batch.viewID, batch.matrices.data(), nullptr, count);
+        if (visible < count)
+        {
+            float *matrices = batch.matrices.data();
+            size_t write = 0;
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (cullVisible[i])
+                {
+                    if (write != i)
+                    {
+                        std::memcpy(matrices + write * 16, matrices + i * 16, 16 * sizeof(float));
+                    }
+                    ++write;
+                }
+            }
+        }
+        cullingStats.submitted += static_cast<uint32_t>(visible);
+        if (batch.lod > 0)
+        {
+            renderQueueStats.reducedLOD += static_cast<uint32_t>(visible);
+        }
+
+        GeometryBufferHandle buffers = GetGeometryBufferHandle(batch.type);
+        const float *data = batch.matrices.data();
+        uint32_t remaining = static_cast<uint32_t>(visible);
+
+        // A bucket larger than the transient instance buffer is split over several submits.
+        while (remaining > 0)
+        {
+            uint32_t count = RHIEncoderSetInstanceData(enc, data, remaining, RHI_INSTANCE_STRIDE);
+            if (count == 0)
+            {
+                DN_CORE_WARN("Instance data buffer exhausted, {} instances dropped this frame.", remaining);
+                break;
+            }
+            RHIEncoderSetVertexBuffer(enc, 0, buffers.vbh);
+            RHIEncoderSetIndexBuffer(enc, buffers.lods[batch.lod]);
+            RHIEncoderSubmit(enc, batch.viewID, program);
+            ++renderQueueStats.instancedSubmits;
+
+            data += static_cast<size_t>(count) * 16;
+            remaining -= count;
+        }
+
+        // Keep the capacity for the next frame.
+        batch.matrices.clear();
+    }
+    RHIEndEncoder(enc);
+}
+
 // ---------------------------------------------------------------------------
 // Geometry buffer management
 // ---------------------------------------------------------------------------
@@ -515,6 +1221,9 @@ static void CreateGeometryBuffers()
         RHIIndexBufferHandle ibh = RHICreateIndexBuffer(
             BoxRenderGeometry::GetIdentityTriList(), static_cast<uint32_t>(BoxRenderGeometry::TriSize()));
         geometryBufferList[RenderGeometryType::BOX] = GeometryBufferHandle(vbh, ibh);
+        CreateGeometryLODs(RenderGeometryType::BOX, BoxRenderGeometry::GetIdentityVertices(),
+                           BoxRenderGeometry::VertSize(), BoxRenderGeometry::GetIdentityTriList(),
+                           BoxRenderGeometry::TriSize());
     }
 
     /* Create PLANE Buffers */
@@ -525,6 +1234,9 @@ static void CreateGeometryBuffers()
         RHIIndexBufferHandle ibh = RHICreateIndexBuffer(
             PlaneRenderGeometry::GetIdentityTriList(), static_cast<uint32_t>(PlaneRenderGeometry::TriSize()));
         geometryBufferList[RenderGeometryType::PLANE] = GeometryBufferHandle(vbh, ibh);
+        CreateGeometryLODs(RenderGeometryType::PLANE, PlaneRenderGeometry::GetIdentityVertices(),
+                           PlaneRenderGeometry::VertSize(), PlaneRenderGeometry::GetIdentityTriList(),
+                           PlaneRenderGeometry::TriSize());
     }
 
     /* Create SPHERE Buffers */
@@ -535,6 +1247,9 @@ static void CreateGeometryBuffers()
         RHIIndexBufferHandle ibh = RHICreateIndexBuffer(
             SphereRenderGeometry::GetIdentityTriList(), static_cast<uint32_t>(SphereRenderGeometry::TriSize()));
         geometryBufferList[RenderGeometryType::SPHERE] = GeometryBufferHandle(vbh, ibh);
+        CreateGeometryLODs(RenderGeometryType::SPHERE, SphereRenderGeometry::GetIdentityVertices(),
+                           SphereRenderGeometry::VertSize(), SphereRenderGeometry::GetIdentityTriList(),
+                           SphereRenderGeometry::TriSize());
     }
 
     /* Create CAPSULE Buffers */
@@ -545,6 +1260,9 @@ static void CreateGeometryBuffers()
         RHIIndexBufferHandle ibh = RHICreateIndexBuffer(
             CapsuleRenderGeometry::GetIdentityTriList(), static_cast<uint32_t>(CapsuleRenderGeometry::TriSize()));
         geometryBufferList[RenderGeometryType::CAPSULE] = GeometryBufferHandle(vbh, ibh);
+        CreateGeometryLODs(RenderGeometryType::CAPSULE, CapsuleRenderGeometry::GetIdentityVertices(),
+                           CapsuleRenderGeometry::VertSize(), CapsuleRenderGeometry::GetIdentityTriList(),
+                           CapsuleRenderGeometry::TriSize());
     }
 
     /* Create CYLINDER Buffers */
@@ -555,6 +1273,9 @@ static void CreateGeometryBuffers()
         RHIIndexBufferHandle ibh = RHICreateIndexBuffer(
             CylinderRenderGeometry::GetIdentityTriList(), static_cast<uint32_t>(CylinderRenderGeometry::TriSize()));
         geometryBufferList[RenderGeometryType::CYLINDER] = GeometryBufferHandle(vbh, ibh);
+        CreateGeometryLODs(RenderGeometryType::CYLINDER, CylinderRenderGeometry::GetIdentityVertices(),
+                           CylinderRenderGeometry::VertSize(), CylinderRenderGeometry::GetIdentityTriList(),
+                           CylinderRenderGeometry::TriSize());
     }
 
     /* Create CONE Buffers */
@@ -565,6 +1286,9 @@ static void CreateGeometryBuffers()
         RHIIndexBufferHandle ibh = RHICreateIndexBuffer(
             ConeRenderGeometry::GetIdentityTriList(), static_cast<uint32_t>(ConeRenderGeometry::TriSize()));
         geometryBufferList[RenderGeometryType::CONE] = GeometryBufferHandle(vbh, ibh);
+        CreateGeometryLODs(RenderGeometryType::CONE, ConeRenderGeometry::GetIdentityVertices(),
+                           ConeRenderGeometry::VertSize(), ConeRenderGeometry::GetIdentityTriList(),
+                           ConeRenderGeometry::TriSize());
     }
 
     /* Create DISK Buffers */
@@ -575,6 +1299,9 @@ static void CreateGeometryBuffers()
         RHIIndexBufferHandle ibh = RHICreateIndexBuffer(
             DiskRenderGeometry::GetIdentityTriList(), static_cast<uint32_t>(DiskRenderGeometry::TriSize()));
         geometryBufferList[RenderGeometryType::DISK] = GeometryBufferHandle(vbh, ibh);
+        CreateGeometryLODs(RenderGeometryType::DISK, DiskRenderGeometry::GetIdentityVertices(),
+                           DiskRenderGeometry::VertSize(), DiskRenderGeometry::GetIdentityTriList(),
+                           DiskRenderGeometry::TriSize());
     }
 
     /* Create TRIANGLE Buffers */
@@ -585,7 +1312,85 @@ static void CreateGeometryBuffers()
         RHIIndexBufferHandle ibh = RHICreateIndexBuffer(
             TriangleRenderGeometry::GetIdentityTriList(), static_cast<uint32_t>(TriangleRenderGeometry::TriSize()));
         geometryBufferList[RenderGeometryType::TRIANGLE] = GeometryBufferHandle(vbh, ibh);
+        CreateGeometryLODs(RenderGeometryType::TRIANGLE, TriangleRenderGeometry::GetIdentityVertices(),
+                           TriangleRenderGeometry::VertSize(), TriangleRenderGeometry::GetIdentityTriList(),
+                           TriangleRenderGeometry::TriSize());
+    }
+}
+
+// Builds the simplified levels of a geometry whose level 0 is already in geometryBufferList.
+static void CreateGeometryLODs(RenderGeometryType::Type type, const PosColorVertex *vertices, size_t vertexCount,
+                               const uint16_t *indices, size_t indexCount)
+{
+    GeometryBufferHandle &buffers = geometryBufferList[type];
+
+    float radiusSq = 0.0f;
+    for (size_t i = 0; i < vertexCount; ++i)
+    {
+        radiusSq = std::max(radiusSq, vertices[i].x * vertices[i].x + vertices[i].y * vertices[i].y +
+                                          vertices[i].z * vertices[i].z);
+    }
+    buffers.radius = std::sqrt(radiusSq);
+
+    geometryLODIndices.resize(RenderGeometryType::Count);
+    std::vector<std::vector<uint16_t>> &levels = geometryLODIndices[type];
+    if (levels.empty())
+    {
+        levels = GenerateLODChain(vertices, vertexCount, indices, indexCount);
     }
+
+    buffers.lodCount = 1;
+    for (size_t lod = 1; lod < levels.size(); ++lod)
+    {
+        RHIIndexBufferHandle ibh =
+            RHICreateIndexBuffer(levels[lod].data(), static_cast<uint32_t>(levels[lod].size()));
+        if (!ibh.IsValid())
+        {
+            break;
+        }
+        buffers.lods[buffers.lodCount++] = ibh;
+    }
+}
+
+// Picks the level for one positioned draw from the projected size of its bounding sphere.
+static uint8_t SelectGeometryLOD(RHIViewId viewID, RenderGeometryType::Type type, const float *mtx, uint64_t objectID)
+{
+    if (!lodEnabled || static_cast<size_t>(type) >= geometryBufferList.size())
+    {
+        return 0;
+    }
+    const GeometryBufferHandle &buffers = geometryBufferList[type];
+    auto it = viewCulling.find(viewID);
+    if (buffers.lodCount <= 1 || it == viewCulling.end() || it->second.projScale <= 0.0f)
+    {
+        return 0;
+    }
+
+    float sx = mtx[0] * mtx[0] + mtx[1] * mtx[1] + mtx[2] * mtx[2];
+    float sy = mtx[4] * mtx[4] + mtx[5] * mtx[5] + mtx[6] * mtx[6];
+    float sz = mtx[8] * mtx[8] + mtx[9] * mtx[9] + mtx[10] * mtx[10];
+    float radius = buffers.radius * std::sqrt(std::max(sx, std::max(sy, sz)));
+
+    const Vector3 &eye = it->second.eye;
+    float dx = mtx[12] - eye.x;
+    float dy = mtx[13] - eye.y;
+    float dz = mtx[14] - eye.z;
+    float screenSize = ComputeScreenSize(radius, std::sqrt(dx * dx + dy * dy + dz * dz), it->second.projScale);
+
+    if (objectID != 0)
+    {
+        // One object may draw several geometry types; each keeps its own level.
+        uint64_t key = objectID ^ (static_cast<uint64_t>(type) * 0x9E3779B97F4A7C15ull);
+        return viewObjectLOD[viewID].Select(key, screenSize, buffers.lodCount, lodSettings);
+    }
+
+    // 20 bits per axis of the position cell, the geometry type in the top bits.
+    auto cell = [](float v) {
+        return static_cast<uint64_t>(static_cast<int64_t>(std::floor(v / LOD_KEY_CELL_SIZE)) & 0xFFFFF);
+    };
+    uint64_t key = (static_cast<uint64_t>(type) << 60) | (cell(mtx[12]) << 40) | (cell(mtx[13]) << 20) |
+                   cell(mtx[14]);
+    return viewLOD[viewID].Select(key, screenSize, buffers.lodCount, lodSettings);
 }
 
 static GeometryBufferHandle GetGeometryBufferHandle(RenderGeometryType::Type type)
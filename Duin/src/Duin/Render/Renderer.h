@@ -12,10 +12,13 @@
 
 #include "RHI.h"
 #include "RenderGeometry.h"
+#include "RenderLOD.h"
 #include "Camera.h"
+#include "Culling.h"
 #include "RenderShape.h"
 
 #include "Duin/Core/Utils/UUID.h"
+#include "Duin/Core/Utils/ThreadPool.h"
 #include "Color.h"
 
 #include <cstdint>
@@ -31,6 +34,7 @@ namespace duin
 struct RenderTexture;
 struct RenderState;
 struct ShaderProgram;
+class Mesh;
 
 /** @brief Initializes the rendering system. */
 void InitRenderer();
@@ -147,12 +151,145 @@ void EndEncoderFrame();
  * @{
  */
 void QueueRender(const RenderGeometryType::Type type);
-void QueueRender(
-    const RenderGeometryType::Type type, const Vector3 position, const Quaternion rotation, const Vector3 size);
+/**
+ * @brief Queues a positioned draw of a built-in geometry.
+ *
+ * objectID is a stable, non-zero identity of the drawn object (e.g. an entity id)
+ * used to keep its LOD level from flickering near a threshold. Without it
+ * (0, as for the Draw* functions) the level is remembered per 0.5-unit position
+ * cell: a moving object loses that history every time it changes cells, and
+ * objects of one geometry type sharing a cell share a level.
+ */
+void QueueRender(const RenderGeometryType::Type type, const Vector3 position, const Quaternion rotation,
+                 const Vector3 size, uint64_t objectID = 0);
+/** @brief Draws the instanced batches queued this frame and submits the frame. */
 void ExecuteRenderPipeline();
 void EmptyRenderStack();
+/**
+ * @brief Enables the instanced path (on by default).
+ *
+ * While active, positioned QueueRender calls (DrawBox, DrawSphere, ...) append
+ * a model matrix to a per-view, per-geometry batch instead of drawing. The
+ * batches are drawn by ExecuteRenderPipeline with one instanced submit each.
+ */
+void SetInstancedRendering(bool enabled);
+/** @brief True when instancing is enabled and supported by the backend and shaders. */
+bool IsInstancedRenderingActive();
+
+/**
+ * @struct RenderQueueStats
+ * @brief Counters of the last ExecuteRenderPipeline.
+ * @ingroup Render_Core
+ *
+ * Non-instanced draws are recorded during the frame and sorted by view,
+ * program, geometry and depth before encoding, so bufferBinds counts the
+ * geometry changes rather than the draws.
+ */
+struct RenderQueueStats
+{
+    uint32_t commands = 0;         ///< Recorded non-instanced draws.
+    uint32_t bufferBinds = 0;      ///< Vertex/index buffer binds they needed.
+    uint32_t instancedSubmits = 0; ///< Submits used for the instanced batches.
+    uint32_t meshCommands = 0;     ///< Recorded DrawMesh calls.
+    uint32_t reducedLOD = 0;       ///< Visible draws and instances below full detail.
+};
+
+RenderQueueStats GetRenderQueueStats();
+
+/**
+ * @brief Enables frustum culling of positioned draws (on by default).
+ *
+ * ExecuteRenderPipeline tests the bounding sphere of every positioned draw
+ * and instance against the frustum of the camera last bound to its view, and
+ * drops those outside before encoding.
+ */
+void SetRenderCulling(bool enabled);
+bool IsRenderCullingEnabled();
+/** @brief Also culls draws farther than distance from the camera. 0 (default) disables. */
+void SetRenderCullDistance(float distance);
+float GetRenderCullDistance();
+/** @brief Culling counters of the last ExecuteRenderPipeline. */
+CullingStats GetCullingStats();
+
+/**
+ * @brief Enables level-of-detail selection for positioned draws (on by default).
+ *
+ * Built-in geometry carries up to MAX_LOD_LEVELS index buffers. Each positioned
+ * draw picks one from the projected size of its bounding sphere in the camera
+ * last bound to its view, with hysteresis so objects near a threshold keep their
+ * level. Draws made through a DrawEncoder always use full detail.
+ */
+void SetRenderLOD(bool enabled);
+bool IsRenderLODEnabled();
+void SetLODSettings(const LODSettings &settings);
+LODSettings GetLODSettings();
+/** @brief Number of levels built for a geometry type, 0 if it has no buffers. */
+uint8_t GetGeometryLODCount(RenderGeometryType::Type type);
+
+/** @brief Frustum of a camera, for culling entities before they are queued. */
+Frustum GetCameraFrustum(Camera &camera);
 /** @} */
 
+/**
+ * @class DrawEncoder
+ * @brief Submits one ParallelDraw chunk through its thread's encoder.
+ * @ingroup Render_Core
+ *
+ * Draws are encoded immediately with the default program. They bypass the
+ * recorded command list, the instanced batches, culling and LOD selection;
+ * cull in the callback with GetCameraFrustum if needed.
+ */
+class DrawEncoder
+{
+  public:
+    DrawEncoder() = default;
+    DrawEncoder(RHIEncoder *encoder, RHIViewId viewID, RHIProgramHandle program)
+        : encoder_(encoder), viewID_(viewID), program_(program)
+    {
+    }
+
+    void Draw(RenderGeometryType::Type type, const Vector3 position, const Quaternion rotation, const Vector3 size);
+    /** @brief Draws with a model matrix in the RHI layout. */
+    void Draw(RenderGeometryType::Type type, const float *mtx);
+
+    RHIEncoder *GetRHIEncoder() const
+    {
+        return encoder_;
+    }
+    RHIViewId GetViewID() const
+    {
+        return viewID_;
+    }
+    /** @brief Draws submitted through this DrawEncoder. */
+    uint32_t GetSubmitCount() const
+    {
+        return submitCount_;
+    }
+
+  private:
+    RHIEncoder *encoder_ = nullptr;
+    RHIViewId viewID_ = RHI_VIEW_3D;
+    RHIProgramHandle program_;
+    uint32_t boundGeometry_ = UINT32_MAX;
+    uint32_t submitCount_ = 0;
+};
+
+using ParallelDrawFn = std::function<void(DrawEncoder &encoder, size_t begin, size_t end)>;
+
+/**
+ * @brief Splits [0, count) into chunks of at most grainSize and encodes them across the pool.
+ *
+ * Every pool thread that runs a chunk, the calling thread included, gets its
+ * own encoder, opened on its first chunk and closed before ParallelDraw
+ * returns; fn receives a DrawEncoder wrapping it for each chunk. The
+ * renderer's main encoder is never used.
+ * Chunks that find no free encoder (the backend caps how many may be open)
+ * run on the calling thread afterwards, once the workers' encoders are closed. Draws target the current view, so
+ * call between BeginDraw3D and EndDraw3D (or inside texture mode); safe to
+ * call from an ECS system.
+ */
+void ParallelDraw(size_t count, size_t grainSize, const ParallelDrawFn &fn, ThreadPool &pool = ThreadPool::Get());
+
 /** @brief Clears the background to a solid color. */
 void ClearBackground(Color color = Color(0x443355FF));
 
@@ -186,6 +323,16 @@ void DrawDisk(
 void DrawTriangle(
     const Vector3 position = Vector3(), const Quaternion rotation = QuaternionIdentity(),
     const Vector3 size = Vector3(1.0f, 1.0f, 1.0f));
+/**
+ * @brief Draws a cooked mesh (see AssetManager::LoadMesh).
+ *
+ * Recorded like the primitives and drawn by ExecuteRenderPipeline, grouped by
+ * mesh so consecutive draws share one buffer bind. The mesh must stay alive
+ * until then.
+ */
+void DrawMesh(
+    const Mesh &mesh, const Vector3 position = Vector3(), const Quaternion rotation = QuaternionIdentity(),
+    const Vector3 size = Vector3(1.0f, 1.0f, 1.0f));
 
 /**
  * @name Debug Draw Functions
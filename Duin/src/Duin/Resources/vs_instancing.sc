@@ -0,0 +1,17 @@
+$input a_position, a_color0, i_data0, i_data1, i_data2, i_data3
+$output v_color0
+
+/*
+ * Copyright 2011-2025 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#include "../common/common.sh"
+
+void main()
+{
+	mat4 model = mtxFromCols(i_data0, i_data1, i_data2, i_data3);
+	vec4 worldPos = mul(model, vec4(a_position, 1.0) );
+	gl_Position = mul(u_viewProj, worldPos);
+	v_color0 = a_color0;
+}
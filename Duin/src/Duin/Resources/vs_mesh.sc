@@ -0,0 +1,29 @@
+$input a_position, a_texcoord1
+$output v_color0
+
+/*
+ * Cooked meshes (PackedMeshVertex): a_position is snorm16 inside the mesh
+ * bounds, dequantized by the model matrix; a_texcoord1 is the octahedral
+ * normal. Shaded with a fixed directional light.
+ */
+
+#include "../common/common.sh"
+
+vec3 decodeOctahedral(vec2 e)
+{
+	vec3 n = vec3(e.x, e.y, 1.0 - abs(e.x) - abs(e.y) );
+	float t = max(-n.z, 0.0);
+	n.x += n.x >= 0.0 ? -t : t;
+	n.y += n.y >= 0.0 ? -t : t;
+	return normalize(n);
+}
+
+void main()
+{
+	gl_Position = mul(u_modelViewProj, vec4(a_position, 1.0) );
+
+	// The model matrix carries the bounds scale, so lighting is approximate for very flat meshes.
+	vec3 normal = normalize(mul(u_model[0], vec4(decodeOctahedral(a_texcoord1), 0.0) ).xyz);
+	float ndotl = max(dot(normal, normalize(vec3(0.4, 1.0, 0.3) ) ), 0.0);
+	v_color0 = vec4(vec3_splat(0.25 + 0.75 * ndotl), 1.0);
+}
@@ -10,6 +10,8 @@
 #include "Duin/ECS/PrefabRegistry.h"
 #include "Duin/Core/Debug/DNAssert.h"
 #include "Duin/IO/FileModule.h"
+#include "Duin/Core/Utils/FrameArena.h"
+#include "Duin/Core/Utils/ThreadPool.h"
 
 #include <rfl/json.hpp>
 
@@ -19,14 +21,21 @@
 
 #define PRETTY_WRITE_JSON
 
-#ifdef PRETTY_WRITE_JSON
 #include <rapidjson/document.h>
 #include <rapidjson/writer.h>
-#include <rapidjson/prettywriter.h>
 #include <rapidjson/stringbuffer.h>
+#ifdef PRETTY_WRITE_JSON
+#include <rapidjson/prettywriter.h>
 #endif
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
+#include <cstring>
+#include <deque>
+#include <map>
 #include <memory>
+#include <set>
+#include <tuple>
 #include <string>
 #include <vector>
 #include <Duin/Core/Debug/DNLog.h>
@@ -82,56 +91,63 @@ duin::SceneBuilder::SceneBuilder()
 // PackComponent
 duin::PackedComponent duin::SceneBuilder::PackComponent(Entity e, Entity cmp)
 {
-    std::string cmpstr;
+    ComponentSerializer &serializer = ComponentSerializer::Get();
+    std::string typeName;
+    const void *data = nullptr;
     if (cmp.IsTag())
     {
-        cmpstr = duin::ComponentSerializer::Get().Serialize(cmp.GetName(), nullptr);
+        typeName = cmp.GetName();
     }
     else if (cmp.IsPair())
     {
         Entity first = cmp.First();
         Entity second = cmp.Second();
-        cmpstr = duin::ComponentSerializer::Get().Serialize(first.GetName(), second.Get(cmp));
+        typeName = first.GetName();
+        data = second.Get(cmp);
     }
     else
     {
-        if (!duin::ComponentSerializer::Get().IsRegistered(cmp.GetName()))
+        if (!serializer.IsRegistered(cmp.GetName()))
         {
             return PackedComponent();
         }
-        cmpstr = duin::ComponentSerializer::Get().Serialize(cmp.GetName(), e.Get(cmp));
-    }
-
-    if (cmpstr.empty() || cmpstr == "" || cmpstr == "{}")
-    {
-        DN_CORE_WARN("SceneBuilder::PackComponent - Failed to serialize component: {}", cmp.GetName());
-        return PackedComponent();
+        typeName = cmp.GetName();
+        data = e.Get(cmp);
     }
 
-    JSONValue v = JSONValue::Parse(cmpstr);
-
-    if (!v.HasMember("type"))
+    // Written once, straight from the component; the writer reports the "type" it wrote.
+    PackedComponent pcmp;
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    if (!serializer.Serialize(typeName, data, writer, &pcmp.componentTypeName) || pcmp.componentTypeName.empty())
     {
         DN_CORE_WARN("SceneBuilder::PackComponent - Serialized component missing 'type' field: {}", cmp.GetName());
         return PackedComponent();
     }
-
-    PackedComponent pcmp;
-    pcmp.componentTypeName = v["type"].GetString();
-    pcmp.jsonData = v.Write();
+    pcmp.jsonData.assign(buffer.GetString(), buffer.GetSize());
 
     return pcmp;
 }
 
+std::string duin::PackedComponent::ToJSON() const
+{
+    return jsonNode.has_value() ? jsonNode->Write() : jsonData;
+}
+
 void duin::SceneBuilder::InstantiateComponent(const PackedComponent &pc, Entity e)
 {
+    if (pc.jsonNode.has_value())
+    {
+        ComponentSerializer::Get().Deserialize(e, pc.componentTypeName, pc.jsonNode->GetRJSONValue());
+        return;
+    }
     void *data = nullptr;
     ComponentSerializer::Get().Deserialize(e, pc.componentTypeName, data, pc.jsonData);
 }
 
 duin::JSONValue duin::SceneBuilder::SerializeComponent(const PackedComponent &pc)
 {
-    JSONValue json = JSONValue::Parse(pc.jsonData);
+    JSONValue json = pc.jsonNode.has_value() ? *pc.jsonNode : JSONValue::Parse(pc.jsonData);
     return json;
 }
 
@@ -146,7 +162,7 @@ duin::PackedComponent duin::SceneBuilder::DeserializeComponent(const JSONValue &
     }
 
     pc.componentTypeName = comp.GetMember("type").GetString();
-    pc.jsonData = comp.Write();
+    pc.jsonNode = comp;
 
     return pc;
 }
@@ -307,8 +323,12 @@ void duin::SceneBuilder::InstantiatePair(const PackedPair &pp, Entity e)
 duin::JSONValue duin::SceneBuilder::SerializePair(const PackedPair &pp)
 {
     JSONValue json;
-    json.SetObject();
+    WritePair(pp, json);
+    return json;
+}
 
+void duin::SceneBuilder::WritePair(const PackedPair &pp, JSONValue &json)
+{
     json.AddMember(PackedPair::TAG_RELATIONSHIPNAME, pp.relationshipName);
     json.AddMember(PackedPair::TAG_RELATIONSHIPUUID, pp.relationshipUUID.ToStrHex());
     json.AddMember(PackedPair::TAG_RELATIONSHIP_IS_COMPONENT, pp.relationshipIsComponent);
@@ -324,8 +344,6 @@ duin::JSONValue duin::SceneBuilder::SerializePair(const PackedPair &pp)
     {
         json.AddMember(PackedPair::TAG_DATA, pp.jsonData);
     }
-
-    return json;
 }
 
 duin::PackedPair duin::SceneBuilder::DeserializePair(const JSONValue &pair)
@@ -658,54 +676,76 @@ void duin::SceneBuilder::InstantiateExternalScene(const PackedExternalDependency
 duin::JSONValue duin::SceneBuilder::SerializeEntity(const PackedEntity &pe)
 {
     JSONValue json;
-    json.SetObject();
+    WriteEntity(pe, json);
+    return json;
+}
 
+namespace
+{
+// Nodes read from a JSON scene are copied node to node. Text packed from a world is parsed once,
+// straight into the array's document rather than into a document of its own.
+void AppendComponentJSON(duin::JSONValue &array, const duin::PackedComponent &pc)
+{
+    if (pc.jsonNode.has_value())
+    {
+        array.PushBack(*pc.jsonNode);
+        return;
+    }
+    rapidjson::Document parsed(&array.GetAllocator());
+    parsed.Parse(pc.jsonData.c_str(), pc.jsonData.size());
+    if (parsed.HasParseError())
+    {
+        DN_CORE_WARN("SceneBuilder::WriteEntity - Skipping unreadable JSON of component: {}", pc.componentTypeName);
+        return;
+    }
+    array.GetRJSONValue().PushBack(parsed.Move(), array.GetAllocator());
+}
+} // namespace
+
+// Builds the subtree in json's own document: children come from NewObject()/NewArray() and are
+// moved into place, so each node is written once instead of being copied at every level.
+void duin::SceneBuilder::WriteEntity(const PackedEntity &pe, JSONValue &json)
+{
     json.AddMember(PackedEntity::TAG_UUID, UUID::ToStringHex(pe.uuid));
     json.AddMember(PackedEntity::TAG_NAME, pe.name);
     json.AddMember(PackedEntity::TAG_ENABLED, pe.enabled);
 
-    JSONValue tagsArray;
-    tagsArray.SetArray();
+    JSONValue tagsArray = json.NewArray();
     for (const auto &tag : pe.tags)
     {
-        JSONValue cmpJSON = JSONValue::Parse(tag.jsonData);
-        tagsArray.PushBack(cmpJSON);
+        AppendComponentJSON(tagsArray, tag);
     }
-    json.AddMember(PackedEntity::TAG_TAGS, tagsArray);
+    json.AddMember(PackedEntity::TAG_TAGS, std::move(tagsArray));
 
-    JSONValue pairsArray;
-    pairsArray.SetArray();
+    JSONValue pairsArray = json.NewArray();
     for (const auto &pair : pe.pairs)
     {
-        JSONValue pairJSON = SerializePair(pair);
-        pairsArray.PushBack(pairJSON);
+        JSONValue pairJSON = json.NewObject();
+        WritePair(pair, pairJSON);
+        pairsArray.PushBack(std::move(pairJSON));
     }
-    json.AddMember(PackedEntity::TAG_PAIRS, pairsArray);
+    json.AddMember(PackedEntity::TAG_PAIRS, std::move(pairsArray));
 
-    JSONValue componentsArray;
-    componentsArray.SetArray();
+    JSONValue componentsArray = json.NewArray();
     for (const auto &cmp : pe.components)
     {
-        JSONValue cmpJSON = JSONValue::Parse(cmp.jsonData);
-        componentsArray.PushBack(cmpJSON);
+        AppendComponentJSON(componentsArray, cmp);
     }
-    json.AddMember(PackedEntity::TAG_COMPONENTS, componentsArray);
+    json.AddMember(PackedEntity::TAG_COMPONENTS, std::move(componentsArray));
 
-    JSONValue childrenArray;
-    childrenArray.SetArray();
+    JSONValue childrenArray = json.NewArray();
     for (const auto &child : pe.children)
     {
-        JSONValue eJSON = SerializeEntity(child);
-        childrenArray.PushBack(eJSON);
+        JSONValue eJSON = json.NewObject();
+        WriteEntity(child, eJSON);
+        childrenArray.PushBack(std::move(eJSON));
     }
-    json.AddMember(PackedEntity::TAG_CHILDREN, childrenArray);
+    json.AddMember(PackedEntity::TAG_CHILDREN, std::move(childrenArray));
 
     if (pe.instanceOf.has_value())
     {
         json.AddMember(PackedEntity::TAG_INSTANCEOF, SerializeExternalDependency(*pe.instanceOf));
     }
-
-    return json;
 }
 
 duin::PackedEntity duin::SceneBuilder::DeserializeEntity(const JSONValue &json)
@@ -742,7 +782,7 @@ duin::PackedEntity duin::SceneBuilder::DeserializeEntity(const JSONValue &json)
                 }
                 PackedComponent cmp;
                 cmp.componentTypeName = cmpJSON.GetMember("type").GetString();
-                cmp.jsonData = cmpJSON.Write();
+                cmp.jsonNode = cmpJSON;
                 if (!cmp.componentTypeName.empty())
                 {
                     pe.tags.push_back(cmp);
@@ -790,7 +830,7 @@ duin::PackedEntity duin::SceneBuilder::DeserializeEntity(const JSONValue &json)
                 }
                 PackedComponent cmp;
                 cmp.componentTypeName = cmpJSON.GetMember("type").GetString();
-                cmp.jsonData = cmpJSON.Write();
+                cmp.jsonNode = cmpJSON;
                 if (!cmp.componentTypeName.empty())
                 {
                     pe.components.push_back(cmp);
@@ -913,23 +953,23 @@ duin::JSONValue duin::SceneBuilder::SerializeScene(const PackedScene &pscn)
 
     // Metadata
     {
-        JSONValue meta;
-        meta.SetObject();
+        JSONValue meta = json.NewObject();
         meta.AddMember(PackedSceneMetadata::TAG_EDITORVERSION, pscn.metadata.editorVersion);
         meta.AddMember(PackedSceneMetadata::TAG_ENGINEVERSION, pscn.metadata.engineVersion);
         meta.AddMember(PackedSceneMetadata::TAG_LASTMODIFIED, pscn.metadata.lastModified);
         meta.AddMember(PackedSceneMetadata::TAG_AUTHOR, pscn.metadata.author);
-        json.AddMember(PackedScene::TAG_METADATA, meta);
+        json.AddMember(PackedScene::TAG_METADATA, std::move(meta));
     }
 
     // Entities
-    JSONValue entitiesArray;
-    entitiesArray.SetArray();
+    JSONValue entitiesArray = json.NewArray();
     for (const auto &entity : pscn.entities)
     {
-        entitiesArray.PushBack(SerializeEntity(entity));
+        JSONValue entityJSON = json.NewObject();
+        WriteEntity(entity, entityJSON);
+        entitiesArray.PushBack(std::move(entityJSON));
     }
-    json.AddMember(PackedScene::TAG_ENTITIES, entitiesArray);
+    json.AddMember(PackedScene::TAG_ENTITIES, std::move(entitiesArray));
 
     return json;
 }
@@ -1007,113 +1047,971 @@ duin::PackedScene duin::SceneBuilder::DeserializeSceneFromFile(const std::string
     return DeserializeScene(v);
 }
 
-// Pre-pass helpers
+// ============================================================
+// Binary scene format
+// ============================================================
 
-void duin::SceneBuilder::PrePassEntity(Entity e)
+namespace
 {
-    UUID uuid; // fresh random UUID
-    instanceToPackedEntityMap[e.GetID()] = uuid;
-    for (Entity child : e.GetChildren())
+// All records are fixed-size, little-endian and read with memcpy, so the
+// buffer may be unaligned (e.g. a mapped file).
+struct BinStringRef
+{
+    uint32_t offset = 0;
+    uint32_t size = 0;
+};
+
+struct BinHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint64_t sceneUUID;
+    BinStringRef name;
+    BinStringRef editorVersion;
+    BinStringRef engineVersion;
+    BinStringRef lastModified;
+    BinStringRef author;
+    uint32_t entityCount;
+    uint32_t typeCount;
+    uint32_t componentCount;
+    uint32_t componentRefCount;
+    uint32_t pairCount;
+    uint32_t rootCount;
+    uint64_t entitiesOffset;
+    uint64_t typesOffset;
+    uint64_t componentsOffset;
+    uint64_t componentRefsOffset;
+    uint64_t pairsOffset;
+    uint64_t stringsOffset;
+    uint64_t stringsSize;
+    uint64_t blobsOffset;
+    uint64_t blobsSize;
+};
+
+// Entities are stored depth-first (pre-order); each one is followed by its subtree.
+struct BinEntity
+{
+    uint64_t uuid;
+    BinStringRef name;
+    BinStringRef instanceOf; // AssetRef JSON, only read when hasInstanceOf is set
+    uint32_t childCount;
+    uint32_t firstPair;
+    uint32_t pairCount;
+    uint32_t firstComponentRef; // Range in the component ref table, in pack order
+    uint32_t componentCount;
+    uint32_t firstTagRef;
+    uint32_t tagCount;
+    uint8_t enabled;
+    uint8_t hasInstanceOf;
+    uint8_t pad[2];
+};
+
+// Component records of one type are contiguous, and so are their payloads.
+struct BinType
+{
+    BinStringRef name;
+    uint64_t blobOffset;
+    uint64_t blobSize;
+    uint32_t firstComponent;
+    uint32_t componentCount;
+};
+
+struct BinComponent
+{
+    uint32_t entityIndex;
+    uint32_t typeIndex;
+    uint32_t dataOffset; // Relative to the type blob
+    uint32_t dataSize;
+};
+
+struct BinPair
+{
+    BinStringRef relationshipName;
+    BinStringRef relationshipPath;
+    BinStringRef targetName;
+    BinStringRef targetPath;
+    BinStringRef data;
+    uint64_t relationshipUUID;
+    uint64_t targetUUID;
+    uint8_t relationshipIsComponent;
+    uint8_t targetIsComponent;
+    uint8_t pad[6];
+};
+
+static_assert(sizeof(BinHeader) == 152, "Binary scene header layout changed; bump BINARY_VERSION");
+static_assert(sizeof(BinEntity) == 56, "Binary scene entity layout changed; bump BINARY_VERSION");
+static_assert(sizeof(BinType) == 32, "Binary scene type layout changed; bump BINARY_VERSION");
+static_assert(sizeof(BinComponent) == 16, "Binary scene component layout changed; bump BINARY_VERSION");
+static_assert(sizeof(BinPair) == 64, "Binary scene pair layout changed; bump BINARY_VERSION");
+
+class SceneBinaryWriter
+{
+  public:
+    explicit SceneBinaryWriter(const duin::PackedScene &pscn) : pscn(pscn)
     {
-        PrePassEntity(child);
     }
-}
 
-void duin::SceneBuilder::PrePassInstantiate(const PackedEntity &pe, World *world, Entity parent)
-{
-    Entity e = world->Entity();
-    if (parent.IsValid())
+    std::vector<uint8_t> Write()
     {
-        e.ChildOf(parent);
+        for (const duin::PackedEntity &pe : pscn.entities)
+        {
+            AddEntity(pe);
+        }
+        return Assemble();
     }
-    //if (!pe.name.empty())
-    //{
-    //    e.SetName(pe.name);
-    //}
-    packedEntityToInstanceMap[pe.uuid] = e.GetID();
-    for (const PackedEntity &child : pe.children)
+
+  private:
+    struct PendingComponent
     {
-        PrePassInstantiate(child, world, e);
+        uint32_t entityIndex;
+        const std::string *json;
+    };
+
+    const duin::PackedScene &pscn;
+    std::vector<BinEntity> entities;
+    std::vector<BinPair> pairs;
+    std::vector<std::string> typeNames;
+    std::unordered_map<std::string, uint32_t> typeIndices;
+    std::vector<std::vector<PendingComponent>> pendingByType;
+    std::vector<std::pair<uint32_t, uint32_t>> pendingRefs; // (type, index within type)
+    std::string strings;
+    std::unordered_map<std::string, BinStringRef> stringRefs;
+    std::deque<std::string> writtenNodes; // Text of components held as JSON nodes; a deque keeps it in place
+
+    BinStringRef AddString(const std::string &str)
+    {
+        if (str.empty())
+            return {};
+        auto it = stringRefs.find(str);
+        if (it != stringRefs.end())
+            return it->second;
+
+        BinStringRef ref{static_cast<uint32_t>(strings.size()), static_cast<uint32_t>(str.size())};
+        strings.append(str);
+        stringRefs.emplace(str, ref);
+        return ref;
     }
-}
 
-duin::Entity duin::SceneBuilder::InstantiateScene(PackedScene &pscn, World *world)
+    void AddComponentRef(uint32_t entityIndex, const duin::PackedComponent &pc)
+    {
+        auto [it, inserted] = typeIndices.try_emplace(pc.componentTypeName, static_cast<uint32_t>(typeNames.size()));
+        if (inserted)
+        {
+            typeNames.push_back(pc.componentTypeName);
+            pendingByType.emplace_back();
+        }
+        std::vector<PendingComponent> &list = pendingByType[it->second];
+        pendingRefs.emplace_back(it->second, static_cast<uint32_t>(list.size()));
+        const std::string *json = &pc.jsonData;
+        if (pc.jsonNode.has_value())
+        {
+            json = &writtenNodes.emplace_back(pc.jsonNode->Write());
+        }
+        list.push_back({entityIndex, json});
+    }
+
+    void AddEntity(const duin::PackedEntity &pe)
+    {
+        uint32_t index = static_cast<uint32_t>(entities.size());
+        entities.emplace_back();
+
+        BinEntity be{};
+        be.uuid = static_cast<uint64_t>(pe.uuid);
+        be.name = AddString(pe.name);
+        be.enabled = pe.enabled ? 1 : 0;
+        if (pe.instanceOf.has_value())
+        {
+            be.hasInstanceOf = 1;
+            be.instanceOf = AddString(rfl::json::write(*pe.instanceOf));
+        }
+
+        be.firstPair = static_cast<uint32_t>(pairs.size());
+        be.pairCount = static_cast<uint32_t>(pe.pairs.size());
+        for (const duin::PackedPair &pp : pe.pairs)
+        {
+            BinPair bp{};
+            bp.relationshipName = AddString(pp.relationshipName);
+            bp.relationshipPath = AddString(pp.relationshipPath);
+            bp.targetName = AddString(pp.targetName);
+            bp.targetPath = AddString(pp.targetPath);
+            bp.data = AddString(pp.jsonData);
+            bp.relationshipUUID = static_cast<uint64_t>(pp.relationshipUUID);
+            bp.targetUUID = static_cast<uint64_t>(pp.targetUUID);
+            bp.relationshipIsComponent = pp.relationshipIsComponent ? 1 : 0;
+            bp.targetIsComponent = pp.targetIsComponent ? 1 : 0;
+            pairs.push_back(bp);
+        }
+
+        be.firstComponentRef = static_cast<uint32_t>(pendingRefs.size());
+        be.componentCount = static_cast<uint32_t>(pe.components.size());
+        for (const duin::PackedComponent &pc : pe.components)
+        {
+            AddComponentRef(index, pc);
+        }
+
+        be.firstTagRef = static_cast<uint32_t>(pendingRefs.size());
+        be.tagCount = static_cast<uint32_t>(pe.tags.size());
+        for (const duin::PackedComponent &tag : pe.tags)
+        {
+            AddComponentRef(index, tag);
+        }
+
+        be.childCount = static_cast<uint32_t>(pe.children.size());
+        entities[index] = be;
+
+        for (const duin::PackedEntity &child : pe.children)
+        {
+            AddEntity(child);
+        }
+    }
+
+    template <typename T>
+    static void Append(std::vector<uint8_t> &out, const T *items, size_t count)
+    {
+        if (count == 0)
+            return;
+        const uint8_t *bytes = reinterpret_cast<const uint8_t *>(items);
+        out.insert(out.end(), bytes, bytes + sizeof(T) * count);
+    }
+
+    static uint64_t Align(std::vector<uint8_t> &out)
+    {
+        out.resize((out.size() + 7) & ~size_t(7), 0);
+        return out.size();
+    }
+
+    std::vector<uint8_t> Assemble()
+    {
+        // Group component records and payloads by type.
+        std::vector<BinType> types(typeNames.size());
+        std::vector<BinComponent> components;
+        std::string blobs;
+        for (uint32_t t = 0; t < typeNames.size(); ++t)
+        {
+            BinType &bt = types[t];
+            bt.name = AddString(typeNames[t]);
+            bt.blobOffset = blobs.size();
+            bt.firstComponent = static_cast<uint32_t>(components.size());
+            bt.componentCount = static_cast<uint32_t>(pendingByType[t].size());
+            for (const PendingComponent &pending : pendingByType[t])
+            {
+                BinComponent bc{};
+                bc.entityIndex = pending.entityIndex;
+                bc.typeIndex = t;
+                bc.dataOffset = static_cast<uint32_t>(blobs.size() - bt.blobOffset);
+                bc.dataSize = static_cast<uint32_t>(pending.json->size());
+                blobs.append(*pending.json);
+                components.push_back(bc);
+            }
+            bt.blobSize = blobs.size() - bt.blobOffset;
+        }
+
+        std::vector<uint32_t> componentRefs;
+        componentRefs.reserve(pendingRefs.size());
+        for (const auto &[type, local] : pendingRefs)
+        {
+            componentRefs.push_back(types[type].firstComponent + local);
+        }
+
+        BinHeader header{};
+        std::memcpy(header.magic, duin::PackedScene::BINARY_MAGIC, sizeof(header.magic));
+        header.version = duin::PackedScene::BINARY_VERSION;
+        header.sceneUUID = static_cast<uint64_t>(pscn.uuid);
+        header.name = AddString(pscn.name);
+        header.editorVersion = AddString(pscn.metadata.editorVersion);
+        header.engineVersion = AddString(pscn.metadata.engineVersion);
+        header.lastModified = AddString(pscn.metadata.lastModified);
+        header.author = AddString(pscn.metadata.author);
+        header.entityCount = static_cast<uint32_t>(entities.size());
+        header.typeCount = static_cast<uint32_t>(types.size());
+        header.componentCount = static_cast<uint32_t>(components.size());
+        header.componentRefCount = static_cast<uint32_t>(componentRefs.size());
+        header.pairCount = static_cast<uint32_t>(pairs.size());
+        header.rootCount = static_cast<uint32_t>(pscn.entities.size());
+
+        std::vector<uint8_t> out(sizeof(BinHeader), 0);
+        out.reserve(sizeof(BinHeader) + entities.size() * sizeof(BinEntity) + components.size() * sizeof(BinComponent) +
+                    pairs.size() * sizeof(BinPair) + strings.size() + blobs.size() + 64);
+
+        header.entitiesOffset = Align(out);
+        Append(out, entities.data(), entities.size());
+        header.typesOffset = Align(out);
+        Append(out, types.data(), types.size());
+        header.componentsOffset = Align(out);
+        Append(out, components.data(), components.size());
+        header.componentRefsOffset = Align(out);
+        Append(out, componentRefs.data(), componentRefs.size());
+        header.pairsOffset = Align(out);
+        Append(out, pairs.data(), pairs.size());
+        header.stringsOffset = Align(out);
+        header.stringsSize = strings.size();
+        Append(out, strings.data(), strings.size());
+        header.blobsOffset = Align(out);
+        header.blobsSize = blobs.size();
+        Append(out, blobs.data(), blobs.size());
+
+        std::memcpy(out.data(), &header, sizeof(BinHeader));
+        return out;
+    }
+};
+
+class SceneBinaryReader
 {
-    DN_CORE_ASSERT(world != nullptr, "World is nullptr!");
-    Entity rootEntity;
+  public:
+    SceneBinaryReader(const uint8_t *data, size_t size) : data(data), size(size)
+    {
+    }
 
-    instanceToPackedEntityMap.clear();
-    packedEntityToInstanceMap.clear();
+    bool Read(duin::PackedScene &pscn)
+    {
+        if (!duin::SceneBuilder::IsSceneBinary(data, size))
+        {
+            DN_CORE_WARN("SceneBuilder::DeserializeSceneBinary - Not a binary scene");
+            return false;
+        }
+        std::memcpy(&header, data, sizeof(BinHeader));
+        if (header.version != duin::PackedScene::BINARY_VERSION)
+        {
+            DN_CORE_WARN("SceneBuilder::DeserializeSceneBinary - Unsupported version {} (expected {})", header.version,
+                         duin::PackedScene::BINARY_VERSION);
+            return false;
+        }
+        if (!CheckRange(header.entitiesOffset, uint64_t(header.entityCount) * sizeof(BinEntity)) ||
+            !CheckRange(header.typesOffset, uint64_t(header.typeCount) * sizeof(BinType)) ||
+            !CheckRange(header.componentsOffset, uint64_t(header.componentCount) * sizeof(BinComponent)) ||
+            !CheckRange(header.componentRefsOffset, uint64_t(header.componentRefCount) * sizeof(uint32_t)) ||
+            !CheckRange(header.pairsOffset, uint64_t(header.pairCount) * sizeof(BinPair)) ||
+            !CheckRange(header.stringsOffset, header.stringsSize) || !CheckRange(header.blobsOffset, header.blobsSize) ||
+            header.rootCount > header.entityCount)
+        {
+            DN_CORE_WARN("SceneBuilder::DeserializeSceneBinary - Truncated or corrupt scene ({} bytes)", size);
+            return false;
+        }
 
-    // Pre-pass: create all entities so pair references can be resolved across root entities.
-    for (PackedEntity &pEntity : pscn.entities)
+        types.resize(header.typeCount);
+        for (uint32_t t = 0; t < header.typeCount; ++t)
+        {
+            std::memcpy(&types[t], data + header.typesOffset + t * sizeof(BinType), sizeof(BinType));
+            if (types[t].blobOffset > header.blobsSize || types[t].blobSize > header.blobsSize - types[t].blobOffset)
+            {
+                DN_CORE_WARN("SceneBuilder::DeserializeSceneBinary - Corrupt type table");
+                return false;
+            }
+            typeNames.push_back(String(types[t].name));
+        }
+
+        pscn.uuid = duin::UUID(header.sceneUUID);
+        pscn.name = String(header.name);
+        pscn.metadata.editorVersion = String(header.editorVersion);
+        pscn.metadata.engineVersion = String(header.engineVersion);
+        pscn.metadata.lastModified = String(header.lastModified);
+        pscn.metadata.author = String(header.author);
+
+        pscn.entities.reserve(header.rootCount);
+        uint32_t cursor = 0;
+        for (uint32_t r = 0; r < header.rootCount && ok; ++r)
+        {
+            pscn.entities.push_back(ReadEntity(cursor, 0));
+        }
+        if (ok && cursor != header.entityCount)
+        {
+            DN_CORE_WARN("SceneBuilder::DeserializeSceneBinary - Entity table size mismatch");
+            ok = false;
+        }
+        return ok;
+    }
+
+  private:
+    const uint8_t *data;
+    size_t size;
+    BinHeader header{};
+    std::vector<BinType> types;
+    std::vector<std::string> typeNames;
+    bool ok = true;
+
+    bool CheckRange(uint64_t offset, uint64_t length) const
     {
-        PrePassInstantiate(pEntity, world, Entity{});
+        return offset <= size && length <= size - offset;
     }
 
-    // Main pass: apply components and pairs using the populated map.
-    for (PackedEntity &pEntity : pscn.entities)
+    template <typename T>
+    bool ReadRecord(uint64_t base, uint32_t index, uint32_t count, T &out)
     {
-        auto it = packedEntityToInstanceMap.find(pEntity.uuid);
-        if (it != packedEntityToInstanceMap.end())
+        if (index >= count)
+        {
+            ok = false;
+            return false;
+        }
+        std::memcpy(&out, data + base + uint64_t(index) * sizeof(T), sizeof(T));
+        return true;
+    }
+
+    std::string String(const BinStringRef &ref)
+    {
+        if (ref.size == 0)
+            return {};
+        if (uint64_t(ref.offset) + ref.size > header.stringsSize)
+        {
+            ok = false;
+            return {};
+        }
+        return std::string(reinterpret_cast<const char *>(data + header.stringsOffset + ref.offset), ref.size);
+    }
+
+    bool ReadComponent(uint32_t refIndex, duin::PackedComponent &pc)
+    {
+        uint32_t componentIndex = 0;
+        BinComponent bc{};
+        if (!ReadRecord(header.componentRefsOffset, refIndex, header.componentRefCount, componentIndex) ||
+            !ReadRecord(header.componentsOffset, componentIndex, header.componentCount, bc) ||
+            bc.typeIndex >= types.size())
+        {
+            ok = false;
+            return false;
+        }
+
+        const BinType &bt = types[bc.typeIndex];
+        if (uint64_t(bc.dataOffset) + bc.dataSize > bt.blobSize)
         {
-            Entity e = world->MakeAlive(it->second);
-            InstantiateEntity(pEntity, e);
+            ok = false;
+            return false;
+        }
+        pc.componentTypeName = typeNames[bc.typeIndex];
+        pc.jsonData.assign(reinterpret_cast<const char *>(data + header.blobsOffset + bt.blobOffset + bc.dataOffset),
+                           bc.dataSize);
+        return true;
+    }
 
-            if (!rootEntity.IsValid())
+    duin::PackedEntity ReadEntity(uint32_t &cursor, uint32_t depth)
+    {
+        duin::PackedEntity pe;
+        BinEntity be{};
+        // Each level is a stack frame; a crafted chain of single children must not exhaust the stack.
+        if (depth >= duin::PackedScene::BINARY_MAX_DEPTH ||
+            !ReadRecord(header.entitiesOffset, cursor, header.entityCount, be))
+        {
+            if (depth >= duin::PackedScene::BINARY_MAX_DEPTH)
             {
-                rootEntity = e;
+                DN_CORE_WARN("SceneBuilder::DeserializeSceneBinary - Entities nested deeper than {}",
+                             duin::PackedScene::BINARY_MAX_DEPTH);
             }
+            ok = false;
+            return pe;
+        }
+        ++cursor;
+
+        if (uint64_t(be.firstPair) + be.pairCount > header.pairCount ||
+            uint64_t(be.firstComponentRef) + be.componentCount > header.componentRefCount ||
+            uint64_t(be.firstTagRef) + be.tagCount > header.componentRefCount ||
+            be.childCount > header.entityCount - cursor)
+        {
+            ok = false;
+            return pe;
+        }
+
+        pe.uuid = duin::UUID(be.uuid);
+        pe.name = String(be.name);
+        pe.enabled = be.enabled != 0;
+        if (be.hasInstanceOf)
+        {
+            auto result = rfl::json::read<duin::AssetRef>(String(be.instanceOf));
+            if (result)
+                pe.instanceOf = result.value();
+        }
+
+        pe.pairs.reserve(be.pairCount);
+        for (uint32_t i = 0; i < be.pairCount && ok; ++i)
+        {
+            BinPair bp{};
+            if (!ReadRecord(header.pairsOffset, be.firstPair + i, header.pairCount, bp))
+                break;
+            duin::PackedPair pp;
+            pp.relationshipName = String(bp.relationshipName);
+            pp.relationshipPath = String(bp.relationshipPath);
+            pp.targetName = String(bp.targetName);
+            pp.targetPath = String(bp.targetPath);
+            pp.jsonData = String(bp.data);
+            pp.relationshipUUID = duin::UUID(bp.relationshipUUID);
+            pp.targetUUID = duin::UUID(bp.targetUUID);
+            pp.relationshipIsComponent = bp.relationshipIsComponent != 0;
+            pp.targetIsComponent = bp.targetIsComponent != 0;
+            pe.pairs.push_back(std::move(pp));
+        }
+
+        pe.components.resize(be.componentCount);
+        for (uint32_t i = 0; i < be.componentCount && ok; ++i)
+        {
+            ReadComponent(be.firstComponentRef + i, pe.components[i]);
+        }
+
+        pe.tags.resize(be.tagCount);
+        for (uint32_t i = 0; i < be.tagCount && ok; ++i)
+        {
+            ReadComponent(be.firstTagRef + i, pe.tags[i]);
         }
+
+        pe.children.reserve(be.childCount);
+        for (uint32_t i = 0; i < be.childCount && ok; ++i)
+        {
+            pe.children.push_back(ReadEntity(cursor, depth + 1));
+        }
+        return pe;
     }
+};
+} // namespace
 
-    instanceToPackedEntityMap.clear();
-    packedEntityToInstanceMap.clear();
+bool duin::SceneBuilder::IsSceneBinary(const void *data, size_t size)
+{
+    return data && size >= sizeof(BinHeader) &&
+           std::memcmp(data, PackedScene::BINARY_MAGIC, sizeof(PackedScene::BINARY_MAGIC)) == 0;
+}
 
-    return rootEntity;
+std::vector<uint8_t> duin::SceneBuilder::SerializeSceneBinary(const PackedScene &pscn)
+{
+    SceneBinaryWriter writer(pscn);
+    return writer.Write();
 }
 
-duin::Entity duin::SceneBuilder::InstantiateSceneAsChildren(PackedScene &pscn, Entity parent)
+bool duin::SceneBuilder::SerializeSceneBinaryToFile(const PackedScene &pscn, const std::string &vpath)
+{
+    std::vector<uint8_t> bytes = SerializeSceneBinary(pscn);
+    std::string resolvedPath = fs::IsVirtualPath(vpath) ? fs::MapVirtualToSystemPath(vpath) : vpath;
+    if (!io::IOStream::SaveFile(resolvedPath, bytes.data(), bytes.size()))
+    {
+        DN_CORE_WARN("SceneBuilder::SerializeSceneBinaryToFile - Failed to write {}", resolvedPath);
+        return false;
+    }
+    return true;
+}
+
+duin::PackedScene duin::SceneBuilder::DeserializeSceneBinary(const void *data, size_t size)
+{
+    PackedScene ps;
+    SceneBinaryReader reader(static_cast<const uint8_t *>(data), size);
+    if (!reader.Read(ps))
+    {
+        return PackedScene();
+    }
+    return ps;
+}
+
+duin::PackedScene duin::SceneBuilder::DeserializeSceneBinaryFromFile(const std::string &vpath)
+{
+    std::string resolvedPath = fs::IsVirtualPath(vpath) ? fs::MapVirtualToSystemPath(vpath) : vpath;
+
+    io::FileMapping view = io::IOStream::MapFile(resolvedPath, io::MapAdvice::Sequential);
+    if (!view.IsValid())
+    {
+        DN_CORE_WARN("SceneBuilder::DeserializeSceneBinaryFromFile - Failed to read {}", resolvedPath);
+        return PackedScene();
+    }
+
+    return DeserializeSceneBinary(view.Data(), view.Size());
+}
+
+// ============================================================
+// Batched instantiation
+// ============================================================
+//
+// Instantiation runs in three steps:
+//   1. Flatten the packed trees and group entities by archetype: their tag and
+//      component set, their parent and their enabled state.
+//   2. Decode every component payload on the ThreadPool into per-group,
+//      per-type staging buffers.
+//   3. Create each group with one ecs_bulk_init inside a single deferred block,
+//      so each table is grown once and no entity moves between tables.
+// Components that cannot be staged (no default constructor), entities with an
+// instanceOf and pairs fall back to the per-entity path afterwards.
+
+namespace
+{
+
+using StagingType = duin::ComponentSerializer::StagingType;
+
+struct InstanceRecord
+{
+    const duin::PackedEntity *pe = nullptr;
+    int64_t parent = -1; // record index, -1 for scene roots
+    size_t group = 0;
+    size_t row = 0;
+    uint64_t entity = 0;
+    std::string cachedName;
+    // Staged payloads, sorted by id (the component is null for tags).
+    std::vector<std::pair<uint64_t, const duin::PackedComponent *>> staged;
+    // Payloads set through ComponentSerializer::Deserialize once the entity exists.
+    std::vector<const duin::PackedComponent *> perEntity;
+};
+
+struct InstanceGroup
+{
+    int64_t parent = -1;
+    bool disabled = false;
+    std::vector<uint64_t> ids;              // sorted tag and component ids
+    std::vector<const StagingType *> types; // parallel to ids
+    std::vector<std::byte *> columns;       // parallel to ids, null for tags
+    std::vector<size_t> records;
+};
+
+struct DecodeJob
+{
+    const StagingType *type = nullptr;
+    const duin::PackedComponent *component = nullptr;
+    void *dst = nullptr;
+
+    bool Construct() const
+    {
+        if (component->jsonNode.has_value())
+        {
+            return type->constructFromJSON(dst, component->jsonNode->GetRJSONValue());
+        }
+        return type->construct(dst, component->jsonData);
+    }
+};
+
+constexpr size_t DECODE_GRAIN_SIZE = 64;
+
+void FlattenPackedEntity(const duin::PackedEntity &pe, int64_t parent, std::vector<InstanceRecord> &records)
 {
-    Entity rootEntity;
+    InstanceRecord record;
+    record.pe = &pe;
+    record.parent = parent;
+    records.push_back(std::move(record));
+
+    int64_t self = static_cast<int64_t>(records.size() - 1);
+    for (const duin::PackedEntity &child : pe.children)
+    {
+        FlattenPackedEntity(child, self, records);
+    }
+}
+
+} // namespace
+
+duin::Entity duin::SceneBuilder::InstantiateBatched(PackedScene &pscn, World *world, Entity parent)
+{
+    DN_CORE_ASSERT(world != nullptr, "World is nullptr!");
+    ComponentSerializer &serializer = ComponentSerializer::Get();
+    flecs::world &flecsWorld = world->GetFlecsWorld();
 
     instanceToPackedEntityMap.clear();
     packedEntityToInstanceMap.clear();
 
-    World *w = parent.GetWorld();
-    if (!w)
+    std::vector<InstanceRecord> records;
+    for (const PackedEntity &pEntity : pscn.entities)
+    {
+        FlattenPackedEntity(pEntity, -1, records);
+    }
+    if (records.empty())
     {
         return Entity();
     }
 
-    // Pre-pass: create all entities as children of parent.
-    for (PackedEntity &pEntity : pscn.entities)
+    // 1. Group by archetype. Parents are always grouped (and created) before their children.
+    std::vector<InstanceGroup> groups;
+    std::map<std::tuple<int64_t, bool, std::vector<uint64_t>>, size_t> groupIndex;
+    for (InstanceRecord &record : records)
+    {
+        const PackedEntity &pe = *record.pe;
+        std::vector<const StagingType *> types;
+
+        // Instances are created bare; their external scene and own data are applied at the end.
+        if (!pe.instanceOf.has_value())
+        {
+            auto stage = [&](const PackedComponent &pc) {
+                const StagingType *type = serializer.GetStagingType(pc.componentTypeName);
+                if (type == nullptr)
+                {
+                    record.perEntity.push_back(&pc);
+                    return;
+                }
+                record.staged.emplace_back(type->id(flecsWorld), type->isTag ? nullptr : &pc);
+                types.push_back(type);
+            };
+            for (const PackedComponent &tag : pe.tags)
+                stage(tag);
+            for (const PackedComponent &cmp : pe.components)
+                stage(cmp);
+        }
+
+        // Sort by id; a type listed twice keeps its last payload.
+        std::vector<size_t> order(record.staged.size());
+        for (size_t i = 0; i < order.size(); ++i)
+            order[i] = i;
+        std::stable_sort(order.begin(), order.end(),
+                         [&](size_t a, size_t b) { return record.staged[a].first < record.staged[b].first; });
+        std::vector<std::pair<uint64_t, const PackedComponent *>> staged;
+        std::vector<const StagingType *> stagedTypes;
+        for (size_t i : order)
+        {
+            if (!staged.empty() && staged.back().first == record.staged[i].first)
+            {
+                staged.back() = record.staged[i];
+                stagedTypes.back() = types[i];
+                continue;
+            }
+            staged.push_back(record.staged[i]);
+            stagedTypes.push_back(types[i]);
+        }
+        record.staged = std::move(staged);
+
+        std::vector<uint64_t> ids;
+        ids.reserve(record.staged.size());
+        for (const auto &[id, component] : record.staged)
+            ids.push_back(id);
+
+        auto key = std::make_tuple(record.parent, !pe.enabled, ids);
+        auto [it, inserted] = groupIndex.try_emplace(std::move(key), groups.size());
+        if (inserted)
+        {
+            InstanceGroup group;
+            group.parent = record.parent;
+            group.disabled = !pe.enabled;
+            group.ids = std::move(ids);
+            group.types = std::move(stagedTypes);
+            groups.push_back(std::move(group));
+        }
+        record.group = it->second;
+        record.row = groups[it->second].records.size();
+        groups[it->second].records.push_back(static_cast<size_t>(&record - records.data()));
+    }
+
+    // 2. Allocate one contiguous buffer per group column and decode the payloads in parallel.
+    FrameArena staging;
+    std::vector<DecodeJob> jobs;
+    for (InstanceGroup &group : groups)
     {
-        PrePassInstantiate(pEntity, w, parent);
+        group.columns.assign(group.ids.size(), nullptr);
+        for (size_t c = 0; c < group.ids.size(); ++c)
+        {
+            const StagingType *type = group.types[c];
+            if (!type->isTag)
+            {
+                group.columns[c] =
+                    static_cast<std::byte *>(staging.Allocate(type->size * group.records.size(), type->alignment));
+            }
+        }
+        for (size_t row = 0; row < group.records.size(); ++row)
+        {
+            const InstanceRecord &record = records[group.records[row]];
+            for (size_t c = 0; c < group.ids.size(); ++c)
+            {
+                if (group.columns[c] != nullptr)
+                {
+                    jobs.push_back({group.types[c], record.staged[c].second, group.columns[c] + group.types[c]->size * row});
+                }
+            }
+        }
     }
 
-    // Main pass: apply components and pairs.
-    for (PackedEntity &pEntity : pscn.entities)
+    std::atomic<size_t> failed{0};
+    ThreadPool::Get().ParallelFor(jobs.size(), DECODE_GRAIN_SIZE, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            if (!jobs[i].Construct())
+            {
+                failed.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    });
+    if (failed.load() > 0)
     {
-        auto it = packedEntityToInstanceMap.find(pEntity.uuid);
-        if (it != packedEntityToInstanceMap.end())
+        DN_CORE_WARN("SceneBuilder::InstantiateScene - {} component payloads could not be read, defaults were used",
+                     failed.load());
+    }
+
+    // 3. Commit. Bulk creation writes the tables directly; everything else is queued until DeferEnd.
+    ecs_world_t *ecs = flecsWorld.c_ptr();
+    world->DeferBegin();
+    for (InstanceGroup &group : groups)
+    {
+        std::vector<ecs_id_t> ids(group.ids.begin(), group.ids.end());
+        std::vector<void *> data(group.columns.begin(), group.columns.end());
+        uint64_t parentId = group.parent >= 0 ? records[group.parent].entity : (parent.IsValid() ? parent.GetID() : 0);
+        if (parentId != 0)
+        {
+            ids.push_back(ecs_pair(EcsChildOf, parentId));
+            data.push_back(nullptr);
+        }
+        if (group.disabled)
+        {
+            ids.push_back(EcsDisabled);
+            data.push_back(nullptr);
+        }
+
+        // ids is zero terminated inside the descriptor; oversized archetypes set their components afterwards.
+        size_t inlineCount = ids.size() < FLECS_ID_DESC_MAX ? ids.size() : 0;
+        ecs_bulk_desc_t desc = {};
+        desc.count = static_cast<int32_t>(group.records.size());
+        if (inlineCount > 0)
+        {
+            std::copy(ids.begin(), ids.end(), desc.ids);
+            desc.data = data.data();
+        }
+        else
+        {
+            size_t n = 0;
+            if (parentId != 0)
+                desc.ids[n++] = ecs_pair(EcsChildOf, parentId);
+            if (group.disabled)
+                desc.ids[n++] = EcsDisabled;
+        }
+
+        const ecs_entity_t *created = ecs_bulk_init(ecs, &desc);
+        for (size_t row = 0; row < group.records.size(); ++row)
+        {
+            InstanceRecord &record = records[group.records[row]];
+            record.entity = created[row];
+            packedEntityToInstanceMap[record.pe->uuid] = record.entity;
+        }
+
+        if (inlineCount == 0)
         {
-            Entity e = w->MakeAlive(it->second);
-            InstantiateEntity(pEntity, e);
+            for (size_t row = 0; row < group.records.size(); ++row)
+            {
+                for (size_t c = 0; c < group.ids.size(); ++c)
+                {
+                    const StagingType *type = group.types[c];
+                    if (type->isTag)
+                        ecs_add_id(ecs, records[group.records[row]].entity, group.ids[c]);
+                    else
+                        ecs_set_id(ecs, records[group.records[row]].entity, group.ids[c], type->size,
+                                   group.columns[c] + type->size * row);
+                }
+            }
+        }
+    }
 
-            if (!rootEntity.IsValid())
+    // flecs copied the staged values, release them.
+    for (InstanceGroup &group : groups)
+    {
+        for (size_t c = 0; c < group.ids.size(); ++c)
+        {
+            if (group.columns[c] == nullptr)
+                continue;
+            for (size_t row = 0; row < group.records.size(); ++row)
             {
-                rootEntity = e;
+                group.types[c]->destroy(group.columns[c] + group.types[c]->size * row);
             }
         }
     }
 
+    // Names are queued as well, so duplicates within this batch are tracked here.
+    std::set<std::pair<uint64_t, std::string>> assignedNames;
+    for (InstanceRecord &record : records)
+    {
+        Entity e(record.entity, world);
+        const PackedEntity &pe = *record.pe;
+        if (!pe.name.empty())
+        {
+            uint64_t scope = record.parent >= 0 ? records[record.parent].entity : (parent.IsValid() ? parent.GetID() : 0);
+            std::string name = pe.name;
+            Entity existing = world->Lookup(pe.name);
+            if ((existing.IsValid() && existing.GetID() != e.GetID()) || assignedNames.count({scope, name}))
+            {
+                name = name + Entity::ID_DELIM + static_cast<std::string>(UUID::ToStringHex(e.GetID()));
+            }
+            assignedNames.insert({scope, name});
+            e.SetName(name);
+            record.cachedName = name;
+        }
+
+        for (const PackedComponent *pc : record.perEntity)
+        {
+            InstantiateComponent(*pc, e);
+        }
+    }
+    world->DeferEnd();
+
+    // Pairs resolve targets by UUID or by name, so they are added once the names above are applied.
+    // Instances get theirs below, after their external scene.
+    world->DeferBegin();
+    for (const InstanceRecord &record : records)
+    {
+        if (record.pe->instanceOf.has_value())
+            continue;
+        Entity e(record.entity, world);
+        for (const PackedPair &pair : record.pe->pairs)
+        {
+            InstantiatePair(pair, e);
+        }
+    }
+    world->DeferEnd();
+
+    // Same order as InstantiateEntity: external scene, then tags, pairs and components on top.
+    for (const InstanceRecord &record : records)
+    {
+        const PackedEntity &pe = *record.pe;
+        if (!pe.instanceOf.has_value())
+            continue;
+        Entity e(record.entity, world);
+        InstantiateExternalScene(*pe.instanceOf, e, world, record.cachedName);
+        for (const PackedComponent &tag : pe.tags)
+        {
+            InstantiateComponent(tag, e);
+        }
+        for (const PackedPair &pair : pe.pairs)
+        {
+            InstantiatePair(pair, e);
+        }
+        for (const PackedComponent &cmp : pe.components)
+        {
+            InstantiateComponent(cmp, e);
+        }
+    }
+
+    Entity rootEntity(records.front().entity, world);
+
     instanceToPackedEntityMap.clear();
     packedEntityToInstanceMap.clear();
 
     return rootEntity;
 }
 
+// Pre-pass helpers
+
+void duin::SceneBuilder::PrePassEntity(Entity e)
+{
+    UUID uuid; // fresh random UUID
+    instanceToPackedEntityMap[e.GetID()] = uuid;
+    for (Entity child : e.GetChildren())
+    {
+        PrePassEntity(child);
+    }
+}
+
+void duin::SceneBuilder::PrePassInstantiate(const PackedEntity &pe, World *world, Entity parent)
+{
+    Entity e = world->Entity();
+    if (parent.IsValid())
+    {
+        e.ChildOf(parent);
+    }
+    //if (!pe.name.empty())
+    //{
+    //    e.SetName(pe.name);
+    //}
+    packedEntityToInstanceMap[pe.uuid] = e.GetID();
+    for (const PackedEntity &child : pe.children)
+    {
+        PrePassInstantiate(child, world, e);
+    }
+}
+
+duin::Entity duin::SceneBuilder::InstantiateScene(PackedScene &pscn, World *world)
+{
+    return InstantiateBatched(pscn, world, Entity{});
+}
+
+duin::Entity duin::SceneBuilder::InstantiateSceneAsChildren(PackedScene &pscn, Entity parent)
+{
+    World *w = parent.GetWorld();
+    if (!w)
+    {
+        return Entity();
+    }
+
+    return InstantiateBatched(pscn, w, parent);
+}
+
 duin::PackedScene duin::SceneBuilder::PackScene(World *world)
 {
     std::vector<Entity> children;
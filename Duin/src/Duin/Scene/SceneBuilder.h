@@ -18,6 +18,7 @@
 #include <rfl.hpp>
 
 #include <flecs.h>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -32,6 +33,10 @@ namespace duin
  * @struct PackedComponent
  * @brief Serialized component data. {"type":"TestStructX","x":"3"}
  * @ingroup ECS_Scene
+ *
+ * Components packed from a world hold their JSON as text (jsonData). Components read
+ * from a JSON scene keep the parsed node instead (jsonNode), so loading and saving a
+ * scene never writes a node out to text only to parse it again.
  */
 struct PackedComponent
 {
@@ -40,6 +45,10 @@ struct PackedComponent
 
     std::string componentTypeName;
     std::string jsonData;
+    std::optional<JSONValue> jsonNode; ///< View into the scene document; takes precedence over jsonData.
+
+    /** @brief The component JSON as text, whichever form it is held in. */
+    std::string ToJSON() const;
 };
 
 /**
@@ -143,6 +152,12 @@ struct PackedScene
     static const std::string TAG_METADATA;
     static const std::string TAG_ENTITIES;
 
+    /// Binary scene files start with this magic, followed by BINARY_VERSION.
+    static constexpr char BINARY_MAGIC[4] = {'D', 'N', 'S', 'B'};
+    static constexpr uint32_t BINARY_VERSION = 1;
+    /// Deepest entity nesting the binary loader accepts; deeper files are rejected as corrupt.
+    static constexpr uint32_t BINARY_MAX_DEPTH = 256;
+
     UUID uuid;                          ///< Scene identifier.
     std::string name;                   ///< Scene name.
     PackedSceneMetadata metadata;       ///< Version/author info.
@@ -158,6 +173,10 @@ class SceneBuilder
     PackedScene PackScene(const std::vector<Entity> &vecEntities);
     PackedScene PackScene(std::shared_ptr<World> world);
     PackedScene PackScene(World *world);
+    /**
+     * Instantiation decodes component payloads in parallel into staging buffers,
+     * then creates entities in bulk per archetype inside one deferred block.
+     */
     Entity InstantiateScene(PackedScene &pscn, World *world);
     Entity InstantiateSceneAsChildren(PackedScene &pscn, Entity parent);
     JSONValue SerializeScene(const PackedScene &pscn);
@@ -165,6 +184,19 @@ class SceneBuilder
     PackedScene DeserializeScene(const JSONValue &scene);
     PackedScene DeserializeSceneFromFile(const std::string &vpath);
 
+    /**
+     * Binary scene format: a header, a flat pre-order entity table, a component
+     * type table, per-type contiguous payload blobs, a pair table (with entity
+     * UUIDs) and a shared string table. All references are offsets, so the
+     * loader reads straight from a file mapped or loaded into memory.
+     * The JSON format stays the source format for diffs and tooling.
+     */
+    std::vector<uint8_t> SerializeSceneBinary(const PackedScene &pscn);
+    bool SerializeSceneBinaryToFile(const PackedScene &pscn, const std::string &vpath);
+    PackedScene DeserializeSceneBinary(const void *data, size_t size);
+    PackedScene DeserializeSceneBinaryFromFile(const std::string &vpath);
+    static bool IsSceneBinary(const void *data, size_t size);
+
     JSONValue SerializeMetadata(const PackedSceneMetadata &metadata);
     PackedSceneMetadata DeserializeMetadata(const JSONValue &metadata);
 
@@ -196,8 +228,11 @@ class SceneBuilder
     std::unordered_map<uint64_t, UUID> instanceToPackedEntityMap;
     std::unordered_map<UUID, uint64_t> packedEntityToInstanceMap;
 
+    void WriteEntity(const PackedEntity &pe, JSONValue &json);
+    void WritePair(const PackedPair &pp, JSONValue &json);
     void PrePassEntity(Entity e);
     void PrePassInstantiate(const PackedEntity &pe, World *world, Entity parent);
+    Entity InstantiateBatched(PackedScene &pscn, World *world, Entity parent);
     void InstantiateExternalScene(const PackedExternalDependency &exdep, Entity e, World *world, const std::string &cachedName);
 };
 
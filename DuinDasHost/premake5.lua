@@ -75,6 +75,7 @@ postbuildcommands
     '{COPYDIR} "' .. path.getabsolute("scripts") .. '" "%{cfg.targetdir}/scripts"',
     '{COPYFILE} "' .. daslang_dll_src .. '" "%{cfg.targetdir}/libDaScriptDyn.dll"',
     '{COPYFILE} "' .. daslang_runtime_dll_src .. '" "%{cfg.targetdir}/libDaScriptDyn_runtime.dll"',
+    '{COPYDIR} "' .. duin_shaders_src .. '" "%{cfg.targetdir}/shaders"',
     '{COPYFILE} "' .. path.getabsolute(hvRoot .. "/bin/hv.dll") .. '" "%{cfg.targetdir}/hv.dll"',
 }
 
@@ -67,6 +67,7 @@ project "DuinEditor"
     {
         '{COPYFILE} "' .. daslang_dll_src .. '" "%{cfg.targetdir}/libDaScriptDyn.dll"',
         '{COPYFILE} "' .. daslang_runtime_dll_src .. '" "%{cfg.targetdir}/libDaScriptDyn_runtime.dll"',
+        '{COPYDIR} "' .. duin_shaders_src .. '" "%{cfg.targetdir}/shaders"',
     }
 
     filter { "files:**/external/**" }
@@ -0,0 +1,278 @@
+#include "TestConfig.h"
+#include "Defines.h"
+#include <doctest.h>
+#include <Duin/Assets/Mesh.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace TestMesh
+{
+
+static const char *CUBE_OBJ = "# unit cube, quads, no normals\n"
+                              "v -1 -1 -1\n"
+                              "v  1 -1 -1\n"
+                              "v  1  1 -1\n"
+                              "v -1  1 -1\n"
+                              "v -1 -1  1\n"
+                              "v  1 -1  1\n"
+                              "v  1  1  1\n"
+                              "v -1  1  1\n"
+                              "vt 0 0\n"
+                              "vt 1 0\n"
+                              "vt 1 1\n"
+                              "vt 0 1\n"
+                              "f 1/1 4/4 3/3 2/2\n"
+                              "f 5/1 6/2 7/3 8/4\n"
+                              "f 1/1 2/2 6/3 5/4\n"
+                              "f 4/1 8/2 7/3 3/4\n"
+                              "f 1/1 5/2 8/3 4/4\n"
+                              "f 2/1 3/2 7/3 6/4\n";
+
+// Regular grid of (n + 1)^2 vertices, two triangles per cell, emitted column-major so the
+// input order is unfriendly to the vertex cache.
+static duin::MeshData MakeGrid(uint32_t n)
+{
+    duin::MeshData mesh;
+    for (uint32_t y = 0; y <= n; ++y)
+    {
+        for (uint32_t x = 0; x <= n; ++x)
+        {
+            duin::MeshVertex vertex;
+            vertex.position = duin::Vector3(float(x), std::sin(float(x + y) * 0.1f), float(y));
+            vertex.normal = duin::Vector3(0.0f, 1.0f, 0.0f);
+            vertex.uv = duin::Vector2(float(x) / float(n), float(y) / float(n));
+            mesh.vertices.push_back(vertex);
+        }
+    }
+    for (uint32_t x = 0; x < n; ++x)
+    {
+        for (uint32_t y = 0; y < n; ++y)
+        {
+            uint32_t i = y * (n + 1) + x;
+            mesh.indices.insert(mesh.indices.end(), {i, i + n + 1, i + 1, i + 1, i + n + 1, i + n + 2});
+        }
+    }
+    return mesh;
+}
+
+static float Distance(duin::Vector3 a, duin::Vector3 b)
+{
+    return std::sqrt((a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y) + (a.z - b.z) * (a.z - b.z));
+}
+
+TEST_SUITE("Assets - Mesh")
+{
+    TEST_CASE("OBJ import triangulates faces and generates normals")
+    {
+        duin::MeshData mesh;
+        REQUIRE(duin::ImportOBJ(CUBE_OBJ, std::strlen(CUBE_OBJ), mesh));
+
+        CHECK(mesh.indices.size() == 6 * 2 * 3);
+        CHECK(mesh.vertices.size() == 18); // a corner is split once per distinct UV
+        for (const duin::MeshVertex &vertex : mesh.vertices)
+        {
+            // Smooth normals of a cube corner point along the diagonal.
+            float dot = (vertex.position.x * vertex.normal.x + vertex.position.y * vertex.normal.y +
+                         vertex.position.z * vertex.normal.z) /
+                        std::sqrt(3.0f);
+            CHECK(dot > 0.99f);
+        }
+    }
+
+    TEST_CASE("OBJ import resolves negative indices and skips bad faces")
+    {
+        const char *obj = "v 0 0 0\nv 1 0 0\nv 0 1 0\nvn 0 0 1\nf -3//1 -2//1 -1//1\nf 1 2 9\n";
+        duin::MeshData mesh;
+        REQUIRE(duin::ImportOBJ(obj, std::strlen(obj), mesh));
+        CHECK(mesh.indices.size() == 3);
+        CHECK(mesh.vertices[mesh.indices[2]].position.y == 1.0f);
+        CHECK(mesh.vertices[0].normal.z == 1.0f);
+
+        duin::MeshData empty;
+        CHECK_FALSE(duin::ImportOBJ("# nothing\n", 10, empty));
+    }
+
+    TEST_CASE("Octahedral normals round trip")
+    {
+        for (int i = 0; i < 200; ++i)
+        {
+            float theta = float(i) * 0.61803f * 6.2831853f;
+            float z = 1.0f - 2.0f * (float(i) + 0.5f) / 200.0f;
+            float r = std::sqrt(1.0f - z * z);
+            duin::Vector3 normal(r * std::cos(theta), r * std::sin(theta), z);
+
+            int16_t encoded[2];
+            duin::EncodeOctahedral(normal, encoded);
+            CHECK(Distance(duin::DecodeOctahedral(encoded), normal) < 1e-3f);
+        }
+    }
+
+    TEST_CASE("Half floats round trip")
+    {
+        CHECK(duin::HalfToFloat(duin::FloatToHalf(0.0f)) == 0.0f);
+        CHECK(duin::HalfToFloat(duin::FloatToHalf(1.0f)) == 1.0f);
+        CHECK(duin::HalfToFloat(duin::FloatToHalf(-2.5f)) == -2.5f);
+        CHECK(duin::HalfToFloat(duin::FloatToHalf(65504.0f)) == 65504.0f);
+        CHECK(std::isinf(duin::HalfToFloat(duin::FloatToHalf(1e6f))));
+        for (float value = -4.0f; value <= 4.0f; value += 0.013f)
+        {
+            CHECK(std::fabs(duin::HalfToFloat(duin::FloatToHalf(value)) - value) <= std::fabs(value) / 1024.0f);
+        }
+    }
+
+    TEST_CASE("Vertex cache optimization lowers ACMR")
+    {
+        duin::MeshData mesh = MakeGrid(64);
+        float before = duin::ComputeACMR(mesh.indices.data(), mesh.indices.size(), mesh.vertices.size());
+
+        std::vector<uint32_t> sortedBefore = mesh.indices;
+        duin::OptimizeVertexCache(mesh.indices.data(), mesh.indices.size(), mesh.vertices.size());
+        float after = duin::ComputeACMR(mesh.indices.data(), mesh.indices.size(), mesh.vertices.size());
+
+        CHECK(after < before);
+        CHECK(after < 0.9f);
+
+        // Same triangles, reordered.
+        auto canonical = [](const std::vector<uint32_t> &indices) {
+            std::vector<std::vector<uint32_t>> triangles;
+            for (size_t i = 0; i < indices.size(); i += 3)
+            {
+                std::vector<uint32_t> tri(indices.begin() + i, indices.begin() + i + 3);
+                std::rotate(tri.begin(), std::min_element(tri.begin(), tri.end()), tri.end());
+                triangles.push_back(tri);
+            }
+            std::sort(triangles.begin(), triangles.end());
+            return triangles;
+        };
+        CHECK(canonical(mesh.indices) == canonical(sortedBefore));
+    }
+
+    TEST_CASE("Vertex fetch optimization orders by first use and drops unused vertices")
+    {
+        duin::MeshData mesh;
+        mesh.vertices.resize(5);
+        for (size_t i = 0; i < mesh.vertices.size(); ++i)
+        {
+            mesh.vertices[i].position = duin::Vector3(float(i), 0.0f, 0.0f);
+        }
+        mesh.indices = {4, 2, 3, 3, 2, 0};
+
+        CHECK(duin::OptimizeVertexFetch(mesh) == 4);
+        CHECK(mesh.indices == std::vector<uint32_t>{0, 1, 2, 2, 1, 3});
+        CHECK(mesh.vertices[0].position.x == 4.0f);
+        CHECK(mesh.vertices[3].position.x == 0.0f);
+    }
+
+    TEST_CASE("Cook and decode stay within quantization error")
+    {
+        duin::MeshData source = MakeGrid(16);
+        duin::CookedMesh cooked = duin::CookedMesh::Cook(source, duin::UUID(42));
+        REQUIRE(cooked.IsValid());
+        CHECK(static_cast<uint64_t>(cooked.GetUUID()) == 42);
+        CHECK_FALSE(cooked.HasIndex32());
+        CHECK(cooked.GetVertexCount() == source.vertices.size());
+        CHECK(cooked.GetIndexCount() == source.indices.size());
+
+        duin::Vector3 extent = cooked.GetBoundsExtent();
+        float tolerance = std::max(extent.x, std::max(extent.y, extent.z)) / 32767.0f * 1.01f;
+
+        // Cooking reorders everything, so compare triangle by triangle through positions.
+        duin::MeshData decoded = cooked.Decode();
+        std::vector<duin::Vector3> sourceCorners;
+        for (uint32_t index : source.indices)
+        {
+            sourceCorners.push_back(source.vertices[index].position);
+        }
+        size_t matched = 0;
+        for (size_t t = 0; t < decoded.indices.size(); t += 3)
+        {
+            duin::Vector3 a = decoded.vertices[decoded.indices[t]].position;
+            for (size_t s = 0; s < sourceCorners.size(); s += 3)
+            {
+                if (Distance(a, sourceCorners[s]) <= tolerance &&
+                    Distance(decoded.vertices[decoded.indices[t + 1]].position, sourceCorners[s + 1]) <= tolerance &&
+                    Distance(decoded.vertices[decoded.indices[t + 2]].position, sourceCorners[s + 2]) <= tolerance)
+                {
+                    ++matched;
+                    break;
+                }
+            }
+        }
+        CHECK(matched == decoded.indices.size() / 3);
+
+        for (const duin::MeshVertex &vertex : decoded.vertices)
+        {
+            CHECK(Distance(vertex.normal, duin::Vector3(0.0f, 1.0f, 0.0f)) < 1e-3f);
+            CHECK(vertex.uv.x >= 0.0f);
+            CHECK(vertex.uv.x <= 1.0f);
+        }
+    }
+
+    TEST_CASE("Large meshes switch to 32-bit indices")
+    {
+        duin::MeshData mesh = MakeGrid(300); // 90601 vertices
+        duin::CookedMesh cooked = duin::CookedMesh::Cook(mesh, duin::UUID(7));
+        REQUIRE(cooked.IsValid());
+        CHECK(cooked.HasIndex32());
+        CHECK(cooked.GetIndex(cooked.GetIndexCount() - 1) < cooked.GetVertexCount());
+    }
+
+    TEST_CASE("Cooked bytes round trip and corrupt data is rejected")
+    {
+        duin::CookedMesh cooked = duin::CookedMesh::Cook(MakeGrid(8), duin::UUID(99));
+        REQUIRE(cooked.IsValid());
+
+        duin::CookedMesh copy = duin::CookedMesh::FromBytes(cooked.GetBytes(), cooked.GetSize());
+        REQUIRE(copy.IsValid());
+        CHECK(copy.GetUUID() == cooked.GetUUID());
+        CHECK(copy.GetSize() == cooked.GetSize());
+        CHECK(std::memcmp(copy.GetBytes(), cooked.GetBytes(), cooked.GetSize()) == 0);
+
+        const std::string path = ARTIFACT_PATH + "/mesh_test.dnmesh";
+        REQUIRE(cooked.SaveToFile(path));
+        duin::CookedMesh loaded = duin::CookedMesh::LoadFromFile(path);
+        REQUIRE(loaded.IsValid());
+        CHECK(std::memcmp(loaded.GetVertices(), cooked.GetVertices(),
+                          cooked.GetVertexCount() * sizeof(duin::PackedMeshVertex)) == 0);
+
+        CHECK_FALSE(duin::CookedMesh::FromBytes(cooked.GetBytes(), cooked.GetSize() - 1).IsValid());
+
+        std::vector<uint8_t> corrupt(cooked.GetBytes(), cooked.GetBytes() + cooked.GetSize());
+        corrupt[0] = 'X';
+        CHECK_FALSE(duin::CookedMesh::FromBytes(corrupt.data(), corrupt.size()).IsValid());
+
+        // An index past the vertex block must never reach the GPU.
+        corrupt[0] = 'D';
+        std::memset(corrupt.data() + corrupt.size() - 2, 0xFF, 2);
+        CHECK_FALSE(duin::CookedMesh::FromBytes(corrupt.data(), corrupt.size()).IsValid());
+    }
+
+    TEST_CASE("Cooked offsets that wrap around are rejected")
+    {
+        duin::CookedMesh cooked = duin::CookedMesh::Cook(MakeGrid(8), duin::UUID(99));
+        REQUIRE(cooked.IsValid());
+        REQUIRE_FALSE(cooked.HasIndex32());
+
+        // indicesOffset (header byte 64) chosen so that offset + size wraps to a small, in-range end.
+        std::vector<uint8_t> corrupt(cooked.GetBytes(), cooked.GetBytes() + cooked.GetSize());
+        uint64_t indicesSize = uint64_t(cooked.GetIndexCount()) * sizeof(uint16_t);
+        uint64_t wrappingOffset = uint64_t(0) - indicesSize + 128;
+        std::memcpy(corrupt.data() + 64, &wrappingOffset, sizeof(wrappingOffset));
+        CHECK_FALSE(duin::CookedMesh::FromBytes(corrupt.data(), corrupt.size()).IsValid());
+    }
+
+    TEST_CASE("Cooking rejects malformed input")
+    {
+        duin::MeshData mesh;
+        CHECK_FALSE(duin::CookedMesh::Cook(mesh, duin::UUID(1)).IsValid());
+
+        mesh.vertices.resize(3);
+        mesh.indices = {0, 1, 5};
+        CHECK_FALSE(duin::CookedMesh::Cook(mesh, duin::UUID(1)).IsValid());
+    }
+}
+
+} // namespace TestMesh
@@ -0,0 +1,116 @@
+#include "TestConfig.h"
+#include "Defines.h"
+#include <doctest.h>
+#include <Duin/Core/Maths/MathsBatch.h>
+#include <cmath>
+#include <vector>
+
+namespace TestMathsBatch
+{
+
+static bool MatrixNear(const duin::Matrix &a, const duin::Matrix &b, float eps = 1e-4f)
+{
+    const float *fa = reinterpret_cast<const float *>(&a);
+    const float *fb = reinterpret_cast<const float *>(&b);
+    for (int i = 0; i < 16; ++i)
+    {
+        if (std::fabs(fa[i] - fb[i]) > eps)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Scalar T * R * S built from the regular DuinMaths helpers.
+static duin::Matrix ReferenceTRS(duin::Vector3 t, duin::Quaternion r, duin::Vector3 s)
+{
+    duin::Matrix m = duin::MatrixMultiply(duin::MatrixScale(s.x, s.y, s.z), duin::QuaternionToMatrix(r));
+    return duin::MatrixMultiply(m, duin::MatrixTranslate(t.x, t.y, t.z));
+}
+
+struct BatchInput
+{
+    std::vector<duin::Vector3> positions;
+    std::vector<duin::Quaternion> rotations;
+    std::vector<duin::Vector3> scales;
+};
+
+static BatchInput MakeInput(size_t count)
+{
+    BatchInput in;
+    for (size_t i = 0; i < count; ++i)
+    {
+        float f = static_cast<float>(i);
+        in.positions.push_back({1.0f + f, -2.0f * f, 0.5f});
+        in.rotations.push_back(
+            duin::QuaternionFromAxisAngle(duin::Vector3Normalize({1.0f, f, 0.25f}), 0.3f * f + 0.1f));
+        in.scales.push_back({1.0f + 0.1f * f, 2.0f, 0.5f});
+    }
+    return in;
+}
+
+TEST_SUITE("MathsBatch")
+{
+    TEST_CASE("MatrixComposeTRSBatch - matches scalar composition, including the tail")
+    {
+        for (size_t count : {1u, 3u, 4u, 7u, 9u, 16u})
+        {
+            CAPTURE(count);
+            BatchInput in = MakeInput(count);
+            std::vector<duin::Matrix> out(count);
+
+            duin::MatrixComposeTRSBatch(in.positions.data(), in.rotations.data(), in.scales.data(), out.data(),
+                                        count);
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                CAPTURE(i);
+                CHECK(MatrixNear(out[i], ReferenceTRS(in.positions[i], in.rotations[i], in.scales[i])));
+            }
+        }
+    }
+
+    TEST_CASE("MatrixMultiplyBatch - matches MatrixMultiply(local, parent)")
+    {
+        duin::Matrix parent =
+            ReferenceTRS({5.0f, 6.0f, 7.0f}, duin::QuaternionFromAxisAngle({0.0f, 1.0f, 0.0f}, 0.7f), {2.0f, 1.0f, 1.0f});
+
+        for (size_t count : {1u, 4u, 5u, 8u, 11u})
+        {
+            CAPTURE(count);
+            BatchInput in = MakeInput(count);
+            std::vector<duin::Matrix> local(count);
+            std::vector<duin::Matrix> out(count);
+            duin::MatrixComposeTRSBatch(in.positions.data(), in.rotations.data(), in.scales.data(), local.data(),
+                                        count);
+
+            duin::MatrixMultiplyBatch(parent, local.data(), out.data(), count);
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                CAPTURE(i);
+                CHECK(MatrixNear(out[i], duin::MatrixMultiply(local[i], parent), 1e-3f));
+            }
+        }
+    }
+
+    TEST_CASE("MatrixMultiplyBatch - output may alias input")
+    {
+        duin::Matrix parent = duin::MatrixTranslate(1.0f, 2.0f, 3.0f);
+        BatchInput in = MakeInput(6);
+        std::vector<duin::Matrix> local(6);
+        duin::MatrixComposeTRSBatch(in.positions.data(), in.rotations.data(), in.scales.data(), local.data(), 6);
+        std::vector<duin::Matrix> expected(6);
+        duin::MatrixMultiplyBatch(parent, local.data(), expected.data(), 6);
+
+        duin::MatrixMultiplyBatch(parent, local.data(), local.data(), 6);
+
+        for (size_t i = 0; i < 6; ++i)
+        {
+            CHECK(MatrixNear(local[i], expected[i], 0.0f));
+        }
+    }
+}
+
+} // namespace TestMathsBatch
@@ -78,6 +78,21 @@ struct FlakyCallback
 
 namespace TestSignal
 {
+static int gFreeListenerSum = 0;
+static void FreeListener(int v)
+{
+    gFreeListenerSum += v;
+}
+
+struct MemberListener
+{
+    int sum = 0;
+    void OnValue(int v)
+    {
+        sum += v;
+    }
+};
+
 TEST_SUITE("Signal - Core")
 {
     // -----------------------------------------------------------------------
@@ -1524,6 +1539,125 @@ TEST_SUITE("Signal - Core")
         CHECK(aHitLimit == true); // A's depth guard was triggered from inside C
     }
 
+    // -----------------------------------------------------------------------
+    // --- Slot map & function-pointer listeners ---
+    // -----------------------------------------------------------------------
+
+    TEST_CASE("Connect<&Fn> calls a free function")
+    {
+        gFreeListenerSum = 0;
+        duin::Signal<int> sig;
+        duin::UUID id = sig.Connect<&FreeListener>();
+        CHECK(id != duin::UUID::INVALID);
+        sig.Emit(4);
+        sig.Emit(5);
+        CHECK(gFreeListenerSum == 9);
+
+        sig.Disconnect(id);
+        sig.Emit(100);
+        CHECK(gFreeListenerSum == 9);
+        CHECK(sig.GetListenerCount() == 0);
+    }
+
+    TEST_CASE("Connect<&Method> calls a member function on the instance")
+    {
+        duin::Signal<int> sig;
+        MemberListener a, b;
+        sig.Connect<&MemberListener::OnValue>(&a);
+        duin::UUID idB = sig.Connect<&MemberListener::OnValue>(&b);
+        sig.Emit(3);
+        sig.Disconnect(idB);
+        sig.Emit(2);
+        CHECK(a.sum == 5);
+        CHECK(b.sum == 3);
+    }
+
+    TEST_CASE("ConnectScoped<&Method> disconnects on reset")
+    {
+        duin::Signal<int> sig;
+        MemberListener listener;
+        auto conn = sig.ConnectScoped<&MemberListener::OnValue>(&listener);
+        sig.Emit(1);
+        conn.reset();
+        sig.Emit(1);
+        CHECK(listener.sum == 1);
+        CHECK(sig.GetListenerCount() == 0);
+    }
+
+    TEST_CASE("Stale UUID does not disconnect the listener reusing its slot")
+    {
+        duin::Signal<int> sig;
+        duin::UUID stale = sig.Connect([](int) {});
+        sig.Disconnect(stale);
+
+        int fired = 0;
+        duin::UUID fresh = sig.Connect([&](int) { ++fired; });
+        CHECK(fresh != stale);
+
+        sig.Disconnect(stale);
+        sig.Emit(0);
+        CHECK(fired == 1);
+        CHECK(sig.GetListenerCount() == 1);
+    }
+
+    TEST_CASE("UUID from another signal is ignored")
+    {
+        duin::Signal<int> sigA, sigB;
+        duin::UUID idA = sigA.Connect([](int) {});
+        int fired = 0;
+        sigB.Connect([&](int) { ++fired; });
+
+        sigB.Disconnect(idA);
+        sigB.Emit(0);
+        CHECK(fired == 1);
+        CHECK(sigA.GetListenerCount() == 1);
+    }
+
+    TEST_CASE("Connecting many listeners during Emit keeps the running listener valid")
+    {
+        // Growing the slot storage must not move the listener that is executing.
+        duin::Signal<int> sig;
+        int outer = 0;
+        std::vector<int> captured(8, 7);
+        sig.Connect([&, captured](int) {
+            for (int i = 0; i < 500; ++i)
+            {
+                sig.Connect([](int) {});
+            }
+            outer += captured[7];
+        });
+        sig.Emit(0);
+        CHECK(outer == 7);
+        CHECK(sig.GetListenerCount() == 501);
+    }
+
+    TEST_CASE("Listener that disconnects itself keeps its captures alive until it returns")
+    {
+        duin::Signal<int> sig;
+        auto payload = std::make_shared<int>(11);
+        int seen = 0;
+        duin::UUID id;
+        id = sig.Connect([&, payload](int) {
+            sig.Disconnect(id);
+            seen = *payload;
+        });
+        sig.Emit(0);
+        CHECK(seen == 11);
+        CHECK(payload.use_count() == 1);
+    }
+
+    TEST_CASE("Emission order follows connection order across slot reuse")
+    {
+        duin::Signal<> sig;
+        std::vector<int> order;
+        duin::UUID first = sig.Connect([&]() { order.push_back(1); });
+        sig.Connect([&]() { order.push_back(2); });
+        sig.Disconnect(first);
+        sig.Connect([&]() { order.push_back(3); }); // reuses the first slot
+        sig.Emit();
+        CHECK((order == std::vector<int>{2, 3}));
+    }
+
 } // TEST_SUITE("Signal - Core")
 
 } // namespace TestSignal
@@ -385,6 +385,30 @@ TEST_SUITE("Application Global Functions")
         CHECK(true);
     }
 
+    TEST_CASE("SetPhysicsFramerate - Ignores Non-Positive Rates")
+    {
+        duin::SetPhysicsFramerate(30);
+        CHECK(duin::GetPhysicsFramerate() == 30);
+
+        duin::SetPhysicsFramerate(0);
+        CHECK(duin::GetPhysicsFramerate() == 30);
+        duin::SetPhysicsFramerate(-60);
+        CHECK(duin::GetPhysicsFramerate() == 30);
+
+        duin::SetPhysicsFramerate(60);
+        CHECK(duin::GetPhysicsFramerate() == 60);
+    }
+
+    TEST_CASE("QueuePreDrawCallback - Runs From EngineDraw")
+    {
+        TestApp app;
+        int called = 0;
+        auto conn = duin::QueuePreDrawCallback([&called]() { ++called; });
+        CHECK(called == 0);
+        app.EngineDraw();
+        CHECK(called == 1);
+    }
+
     TEST_CASE("QueuePostReadyCallback - Callback is Queued")
     {
         int called = 0;
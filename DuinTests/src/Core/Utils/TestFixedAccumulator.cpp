@@ -0,0 +1,188 @@
+#include <doctest.h>
+#include <Duin/Core/Utils/FixedAccumulator.h>
+#include <Duin/Core/Utils/FrameArena.h>
+#include <utility>
+#include <vector>
+
+namespace TestFixedAccumulator
+{
+struct Value
+{
+    float x = 0.0f;
+};
+
+using Accumulator = duin::FixedAccumulator<Value, 4>;
+
+TEST_SUITE("FixedAccumulator")
+{
+    TEST_CASE("Copies never share the spill buffer")
+    {
+        duin::FrameArena arena;
+        Accumulator acc;
+        for (int i = 0; i < 6; ++i)
+        {
+            acc.Push({static_cast<float>(i)}, arena);
+        }
+        acc[0].x = 100.0f;
+
+        Accumulator copy = acc;
+        CHECK(copy.IsSpilled());
+        REQUIRE(copy.Size() == 6);
+        CHECK(copy[0].x == 100.0f);
+        CHECK(copy[5].x == 5.0f);
+        CHECK(copy.Data() != acc.Data());
+
+        copy.Push({7.0f}, arena);
+        copy[1].x = -1.0f;
+        CHECK(acc.Size() == 6);
+        CHECK(acc[1].x == 1.0f);
+        CHECK(acc[4].x == 4.0f);
+
+        Accumulator assigned;
+        assigned = copy;
+        REQUIRE(assigned.Size() == 7);
+        CHECK(assigned[1].x == -1.0f);
+        CHECK(assigned[6].x == 7.0f);
+    }
+
+    TEST_CASE("A copy of a stale spill is empty")
+    {
+        duin::FrameArena arena;
+        Accumulator acc;
+        for (int i = 0; i < 6; ++i)
+        {
+            acc.Push({static_cast<float>(i)}, arena);
+        }
+        arena.Reset();
+
+        Accumulator copy = acc;
+        CHECK(copy.Empty());
+        CHECK_FALSE(copy.IsSpilled());
+    }
+
+    TEST_CASE("Moves hand the spill buffer over")
+    {
+        duin::FrameArena arena;
+        Accumulator acc;
+        for (int i = 0; i < 6; ++i)
+        {
+            acc.Push({static_cast<float>(i)}, arena);
+        }
+
+        Accumulator moved = std::move(acc);
+        CHECK(moved.IsSpilled());
+        REQUIRE(moved.Size() == 6);
+        CHECK(moved[5].x == 5.0f);
+        CHECK(acc.Empty());
+    }
+
+    TEST_CASE("Stays inline up to its capacity")
+    {
+        duin::FrameArena arena;
+        Accumulator acc;
+
+        for (int i = 0; i < 4; ++i)
+        {
+            acc.Push({static_cast<float>(i)}, arena);
+        }
+
+        CHECK(acc.Size() == 4);
+        CHECK_FALSE(acc.IsSpilled());
+        CHECK(arena.GetBytesUsed() == 0);
+        CHECK_FALSE(acc.TryPush({4.0f}));
+    }
+
+    TEST_CASE("Spills into the arena and keeps values contiguous")
+    {
+        duin::FrameArena arena(128);
+        Accumulator acc;
+
+        for (int i = 0; i < 20; ++i)
+        {
+            acc.Push({static_cast<float>(i)}, arena);
+        }
+
+        REQUIRE(acc.Size() == 20);
+        CHECK(acc.IsSpilled());
+        CHECK(arena.GetBytesUsed() > 0);
+
+        float sum = 0.0f;
+        for (const Value &v : acc)
+        {
+            sum += v.x;
+        }
+        CHECK(sum == doctest::Approx(190.0f));
+        CHECK(acc.Items()[19].x == 19.0f);
+    }
+
+    TEST_CASE("Is empty after the arena is reset")
+    {
+        duin::FrameArena arena;
+        Accumulator acc;
+        for (int i = 0; i < 6; ++i)
+        {
+            acc.Push({static_cast<float>(i)}, arena);
+        }
+        // Written after the spill, so only the arena copy holds it.
+        acc[0].x = 100.0f;
+
+        arena.Reset();
+
+        CHECK_FALSE(acc.IsSpilled());
+        CHECK(acc.Empty());
+
+        acc.Push({42.0f}, arena);
+        REQUIRE(acc.Size() == 1);
+        CHECK(acc[0].x == 42.0f);
+    }
+
+    TEST_CASE("Clear empties without touching the arena")
+    {
+        duin::FrameArena arena;
+        Accumulator acc;
+        for (int i = 0; i < 8; ++i)
+        {
+            acc.Push({1.0f}, arena);
+        }
+        size_t used = arena.GetBytesUsed();
+
+        acc.Clear();
+
+        CHECK(acc.Empty());
+        CHECK(arena.GetBytesUsed() == used);
+    }
+
+    TEST_CASE("Reflection round-trips the inline values")
+    {
+        Accumulator acc;
+        acc.TryPush({1.0f});
+        acc.TryPush({2.0f});
+
+        std::vector<Value> values = acc.reflection();
+        Accumulator copy(values);
+
+        REQUIRE(copy.Size() == 2);
+        CHECK(copy[1].x == 2.0f);
+    }
+}
+
+TEST_SUITE("FrameArena")
+{
+    TEST_CASE("Allocations are aligned and reused after Reset")
+    {
+        duin::FrameArena arena(256);
+
+        void *first = arena.Allocate(24, 16);
+        CHECK(reinterpret_cast<uintptr_t>(first) % 16 == 0);
+        arena.Allocate(1000, 8); // larger than a block
+        uint32_t generation = arena.GetGeneration();
+
+        arena.Reset();
+
+        CHECK(arena.GetGeneration() != generation);
+        CHECK(arena.GetBytesUsed() == 0);
+        CHECK(arena.Allocate(24, 16) == first);
+    }
+}
+
+} // namespace TestFixedAccumulator
@@ -0,0 +1,83 @@
+#include <doctest.h>
+#include <Duin/Core/Utils/ThreadPool.h>
+#include <atomic>
+#include <functional>
+#include <vector>
+
+namespace TestThreadPool
+{
+TEST_SUITE("ThreadPool")
+{
+    TEST_CASE("ParallelFor covers the range exactly once")
+    {
+        duin::ThreadPool pool(3);
+        std::vector<std::atomic<int>> hits(1000);
+
+        pool.ParallelFor(hits.size(), 64, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                hits[i]++;
+            }
+        });
+
+        for (size_t i = 0; i < hits.size(); ++i)
+        {
+            CAPTURE(i);
+            CHECK(hits[i] == 1);
+        }
+    }
+
+    TEST_CASE("Wait covers tasks submitted from other tasks")
+    {
+        duin::ThreadPool pool(3);
+        duin::TaskGroup group;
+        std::atomic<int> count{0};
+
+        std::function<void(int)> spawn = [&](int depth) {
+            count++;
+            if (depth < 5)
+            {
+                pool.Submit(group, [&, depth]() { spawn(depth + 1); });
+                pool.Submit(group, [&, depth]() { spawn(depth + 1); });
+            }
+        };
+        pool.Submit(group, [&]() { spawn(0); });
+        pool.Wait(group);
+
+        CHECK(group.IsDone());
+        CHECK(count == 63);
+    }
+
+    TEST_CASE("Thread indices are unique per worker")
+    {
+        duin::ThreadPool pool(4);
+        CHECK(pool.GetThreadCount() == 5);
+        CHECK(pool.GetCurrentThreadIndex() == 0);
+
+        std::atomic<size_t> maxIndex{0};
+        pool.ParallelFor(4096, 1, [&](size_t, size_t) {
+            size_t index = pool.GetCurrentThreadIndex();
+            size_t seen = maxIndex.load();
+            while (index > seen && !maxIndex.compare_exchange_weak(seen, index))
+            {
+            }
+        });
+
+        CHECK(maxIndex < pool.GetThreadCount());
+    }
+
+    TEST_CASE("A pool without workers runs everything inline")
+    {
+        duin::ThreadPool pool(0);
+        duin::TaskGroup group;
+        int runs = 0;
+
+        pool.Submit(group, [&]() { runs++; });
+        pool.ParallelFor(10, 3, [&](size_t begin, size_t end) { runs += static_cast<int>(end - begin); });
+        pool.Wait(group);
+
+        CHECK(runs == 11);
+    }
+}
+
+} // namespace TestThreadPool
@@ -3,7 +3,9 @@
 #include <Duin/ECS/DECS/World.h>
 #include <Duin/ECS/DECS/Entity.h>
 #include <Duin/ECS/DECS/Query.h>
+#include <atomic>
 #include <map>
+#include <span>
 #include <vector>
 #include <string>
 
@@ -630,5 +632,166 @@ TEST_SUITE("Query")
 
         CHECK(validDepthRelations == maxDepth); // All 5 parent-child relationships are valid
     }
+
+    TEST_CASE("Iter hands out contiguous spans per table")
+    {
+        duin::World w;
+        struct Pos
+        {
+            float x = 0.0f;
+        };
+        struct Vel
+        {
+            float x = 0.0f;
+        };
+        struct Marker
+        {
+        };
+        w.Component<Pos>();
+        w.Component<Vel>();
+        w.Component<Marker>();
+
+        for (int i = 0; i < 10; ++i)
+        {
+            duin::Entity e = w.Entity().Set<Pos>({0.0f}).Set<Vel>({static_cast<float>(i)});
+            if (i % 2)
+            {
+                e.Add<Marker>(); // second table
+            }
+        }
+
+        auto q = w.QueryBuilder<Pos, const Vel>().Build();
+
+        int tables = 0;
+        size_t rows = 0;
+        q.Iter([&](duin::Iter &it, std::span<Pos> pos, std::span<const Vel> vel) {
+            CHECK(pos.size() == it.Count());
+            CHECK(vel.size() == it.Count());
+            CHECK(it.Entities().size() == it.Count());
+            for (size_t i = 0; i < pos.size(); ++i)
+            {
+                pos[i].x += vel[i].x;
+            }
+            tables++;
+            rows += it.Count();
+        });
+
+        CHECK(tables == 2);
+        CHECK(rows == 10);
+
+        float total = 0.0f;
+        q.Each([&](duin::Entity, Pos &p, const Vel &) { total += p.x; });
+        CHECK(total == doctest::Approx(45.0f));
+    }
+
+    TEST_CASE("Iter gives an empty span for an unset optional term")
+    {
+        duin::World w;
+        struct Pos
+        {
+            float x = 0.0f;
+        };
+        struct Scale
+        {
+            float s = 1.0f;
+        };
+        w.Component<Pos>();
+        w.Component<Scale>();
+
+        w.Entity().Set<Pos>({1.0f});
+        w.Entity().Set<Pos>({2.0f}).Set<Scale>({3.0f});
+
+        auto q = w.QueryBuilder<Pos, const Scale *>().Build();
+
+        size_t withScale = 0;
+        size_t withoutScale = 0;
+        q.Iter([&](duin::Iter &it, std::span<Pos> pos, std::span<const Scale> scale) {
+            if (scale.empty())
+            {
+                withoutScale += pos.size();
+            }
+            else
+            {
+                withScale += pos.size();
+            }
+        });
+
+        CHECK(withScale == 1);
+        CHECK(withoutScale == 1);
+    }
+
+    TEST_CASE("IterParallel splits tables by grain size and visits every row once")
+    {
+        duin::World w;
+        struct Counter
+        {
+            int hits = 0;
+        };
+        w.Component<Counter>();
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            w.Entity().Set<Counter>({});
+        }
+
+        auto q = w.QueryBuilder<Counter>().Build();
+        duin::ThreadPool pool(3);
+
+        std::atomic<size_t> rows{0};
+        std::atomic<size_t> largestRange{0};
+        std::atomic<int> mismatched{0};
+        q.IterParallel(
+            64,
+            [&](std::span<const uint64_t> entities, std::span<Counter> counters) {
+                mismatched += entities.size() != counters.size();
+                for (Counter &c : counters)
+                {
+                    c.hits++;
+                }
+                rows += counters.size();
+                size_t seen = largestRange.load();
+                while (counters.size() > seen && !largestRange.compare_exchange_weak(seen, counters.size()))
+                {
+                }
+            },
+            pool);
+
+        CHECK(rows == 1000);
+        CHECK(largestRange <= 64);
+        CHECK(mismatched == 0);
+
+        int wrong = 0;
+        q.Each([&](duin::Entity, Counter &c) { wrong += c.hits != 1; });
+        CHECK(wrong == 0);
+    }
+
+    TEST_CASE("EachParallel passes components by reference")
+    {
+        duin::World w;
+        struct Pos
+        {
+            float x = 0.0f;
+        };
+        struct Vel
+        {
+            float x = 0.0f;
+        };
+        w.Component<Pos>();
+        w.Component<Vel>();
+
+        for (int i = 0; i < 500; ++i)
+        {
+            w.Entity().Set<Pos>({0.0f}).Set<Vel>({2.0f});
+        }
+
+        auto q = w.QueryBuilder<Pos, const Vel>().Cached().Build();
+        duin::ThreadPool pool(3);
+
+        q.EachParallel(32, [](Pos &p, const Vel &v) { p.x += v.x; }, pool);
+
+        int wrong = 0;
+        q.Each([&](duin::Entity, Pos &p, const Vel &) { wrong += p.x != 2.0f; });
+        CHECK(wrong == 0);
+    }
 }
 } // namespace TestQuery
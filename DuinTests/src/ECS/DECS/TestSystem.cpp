@@ -0,0 +1,232 @@
+#include "doctest.h"
+#include "TestSystem.h"
+#include <Duin/ECS/DECS/World.h>
+#include <Duin/ECS/DECS/Entity.h>
+#include <Duin/ECS/DECS/Query.h>
+#include <Duin/ECS/DECS/System.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace TestSystem
+{
+struct Position
+{
+    float x = 0.0f;
+};
+struct Velocity
+{
+    float x = 0.0f;
+};
+struct Health
+{
+    int value = 0;
+};
+struct Dead
+{
+};
+
+static duin::SystemDesc MakeDesc(std::vector<uint64_t> reads, std::vector<uint64_t> writes)
+{
+    duin::SystemDesc desc;
+    desc.reads = std::move(reads);
+    desc.writes = std::move(writes);
+    return desc;
+}
+
+TEST_SUITE("System")
+{
+    TEST_CASE("Conflicts - readers share, writers exclude")
+    {
+        CHECK_FALSE(duin::SystemScheduler::Conflicts(MakeDesc({1}, {}), MakeDesc({1}, {})));
+        CHECK_FALSE(duin::SystemScheduler::Conflicts(MakeDesc({1}, {2}), MakeDesc({1}, {3})));
+        CHECK(duin::SystemScheduler::Conflicts(MakeDesc({1}, {2}), MakeDesc({2}, {})));
+        CHECK(duin::SystemScheduler::Conflicts(MakeDesc({}, {2}), MakeDesc({}, {2})));
+        CHECK(duin::SystemScheduler::Conflicts(MakeDesc({}, {}), MakeDesc({5}, {})));
+    }
+
+    TEST_CASE("RunSystems - runs every system of the phase once")
+    {
+        duin::World w;
+        w.Component<Position>();
+        w.Component<Velocity>();
+
+        std::atomic<int> updateRuns{0};
+        std::atomic<int> physicsRuns{0};
+        w.System("A").Phase(duin::SystemPhase::PostUpdate).Read<Position>().Run([&](duin::SystemContext &) {
+            updateRuns++;
+        });
+        w.System("B").Phase(duin::SystemPhase::PostUpdate).Read<Velocity>().Run([&](duin::SystemContext &) {
+            updateRuns++;
+        });
+        w.System("C").Phase(duin::SystemPhase::PostPhysicsUpdate).Read<Velocity>().Run(
+            [&](duin::SystemContext &) { physicsRuns++; });
+
+        w.RunSystems(duin::SystemPhase::PostUpdate, 0.016);
+
+        CHECK(updateRuns == 2);
+        CHECK(physicsRuns == 0);
+    }
+
+    TEST_CASE("RunSystems - conflicting systems keep registration order")
+    {
+        duin::World w;
+        w.Component<Position>();
+
+        std::mutex mutex;
+        std::vector<std::string> order;
+        auto record = [&](const char *name) {
+            return [&, name](duin::SystemContext &) {
+                // Give a racing system time to overtake if ordering were broken.
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                std::lock_guard<std::mutex> lock(mutex);
+                order.push_back(name);
+            };
+        };
+
+        w.System("Write1").Write<Position>().Run(record("Write1"));
+        w.System("Read").Read<Position>().Run(record("Read"));
+        w.System("Write2").Write<Position>().Run(record("Write2"));
+
+        w.RunSystems(duin::SystemPhase::PostUpdate, 0.0);
+
+        REQUIRE(order.size() == 3);
+        CHECK(order[0] == "Write1");
+        CHECK(order[1] == "Read");
+        CHECK(order[2] == "Write2");
+    }
+
+    TEST_CASE("RunSystems - After orders systems that share no components")
+    {
+        duin::World w;
+        w.Component<Position>();
+        w.Component<Velocity>();
+
+        std::mutex mutex;
+        std::vector<std::string> order;
+        w.System("Late").Write<Position>().After("Early").Run([&](duin::SystemContext &) {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back("Late");
+        });
+        w.System("Early").Write<Velocity>().Run([&](duin::SystemContext &) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back("Early");
+        });
+
+        w.RunSystems(duin::SystemPhase::PostUpdate, 0.0);
+
+        REQUIRE(order.size() == 2);
+        CHECK(order[0] == "Early");
+        CHECK(order[1] == "Late");
+    }
+
+    TEST_CASE("RunSystems - systems iterate on their stage and write components")
+    {
+        duin::World w;
+        w.Component<Position>();
+        w.Component<Velocity>();
+        w.Component<Health>();
+
+        for (int i = 0; i < 64; ++i)
+        {
+            w.Entity().Set<Position>({0.0f}).Set<Velocity>({1.0f}).Set<Health>({i});
+        }
+
+        auto move = w.QueryBuilder<Position, const Velocity>().Cached().Build();
+        auto heal = w.QueryBuilder<Health>().Cached().Build();
+
+        w.System("Move").Read<Velocity>().Write<Position>().Run([move](duin::SystemContext &ctx) {
+            move.Each(ctx.Stage(), [&](duin::Entity, Position &p, const Velocity &v) {
+                p.x += v.x * static_cast<float>(ctx.GetDelta());
+            });
+        });
+        w.System("Heal").Write<Health>().Run([heal](duin::SystemContext &ctx) {
+            heal.Each(ctx.Stage(), [](duin::Entity, Health &h) { h.value += 100; });
+        });
+
+        w.RunSystems(duin::SystemPhase::PostUpdate, 2.0);
+
+        int checked = 0;
+        auto verify = w.QueryBuilder<const Position, const Health>().Build();
+        verify.Each([&](duin::Entity, const Position &p, const Health &h) {
+            CHECK(p.x == doctest::Approx(2.0f));
+            CHECK(h.value >= 100);
+            checked++;
+        });
+        CHECK(checked == 64);
+    }
+
+    TEST_CASE("RunSystems - structural changes are applied when the phase ends")
+    {
+        duin::World w;
+        w.Component<Health>();
+        w.Component<Dead>();
+
+        duin::Entity alive = w.Entity().Set<Health>({10});
+        duin::Entity dying = w.Entity().Set<Health>({0});
+
+        auto q = w.QueryBuilder<const Health>().Cached().Build();
+        w.System("Reap").Read<Health>().Write<Dead>().Run([q](duin::SystemContext &ctx) {
+            q.Each(ctx.Stage(), [](duin::Entity e, const Health &h) {
+                if (h.value <= 0)
+                {
+                    e.Add<Dead>();
+                }
+            });
+        });
+
+        w.RunSystems(duin::SystemPhase::PostUpdate, 0.0);
+
+        CHECK_FALSE(alive.Has<Dead>());
+        CHECK(dying.Has<Dead>());
+    }
+
+    TEST_CASE("RunSystems - a throwing system reaches the caller after the phase drains")
+    {
+        duin::World w;
+        w.Component<Position>();
+        w.Component<Velocity>();
+        w.Component<Health>();
+
+        std::atomic<int> runs{0};
+        w.System("Throw").Write<Position>().Run([&](duin::SystemContext &) {
+            runs++;
+            throw std::runtime_error("system failed");
+        });
+        w.System("After").Write<Position>().Run([&](duin::SystemContext &) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            runs++;
+        });
+        w.System("Independent").Write<Velocity>().Run([&](duin::SystemContext &) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            runs++;
+        });
+
+        CHECK_THROWS_AS(w.RunSystems(duin::SystemPhase::PostUpdate, 0.0), std::runtime_error);
+        CHECK(runs == 3);
+
+        // The world left readonly mode and can still be written.
+        duin::Entity e = w.Entity().Set<Health>({5});
+        CHECK(e.Get<Health>().value == 5);
+    }
+
+    TEST_CASE("ClearSystems - removes every registered system")
+    {
+        duin::World w;
+        w.Component<Position>();
+
+        int runs = 0;
+        w.System("A").Read<Position>().Run([&](duin::SystemContext &) { runs++; });
+        w.ClearSystems();
+        w.RunSystems(duin::SystemPhase::PostUpdate, 0.0);
+
+        CHECK(runs == 0);
+    }
+}
+
+} // namespace TestSystem
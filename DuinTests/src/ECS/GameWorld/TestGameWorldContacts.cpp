@@ -0,0 +1,74 @@
+#include "TestConfig.h"
+#include "Defines.h"
+#include <doctest.h>
+#include <Duin/ECS/GameWorld.h>
+
+namespace TestGameWorld
+{
+
+// Far from the origin so bodies other tests leave behind stay out of the way.
+static const duin::Vector3 CONTACT_ORIGIN = {-500.0f, 0.0f, 500.0f};
+
+static void ContactTick(duin::GameWorld &gw)
+{
+    duin::PhysicsServer::Get().StepPhysics(1.0 / 60.0);
+    gw.PullPhysicsBodies();
+    gw.DispatchContactEvents();
+}
+
+TEST_SUITE("GameWorld - Contacts")
+{
+    TEST_CASE("A resting body begins contact once and ends it when the other body goes")
+    {
+        duin::GameWorld gw;
+        gw.Initialize(false);
+
+        duin::PxBox groundShape;
+        groundShape.sides = {10.0f, 1.0f, 10.0f};
+        duin::Entity ground = gw.Entity("Ground").Set<duin::ECSComponent::Transform3D>(
+            duin::ECSComponent::Transform3D(CONTACT_ORIGIN));
+        duin::Entity ball = gw.Entity("Ball").Set<duin::ECSComponent::Transform3D>(duin::ECSComponent::Transform3D(
+            {CONTACT_ORIGIN.x, CONTACT_ORIGIN.y + 1.2f, CONTACT_ORIGIN.z}));
+        REQUIRE(gw.AddPhysicsBody(ground, groundShape, duin::PhysicsMotionType::Static));
+        REQUIRE(gw.AddPhysicsBody(ball, duin::PxSphere{0.5f}, duin::PhysicsMotionType::Dynamic));
+
+        int beginTicks = 0;
+        for (int i = 0; i < 90; ++i)
+        {
+            ContactTick(gw);
+            if (!ball.Has<duin::ECSComponent::ContactBegin>())
+            {
+                continue;
+            }
+            ++beginTicks;
+
+            const duin::ECSComponent::ContactBegin &begin = ball.Get<duin::ECSComponent::ContactBegin>();
+            REQUIRE(begin.contacts.size() == 1);
+            CHECK(begin.contacts[0].other == ground.GetID());
+            CHECK(begin.contacts[0].otherBody == ground.Get<duin::ECSComponent::PhysicsBody>().bodyID);
+            CHECK(begin.contacts[0].normal.y < -0.9f);
+
+            REQUIRE(ground.Has<duin::ECSComponent::ContactBegin>());
+            CHECK(ground.Get<duin::ECSComponent::ContactBegin>().contacts[0].other == ball.GetID());
+            CHECK(ground.Get<duin::ECSComponent::ContactBegin>().contacts[0].normal.y > 0.9f);
+        }
+        // The contact persisted for the rest of the run without beginning again.
+        CHECK(beginTicks == 1);
+        CHECK_FALSE(ball.Has<duin::ECSComponent::ContactEnd>());
+
+        gw.RemovePhysicsBody(ground);
+        ContactTick(gw);
+        REQUIRE(ball.Has<duin::ECSComponent::ContactEnd>());
+        CHECK(ball.Get<duin::ECSComponent::ContactEnd>().contacts.size() == 1);
+        CHECK(ball.Get<duin::ECSComponent::ContactEnd>().contacts[0].other == 0);
+        CHECK_FALSE(ground.Has<duin::ECSComponent::ContactEnd>());
+
+        // Contact components only last one tick.
+        ContactTick(gw);
+        CHECK_FALSE(ball.Has<duin::ECSComponent::ContactEnd>());
+
+        gw.RemovePhysicsBody(ball);
+    }
+}
+
+} // namespace TestGameWorld
@@ -0,0 +1,99 @@
+#include "TestConfig.h"
+#include "Defines.h"
+#include <doctest.h>
+#include <Duin/ECS/GameWorld.h>
+#include <cmath>
+
+namespace TestGameWorld
+{
+
+static duin::Entity MakeBodyEntity(duin::GameWorld &gw, const char *name, duin::Vector3 position)
+{
+    return gw.Entity(name)
+        .Set<duin::ECSComponent::Transform3D>(duin::ECSComponent::Transform3D(position))
+        .Set<duin::ECSComponent::Velocity3D>(duin::ECSComponent::Velocity3D());
+}
+
+TEST_SUITE("GameWorld - Physics Bodies")
+{
+    TEST_CASE("AddPhysicsBody - requires a Transform3D and one body per entity")
+    {
+        duin::GameWorld gw;
+        gw.Initialize(false);
+
+        duin::Entity bare = gw.Entity("Bare");
+        CHECK_FALSE(gw.AddPhysicsBody(bare, duin::PxBox{}, duin::PhysicsMotionType::Dynamic));
+        CHECK_FALSE(bare.Has<duin::ECSComponent::PhysicsBody>());
+
+        duin::Entity e = MakeBodyEntity(gw, "Body", {0.0f, 5.0f, 0.0f});
+        REQUIRE(gw.AddPhysicsBody(e, duin::PxBox{}, duin::PhysicsMotionType::Kinematic));
+        CHECK(e.Has<duin::ECSComponent::PhysicsBody>());
+        CHECK(e.Has<duin::ECSTag::PxKinematic>());
+        CHECK_FALSE(e.Has<duin::ECSTag::PxDynamic>());
+        CHECK_FALSE(e.Get<duin::ECSComponent::PhysicsBody>().bodyID.IsInvalid());
+
+        CHECK_FALSE(gw.AddPhysicsBody(e, duin::PxBox{}, duin::PhysicsMotionType::Dynamic));
+
+        gw.RemovePhysicsBody(e);
+        CHECK_FALSE(e.Has<duin::ECSComponent::PhysicsBody>());
+        CHECK_FALSE(e.Has<duin::ECSTag::PxKinematic>());
+    }
+
+    TEST_CASE("AddPhysicsBody - plane shapes cannot be dynamic")
+    {
+        duin::GameWorld gw;
+        gw.Initialize(false);
+
+        duin::Entity e = MakeBodyEntity(gw, "Plane", {0.0f, 0.0f, 0.0f});
+        CHECK_FALSE(gw.AddPhysicsBody(e, duin::PxPlane{}, duin::PhysicsMotionType::Dynamic));
+        CHECK_FALSE(e.Has<duin::ECSComponent::PhysicsBody>());
+    }
+
+    TEST_CASE("PullPhysicsBodies - dynamic bodies write their simulated pose back")
+    {
+        duin::GameWorld gw;
+        gw.Initialize(false);
+
+        duin::Entity e = MakeBodyEntity(gw, "Falling", {3.0f, 50.0f, -2.0f});
+        REQUIRE(gw.AddPhysicsBody(e, duin::PxSphere{}, duin::PhysicsMotionType::Dynamic));
+
+        for (int i = 0; i < 10; ++i)
+        {
+            gw.PushPhysicsBodies();
+            duin::PhysicsServer::Get().StepPhysics(1.0 / 60.0);
+            gw.PullPhysicsBodies();
+        }
+        gw.PropagateTransforms();
+
+        duin::Vector3 position = e.Get<duin::ECSComponent::Transform3D>().GetPosition();
+        CHECK(position.y < 50.0f);
+        CHECK(std::fabs(position.x - 3.0f) < 1e-3f);
+        CHECK(std::fabs(position.z + 2.0f) < 1e-3f);
+        CHECK(e.Get<duin::ECSComponent::Velocity3D>().value.y < 0.0f);
+
+        gw.RemovePhysicsBody(e);
+    }
+
+    TEST_CASE("PullPhysicsBodies - bodies of another world are ignored")
+    {
+        duin::GameWorld gwA;
+        gwA.Initialize(false);
+        duin::GameWorld gwB;
+        gwB.Initialize(false);
+
+        duin::Entity a = MakeBodyEntity(gwA, "A", {0.0f, 20.0f, 0.0f});
+        duin::Entity b = MakeBodyEntity(gwB, "B", {10.0f, 20.0f, 0.0f});
+        REQUIRE(gwA.AddPhysicsBody(a, duin::PxSphere{}, duin::PhysicsMotionType::Dynamic));
+
+        duin::PhysicsServer::Get().StepPhysics(1.0 / 60.0);
+        gwB.PullPhysicsBodies();
+        gwA.PullPhysicsBodies();
+
+        CHECK(b.Get<duin::ECSComponent::Transform3D>().GetPosition().y == 20.0f);
+        CHECK(a.Get<duin::ECSComponent::Transform3D>().GetPosition().y < 20.0f);
+
+        gwA.RemovePhysicsBody(a);
+    }
+}
+
+} // namespace TestGameWorld
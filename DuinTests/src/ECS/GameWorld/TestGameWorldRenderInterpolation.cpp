@@ -0,0 +1,108 @@
+#include "TestConfig.h"
+#include "Defines.h"
+#include <doctest.h>
+#include <Duin/ECS/GameWorld.h>
+#include <cmath>
+
+namespace TestGameWorld
+{
+
+static bool TranslationNear(const duin::Matrix &m, duin::Vector3 v, float eps = 1e-4f)
+{
+    return std::fabs(m.m12 - v.x) < eps && std::fabs(m.m13 - v.y) < eps && std::fabs(m.m14 - v.z) < eps;
+}
+
+// One fixed tick as the engine runs it, without a physics body in the way.
+static void Tick(duin::GameWorld &gw)
+{
+    gw.PropagateTransforms();
+    gw.SnapshotRenderTransforms();
+}
+
+TEST_SUITE("GameWorld - Render Interpolation")
+{
+    TEST_CASE("Render transform blends the last two ticks")
+    {
+        duin::GameWorld gw;
+        gw.Initialize(false);
+
+        duin::Entity e = gw.Entity("Mover")
+                             .Set<duin::ECSComponent::Transform3D>(duin::ECSComponent::Transform3D({0.0f, 0.0f, 0.0f}))
+                             .Set<duin::ECSComponent::RenderTransform>(duin::ECSComponent::RenderTransform());
+        Tick(gw);
+
+        e.GetMut<duin::ECSComponent::Transform3D>().SetPosition({10.0f, 0.0f, -4.0f});
+        Tick(gw);
+
+        gw.InterpolateRenderTransforms(0.0f);
+        CHECK(TranslationNear(e.Get<duin::ECSComponent::RenderTransform>().value, {0.0f, 0.0f, 0.0f}));
+        gw.InterpolateRenderTransforms(0.25f);
+        CHECK(TranslationNear(e.Get<duin::ECSComponent::RenderTransform>().value, {2.5f, 0.0f, -1.0f}));
+        gw.InterpolateRenderTransforms(1.0f);
+        CHECK(TranslationNear(e.Get<duin::ECSComponent::RenderTransform>().value, {10.0f, 0.0f, -4.0f}));
+    }
+
+    TEST_CASE("Render transform settles once the entity stops")
+    {
+        duin::GameWorld gw;
+        gw.Initialize(false);
+
+        duin::Entity e = gw.Entity("Mover")
+                             .Set<duin::ECSComponent::Transform3D>(duin::ECSComponent::Transform3D({0.0f, 0.0f, 0.0f}))
+                             .Set<duin::ECSComponent::RenderTransform>(duin::ECSComponent::RenderTransform());
+        Tick(gw);
+        e.GetMut<duin::ECSComponent::Transform3D>().SetPosition({4.0f, 0.0f, 0.0f});
+        Tick(gw);
+        Tick(gw);
+
+        gw.InterpolateRenderTransforms(0.0f);
+        CHECK(TranslationNear(e.Get<duin::ECSComponent::RenderTransform>().value, {4.0f, 0.0f, 0.0f}));
+        gw.InterpolateRenderTransforms(0.5f);
+        CHECK(TranslationNear(e.Get<duin::ECSComponent::RenderTransform>().value, {4.0f, 0.0f, 0.0f}));
+    }
+
+    TEST_CASE("Before the first tick and after a reset the current transform is drawn")
+    {
+        duin::GameWorld gw;
+        gw.Initialize(false);
+
+        duin::Entity e = gw.Entity("Mover")
+                             .Set<duin::ECSComponent::Transform3D>(duin::ECSComponent::Transform3D({1.0f, 2.0f, 3.0f}))
+                             .Set<duin::ECSComponent::RenderTransform>(duin::ECSComponent::RenderTransform());
+        gw.PropagateTransforms();
+        gw.InterpolateRenderTransforms(0.5f);
+        CHECK(TranslationNear(e.Get<duin::ECSComponent::RenderTransform>().value, {1.0f, 2.0f, 3.0f}));
+
+        Tick(gw);
+        e.GetMut<duin::ECSComponent::Transform3D>().SetPosition({100.0f, 2.0f, 3.0f});
+        gw.ResetInterpolation(e);
+        gw.InterpolateRenderTransforms(0.5f);
+        CHECK(TranslationNear(e.Get<duin::ECSComponent::RenderTransform>().value, {100.0f, 2.0f, 3.0f}));
+
+        // The teleport is not blended across on the next tick either.
+        Tick(gw);
+        gw.InterpolateRenderTransforms(0.5f);
+        CHECK(TranslationNear(e.Get<duin::ECSComponent::RenderTransform>().value, {100.0f, 2.0f, 3.0f}));
+    }
+
+    TEST_CASE("Moving physics bodies get a RenderTransform, static ones do not")
+    {
+        duin::GameWorld gw;
+        gw.Initialize(false);
+
+        duin::Entity dynamicBody = gw.Entity("Dynamic").Set<duin::ECSComponent::Transform3D>(
+            duin::ECSComponent::Transform3D({0.0f, 30.0f, 0.0f}));
+        duin::Entity staticBody = gw.Entity("Static").Set<duin::ECSComponent::Transform3D>(
+            duin::ECSComponent::Transform3D({5.0f, 0.0f, 0.0f}));
+        REQUIRE(gw.AddPhysicsBody(dynamicBody, duin::PxSphere{}, duin::PhysicsMotionType::Dynamic));
+        REQUIRE(gw.AddPhysicsBody(staticBody, duin::PxBox{}, duin::PhysicsMotionType::Static));
+
+        CHECK(dynamicBody.Has<duin::ECSComponent::RenderTransform>());
+        CHECK_FALSE(staticBody.Has<duin::ECSComponent::RenderTransform>());
+
+        gw.RemovePhysicsBody(dynamicBody);
+        gw.RemovePhysicsBody(staticBody);
+    }
+}
+
+} // namespace TestGameWorld
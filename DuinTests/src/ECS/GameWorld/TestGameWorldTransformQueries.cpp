@@ -2,6 +2,7 @@
 #include "Defines.h"
 #include <doctest.h>
 #include <Duin/ECS/GameWorld.h>
+#include <cmath>
 
 namespace TestGameWorld
 {
@@ -16,4 +17,157 @@ static duin::Entity MakeNode3D(duin::GameWorld &gw, const char *name,
     return e;
 }
 
+// Plain Transform3D entity; does not rely on ECSPrefab globals.
+static duin::Entity MakeTransform(duin::GameWorld &gw, const char *name, duin::ECSComponent::Transform3D tx = {})
+{
+    return gw.Entity(name).Set<duin::ECSComponent::Transform3D>(tx);
+}
+
+static bool Vector3Near(duin::Vector3 a, duin::Vector3 b, float eps = 1e-4f)
+{
+    return std::fabs(a.x - b.x) < eps && std::fabs(a.y - b.y) < eps && std::fabs(a.z - b.z) < eps;
+}
+
+TEST_SUITE("GameWorld - Transform Propagation")
+{
+    TEST_CASE("PropagateTransforms - root global equals local")
+    {
+        duin::GameWorld gw;
+        gw.Initialize(false);
+
+        duin::Entity root = MakeTransform(gw, "Root", duin::ECSComponent::Transform3D({1.0f, 2.0f, 3.0f}));
+        gw.PropagateTransforms();
+
+        CHECK(Vector3Near(gw.GetGlobalPosition(root), {1.0f, 2.0f, 3.0f}));
+    }
+
+    TEST_CASE("PropagateTransforms - child composes parent translation, scale and rotation")
+    {
+        duin::GameWorld gw;
+        gw.Initialize(false);
+
+        duin::Quaternion quarterTurnY = duin::QuaternionFromAxisAngle({0.0f, 1.0f, 0.0f}, PI * 0.5f);
+        duin::Entity parent = MakeTransform(
+            gw, "Parent", duin::ECSComponent::Transform3D({10.0f, 0.0f, 0.0f}, {2.0f, 2.0f, 2.0f}, quarterTurnY));
+        duin::Entity child =
+            MakeTransform(gw, "Child", duin::ECSComponent::Transform3D({1.0f, 0.0f, 0.0f})).ChildOf(parent);
+
+        gw.PropagateTransforms();
+
+        // (1,0,0) scaled by 2 and rotated a quarter turn about Y is (0,0,-2).
+        CHECK(Vector3Near(gw.GetGlobalPosition(child), {10.0f, 0.0f, -2.0f}));
+        CHECK(Vector3Near(gw.GetGlobalScale(child), {2.0f, 2.0f, 2.0f}));
+    }
+
+    TEST_CASE("PropagateTransforms - moving a parent updates every descendant")
+    {
+        duin::GameWorld gw;
+        gw.Initialize(false);
+
+        duin::Entity root = MakeTransform(gw, "Root");
+        duin::Entity mid = MakeTransform(gw, "Mid", duin::ECSComponent::Transform3D({0.0f, 1.0f, 0.0f})).ChildOf(root);
+        duin::Entity leaf =
+            MakeTransform(gw, "Leaf", duin::ECSComponent::Transform3D({0.0f, 0.0f, 1.0f})).ChildOf(mid);
+
+        gw.PropagateTransforms();
+        REQUIRE(Vector3Near(gw.GetGlobalPosition(leaf), {0.0f, 1.0f, 1.0f}));
+
+        root.GetMut<duin::ECSComponent::Transform3D>().SetPosition({5.0f, 0.0f, 0.0f});
+        gw.PropagateTransforms();
+
+        CHECK(Vector3Near(gw.GetGlobalPosition(mid), {5.0f, 1.0f, 0.0f}));
+        CHECK(Vector3Near(gw.GetGlobalPosition(leaf), {5.0f, 1.0f, 1.0f}));
+    }
+
+    TEST_CASE("GetGlobalPosition - sees a parent change made after the last pass")
+    {
+        duin::GameWorld gw;
+        gw.Initialize(false);
+
+        duin::Entity root = MakeTransform(gw, "Root");
+        duin::Entity child =
+            MakeTransform(gw, "Child", duin::ECSComponent::Transform3D({1.0f, 0.0f, 0.0f})).ChildOf(root);
+
+        CHECK(Vector3Near(gw.GetGlobalPosition(child), {1.0f, 0.0f, 0.0f}));
+
+        gw.SetGlobalPosition(root, {0.0f, 3.0f, 0.0f});
+
+        CHECK(Vector3Near(gw.GetGlobalPosition(child), {1.0f, 3.0f, 0.0f}));
+    }
+
+    TEST_CASE("SetGlobalTransform - invalidates descendants")
+    {
+        duin::GameWorld gw;
+        gw.Initialize(false);
+
+        duin::Entity root = MakeTransform(gw, "Root");
+        duin::Entity child =
+            MakeTransform(gw, "Child", duin::ECSComponent::Transform3D({1.0f, 0.0f, 0.0f})).ChildOf(root);
+        gw.PropagateTransforms();
+
+        gw.SetGlobalTransform(root, duin::ECSComponent::Transform3D({0.0f, 0.0f, 4.0f}));
+        gw.PropagateTransforms();
+
+        CHECK(Vector3Near(gw.GetGlobalPosition(child), {1.0f, 0.0f, 4.0f}));
+    }
+
+    TEST_CASE("PropagateTransforms - parent without Transform3D breaks the chain")
+    {
+        duin::GameWorld gw;
+        gw.Initialize(false);
+
+        duin::Entity root = MakeTransform(gw, "Root", duin::ECSComponent::Transform3D({7.0f, 0.0f, 0.0f}));
+        duin::Entity plain = gw.Entity("Plain").ChildOf(root);
+        duin::Entity leaf =
+            MakeTransform(gw, "Leaf", duin::ECSComponent::Transform3D({1.0f, 0.0f, 0.0f})).ChildOf(plain);
+
+        gw.PropagateTransforms();
+
+        CHECK(Vector3Near(gw.GetGlobalPosition(leaf), {1.0f, 0.0f, 0.0f}));
+    }
+
+    TEST_CASE("PropagateTransforms - reparenting to root drops the old parent offset")
+    {
+        duin::GameWorld gw;
+        gw.Initialize(false);
+
+        duin::Entity root = MakeTransform(gw, "Root", duin::ECSComponent::Transform3D({3.0f, 0.0f, 0.0f}));
+        duin::Entity child =
+            MakeTransform(gw, "Child", duin::ECSComponent::Transform3D({1.0f, 0.0f, 0.0f})).ChildOf(root);
+        gw.PropagateTransforms();
+        REQUIRE(Vector3Near(gw.GetGlobalPosition(child), {4.0f, 0.0f, 0.0f}));
+
+        child.RemovePair(flecs::ChildOf, root.GetID());
+        gw.PropagateTransforms();
+
+        CHECK(Vector3Near(gw.GetGlobalPosition(child), {1.0f, 0.0f, 0.0f}));
+    }
+
+    TEST_CASE("PropagateTransforms - GlobalTransform matrix follows the hierarchy")
+    {
+        duin::GameWorld gw;
+        gw.Initialize(false);
+
+        duin::Quaternion quarterTurnY = duin::QuaternionFromAxisAngle({0.0f, 1.0f, 0.0f}, PI * 0.5f);
+        duin::Entity parent =
+            MakeTransform(gw, "Parent", duin::ECSComponent::Transform3D({10.0f, 0.0f, 0.0f}, {2.0f, 2.0f, 2.0f},
+                                                                         quarterTurnY))
+                .Set<duin::ECSComponent::GlobalTransform>({});
+        duin::Entity child = MakeTransform(gw, "Child", duin::ECSComponent::Transform3D({1.0f, 0.0f, 0.0f}))
+                                 .Set<duin::ECSComponent::GlobalTransform>({})
+                                 .ChildOf(parent);
+
+        gw.PropagateTransforms();
+
+        const duin::Matrix &m = child.Get<duin::ECSComponent::GlobalTransform>().value;
+        CHECK(Vector3Near({m.m12, m.m13, m.m14}, {10.0f, 0.0f, -2.0f}));
+
+        parent.GetMut<duin::ECSComponent::Transform3D>().SetPosition({0.0f, 5.0f, 0.0f});
+        gw.PropagateTransforms();
+
+        const duin::Matrix &moved = child.Get<duin::ECSComponent::GlobalTransform>().value;
+        CHECK(Vector3Near({moved.m12, moved.m13, moved.m14}, {0.0f, 5.0f, -2.0f}));
+    }
+}
+
 } // namespace TestGameWorld
@@ -0,0 +1,198 @@
+#include "TestConfig.h"
+#include <doctest.h>
+#include <Duin/IO/AsyncIOStream.h>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace TestAsyncIOStream
+{
+
+static std::string TestPath(const std::string &name)
+{
+    std::filesystem::create_directories(ARTIFACT_PATH);
+    return ARTIFACT_PATH + "/" + name;
+}
+
+static void CreateTestFile(const std::string &path, const std::string &content)
+{
+    std::ofstream file(path, std::ios::binary);
+    file << content;
+}
+
+// Pumps the phase until `done` is set or about two seconds have passed.
+static bool PumpUntil(duin::io::AsyncIOStream &service, duin::io::AsyncIOPhase phase, const bool &done)
+{
+    for (int i = 0; i < 2000 && !done; ++i)
+    {
+        if (service.Pump(phase) == 0)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    return done;
+}
+
+TEST_SUITE("IO - AsyncIOStream")
+{
+    TEST_CASE("Reads complete on the pumping thread in their phase")
+    {
+        for (duin::io::AsyncIOBackend backend : {duin::io::AsyncIOBackend::Auto, duin::io::AsyncIOBackend::Threads})
+        {
+            duin::io::AsyncIOStream service(backend);
+            const std::string path = TestPath("async_read.bin");
+            std::string content(100000, '\0');
+            for (size_t i = 0; i < content.size(); ++i)
+            {
+                content[i] = static_cast<char>(i * 31);
+            }
+            CreateTestFile(path, content);
+
+            bool done = false;
+            duin::io::AsyncIOResult received;
+            std::thread::id callbackThread;
+            duin::io::AsyncIORequestId id = service.ReadFile(
+                path,
+                [&](duin::io::AsyncIOResult &result) {
+                    callbackThread = std::this_thread::get_id();
+                    received = std::move(result);
+                    done = true;
+                },
+                duin::io::AsyncIOPriority::Normal, duin::io::AsyncIOPhase::PostUpdate);
+            REQUIRE(id != duin::io::ASYNCIO_INVALID_REQUEST);
+
+            // Pumping another phase never delivers it.
+            while (service.GetPendingCount() > 0)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            CHECK(service.Pump(duin::io::AsyncIOPhase::PreFrame) == 0);
+            CHECK_FALSE(done);
+
+            REQUIRE(PumpUntil(service, duin::io::AsyncIOPhase::PostUpdate, done));
+            CHECK(callbackThread == std::this_thread::get_id());
+            CHECK(received.id == id);
+            CHECK(received.status == duin::io::AsyncIOStatus::Completed);
+            CHECK(received.size == content.size());
+            CHECK(std::string(received.data.begin(), received.data.end()) == content);
+        }
+    }
+
+    TEST_CASE("Writes are readable afterwards")
+    {
+        duin::io::AsyncIOStream service;
+        const std::string path = TestPath("async_write.bin");
+        std::vector<uint8_t> bytes = {'d', 'u', 'i', 'n', 0, 1, 2, 3};
+
+        bool written = false;
+        duin::io::AsyncIOStatus writeStatus = duin::io::AsyncIOStatus::Failed;
+        service.WriteFile(path, bytes, [&](duin::io::AsyncIOResult &result) {
+            writeStatus = result.status;
+            CHECK(result.size == 8);
+            CHECK(result.data.empty());
+            written = true;
+        });
+        REQUIRE(PumpUntil(service, duin::io::AsyncIOPhase::PreFrame, written));
+        CHECK(writeStatus == duin::io::AsyncIOStatus::Completed);
+
+        bool read = false;
+        std::vector<uint8_t> readBack;
+        service.ReadFile(path, [&](duin::io::AsyncIOResult &result) {
+            readBack = std::move(result.data);
+            read = true;
+        });
+        REQUIRE(PumpUntil(service, duin::io::AsyncIOPhase::PreFrame, read));
+        CHECK(readBack == bytes);
+    }
+
+    TEST_CASE("Missing files and empty files")
+    {
+        duin::io::AsyncIOStream service;
+
+        bool missingDone = false;
+        service.ReadFile(TestPath("async_missing.bin"), [&](duin::io::AsyncIOResult &result) {
+            CHECK(result.status == duin::io::AsyncIOStatus::Failed);
+            CHECK(result.data.empty());
+            missingDone = true;
+        });
+        CHECK(PumpUntil(service, duin::io::AsyncIOPhase::PreFrame, missingDone));
+
+        const std::string empty = TestPath("async_empty.bin");
+        CreateTestFile(empty, "");
+        bool emptyDone = false;
+        service.ReadFile(empty, [&](duin::io::AsyncIOResult &result) {
+            CHECK(result.status == duin::io::AsyncIOStatus::Completed);
+            CHECK(result.size == 0);
+            emptyDone = true;
+        });
+        CHECK(PumpUntil(service, duin::io::AsyncIOPhase::PreFrame, emptyDone));
+    }
+
+    TEST_CASE("Every request gets exactly one callback, cancelled or not")
+    {
+        duin::io::AsyncIOStream service(duin::io::AsyncIOBackend::Threads, 1);
+        const std::string path = TestPath("async_cancel.bin");
+        CreateTestFile(path, std::string(4096, 'x'));
+
+        const int count = 64;
+        std::vector<int> calls(count, 0);
+        std::vector<bool> cancelled(count, false);
+        std::vector<duin::io::AsyncIOStatus> statuses(count, duin::io::AsyncIOStatus::Failed);
+        for (int i = 0; i < count; ++i)
+        {
+            duin::io::AsyncIORequestId id = service.ReadFile(
+                path,
+                [&, i](duin::io::AsyncIOResult &result) {
+                    ++calls[i];
+                    statuses[i] = result.status;
+                    if (result.status == duin::io::AsyncIOStatus::Cancelled)
+                    {
+                        CHECK(result.data.empty());
+                    }
+                },
+                i % 2 ? duin::io::AsyncIOPriority::High : duin::io::AsyncIOPriority::Low);
+            if (i % 3 == 0)
+            {
+                cancelled[i] = service.Cancel(id);
+            }
+        }
+
+        bool allDone = false;
+        for (int i = 0; i < 2000 && !allDone; ++i)
+        {
+            service.Pump(duin::io::AsyncIOPhase::PreFrame);
+            allDone = service.GetPendingCount() == 0;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        service.Pump(duin::io::AsyncIOPhase::PreFrame);
+        REQUIRE(allDone);
+
+        for (int i = 0; i < count; ++i)
+        {
+            CHECK(calls[i] == 1);
+            CHECK(statuses[i] == (cancelled[i] ? duin::io::AsyncIOStatus::Cancelled
+                                               : duin::io::AsyncIOStatus::Completed));
+        }
+        CHECK_FALSE(service.Cancel(12345));
+    }
+
+    TEST_CASE("Destroying the service drops pending requests")
+    {
+        const std::string path = TestPath("async_shutdown.bin");
+        CreateTestFile(path, "shutdown");
+        int calls = 0;
+        {
+            duin::io::AsyncIOStream service(duin::io::AsyncIOBackend::Threads, 1);
+            for (int i = 0; i < 32; ++i)
+            {
+                service.ReadFile(path, [&](duin::io::AsyncIOResult &) { ++calls; });
+            }
+        }
+        CHECK(calls == 0);
+    }
+}
+
+} // namespace TestAsyncIOStream
@@ -1239,4 +1239,60 @@ TEST_SUITE("IOStream - Edge Cases")
     }
 }
 
+// ============================================================================
+// File mapping
+// ============================================================================
+
+TEST_SUITE("IOStream - MapFile")
+{
+    TEST_CASE("MapFile views the whole file")
+    {
+        std::string path = ARTIFACTS_DIR + "/test_mapfile.bin";
+        std::vector<uint8_t> data(70000);
+        for (size_t i = 0; i < data.size(); ++i)
+        {
+            data[i] = static_cast<uint8_t>(i * 7);
+        }
+        CreateBinaryFile(path, data.data(), data.size());
+
+        {
+            duin::io::FileMapping view = duin::io::IOStream::MapFile(path);
+            REQUIRE(view.IsValid());
+            REQUIRE(view.Size() == data.size());
+            CHECK(std::memcmp(view.Data(), data.data(), data.size()) == 0);
+
+            // Hints never change the contents.
+            view.Advise(duin::io::MapAdvice::Random, 4097, 100);
+            view.Advise(duin::io::MapAdvice::WillNeed);
+            CHECK(view.Data()[69999] == data[69999]);
+
+            duin::io::FileMapping moved = std::move(view);
+            CHECK_FALSE(view.IsValid());
+            CHECK(view.Data() == nullptr);
+            CHECK(moved.Size() == data.size());
+        }
+
+        RemoveTestFile(path);
+    }
+
+    TEST_CASE("MapFile of an empty file is valid and empty")
+    {
+        std::string path = ARTIFACTS_DIR + "/test_mapfile_empty.bin";
+        CreateTestFile(path, "");
+        {
+            duin::io::FileMapping view = duin::io::IOStream::MapFile(path);
+            CHECK(view.IsValid());
+            CHECK(view.Size() == 0);
+        }
+        RemoveTestFile(path);
+    }
+
+    TEST_CASE("MapFile of a missing file is invalid")
+    {
+        duin::io::FileMapping view = duin::io::IOStream::MapFile(ARTIFACTS_DIR + "/no_such_file.bin");
+        CHECK_FALSE(view.IsValid());
+        CHECK(view.Size() == 0);
+    }
+}
+
 } // namespace TestIOStream
@@ -1,5 +1,7 @@
 #include <doctest.h>
 #include <Duin/IO/JSONValue.h>
+#include <filesystem>
+#include <fstream>
 #include <string>
 
 namespace TestJSONValue
@@ -836,8 +838,30 @@ TEST_SUITE("JSONValue - ParseFromFile")
         CHECK(v.IsObject());
     }
 
-    // Note: Testing actual file parsing requires creating temporary files
-    // which may require filesystem modification, so we skip actual file tests
+    TEST_CASE("Parse a mapped file")
+    {
+        std::filesystem::create_directories("./artifacts");
+        const std::string path = "./artifacts/test_parse_mapped.json";
+        {
+            std::ofstream file(path, std::ios::binary);
+            file << "{\"name\": \"duin\", \"values\": [1, 2, 3]}";
+        }
+        duin::JSONValue v = duin::JSONValue::ParseFromFile(path);
+        std::filesystem::remove(path);
+
+        REQUIRE(v.IsObject());
+        CHECK(v.GetMember("name").GetString() == "duin");
+        CHECK(v.GetMember("values").IsArray());
+    }
+
+    TEST_CASE("Parse length-delimited text")
+    {
+        // Only the first 13 bytes are JSON; the rest must be ignored.
+        const char text[] = "{\"value\": 42}garbage";
+        duin::JSONValue v = duin::JSONValue::Parse(text, 13);
+        REQUIRE(v.IsObject());
+        CHECK(v.GetMember("value").GetInt() == 42);
+    }
 }
 
 TEST_SUITE("JSONValue - Parse Error Handling")
@@ -1056,4 +1080,90 @@ TEST_SUITE("JSONValue - Inequality Operator Edge Cases")
         CHECK(v1 != v2);
     }
 }
+TEST_SUITE("JSONValue - Shared Document Children")
+{
+    TEST_CASE("NewObject/NewArray children are moved into place")
+    {
+        duin::JSONValue root;
+        duin::JSONValue child = root.NewObject();
+        child.AddMember("name", std::string("child"));
+        duin::JSONValue list = root.NewArray();
+        list.PushBack(1);
+        list.PushBack(2);
+        child.AddMember("list", std::move(list));
+        root.AddMember("child", std::move(child));
+
+        CHECK(root.Write() == "{\"child\":{\"name\":\"child\",\"list\":[1,2]}}");
+
+        // After the move the handle refers to the member inside root.
+        child.AddMember("added", true);
+        CHECK(root.GetMember("child").HasMember("added"));
+        CHECK(child == root.GetMember("child"));
+    }
+
+    TEST_CASE("Moved-in array elements keep referring to the element")
+    {
+        duin::JSONValue root;
+        duin::JSONValue array = root.NewArray();
+        for (int i = 0; i < 3; ++i)
+        {
+            duin::JSONValue element = root.NewObject();
+            element.AddMember("index", i);
+            array.PushBack(std::move(element));
+            CHECK(element.GetMember("index").GetInt() == i);
+        }
+        root.AddMember("array", std::move(array));
+        CHECK(root.Write() == "{\"array\":[{\"index\":0},{\"index\":1},{\"index\":2}]}");
+    }
+
+    TEST_CASE("Values from another document are copied")
+    {
+        duin::JSONValue root;
+        duin::JSONValue other;
+        other.AddMember("a", 1);
+        root.AddMember("other", std::move(other));
+
+        CHECK(root.GetMember("other").GetMember("a").GetInt() == 1);
+        CHECK(other.GetMember("a").GetInt() == 1);
+        CHECK(other != root.GetMember("other"));
+    }
+
+    TEST_CASE("Deep trees built from children serialize intact")
+    {
+        duin::JSONValue root;
+        duin::JSONValue node = root.NewObject();
+        node.AddMember("leaf", 0);
+        for (int depth = 1; depth < 64; ++depth)
+        {
+            duin::JSONValue parent = root.NewObject();
+            parent.AddMember("depth", depth);
+            parent.AddMember("next", std::move(node));
+            node = parent;
+        }
+        root.AddMember("tree", std::move(node));
+
+        duin::JSONValue reparsed = duin::JSONValue::Parse(root.Write());
+        duin::JSONValue cursor = reparsed.GetMember("tree");
+        for (int depth = 63; depth >= 1; --depth)
+        {
+            REQUIRE(cursor.GetMember("depth").GetInt() == depth);
+            cursor = cursor.GetMember("next");
+        }
+        CHECK(cursor.GetMember("leaf").GetInt() == 0);
+    }
+
+    TEST_CASE("Writing to a failed lookup does not leak into other lookups")
+    {
+        duin::JSONValue obj;
+        duin::JSONValue missing = obj["missing"];
+        CHECK(missing.IsObject());
+        missing.AddMember("written", 1);
+        CHECK(missing.HasMember("written"));
+
+        CHECK(obj.GetMember("other").IsEmpty());
+        CHECK(obj[0].IsEmpty());
+        CHECK(duin::JSONValue::Invalid().IsEmpty());
+        CHECK_FALSE(obj.HasMember("missing"));
+    }
+}
 } // namespace TestJSONValue
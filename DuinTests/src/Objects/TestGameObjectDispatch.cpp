@@ -0,0 +1,211 @@
+#include <doctest.h>
+#include "Defines.h"
+#include <Duin/Objects/GameObject.h>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace TestGameObjectDispatch
+{
+// Appends its name to a shared log for every callback, to compare dispatch orders.
+class OrderObject : public duin::GameObject
+{
+  public:
+    OrderObject(std::vector<std::string> &log, std::string name) : log(log), name(std::move(name))
+    {
+    }
+
+    void Update(double delta) override
+    {
+        log.push_back(name);
+    }
+    void Draw() override
+    {
+        log.push_back("draw:" + name);
+    }
+
+    std::vector<std::string> &log;
+    std::string name;
+};
+
+class CountObject : public duin::GameObject
+{
+  public:
+    void Update(double delta) override
+    {
+        ++updateCalls;
+    }
+    int updateCalls = 0;
+};
+
+// Builds root -> a(a1, a2), b(b1) and returns the objects by name.
+static std::shared_ptr<OrderObject> BuildTree(std::vector<std::string> &log,
+                                              std::vector<std::shared_ptr<OrderObject>> &nodes)
+{
+    auto root = duin::GameObject::Create<OrderObject>(log, "root");
+    auto a = root->CreateChildObject<OrderObject>(log, "a");
+    auto a1 = a->CreateChildObject<OrderObject>(log, "a1");
+    auto a2 = a->CreateChildObject<OrderObject>(log, "a2");
+    auto b = root->CreateChildObject<OrderObject>(log, "b");
+    auto b1 = b->CreateChildObject<OrderObject>(log, "b1");
+    nodes = {root, a, a1, a2, b, b1};
+    return root;
+}
+
+static std::vector<std::string> RunUpdate(const std::shared_ptr<OrderObject> &root, std::vector<std::string> &log)
+{
+    log.clear();
+    root->ObjectUpdate(0.016);
+    return log;
+}
+
+// Balanced tree with `count` objects and the given fan-out.
+static std::shared_ptr<CountObject> BuildWideTree(size_t count, size_t fanOut,
+                                                  std::vector<std::shared_ptr<CountObject>> &all)
+{
+    auto root = duin::GameObject::Create<CountObject>();
+    all.clear();
+    all.reserve(count);
+    all.push_back(root);
+    for (size_t i = 1; i < count; ++i)
+    {
+        all.push_back(all[(i - 1) / fanOut]->CreateChildObject<CountObject>());
+    }
+    return root;
+}
+
+TEST_SUITE("GameObject - Flat Dispatch")
+{
+    TEST_CASE("Flat dispatch matches recursive order")
+    {
+        std::vector<std::string> log;
+        std::vector<std::shared_ptr<OrderObject>> nodes;
+        auto root = BuildTree(log, nodes);
+
+        auto recursive = RunUpdate(root, log);
+        root->EnableFlatDispatch(true);
+        CHECK(root->IsFlatDispatchEnabled());
+        auto flat = RunUpdate(root, log);
+
+        CHECK(recursive == flat);
+        CHECK((flat == std::vector<std::string>{"a1", "a2", "a", "b1", "b", "root"}));
+        CHECK(root->GetImpl()->GetDispatchListSize() == 6);
+    }
+
+    TEST_CASE("Flat dispatch honours per-phase enable flags")
+    {
+        std::vector<std::string> log;
+        std::vector<std::shared_ptr<OrderObject>> nodes;
+        auto root = BuildTree(log, nodes);
+        root->EnableFlatDispatch(true);
+
+        nodes[1]->EnableUpdate(false); // a and its subtree skip Update
+        auto flat = RunUpdate(root, log);
+        CHECK((flat == std::vector<std::string>{"b1", "b", "root"}));
+
+        // Draw is unaffected by the Update flag.
+        log.clear();
+        root->ObjectDraw();
+        CHECK(log.size() == 6);
+
+        nodes[1]->EnableUpdate(true);
+        nodes[4]->EnableChildren(false); // b still runs, b1 does not
+        flat = RunUpdate(root, log);
+        CHECK((flat == std::vector<std::string>{"a1", "a2", "a", "b", "root"}));
+
+        root->EnableFlatDispatch(false);
+        CHECK(RunUpdate(root, log) == flat);
+    }
+
+    TEST_CASE("Flat dispatch picks up added and removed children")
+    {
+        std::vector<std::string> log;
+        std::vector<std::shared_ptr<OrderObject>> nodes;
+        auto root = BuildTree(log, nodes);
+        root->EnableFlatDispatch(true);
+        RunUpdate(root, log);
+
+        nodes[2]->CreateChildObject<OrderObject>(log, "a1x");
+        root->RemoveChildObject(nodes[4]);
+        auto flat = RunUpdate(root, log);
+        CHECK((flat == std::vector<std::string>{"a1x", "a1", "a2", "a", "root"}));
+        CHECK(root->GetImpl()->GetDispatchListSize() == 5);
+    }
+
+    TEST_CASE("Child added during a flat pass runs from the next dispatch")
+    {
+        class Spawner : public duin::GameObject
+        {
+          public:
+            void Update(double delta) override
+            {
+                if (!spawned)
+                {
+                    child = CreateChildObject<CountObject>();
+                    spawned = true;
+                }
+            }
+            bool spawned = false;
+            std::shared_ptr<CountObject> child;
+        };
+
+        auto root = duin::GameObject::Create<Spawner>();
+        root->EnableFlatDispatch(true);
+        root->ObjectUpdate(0.016);
+        REQUIRE(root->child);
+        CHECK(root->child->updateCalls == 0);
+
+        root->ObjectUpdate(0.016);
+        CHECK(root->child->updateCalls == 1);
+    }
+
+    TEST_CASE("Flat dispatch reaches every object of a wide tree once per frame")
+    {
+        std::vector<std::shared_ptr<CountObject>> all;
+        auto root = BuildWideTree(200, 8, all);
+        root->ObjectUpdate(0.016);
+        root->EnableFlatDispatch(true);
+        root->ObjectUpdate(0.016);
+        root->ObjectUpdate(0.016);
+
+        bool allUpdated = true;
+        for (const std::shared_ptr<CountObject> &object : all)
+        {
+            allUpdated = allUpdated && object->updateCalls == 3;
+        }
+        CHECK(allUpdated);
+    }
+
+    // Timing only, and slow: every GameObject logs on construction. Run with --no-skip.
+    TEST_CASE("Benchmark - flat vs recursive dispatch" * doctest::skip())
+    {
+        for (size_t count : {size_t(10000), size_t(100000)})
+        {
+            std::vector<std::shared_ptr<CountObject>> all;
+            auto root = BuildWideTree(count, 8, all);
+            const int frames = 20;
+
+            auto t0 = std::chrono::steady_clock::now();
+            for (int i = 0; i < frames; ++i)
+                root->ObjectUpdate(0.016);
+            auto recursiveUs =
+                std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - t0).count();
+
+            root->EnableFlatDispatch(true);
+            root->ObjectUpdate(0.016); // builds the list
+
+            t0 = std::chrono::steady_clock::now();
+            for (int i = 0; i < frames; ++i)
+                root->ObjectUpdate(0.016);
+            auto flatUs =
+                std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - t0).count();
+
+            MESSAGE(count, " objects, per frame: recursive ", recursiveUs / frames, "us, flat ", flatUs / frames,
+                    "us");
+            CHECK(root->updateCalls == 2 * frames + 1);
+            CHECK(all.back()->updateCalls == 2 * frames + 1);
+        }
+    }
+}
+} // namespace TestGameObjectDispatch
@@ -0,0 +1,168 @@
+#include "TestConfig.h"
+#include <doctest.h>
+#include <Duin/IO/ConfigValue.h>
+#include <Duin/Physics/PhysicsIncludes.h>
+#include <string>
+
+namespace TestPhysicsConfig
+{
+
+TEST_SUITE("Physics - Layer Table")
+{
+    TEST_CASE("Built-in layers keep the original collision rules")
+    {
+        duin::PhysicsLayerTable table;
+        REQUIRE(table.GetObjectLayerCount() == 2);
+        REQUIRE(table.GetBroadPhaseLayerCount() == 2);
+        CHECK(table.FindObjectLayer("NON_MOVING") == duin::Layers::NON_MOVING);
+        CHECK(table.FindObjectLayer("MOVING") == duin::Layers::MOVING);
+
+        CHECK_FALSE(table.ShouldCollide(duin::Layers::NON_MOVING, duin::Layers::NON_MOVING));
+        CHECK(table.ShouldCollide(duin::Layers::NON_MOVING, duin::Layers::MOVING));
+        CHECK(table.ShouldCollide(duin::Layers::MOVING, duin::Layers::MOVING));
+
+        CHECK_FALSE(table.ShouldCollideBroadPhase(duin::Layers::NON_MOVING, 0));
+        CHECK(table.ShouldCollideBroadPhase(duin::Layers::NON_MOVING, 1));
+        CHECK(table.ShouldCollideBroadPhase(duin::Layers::MOVING, 0));
+    }
+
+    TEST_CASE("Added layers are symmetric and share broadphase layers by name")
+    {
+        duin::PhysicsLayerTable table;
+        JPH::ObjectLayer debris = table.AddObjectLayer("DEBRIS", "DEBRIS");
+        JPH::ObjectLayer trigger = table.AddObjectLayer("TRIGGER", "SENSOR");
+        JPH::ObjectLayer pickup = table.AddObjectLayer("PICKUP", "SENSOR");
+        REQUIRE(debris != JPH::cObjectLayerInvalid);
+        REQUIRE(trigger != JPH::cObjectLayerInvalid);
+        CHECK(table.GetBroadPhaseLayerCount() == 4);
+        CHECK(table.GetBroadPhaseLayer(trigger) == table.GetBroadPhaseLayer(pickup));
+
+        CHECK_FALSE(table.ShouldCollide(debris, duin::Layers::MOVING));
+        table.SetCollision(debris, duin::Layers::NON_MOVING, true);
+        CHECK(table.ShouldCollide(duin::Layers::NON_MOVING, debris));
+        CHECK(table.ShouldCollideBroadPhase(duin::Layers::NON_MOVING, table.GetBroadPhaseLayer(debris)));
+
+        table.SetCollision(debris, duin::Layers::NON_MOVING, false);
+        CHECK_FALSE(table.ShouldCollide(debris, duin::Layers::NON_MOVING));
+
+        CHECK(table.AddObjectLayer("DEBRIS", "MOVING") == JPH::cObjectLayerInvalid);
+    }
+
+    TEST_CASE("The table is capped at MAX_LAYERS")
+    {
+        duin::PhysicsLayerTable table;
+        for (size_t i = table.GetObjectLayerCount(); i < duin::PhysicsLayerTable::MAX_LAYERS; ++i)
+        {
+            REQUIRE(table.AddObjectLayer("L" + std::to_string(i), "MOVING") != JPH::cObjectLayerInvalid);
+        }
+        CHECK(table.AddObjectLayer("ONE_TOO_MANY", "MOVING") == JPH::cObjectLayerInvalid);
+
+        JPH::ObjectLayer last = static_cast<JPH::ObjectLayer>(duin::PhysicsLayerTable::MAX_LAYERS - 1);
+        table.SetCollision(last, duin::Layers::MOVING, true);
+        CHECK(table.ShouldCollide(duin::Layers::MOVING, last));
+    }
+}
+
+TEST_SUITE("Physics - Config")
+{
+    TEST_CASE("FromConfig reads capacities and layers")
+    {
+        duin::ConfigValue project = duin::ConfigValue::Parse(R"(
+            [physics]
+            max_bodies = 32768
+            max_body_pairs = 65536
+            max_contact_constraints = 16384
+            temp_allocator_mb = 64
+            threads = 3
+            broadphase_layers = ["NON_MOVING", "MOVING", "DEBRIS", "SENSOR"]
+
+            [[physics.layers]]
+            name = "TRIGGER"
+            broadphase = "SENSOR"
+            collides_with = ["MOVING", "CHARACTER"]
+
+            [[physics.layers]]
+            name = "DEBRIS"
+            collides_with = ["NON_MOVING", "NOWHERE"]
+
+            [[physics.layers]]
+            name = "CHARACTER"
+            broadphase = "MOVING"
+        )");
+        duin::PhysicsConfig config = duin::PhysicsConfig::FromConfig(project.At("physics"));
+
+        CHECK(config.maxBodies == 32768);
+        CHECK(config.maxBodyPairs == 65536);
+        CHECK(config.maxContactConstraints == 16384);
+        CHECK(config.numBodyMutexes == 0);
+        CHECK(config.tempAllocatorSize == size_t(64) * 1024 * 1024);
+        CHECK(config.threadCount == 3);
+
+        const duin::PhysicsLayerTable &layers = config.layers;
+        CHECK(layers.GetObjectLayerCount() == 5);
+        CHECK(layers.GetBroadPhaseLayerCount() == 4);
+        JPH::ObjectLayer trigger = layers.FindObjectLayer("TRIGGER");
+        JPH::ObjectLayer debris = layers.FindObjectLayer("DEBRIS");
+        JPH::ObjectLayer character = layers.FindObjectLayer("CHARACTER");
+        REQUIRE(trigger != JPH::cObjectLayerInvalid);
+        REQUIRE(debris != JPH::cObjectLayerInvalid);
+        REQUIRE(character != JPH::cObjectLayerInvalid);
+
+        // Broadphase order follows broadphase_layers; a layer without one gets its own name.
+        CHECK(layers.GetBroadPhaseLayerName(layers.GetBroadPhaseLayer(trigger)) == "SENSOR");
+        CHECK(layers.GetBroadPhaseLayer(debris) == 2);
+        CHECK(layers.GetBroadPhaseLayer(character) == 1);
+
+        // collides_with may name layers declared later.
+        CHECK(layers.ShouldCollide(trigger, character));
+        CHECK(layers.ShouldCollide(trigger, duin::Layers::MOVING));
+        CHECK_FALSE(layers.ShouldCollide(trigger, debris));
+        CHECK(layers.ShouldCollide(debris, duin::Layers::NON_MOVING));
+        CHECK_FALSE(layers.ShouldCollide(character, duin::Layers::MOVING));
+    }
+
+    TEST_CASE("FromConfig keeps defaults for missing or invalid keys")
+    {
+        duin::PhysicsConfig defaults;
+        duin::PhysicsConfig config = duin::PhysicsConfig::FromConfig(duin::ConfigValue::Parse(R"(
+            max_bodies = -5
+            max_body_pairs = 0
+        )"));
+        CHECK(config.maxBodies == defaults.maxBodies);
+        CHECK(config.maxBodyPairs == defaults.maxBodyPairs);
+        CHECK(config.tempAllocatorSize == defaults.tempAllocatorSize);
+        CHECK(config.layers.GetObjectLayerCount() == 2);
+
+        duin::PhysicsConfig empty = duin::PhysicsConfig::FromConfig(duin::ConfigValue());
+        CHECK(empty.maxBodies == defaults.maxBodies);
+    }
+
+    TEST_CASE("Initialize rebuilds the server only while no bodies exist")
+    {
+        duin::PhysicsServer &server = duin::PhysicsServer::Get();
+
+        duin::PhysicsConfig config;
+        config.maxBodies = 4096;
+        JPH::ObjectLayer debris = config.layers.AddObjectLayer("DEBRIS", "DEBRIS");
+        config.layers.SetCollision(debris, duin::Layers::NON_MOVING, true);
+        REQUIRE(server.Initialize(config) == duin::SUCCESS);
+        CHECK(server.GetConfig().maxBodies == 4096);
+        CHECK(server.GetObjectLayer("DEBRIS") == debris);
+
+        JPH::BodyID body = server.CreateBody(duin::PxSphere{}, duin::PhysicsMotionType::Dynamic, {0.0f, 5.0f, 0.0f},
+                                             duin::QuaternionIdentity(), 0, debris);
+        REQUIRE_FALSE(body.IsInvalid());
+        CHECK(server.Initialize(duin::PhysicsConfig()) == duin::INIT_FAILED);
+        CHECK(server.GetConfig().maxBodies == 4096);
+
+        CHECK(server.CreateBody(duin::PxSphere{}, duin::PhysicsMotionType::Dynamic, {0.0f, 0.0f, 0.0f},
+                                duin::QuaternionIdentity(), 0, 99)
+                  .IsInvalid());
+
+        server.DestroyBody(body);
+        CHECK(server.Initialize(duin::PhysicsConfig()) == duin::SUCCESS);
+        CHECK(server.GetObjectLayer("DEBRIS") == JPH::cObjectLayerInvalid);
+    }
+}
+
+} // namespace TestPhysicsConfig
@@ -0,0 +1,115 @@
+#include "TestConfig.h"
+#include <doctest.h>
+#include <Duin/Physics/PhysicsIncludes.h>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace TestPhysicsContacts
+{
+
+static duin::PhysicsContactRecord Record(uint32_t body1, uint32_t body2)
+{
+    duin::PhysicsContactRecord record;
+    record.body1 = JPH::BodyID(body1);
+    record.body2 = JPH::BodyID(body2);
+    return record;
+}
+
+TEST_SUITE("Physics - Contact Queue")
+{
+    TEST_CASE("Records beyond the capacity overflow, then the queue grows")
+    {
+        duin::PhysicsContactQueue queue(4);
+        for (uint32_t i = 0; i < 6; ++i)
+        {
+            CHECK(queue.Push(Record(i, i + 1)) == (i < 4));
+        }
+        REQUIRE(queue.Pending().size() == 4);
+        CHECK(queue.Pending()[3].body1 == JPH::BodyID(3));
+        REQUIRE(queue.Overflow().size() == 2);
+        CHECK(queue.Overflow()[0].body1 == JPH::BodyID(4));
+        CHECK(queue.Overflow()[1].body1 == JPH::BodyID(5));
+
+        queue.Clear();
+        CHECK(queue.Pending().empty());
+        CHECK(queue.Overflow().empty());
+        CHECK(queue.GetCapacity() == 8);
+    }
+
+    TEST_CASE("Concurrent producers each get their own slot")
+    {
+        const uint32_t threads = 4;
+        const uint32_t perThread = 1000;
+        duin::PhysicsContactQueue queue(threads * perThread);
+
+        std::vector<std::thread> producers;
+        for (uint32_t t = 0; t < threads; ++t)
+        {
+            producers.emplace_back([&queue, t, perThread]() {
+                for (uint32_t i = 0; i < perThread; ++i)
+                {
+                    queue.Push(Record(t, i));
+                }
+            });
+        }
+        for (std::thread &producer : producers)
+        {
+            producer.join();
+        }
+
+        REQUIRE(queue.Pending().size() == threads * perThread);
+        std::vector<uint32_t> seen(threads * perThread, 0);
+        for (const duin::PhysicsContactRecord &record : queue.Pending())
+        {
+            ++seen[record.body1.GetIndexAndSequenceNumber() * perThread + record.body2.GetIndexAndSequenceNumber()];
+        }
+        bool eachOnce = true;
+        for (uint32_t count : seen)
+        {
+            eachOnce = eachOnce && count == 1;
+        }
+        CHECK(eachOnce);
+    }
+
+    TEST_CASE("Concurrent producers lose no record when the slots run out")
+    {
+        const uint32_t threads = 4;
+        const uint32_t perThread = 1000;
+        duin::PhysicsContactQueue queue(threads * perThread / 4);
+
+        std::vector<std::thread> producers;
+        for (uint32_t t = 0; t < threads; ++t)
+        {
+            producers.emplace_back([&queue, t, perThread]() {
+                for (uint32_t i = 0; i < perThread; ++i)
+                {
+                    queue.Push(Record(t, i));
+                }
+            });
+        }
+        for (std::thread &producer : producers)
+        {
+            producer.join();
+        }
+
+        REQUIRE(queue.Pending().size() + queue.Overflow().size() == threads * perThread);
+        std::vector<uint32_t> seen(threads * perThread, 0);
+        for (std::span<const duin::PhysicsContactRecord> records : {queue.Pending(), queue.Overflow()})
+        {
+            for (const duin::PhysicsContactRecord &record : records)
+            {
+                ++seen[record.body1.GetIndexAndSequenceNumber() * perThread +
+                       record.body2.GetIndexAndSequenceNumber()];
+            }
+        }
+        bool eachOnce = true;
+        for (uint32_t count : seen)
+        {
+            eachOnce = eachOnce && count == 1;
+        }
+        CHECK(eachOnce);
+    }
+}
+
+} // namespace TestPhysicsContacts
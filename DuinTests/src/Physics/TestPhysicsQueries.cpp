@@ -0,0 +1,150 @@
+#include "TestConfig.h"
+#include <doctest.h>
+#include <Duin/Physics/PhysicsIncludes.h>
+#include <vector>
+
+namespace TestPhysicsQueries
+{
+
+// Far from the origin so bodies other tests leave behind cannot be hit.
+static const duin::Vector3 ORIGIN = {500.0f, 0.0f, 500.0f};
+
+static duin::Vector3 At(float x, float y, float z)
+{
+    return {ORIGIN.x + x, ORIGIN.y + y, ORIGIN.z + z};
+}
+
+static JPH::BodyID CreateStaticBox(duin::Vector3 position, uint64_t userData = 0)
+{
+    duin::PxBox box;
+    box.sides = {2.0f, 2.0f, 2.0f};
+    return duin::PhysicsServer::Get().CreateBody(box, duin::PhysicsMotionType::Static, position,
+                                                 duin::QuaternionIdentity(), userData);
+}
+
+TEST_SUITE("Physics - Queries")
+{
+    TEST_CASE("CastRays reports the closest hit of each ray")
+    {
+        duin::PhysicsServer &server = duin::PhysicsServer::Get();
+        JPH::BodyID box = CreateStaticBox(At(0.0f, 0.0f, 0.0f), 42);
+        REQUIRE_FALSE(box.IsInvalid());
+
+        duin::PhysicsRay rays[2] = {{At(0.0f, 5.0f, 0.0f), {0.0f, -10.0f, 0.0f}},
+                                    {At(5.0f, 5.0f, 0.0f), {0.0f, -10.0f, 0.0f}}};
+        duin::PhysicsQueryHit hits[2];
+        CHECK(server.CastRays(rays, hits) == 1);
+
+        REQUIRE(hits[0].IsHit());
+        CHECK(hits[0].bodyID == box);
+        CHECK(hits[0].userData == 42);
+        CHECK(hits[0].fraction == doctest::Approx(0.4f).epsilon(0.01));
+        CHECK(hits[0].position.y == doctest::Approx(1.0f).epsilon(0.01));
+        CHECK(hits[0].normal.y == doctest::Approx(1.0f).epsilon(0.01));
+        CHECK_FALSE(hits[1].IsHit());
+
+        server.DestroyBody(box);
+    }
+
+    TEST_CASE("CastRays honours the query filter")
+    {
+        duin::PhysicsServer &server = duin::PhysicsServer::Get();
+        JPH::BodyID box = CreateStaticBox(At(0.0f, 0.0f, 0.0f));
+        REQUIRE_FALSE(box.IsInvalid());
+
+        duin::PhysicsRay ray = {At(0.0f, 5.0f, 0.0f), {0.0f, -10.0f, 0.0f}};
+        duin::PhysicsQueryHit hit;
+
+        duin::PhysicsQueryFilter ignoreBox;
+        ignoreBox.ignoreBody = box;
+        CHECK(server.CastRays({&ray, 1}, {&hit, 1}, ignoreBox) == 0);
+        CHECK_FALSE(hit.IsHit());
+
+        duin::PhysicsQueryFilter movingOnly;
+        movingOnly.objectLayers = uint64_t(1) << duin::Layers::MOVING;
+        CHECK(server.CastRays({&ray, 1}, {&hit, 1}, movingOnly) == 0);
+
+        duin::PhysicsQueryFilter staticOnly;
+        staticOnly.objectLayers = uint64_t(1) << duin::Layers::NON_MOVING;
+        CHECK(server.CastRays({&ray, 1}, {&hit, 1}, staticOnly) == 1);
+
+        server.DestroyBody(box);
+    }
+
+    TEST_CASE("Large ray batches keep every result in its own slot")
+    {
+        duin::PhysicsServer &server = duin::PhysicsServer::Get();
+        JPH::BodyID box = CreateStaticBox(At(0.0f, 0.0f, 0.0f));
+        REQUIRE_FALSE(box.IsInvalid());
+
+        const size_t count = 1000;
+        std::vector<duin::PhysicsRay> rays(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            rays[i] = {At(i % 2 == 0 ? 0.0f : 5.0f, 5.0f, 0.0f), {0.0f, -10.0f, 0.0f}};
+        }
+        // One more hit slot than rays: it must be left alone.
+        std::vector<duin::PhysicsQueryHit> hits(count + 1);
+        hits[count].fraction = 0.5f;
+
+        CHECK(server.CastRays(rays, hits) == count / 2);
+        bool slotsMatch = true;
+        for (size_t i = 0; i < count; ++i)
+        {
+            slotsMatch = slotsMatch && hits[i].IsHit() == (i % 2 == 0);
+        }
+        CHECK(slotsMatch);
+        CHECK(hits[count].fraction == 0.5f);
+
+        server.DestroyBody(box);
+    }
+
+    TEST_CASE("CastShapes sweeps a shape onto a body")
+    {
+        duin::PhysicsServer &server = duin::PhysicsServer::Get();
+        JPH::BodyID box = CreateStaticBox(At(0.0f, 0.0f, 0.0f), 7);
+        REQUIRE_FALSE(box.IsInvalid());
+
+        duin::PhysicsShapeCast casts[2];
+        casts[0].origin = At(0.0f, 5.0f, 0.0f);
+        casts[0].direction = {0.0f, -10.0f, 0.0f};
+        casts[1].origin = At(5.0f, 5.0f, 0.0f);
+        casts[1].direction = {0.0f, -10.0f, 0.0f};
+        duin::PhysicsQueryHit hits[2];
+
+        CHECK(server.CastShapes(duin::PxSphere{0.5f}, casts, hits) == 1);
+        REQUIRE(hits[0].IsHit());
+        CHECK(hits[0].userData == 7);
+        CHECK(hits[0].fraction == doctest::Approx(0.35f).epsilon(0.02));
+        CHECK(hits[0].normal.y > 0.9f);
+        CHECK_FALSE(hits[1].IsHit());
+
+        server.DestroyBody(box);
+    }
+
+    TEST_CASE("CollideAABB collects overlapping bodies up to the span size")
+    {
+        duin::PhysicsServer &server = duin::PhysicsServer::Get();
+        JPH::BodyID near = CreateStaticBox(At(0.0f, 0.0f, 0.0f));
+        JPH::BodyID far = CreateStaticBox(At(10.0f, 0.0f, 0.0f));
+        REQUIRE_FALSE(near.IsInvalid());
+        REQUIRE_FALSE(far.IsInvalid());
+
+        JPH::BodyID out[4];
+        REQUIRE(server.CollideAABB(At(-0.5f, -0.5f, -0.5f), At(0.5f, 0.5f, 0.5f), out) == 1);
+        CHECK(out[0] == near);
+
+        CHECK(server.CollideAABB(At(-2.0f, -2.0f, -2.0f), At(12.0f, 2.0f, 2.0f), out) == 2);
+        CHECK(server.CollideAABB(At(-2.0f, -2.0f, -2.0f), At(12.0f, 2.0f, 2.0f), {out, 1}) == 1);
+
+        duin::PhysicsQueryFilter ignoreNear;
+        ignoreNear.ignoreBody = near;
+        REQUIRE(server.CollideAABB(At(-2.0f, -2.0f, -2.0f), At(12.0f, 2.0f, 2.0f), out, ignoreNear) == 1);
+        CHECK(out[0] == far);
+
+        server.DestroyBody(near);
+        server.DestroyBody(far);
+    }
+}
+
+} // namespace TestPhysicsQueries
@@ -0,0 +1,137 @@
+#include "TestConfig.h"
+#include "Defines.h"
+#include <doctest.h>
+#include <Duin/Render/Culling.h>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+namespace TestCulling
+{
+
+// Camera at the origin looking down +Z, in the RHI (row-vector, left-handed) layout.
+static duin::Frustum MakeFrustum(bool homogeneousDepth)
+{
+    float view[16] = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+
+    const float nearPlane = 0.1f;
+    const float farPlane = 100.0f;
+    const float height = 1.0f / std::tan(30.0f * 3.14159265f / 180.0f); // 60 degree fovy
+    const float diff = farPlane - nearPlane;
+    const float aa = homogeneousDepth ? (farPlane + nearPlane) / diff : farPlane / diff;
+    const float bb = homogeneousDepth ? 2.0f * farPlane * nearPlane / diff : nearPlane * aa;
+    float proj[16] = {height, 0, 0, 0, 0, height, 0, 0, 0, 0, aa, 1, 0, 0, -bb, 0};
+
+    return duin::Frustum::FromViewProjection(view, proj);
+}
+
+struct Sphere
+{
+    duin::Vector3 center;
+    float radius;
+    bool visible;
+};
+
+static const std::vector<Sphere> SPHERES = {
+    {{0.0f, 0.0f, 10.0f}, 1.0f, true},    // straight ahead
+    {{0.0f, 0.0f, -10.0f}, 1.0f, false},  // behind
+    {{0.0f, 0.0f, 150.0f}, 1.0f, false},  // past the far plane
+    {{0.0f, 0.0f, 100.5f}, 1.0f, true},   // straddles the far plane
+    {{50.0f, 0.0f, 10.0f}, 1.0f, false},  // off to the right
+    {{6.5f, 0.0f, 10.0f}, 1.0f, true},    // straddles the right plane
+    {{0.0f, 20.0f, 10.0f}, 1.0f, false},  // above
+    {{0.0f, 0.0f, 50.0f}, 1.0f, true},    // far but inside
+    {{-3.0f, -3.0f, 20.0f}, 0.5f, true},  // tail lane
+};
+
+TEST_SUITE("Render - Culling")
+{
+    TEST_CASE("Sphere batches agree with the single-sphere test")
+    {
+        for (bool homogeneousDepth : {false, true})
+        {
+            duin::Frustum frustum = MakeFrustum(homogeneousDepth);
+            std::vector<float> x, y, z, r;
+            for (const Sphere &s : SPHERES)
+            {
+                x.push_back(s.center.x);
+                y.push_back(s.center.y);
+                z.push_back(s.center.z);
+                r.push_back(s.radius);
+            }
+
+            std::vector<uint8_t> visible(SPHERES.size());
+            size_t passed = duin::CullSpheres(frustum, duin::CullingParams{}, x.data(), y.data(), z.data(), r.data(),
+                                              SPHERES.size(), visible.data());
+
+            size_t expected = 0;
+            for (size_t i = 0; i < SPHERES.size(); ++i)
+            {
+                CAPTURE(i);
+                CHECK(frustum.TestSphere(SPHERES[i].center, SPHERES[i].radius) == SPHERES[i].visible);
+                CHECK((visible[i] != 0) == SPHERES[i].visible);
+                expected += SPHERES[i].visible ? 1 : 0;
+            }
+            CHECK(passed == expected);
+        }
+    }
+
+    TEST_CASE("Distance culling rejects far spheres")
+    {
+        duin::Frustum frustum = MakeFrustum(false);
+        float x[] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+        float y[] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+        float z[] = {10.0f, 19.5f, 21.5f, 40.0f, 90.0f};
+        float r[] = {1.0f, 1.0f, 1.0f, 1.0f, 1.0f};
+
+        duin::CullingParams params;
+        params.maxDistance = 20.0f;
+        uint8_t visible[5] = {};
+        CHECK(duin::CullSpheres(frustum, params, x, y, z, r, 5, visible) == 2);
+        CHECK(visible[0] == 1);
+        CHECK(visible[1] == 1);
+        CHECK(visible[2] == 0); // nearest point is 20.5 away
+        CHECK(visible[3] == 0);
+        CHECK(visible[4] == 0);
+    }
+
+    TEST_CASE("AABB batches agree with the single-box test")
+    {
+        duin::Frustum frustum = MakeFrustum(false);
+        std::srand(7);
+        for (size_t count : {size_t(3), size_t(64), size_t(257)})
+        {
+            std::vector<float> bounds[6];
+            for (size_t i = 0; i < count; ++i)
+            {
+                float cx = static_cast<float>(std::rand() % 200 - 100);
+                float cy = static_cast<float>(std::rand() % 200 - 100);
+                float cz = static_cast<float>(std::rand() % 200 - 100);
+                float e = static_cast<float>(std::rand() % 5) + 0.5f;
+                bounds[0].push_back(cx - e);
+                bounds[1].push_back(cy - e);
+                bounds[2].push_back(cz - e);
+                bounds[3].push_back(cx + e);
+                bounds[4].push_back(cy + e);
+                bounds[5].push_back(cz + e);
+            }
+
+            std::vector<uint8_t> visible(count);
+            size_t passed =
+                duin::CullAABBs(frustum, duin::CullingParams{}, bounds[0].data(), bounds[1].data(), bounds[2].data(),
+                                bounds[3].data(), bounds[4].data(), bounds[5].data(), count, visible.data());
+
+            size_t expected = 0;
+            for (size_t i = 0; i < count; ++i)
+            {
+                bool inside = frustum.TestAABB({bounds[0][i], bounds[1][i], bounds[2][i]},
+                                               {bounds[3][i], bounds[4][i], bounds[5][i]});
+                CHECK((visible[i] != 0) == inside);
+                expected += inside ? 1 : 0;
+            }
+            CHECK(passed == expected);
+        }
+    }
+}
+
+} // namespace TestCulling
@@ -0,0 +1,143 @@
+#include "TestConfig.h"
+#include "Defines.h"
+#include <doctest.h>
+#include <Duin/Render/RenderGeometry.h>
+#include <Duin/Render/RenderLOD.h>
+#include <cmath>
+#include <vector>
+
+namespace TestLOD
+{
+
+static std::vector<std::vector<uint16_t>> SphereChain()
+{
+    return duin::GenerateLODChain(duin::SphereRenderGeometry::GetIdentityVertices(),
+                                  duin::SphereRenderGeometry::VertSize(),
+                                  duin::SphereRenderGeometry::GetIdentityTriList(),
+                                  duin::SphereRenderGeometry::TriSize());
+}
+
+TEST_SUITE("Render - LOD")
+{
+    TEST_CASE("Sphere tessellation is closed and on the unit sphere")
+    {
+        const duin::PosColorVertex *vertices = duin::SphereRenderGeometry::GetIdentityVertices();
+        for (size_t i = 0; i < duin::SphereRenderGeometry::VertSize(); ++i)
+        {
+            float length = std::sqrt(vertices[i].x * vertices[i].x + vertices[i].y * vertices[i].y +
+                                     vertices[i].z * vertices[i].z);
+            CHECK(std::fabs(length - 1.0f) < 1e-4f);
+        }
+
+        // Every edge of a closed mesh is shared by exactly two triangles, once in each direction.
+        const uint16_t *indices = duin::SphereRenderGeometry::GetIdentityTriList();
+        std::vector<int> edges(duin::SphereRenderGeometry::VertSize() * duin::SphereRenderGeometry::VertSize(), 0);
+        for (size_t t = 0; t < duin::SphereRenderGeometry::TriSize(); t += 3)
+        {
+            for (size_t k = 0; k < 3; ++k)
+            {
+                uint16_t a = indices[t + k];
+                uint16_t b = indices[t + (k + 1) % 3];
+                ++edges[a * duin::SphereRenderGeometry::VertSize() + b];
+                --edges[b * duin::SphereRenderGeometry::VertSize() + a];
+            }
+        }
+        bool balanced = true;
+        for (int edge : edges)
+        {
+            balanced &= edge == 0;
+        }
+        CHECK(balanced);
+    }
+
+    TEST_CASE("LOD chain halves the triangle count per level")
+    {
+        std::vector<std::vector<uint16_t>> chain = SphereChain();
+        REQUIRE(chain.size() >= 3);
+        CHECK(chain[0].size() == duin::SphereRenderGeometry::TriSize());
+
+        for (size_t level = 1; level < chain.size(); ++level)
+        {
+            CHECK(chain[level].size() % 3 == 0);
+            CHECK(chain[level].size() <= chain[level - 1].size() / 2 + 2);
+            CHECK(chain[level].size() >= 4 * 3);
+            for (size_t i = 0; i < chain[level].size(); i += 3)
+            {
+                const uint16_t *tri = &chain[level][i];
+                CHECK(tri[0] < duin::SphereRenderGeometry::VertSize());
+                CHECK(tri[0] != tri[1]);
+                CHECK(tri[1] != tri[2]);
+                CHECK(tri[0] != tri[2]);
+            }
+        }
+    }
+
+    TEST_CASE("Geometry too small to simplify has a single level")
+    {
+        std::vector<std::vector<uint16_t>> chain = duin::GenerateLODChain(
+            duin::BoxRenderGeometry::GetIdentityVertices(), duin::BoxRenderGeometry::VertSize(),
+            duin::BoxRenderGeometry::GetIdentityTriList(), duin::BoxRenderGeometry::TriSize());
+        CHECK(chain.size() == 1);
+    }
+
+    TEST_CASE("Screen size falls off with distance")
+    {
+        const float projScale = 1.0f / std::tan(30.0f * 3.14159265f / 180.0f);
+        CHECK(duin::ComputeScreenSize(1.0f, 0.5f, projScale) == 1.0f);
+        float near = duin::ComputeScreenSize(1.0f, 10.0f, projScale);
+        float far = duin::ComputeScreenSize(1.0f, 20.0f, projScale);
+        CHECK(std::fabs(near - 2.0f * far) < 1e-6f);
+    }
+
+    TEST_CASE("Selection follows thresholds without history")
+    {
+        duin::LODSettings settings;
+        CHECK(duin::SelectLOD(0.5f, duin::LOD_NONE, 4, settings) == 0);
+        CHECK(duin::SelectLOD(0.2f, duin::LOD_NONE, 4, settings) == 1);
+        CHECK(duin::SelectLOD(0.05f, duin::LOD_NONE, 4, settings) == 2);
+        CHECK(duin::SelectLOD(0.01f, duin::LOD_NONE, 4, settings) == 3);
+        CHECK(duin::SelectLOD(0.01f, duin::LOD_NONE, 2, settings) == 1);
+        CHECK(duin::SelectLOD(0.01f, duin::LOD_NONE, 1, settings) == 0);
+    }
+
+    TEST_CASE("Hysteresis keeps the level near a threshold")
+    {
+        duin::LODSettings settings;
+        const float threshold = settings.thresholds[0];
+
+        // Just below the threshold: not far enough to leave level 0.
+        CHECK(duin::SelectLOD(threshold * 0.95f, 0, 4, settings) == 0);
+        CHECK(duin::SelectLOD(threshold * 0.8f, 0, 4, settings) == 1);
+        // Just above it: not far enough to come back.
+        CHECK(duin::SelectLOD(threshold * 1.05f, 1, 4, settings) == 1);
+        CHECK(duin::SelectLOD(threshold * 1.2f, 1, 4, settings) == 0);
+        // Large jumps cross several levels at once.
+        CHECK(duin::SelectLOD(0.001f, 0, 4, settings) == 3);
+        CHECK(duin::SelectLOD(0.9f, 3, 4, settings) == 0);
+    }
+
+    TEST_CASE("Selector remembers levels per key and forgets stale keys")
+    {
+        duin::LODSettings settings;
+        duin::LODSelector selector;
+        const float threshold = settings.thresholds[0];
+
+        CHECK(selector.Select(1, threshold * 1.05f, 4, settings) == 0);
+        CHECK(selector.Select(2, threshold * 0.8f, 4, settings) == 1);
+        selector.EndFrame();
+
+        // The same in-between size resolves differently depending on the history.
+        CHECK(selector.Select(1, threshold * 0.95f, 4, settings) == 0);
+        CHECK(selector.Select(2, threshold * 1.05f, 4, settings) == 1);
+        CHECK(selector.GetTrackedCount() == 2);
+
+        for (int frame = 0; frame < 4; ++frame)
+        {
+            selector.Select(1, threshold, 4, settings);
+            selector.EndFrame();
+        }
+        CHECK(selector.GetTrackedCount() == 1);
+    }
+}
+
+} // namespace TestLOD
@@ -0,0 +1,294 @@
+#include "TestConfig.h"
+#include "Defines.h"
+#include <doctest.h>
+#include <Duin/Assets/Mesh.h>
+#include <Duin/Render/Renderer.h>
+#include <Duin/Render/RHI.h>
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <vector>
+
+namespace TestRecordingRHI
+{
+
+// Starts the Noop-backed recording RHI and the renderer on top of it.
+struct RecordingRenderer
+{
+    RecordingRenderer()
+    {
+        duin::RHIStart(duin::RHI_VIEW_3D, 1280, 720, []() -> void * { return nullptr; }, true,
+                       duin::RHIBackend::Recording);
+        duin::InitRenderer();
+        duin::SetInstancedRendering(false); // most tests check the per-draw command stream
+        duin::RHIClearCommandStream();
+    }
+
+    ~RecordingRenderer()
+    {
+        duin::SetInstancedRendering(true);
+        duin::ResetRenderer();
+        duin::RHIClose();
+    }
+};
+
+// Program handles depend on which shader binaries exist on the machine, so golden text leaves them out.
+static std::string FormatWithoutPrograms(const duin::RHICommandStream &stream)
+{
+    duin::RHICommandStream copy = stream;
+    for (duin::RHICommand &command : copy.commands)
+    {
+        command.program = UINT16_MAX;
+    }
+    return duin::FormatRHICommandStream(copy);
+}
+
+TEST_SUITE("Render - Recording RHI")
+{
+    TEST_CASE("Renderer initialisation is captured")
+    {
+        duin::RHIStart(duin::RHI_VIEW_3D, 1280, 720, []() -> void * { return nullptr; }, true,
+                       duin::RHIBackend::Recording);
+        CHECK(duin::RHIIsRecording());
+        duin::InitRenderer();
+
+        // One vertex buffer per built-in geometry, one index buffer per LOD level.
+        size_t lodLevels = 0;
+        for (int type = 0; type < duin::RenderGeometryType::TRIANGLEMESH; ++type)
+        {
+            lodLevels += duin::GetGeometryLODCount(static_cast<duin::RenderGeometryType::Type>(type));
+        }
+        CHECK(lodLevels > duin::RenderGeometryType::TRIANGLEMESH);
+
+        const duin::RHICommandStream &stream = duin::RHIGetCommandStream();
+        CHECK(stream.Count(duin::RHICommandType::CreateVertexBuffer) == duin::RenderGeometryType::TRIANGLEMESH);
+        CHECK(stream.Count(duin::RHICommandType::CreateIndexBuffer) == lodLevels);
+
+        duin::ResetRenderer();
+        CHECK(stream.Count(duin::RHICommandType::DestroyVertexBuffer) == duin::RenderGeometryType::TRIANGLEMESH);
+        CHECK(stream.Count(duin::RHICommandType::DestroyIndexBuffer) == lodLevels);
+        duin::RHIClose();
+        CHECK_FALSE(duin::RHIIsRecording());
+    }
+
+    TEST_CASE("Golden command stream for a frame of boxes")
+    {
+        RecordingRenderer renderer;
+
+        duin::DrawBox(duin::Vector3(1.0f, 2.0f, 3.0f));
+        duin::DrawBox(duin::Vector3(-1.0f, 0.0f, 0.0f), duin::QuaternionIdentity(), duin::Vector3(2.0f, 2.0f, 2.0f));
+        duin::ExecuteRenderPipeline();
+
+        const std::string expected = "SetVertexBuffer handle=0\n"
+                                     "SetIndexBuffer handle=0\n"
+                                     "SetTransform [1.000 0.000 0.000 0.000 0.000 1.000 0.000 0.000 0.000 0.000 "
+                                     "1.000 0.000 1.000 2.000 3.000 1.000]\n"
+                                     "Submit\n"
+                                     "SetTransform [2.000 0.000 0.000 0.000 0.000 2.000 0.000 0.000 0.000 0.000 "
+                                     "2.000 0.000 -1.000 0.000 0.000 1.000]\n"
+                                     "Submit\n"
+                                     "Discard\n"
+                                     "Frame\n";
+        CHECK(FormatWithoutPrograms(duin::RHIGetCommandStream()) == expected);
+        CHECK(duin::GetRenderQueueStats().bufferBinds == 1);
+    }
+
+    TEST_CASE("A draw without a transform does not inherit the previous one")
+    {
+        RecordingRenderer renderer;
+
+        duin::DrawBox(duin::Vector3(1.0f, 2.0f, 3.0f));
+        duin::QueueRender(duin::RenderGeometryType::BOX);
+        duin::ExecuteRenderPipeline();
+
+        // Submits keep only the bound buffers; the untransformed draw sets the identity itself.
+        const duin::RHICommandStream &stream = duin::RHIGetCommandStream();
+        CHECK(stream.Count(duin::RHICommandType::Submit) == 2);
+        REQUIRE(stream.Count(duin::RHICommandType::SetTransform) == 2);
+        size_t identities = 0;
+        for (const duin::RHICommand &command : stream.commands)
+        {
+            if (command.type != duin::RHICommandType::SetTransform)
+            {
+                continue;
+            }
+            const float *mtx = stream.GetData(command);
+            REQUIRE(mtx != nullptr);
+            bool identity = true;
+            for (int i = 0; i < 16; ++i)
+            {
+                identity = identity && mtx[i] == (i % 5 == 0 ? 1.0f : 0.0f);
+            }
+            identities += identity ? 1 : 0;
+        }
+        CHECK(identities == 1);
+    }
+
+    TEST_CASE("Distant geometry is drawn at a lower LOD")
+    {
+        RecordingRenderer renderer;
+        REQUIRE(duin::GetGeometryLODCount(duin::RenderGeometryType::SPHERE) > 1);
+
+        duin::Camera camera(duin::UUID(1), duin::Vector3(0.0f, 0.0f, 0.0f), duin::Vector3(0.0f, 0.0f, 1.0f),
+                            duin::Vector3(0.0f, 1.0f, 0.0f), 60.0f);
+        duin::BeginDraw3D(camera);
+        duin::RHIClearCommandStream();
+        duin::DrawSphere(duin::Vector3(0.0f, 0.0f, 3.0f));
+        duin::DrawSphere(duin::Vector3(0.0f, 0.0f, 80.0f));
+        duin::ExecuteRenderPipeline();
+        duin::EndDraw3D();
+
+        const duin::RHICommandStream &stream = duin::RHIGetCommandStream();
+        CHECK(stream.Count(duin::RHICommandType::Submit) == 2);
+        CHECK(stream.Count(duin::RHICommandType::SetIndexBuffer) == 2);
+        CHECK(duin::GetRenderQueueStats().reducedLOD == 1);
+
+        // Without LOD both draws share the full-detail buffers.
+        duin::SetRenderLOD(false);
+        duin::BeginDraw3D(camera);
+        duin::RHIClearCommandStream();
+        duin::DrawSphere(duin::Vector3(0.0f, 0.0f, 3.0f));
+        duin::DrawSphere(duin::Vector3(0.0f, 0.0f, 80.0f));
+        duin::ExecuteRenderPipeline();
+        duin::EndDraw3D();
+        duin::SetRenderLOD(true);
+
+        CHECK(duin::RHIGetCommandStream().Count(duin::RHICommandType::SetIndexBuffer) == 1);
+        CHECK(duin::GetRenderQueueStats().reducedLOD == 0);
+    }
+
+    TEST_CASE("Objects keep their LOD history by id while they move")
+    {
+        RecordingRenderer renderer;
+        REQUIRE(duin::GetGeometryLODCount(duin::RenderGeometryType::SPHERE) > 1);
+
+        duin::Camera camera(duin::UUID(1), duin::Vector3(0.0f, 0.0f, 0.0f), duin::Vector3(0.0f, 0.0f, 1.0f),
+                            duin::Vector3(0.0f, 1.0f, 0.0f), 60.0f);
+        auto drawFrame = [&](float distance, uint64_t objectID) {
+            duin::BeginDraw3D(camera);
+            duin::QueueRender(duin::RenderGeometryType::SPHERE, duin::Vector3(0.0f, 0.0f, distance),
+                              duin::QuaternionIdentity(), duin::Vector3(1.0f, 1.0f, 1.0f), objectID);
+            duin::ExecuteRenderPipeline();
+            duin::EndDraw3D();
+            return duin::GetRenderQueueStats().reducedLOD;
+        };
+
+        // A unit sphere at 60 degrees crosses the first threshold (0.25) at about 6.93 units.
+        // 7.6 is past it; 6.6 is back over it but inside the hysteresis margin, two cells closer.
+        CHECK(drawFrame(7.6f, 42) == 1);
+        CHECK(drawFrame(6.6f, 42) == 1);
+
+        // Keyed by position cell, the moved sphere has no history and snaps back.
+        CHECK(drawFrame(7.6f, 0) == 1);
+        CHECK(drawFrame(6.6f, 0) == 0);
+    }
+
+    TEST_CASE("Same-type draws collapse into one instanced submit per view, LOD and type")
+    {
+        RecordingRenderer renderer;
+        duin::SetInstancedRendering(true);
+        // The Noop renderer gets placeholder engine shaders, so the instanced program always exists here.
+        REQUIRE(duin::IsInstancedRenderingActive());
+
+        auto instanceCounts = [](const duin::RHICommandStream &stream) {
+            std::vector<uint32_t> counts;
+            for (const duin::RHICommand &command : stream.commands)
+            {
+                if (command.type == duin::RHICommandType::SetInstanceData)
+                {
+                    counts.push_back(command.value);
+                }
+            }
+            std::sort(counts.begin(), counts.end());
+            return counts;
+        };
+
+        duin::RHIClearCommandStream();
+        for (int i = 0; i < 3; ++i)
+        {
+            duin::DrawBox(duin::Vector3(float(i), 0.0f, 0.0f));
+        }
+        duin::DrawSphere(duin::Vector3(0.0f, 2.0f, 0.0f));
+        duin::DrawSphere(duin::Vector3(1.0f, 2.0f, 0.0f));
+        duin::ExecuteRenderPipeline();
+
+        const duin::RHICommandStream &stream = duin::RHIGetCommandStream();
+        CHECK(stream.Count(duin::RHICommandType::Submit) == 2);
+        CHECK(stream.Count(duin::RHICommandType::SetTransform) == 0);
+        CHECK(instanceCounts(stream) == std::vector<uint32_t>{2, 3});
+        CHECK(duin::GetRenderQueueStats().instancedSubmits == 2);
+
+        // The same type at two LOD levels is two batches.
+        REQUIRE(duin::GetGeometryLODCount(duin::RenderGeometryType::SPHERE) > 1);
+        duin::Camera camera(duin::UUID(1), duin::Vector3(0.0f, 0.0f, 0.0f), duin::Vector3(0.0f, 0.0f, 1.0f),
+                            duin::Vector3(0.0f, 1.0f, 0.0f), 60.0f);
+        duin::BeginDraw3D(camera);
+        duin::RHIClearCommandStream();
+        duin::DrawSphere(duin::Vector3(0.0f, 0.0f, 3.0f));
+        duin::DrawSphere(duin::Vector3(0.5f, 0.0f, 3.0f));
+        duin::DrawSphere(duin::Vector3(0.0f, 0.0f, 80.0f));
+        duin::ExecuteRenderPipeline();
+        duin::EndDraw3D();
+
+        const duin::RHICommandStream &lodStream = duin::RHIGetCommandStream();
+        CHECK(lodStream.Count(duin::RHICommandType::Submit) == 2);
+        CHECK(instanceCounts(lodStream) == std::vector<uint32_t>{1, 2});
+        CHECK(duin::GetRenderQueueStats().instancedSubmits == 2);
+        CHECK(duin::GetRenderQueueStats().reducedLOD == 1);
+    }
+
+    TEST_CASE("Cooked meshes draw through the mesh program")
+    {
+        RecordingRenderer renderer;
+
+        duin::MeshData data;
+        for (duin::Vector3 position : {duin::Vector3(-1.0f, -1.0f, 0.0f), duin::Vector3(1.0f, -1.0f, 0.0f),
+                                       duin::Vector3(0.0f, 1.0f, 0.0f)})
+        {
+            duin::MeshVertex vertex;
+            vertex.position = position;
+            vertex.normal = duin::Vector3(0.0f, 0.0f, 1.0f);
+            data.vertices.push_back(vertex);
+        }
+        data.indices = {0, 1, 2};
+        {
+            duin::Mesh mesh(duin::CookedMesh::Cook(data, duin::UUID(7)));
+            REQUIRE(mesh.IsValid());
+            duin::RHIClearCommandStream();
+
+            duin::DrawMesh(mesh, duin::Vector3(0.0f, 0.0f, 0.0f));
+            duin::DrawMesh(mesh, duin::Vector3(2.0f, 0.0f, 0.0f));
+            duin::ExecuteRenderPipeline();
+
+            const duin::RHICommandStream &stream = duin::RHIGetCommandStream();
+            CHECK(duin::GetRenderQueueStats().meshCommands == 2);
+            CHECK(stream.Count(duin::RHICommandType::Submit) == 2);
+            CHECK(stream.Count(duin::RHICommandType::SetVertexBuffer) == 1);
+        }
+    }
+
+    TEST_CASE("ParallelDraw submits every element once")
+    {
+        RecordingRenderer renderer;
+
+        const size_t count = 1000;
+        std::atomic<size_t> drawn{0};
+        duin::ParallelDraw(count, 64, [&](duin::DrawEncoder &encoder, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                encoder.Draw(duin::RenderGeometryType::BOX, duin::Vector3(float(i), 0.0f, 0.0f),
+                             duin::QuaternionIdentity(), duin::Vector3(1.0f, 1.0f, 1.0f));
+            }
+            drawn += encoder.GetSubmitCount();
+        });
+        duin::RHIFrame();
+
+        const duin::RHICommandStream &stream = duin::RHIGetCommandStream();
+        CHECK(drawn == count);
+        CHECK(stream.Count(duin::RHICommandType::Submit) == count);
+        CHECK(stream.Count(duin::RHICommandType::SetTransform) == count);
+        CHECK(stream.Count(duin::RHICommandType::Frame) == 1);
+    }
+}
+
+} // namespace TestRecordingRHI
@@ -0,0 +1,86 @@
+#include "TestConfig.h"
+#include "Defines.h"
+#include <doctest.h>
+#include <Duin/Render/RenderCommand.h>
+#include <cstdint>
+#include <vector>
+
+namespace TestRenderCommand
+{
+
+static duin::RenderCommand Command(uint16_t view, uint16_t program, uint8_t geometry, float depth, uint32_t id)
+{
+    duin::RenderCommand cmd;
+    cmd.key = duin::MakeRenderCommandKey(view, program, geometry, depth);
+    cmd.transform = id; // stands in for the recording order
+    return cmd;
+}
+
+static std::vector<uint32_t> Order(const std::vector<duin::RenderCommand> &commands)
+{
+    std::vector<uint32_t> order;
+    for (const duin::RenderCommand &cmd : commands)
+    {
+        order.push_back(cmd.transform);
+    }
+    return order;
+}
+
+TEST_SUITE("Render - Command sort")
+{
+    TEST_CASE("Keys order by view, then program, then geometry, then depth")
+    {
+        std::vector<duin::RenderCommand> commands = {
+            Command(1, 0, 0, 0.0f, 0), // later view beats everything else
+            Command(0, 2, 0, 0.0f, 1), // later program
+            Command(0, 1, 9, 0.0f, 2), // later geometry
+            Command(0, 1, 3, 50.0f, 3),
+            Command(0, 1, 3, 0.5f, 4), // nearest
+        };
+        std::vector<duin::RenderCommand> scratch;
+        duin::SortRenderCommands(commands, scratch);
+
+        CHECK(Order(commands) == std::vector<uint32_t>{4, 3, 2, 1, 0});
+    }
+
+    TEST_CASE("Equal keys keep their recording order")
+    {
+        std::vector<duin::RenderCommand> commands;
+        for (uint32_t i = 0; i < 300; ++i)
+        {
+            // Two interleaved keys; the differing byte (geometry) forces a sort pass.
+            commands.push_back(Command(0, 1, i % 2 == 0 ? 5 : 4, 2.0f, i));
+        }
+        std::vector<duin::RenderCommand> scratch;
+        duin::SortRenderCommands(commands, scratch);
+
+        REQUIRE(commands.size() == 300);
+        bool stable = true;
+        for (size_t i = 1; i < commands.size(); ++i)
+        {
+            if (commands[i - 1].key == commands[i].key)
+            {
+                stable = stable && commands[i - 1].transform < commands[i].transform;
+            }
+            else
+            {
+                stable = stable && commands[i - 1].key < commands[i].key;
+            }
+        }
+        CHECK(stable);
+        CHECK(commands.front().transform == 1);
+        CHECK(commands[150].transform == 0);
+    }
+
+    TEST_CASE("Keys that share every byte are left in place")
+    {
+        std::vector<duin::RenderCommand> commands = {Command(0, 1, 4, 1.0f, 0), Command(0, 1, 4, 1.0f, 1),
+                                                     Command(0, 1, 4, 1.0f, 2)};
+        std::vector<duin::RenderCommand> scratch;
+        duin::SortRenderCommands(commands, scratch);
+
+        CHECK(Order(commands) == std::vector<uint32_t>{0, 1, 2});
+    }
+}
+
+} // namespace TestRenderCommand
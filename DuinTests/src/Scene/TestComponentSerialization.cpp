@@ -5,11 +5,26 @@
 #include <Duin/Core/Utils/UUID.h>
 #include <Duin/IO/JSONValue.h>
 #include <Duin/ECS/ECSModule.h>
+#include <Duin/ECS/ComponentSerializer.h>
+#include <Duin/IO/JSONGeneric.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+#include <cstdint>
+#include <string>
 #include <vector>
 
 namespace TestSceneBuilder
 {
 
+// References another entity by UUID, the way gameplay components do.
+struct EntityRef
+{
+    duin::UUID target;
+};
+
+static const uint64_t HIGH_BIT_UUID = 0xF000000000000001ull;
+static const char *HIGH_BIT_UUID_TEXT = "17293822569102704641";
+
 TEST_SUITE("Component Serialization")
 {
     TEST_CASE("Deserialize Component")
@@ -27,7 +42,7 @@ TEST_SUITE("Component Serialization")
 
         duin::PackedComponent p = sb.DeserializeComponent(v);
 
-        CHECK(p.jsonData == normalizedJsonStr);
+        CHECK(p.ToJSON() == normalizedJsonStr);
     }
 
     TEST_CASE("Serialize Component")
@@ -103,6 +118,123 @@ TEST_SUITE("Component Instantiation")
         CHECK(e.GetMut<Vec3>() == Vec3{1.0f, 2.0f, 3.0f});
         CHECK(e.GetMut<Camera>() == Camera{3.0f, 2.0f, 4.0f, true});
     }
+
+    TEST_CASE("Serialize Component into a rapidjson writer")
+    {
+        duin::World world;
+        world.Component<Vec3>();
+        Vec3 v{1.0f, 2.0f, 3.0f};
+
+        rapidjson::StringBuffer buffer;
+        rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+        std::string structName;
+        REQUIRE(duin::ComponentSerializer::Get().Serialize("Vec3", &v, writer, &structName));
+
+        CHECK(std::string(buffer.GetString(), buffer.GetSize()) == duin::ComponentSerializer::Get().Serialize("Vec3", &v));
+        CHECK(structName == "Vec3");
+
+        rapidjson::StringBuffer unknownBuffer;
+        rapidjson::Writer<rapidjson::StringBuffer> unknownWriter(unknownBuffer);
+        CHECK_FALSE(duin::ComponentSerializer::Get().Serialize("NotAComponent", &v, unknownWriter));
+    }
+
+    TEST_CASE("Serialize Component into a JSONValue node")
+    {
+        duin::World world;
+        world.Component<Camera>();
+        Camera cam{45.0f, 0.5f, 100.0f, true};
+
+        duin::JSONValue root;
+        duin::JSONValue node;
+        REQUIRE(duin::ComponentSerializer::Get().Serialize("Camera", &cam, node));
+        root.AddMember("camera", node);
+
+        duin::JSONValue out = duin::JSONValue::Parse(root.Write());
+        CHECK(out["camera"]["type"].GetString() == "Camera");
+        CHECK(out["camera"]["fov"].GetDouble() == doctest::Approx(45.0));
+        CHECK(out["camera"]["isPrimary"].GetBool());
+    }
+
+    TEST_CASE("Deserialize Component from a rapidjson value")
+    {
+        duin::World world;
+        world.Component<Vec3>();
+        world.Component<Camera>();
+        duin::JSONValue json = duin::JSONValue::Parse(
+            R"({"vec":{"type":"Vec3","x":1.0,"y":2.0,"z":3.0},"cam":{"type":"Camera","fov":3.0,"nearPlane":2.0,"farPlane":4.0,"isPrimary":true}})");
+
+        duin::Entity e = world.Entity();
+        CHECK(duin::ComponentSerializer::Get().Deserialize(e, "Vec3", json["vec"].GetRJSONValue()));
+        CHECK(duin::ComponentSerializer::Get().Deserialize(e, "Camera", json["cam"].GetRJSONValue()));
+        CHECK(e.GetMut<Vec3>() == Vec3{1.0f, 2.0f, 3.0f});
+        CHECK(e.GetMut<Camera>() == Camera{3.0f, 2.0f, 4.0f, true});
+
+        CHECK_FALSE(duin::ComponentSerializer::Get().Deserialize(e, "NotAComponent", json["vec"].GetRJSONValue()));
+    }
+
+    TEST_CASE("Unsigned values above INT64_MAX are read from a rapidjson value exactly")
+    {
+        rapidjson::Document doc;
+        doc.Parse(R"({"uuid":17293822569102704641})");
+        REQUIRE_FALSE(doc.HasParseError());
+
+        auto result = rfl::from_generic<duin::UUID::ReflectionType>(duin::JSONToGeneric(doc));
+        REQUIRE(result);
+        CHECK(result.value().uuid == HIGH_BIT_UUID);
+    }
+
+    TEST_CASE("Unsigned values above INT64_MAX are written exactly")
+    {
+        duin::World world;
+        world.Component<EntityRef>();
+        EntityRef ref{duin::UUID(HIGH_BIT_UUID)};
+
+        rapidjson::StringBuffer buffer;
+        rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+        REQUIRE(duin::ComponentSerializer::Get().Serialize("EntityRef", &ref, writer));
+        CHECK(std::string(buffer.GetString(), buffer.GetSize()).find(HIGH_BIT_UUID_TEXT) != std::string::npos);
+
+        duin::JSONValue node;
+        REQUIRE(duin::ComponentSerializer::Get().Serialize("EntityRef", &ref, node));
+        CHECK(node.Write().find(HIGH_BIT_UUID_TEXT) != std::string::npos);
+    }
+
+    TEST_CASE("A high-bit UUID survives pack, JSON scene and instantiation")
+    {
+        duin::World world;
+        world.Component<EntityRef>();
+        duin::SceneBuilder sb;
+        duin::Entity e = world.Entity().Set<EntityRef>(EntityRef{duin::UUID(HIGH_BIT_UUID)});
+
+        duin::PackedScene scene;
+        scene.entities.push_back(sb.PackEntity(e));
+        REQUIRE(scene.entities[0].components.size() == 1);
+        const duin::PackedComponent &packed = scene.entities[0].components[0];
+        CHECK(packed.componentTypeName == "EntityRef");
+        CHECK(packed.jsonData == rfl::json::write<rfl::AddStructName<"type">>(EntityRef{duin::UUID(HIGH_BIT_UUID)}));
+        CHECK(packed.jsonData.find(HIGH_BIT_UUID_TEXT) != std::string::npos);
+
+        std::string sceneText = sb.SerializeScene(scene).Write();
+        CHECK(sceneText.find(HIGH_BIT_UUID_TEXT) != std::string::npos);
+
+        duin::PackedScene loaded = sb.DeserializeScene(duin::JSONValue::Parse(sceneText));
+        REQUIRE(loaded.entities.size() == 1);
+        REQUIRE(loaded.entities[0].components.size() == 1);
+        const duin::PackedComponent &node = loaded.entities[0].components[0];
+        CHECK(node.jsonNode.has_value());
+        CHECK(node.ToJSON().find(HIGH_BIT_UUID_TEXT) != std::string::npos);
+
+        // Per-entity path
+        duin::Entity single = world.Entity();
+        sb.InstantiateComponent(node, single);
+        CHECK(single.GetMut<EntityRef>().target == duin::UUID(HIGH_BIT_UUID));
+
+        // Staged path
+        duin::World world2;
+        world2.Component<EntityRef>();
+        duin::Entity root = sb.InstantiateScene(loaded, &world2);
+        CHECK(root.GetMut<EntityRef>().target == duin::UUID(HIGH_BIT_UUID));
+    }
 }
 
 } // namespace TestSceneBuilder
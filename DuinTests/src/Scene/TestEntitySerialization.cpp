@@ -38,7 +38,7 @@ TEST_SUITE("Simple Entity Serialization")
 
             // Check first component (Transform)
             CHECK(p.components[txIdx].componentTypeName == "Transform");
-            duin::JSONValue comp0 = duin::JSONValue::Parse(p.components[txIdx].jsonData);
+            duin::JSONValue comp0 = duin::JSONValue::Parse(p.components[txIdx].ToJSON());
             CHECK(comp0.HasMember("type"));
             CHECK(comp0["type"].GetString() == "Transform");
             CHECK(comp0.HasMember("position"));
@@ -48,7 +48,7 @@ TEST_SUITE("Simple Entity Serialization")
 
             // Check second component (Camera)
             CHECK(p.components[cmIdx].componentTypeName == "Camera");
-            duin::JSONValue comp1 = duin::JSONValue::Parse(p.components[cmIdx].jsonData);
+            duin::JSONValue comp1 = duin::JSONValue::Parse(p.components[cmIdx].ToJSON());
             CHECK(comp1.HasMember("type"));
             CHECK(comp1["type"].GetString() == "Camera");
             CHECK(comp1["fov"].GetDouble() == doctest::Approx(75.0));
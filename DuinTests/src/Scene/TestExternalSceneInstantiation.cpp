@@ -692,6 +692,59 @@ TEST_SUITE("External Scene Instantiation")
         duin::fs::RemovePath(leafPath);
         duin::fs::RemovePath(middlePath);
     }
+
+    TEST_CASE("Pairs on an instanceOf entity are added after its external scene")
+    {
+        std::string playerPath = WritePlayerSceneToDisk();
+
+        duin::PackedScene scene;
+        scene.name = "InstancePairs";
+
+        duin::PackedEntity enemy;
+        enemy.uuid = duin::UUID();
+        enemy.name = "Enemy";
+        enemy.enabled = true;
+
+        duin::PackedEntity player;
+        player.uuid = duin::UUID();
+        player.name = "Player";
+        player.enabled = true;
+        player.instanceOf = duin::PackedExternalDependency(playerPath);
+
+        // Only resolvable once the external scene has created Player's children.
+        duin::PackedPair watchesCamera;
+        watchesCamera.relationshipName = "Watches";
+        watchesCamera.targetName = "Player::CameraRoot";
+        player.pairs.push_back(watchesCamera);
+
+        // Resolved through this scene's UUID map, which the external scene must not disturb.
+        duin::PackedPair watchesEnemy;
+        watchesEnemy.relationshipName = "Watches";
+        watchesEnemy.targetName = "Enemy";
+        watchesEnemy.targetUUID = enemy.uuid;
+        player.pairs.push_back(watchesEnemy);
+
+        scene.entities.push_back(enemy);
+        scene.entities.push_back(player);
+
+        duin::World world;
+        duin::Entity watches = world.Entity("Watches");
+
+        duin::SceneBuilder sb;
+        sb.InstantiateScene(scene, &world);
+
+        duin::Entity playerEntity = world.Lookup("Player");
+        REQUIRE(playerEntity.IsValid());
+        duin::Entity cameraRoot = playerEntity.Lookup("CameraRoot");
+        REQUIRE(cameraRoot.IsValid());
+        duin::Entity enemyEntity = world.Lookup("Enemy");
+        REQUIRE(enemyEntity.IsValid());
+
+        CHECK(playerEntity.Has(watches, cameraRoot));
+        CHECK(playerEntity.Has(watches, enemyEntity));
+
+        duin::fs::RemovePath(playerPath);
+    }
 }
 
 } // namespace TestSceneBuilder
@@ -0,0 +1,239 @@
+#include "TestConfig.h"
+#include "TestSceneBuilderCommon.h"
+#include <doctest.h>
+#include <Duin/Scene/SceneBuilder.h>
+#include <Duin/Core/Utils/UUID.h>
+#include <Duin/IO/JSONValue.h>
+#include <Duin/ECS/ECSModule.h>
+#include "Defines.h"
+
+#include <cstring>
+
+namespace TestSceneBuilder
+{
+
+static std::string BinaryBaseName(const std::string &name)
+{
+    auto pos = name.find('#');
+    return pos != std::string::npos ? name.substr(0, pos) : name;
+}
+
+static duin::PackedComponent MakeComponent(const std::string &type, const std::string &json)
+{
+    duin::PackedComponent pc;
+    pc.componentTypeName = type;
+    pc.jsonData = json;
+    return pc;
+}
+
+static duin::PackedScene MakeBinaryTestScene()
+{
+    duin::PackedScene scene;
+    scene.uuid = duin::UUID::FromStringHex("b1a2c3d4e5f60708");
+    scene.name = "BinaryScene";
+    scene.metadata.editorVersion = "1.0";
+    scene.metadata.engineVersion = "0.1.0";
+    scene.metadata.author = "DuinEditor";
+
+    duin::PackedEntity root;
+    root.uuid = duin::UUID::FromStringHex("1000");
+    root.name = "Root";
+    root.enabled = true;
+    root.components.push_back(MakeComponent("Vec3", R"({"type":"Vec3","x":1.0,"y":2.0,"z":3.0})"));
+    root.tags.push_back(MakeComponent("TAG_Main", R"({"type":"TAG_Main"})"));
+
+    duin::PackedEntity child;
+    child.uuid = duin::UUID::FromStringHex("2000");
+    child.name = "Child";
+    child.enabled = false;
+    child.components.push_back(MakeComponent("Vec3", R"({"type":"Vec3","x":4.0,"y":5.0,"z":6.0})"));
+    child.components.push_back(MakeComponent("Camera", R"({"type":"Camera","fov":60.0})"));
+
+    duin::PackedPair pair;
+    pair.relationshipName = "Likes";
+    pair.relationshipIsComponent = true;
+    pair.relationshipPath = "::TestSceneBuilder::Likes";
+    pair.targetName = "Root";
+    pair.targetUUID = root.uuid;
+    child.pairs.push_back(pair);
+
+    duin::PackedEntity grandChild;
+    grandChild.uuid = duin::UUID::FromStringHex("3000");
+    grandChild.name = "GrandChild";
+    grandChild.enabled = true;
+    grandChild.instanceOf = duin::AssetRef("res://scenes/prop.scn");
+    child.children.push_back(grandChild);
+    root.children.push_back(child);
+
+    duin::PackedEntity second;
+    second.uuid = duin::UUID::FromStringHex("4000");
+    second.name = "Second";
+    second.enabled = true;
+
+    scene.entities.push_back(root);
+    scene.entities.push_back(second);
+    return scene;
+}
+
+TEST_SUITE("SceneBuilder - Binary PackedScene")
+{
+    TEST_CASE("Binary round trip preserves the packed scene")
+    {
+        duin::SceneBuilder builder;
+        duin::PackedScene scene = MakeBinaryTestScene();
+
+        std::vector<uint8_t> bytes = builder.SerializeSceneBinary(scene);
+        REQUIRE(duin::SceneBuilder::IsSceneBinary(bytes.data(), bytes.size()));
+
+        duin::PackedScene out = builder.DeserializeSceneBinary(bytes.data(), bytes.size());
+        CHECK(out.uuid == scene.uuid);
+        CHECK(out.name == "BinaryScene");
+        CHECK(out.metadata.author == "DuinEditor");
+        CHECK(out.metadata.lastModified.empty());
+        REQUIRE(out.entities.size() == 2);
+
+        const duin::PackedEntity &root = out.entities[0];
+        CHECK(root.uuid == duin::UUID::FromStringHex("1000"));
+        CHECK(root.enabled);
+        REQUIRE(root.components.size() == 1);
+        CHECK(root.components[0].componentTypeName == "Vec3");
+        CHECK(root.components[0].jsonData == scene.entities[0].components[0].jsonData);
+        REQUIRE(root.tags.size() == 1);
+        CHECK(root.tags[0].componentTypeName == "TAG_Main");
+
+        REQUIRE(root.children.size() == 1);
+        const duin::PackedEntity &child = root.children[0];
+        CHECK(child.name == "Child");
+        CHECK_FALSE(child.enabled);
+        REQUIRE(child.components.size() == 2);
+        CHECK(child.components[0].componentTypeName == "Vec3"); // pack order is kept
+        CHECK(child.components[1].componentTypeName == "Camera");
+        REQUIRE(child.pairs.size() == 1);
+        CHECK(child.pairs[0].targetUUID == root.uuid);
+        CHECK(child.pairs[0].relationshipIsComponent);
+        CHECK(child.pairs[0].relationshipPath == "::TestSceneBuilder::Likes");
+
+        REQUIRE(child.children.size() == 1);
+        REQUIRE(child.children[0].instanceOf.has_value());
+        CHECK(child.children[0].instanceOf->rPath == "res://scenes/prop.scn");
+        CHECK(out.entities[1].name == "Second");
+    }
+
+    TEST_CASE("Binary and JSON serializations describe the same scene")
+    {
+        duin::SceneBuilder builder;
+        duin::PackedScene scene = MakeBinaryTestScene();
+
+        std::vector<uint8_t> bytes = builder.SerializeSceneBinary(scene);
+        duin::PackedScene fromBinary = builder.DeserializeSceneBinary(bytes.data(), bytes.size());
+
+        CHECK(builder.SerializeScene(fromBinary).Write() == builder.SerializeScene(scene).Write());
+    }
+
+    TEST_CASE("Binary loader accepts an unaligned buffer")
+    {
+        duin::SceneBuilder builder;
+        std::vector<uint8_t> bytes = builder.SerializeSceneBinary(MakeBinaryTestScene());
+
+        std::vector<uint8_t> shifted(bytes.size() + 1);
+        std::memcpy(shifted.data() + 1, bytes.data(), bytes.size());
+        duin::PackedScene out = builder.DeserializeSceneBinary(shifted.data() + 1, bytes.size());
+        CHECK(out.entities.size() == 2);
+    }
+
+    TEST_CASE("Truncated, foreign or future-version data yields an empty scene")
+    {
+        duin::SceneBuilder builder;
+        std::vector<uint8_t> bytes = builder.SerializeSceneBinary(MakeBinaryTestScene());
+
+        for (size_t size : {size_t(0), size_t(16), bytes.size() / 2, bytes.size() - 1})
+        {
+            CHECK(builder.DeserializeSceneBinary(bytes.data(), size).entities.empty());
+        }
+
+        std::string json = R"({"sceneName":"x"})";
+        CHECK_FALSE(duin::SceneBuilder::IsSceneBinary(json.data(), json.size()));
+
+        std::vector<uint8_t> future = bytes;
+        uint32_t version = duin::PackedScene::BINARY_VERSION + 1;
+        std::memcpy(future.data() + 4, &version, sizeof(version));
+        CHECK(builder.DeserializeSceneBinary(future.data(), future.size()).entities.empty());
+    }
+
+    TEST_CASE("A type blob range that wraps around is rejected")
+    {
+        duin::SceneBuilder builder;
+        std::vector<uint8_t> bytes = builder.SerializeSceneBinary(MakeBinaryTestScene());
+
+        // typesOffset follows the magic, version, scene UUID, five string refs, six counts and entitiesOffset.
+        uint64_t typesOffset = 0;
+        std::memcpy(&typesOffset, bytes.data() + 88, sizeof(typesOffset));
+        REQUIRE(typesOffset + 24 <= bytes.size());
+
+        // The first type's blobOffset and blobSize sum past 2^64 back to 8.
+        uint64_t blobOffset = ~uint64_t(0) - 7;
+        uint64_t blobSize = 16;
+        std::memcpy(bytes.data() + typesOffset + 8, &blobOffset, sizeof(blobOffset));
+        std::memcpy(bytes.data() + typesOffset + 16, &blobSize, sizeof(blobSize));
+        CHECK(builder.DeserializeSceneBinary(bytes.data(), bytes.size()).entities.empty());
+    }
+
+    TEST_CASE("Entity nesting is capped at BINARY_MAX_DEPTH")
+    {
+        duin::SceneBuilder builder;
+        auto chain = [](uint32_t depth) {
+            duin::PackedScene scene;
+            scene.name = "Chain";
+            duin::PackedEntity entity;
+            entity.name = "Leaf";
+            for (uint32_t i = 1; i < depth; ++i)
+            {
+                duin::PackedEntity parent;
+                parent.name = "Level";
+                parent.children.push_back(std::move(entity));
+                entity = std::move(parent);
+            }
+            scene.entities.push_back(std::move(entity));
+            return scene;
+        };
+
+        std::vector<uint8_t> atLimit = builder.SerializeSceneBinary(chain(duin::PackedScene::BINARY_MAX_DEPTH));
+        CHECK(builder.DeserializeSceneBinary(atLimit.data(), atLimit.size()).entities.size() == 1);
+
+        std::vector<uint8_t> tooDeep = builder.SerializeSceneBinary(chain(duin::PackedScene::BINARY_MAX_DEPTH + 1));
+        CHECK(builder.DeserializeSceneBinary(tooDeep.data(), tooDeep.size()).entities.empty());
+    }
+
+    TEST_CASE("Pack -> binary -> Instantiate")
+    {
+        duin::World world;
+        world.Component<Vec3>();
+        world.Component<Camera>();
+
+        duin::Entity obj = world.Entity("Object").Set<Vec3>(3.0f, 6.0f, 9.0f).Set<Camera>(45.0f, 0.5f, 100.0f, false);
+        world.Entity("Child").ChildOf(obj).Set<Vec3>(1.0f, 1.0f, 1.0f);
+
+        duin::SceneBuilder builder;
+        duin::PackedScene ps = builder.PackScene({obj});
+        std::vector<uint8_t> bytes = builder.SerializeSceneBinary(ps);
+        duin::PackedScene loaded = builder.DeserializeSceneBinary(bytes.data(), bytes.size());
+
+        duin::World world2;
+        world2.Component<Vec3>();
+        world2.Component<Camera>();
+        duin::SceneBuilder builder2;
+        builder2.InstantiateScene(loaded, &world2);
+
+        std::vector<duin::Entity> roots = world2.GetChildren();
+        REQUIRE(roots.size() == 1);
+        CHECK(BinaryBaseName(roots[0].GetName()) == "Object");
+        CHECK(roots[0].GetMut<Vec3>() == Vec3{3.0f, 6.0f, 9.0f});
+        CHECK(roots[0].GetMut<Camera>() == Camera{45.0f, 0.5f, 100.0f, false});
+
+        std::vector<duin::Entity> children = roots[0].GetChildren();
+        REQUIRE(children.size() == 1);
+        CHECK(children[0].GetMut<Vec3>() == Vec3{1.0f, 1.0f, 1.0f});
+    }
+}
+
+} // namespace TestSceneBuilder
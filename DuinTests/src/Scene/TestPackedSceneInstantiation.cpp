@@ -133,6 +133,82 @@ TEST_SUITE("PackedScene Pack and Instantiate")
         CHECK(restoredEnemy->Has<Vec3>());
         CHECK(restoredEnemy->GetMut<Vec3>() == Vec3{10.0f, 0.0f, 10.0f});
     }
+
+    TEST_CASE("Bulk instantiation of many entities with mixed archetypes")
+    {
+        duin::PackedScene scene;
+        duin::PackedEntity root;
+        root.uuid = duin::UUID::FromStringHex("5000");
+        root.name = "Spawner";
+        root.enabled = true;
+
+        const int count = 600;
+        for (int i = 0; i < count; ++i)
+        {
+            duin::PackedEntity child;
+            child.uuid = duin::UUID(0x6000 + i);
+            child.name = "Item" + std::to_string(i);
+            child.enabled = i % 5 != 0;
+            duin::PackedComponent pos;
+            pos.componentTypeName = "Vec3";
+            pos.jsonData = "{\"type\":\"Vec3\",\"x\":" + std::to_string(i) + ".0,\"y\":1.0,\"z\":2.0}";
+            child.components.push_back(pos);
+            if (i % 3 == 0)
+            {
+                duin::PackedComponent cam;
+                cam.componentTypeName = "Camera";
+                cam.jsonData = R"({"type":"Camera","fov":70.0,"nearPlane":0.1,"farPlane":50.0,"isPrimary":false})";
+                child.components.push_back(cam);
+            }
+            root.children.push_back(child);
+        }
+        scene.entities.push_back(root);
+
+        duin::World world;
+        world.Component<Vec3>();
+        world.Component<Camera>();
+        duin::SceneBuilder builder;
+        duin::Entity spawner = builder.InstantiateScene(scene, &world);
+        REQUIRE(spawner.IsValid());
+        CHECK(spawner.GetName() == "Spawner");
+
+        std::vector<duin::Entity> children = spawner.GetChildren();
+        REQUIRE(children.size() == count);
+        for (duin::Entity &child : children)
+        {
+            std::string name = child.GetName();
+            REQUIRE(name.rfind("Item", 0) == 0);
+            int i = std::stoi(name.substr(4));
+            CHECK(child.GetMut<Vec3>() == Vec3{static_cast<float>(i), 1.0f, 2.0f});
+            CHECK(child.Has<Camera>() == (i % 3 == 0));
+            CHECK(child.GetFlecsEntity().has(flecs::Disabled) == (i % 5 == 0));
+        }
+    }
+
+    TEST_CASE("Bulk instantiation suffixes duplicate sibling names")
+    {
+        duin::PackedScene scene;
+        duin::PackedEntity root;
+        root.name = "Parent";
+        root.enabled = true;
+        for (int i = 0; i < 2; ++i)
+        {
+            duin::PackedEntity child;
+            child.uuid = duin::UUID(0x7000 + i);
+            child.name = "Twin";
+            child.enabled = true;
+            root.children.push_back(child);
+        }
+        scene.entities.push_back(root);
+
+        duin::World world;
+        duin::SceneBuilder builder;
+        duin::Entity parent = builder.InstantiateScene(scene, &world);
+
+        std::vector<duin::Entity> children = parent.GetChildren();
+        REQUIRE(children.size() == 2);
+        CHECK(children[0].GetName() != children[1].GetName());
+    }
 }
 
 } // namespace TestSceneBuilder
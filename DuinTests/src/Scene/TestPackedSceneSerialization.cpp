@@ -329,7 +329,7 @@ TEST_SUITE("SceneBuilder - PackedScene Deserialization")
             {
                 CHECK(scene.entities[0].components[0].componentTypeName == "Transform");
 
-                duin::JSONValue compData = duin::JSONValue::Parse(scene.entities[0].components[0].jsonData);
+                duin::JSONValue compData = duin::JSONValue::Parse(scene.entities[0].components[0].ToJSON());
                 CHECK(compData["type"].GetString() == "Transform");
                 CHECK(compData.HasMember("position"));
             }
@@ -598,8 +598,8 @@ TEST_SUITE("SceneBuilder - Round-trip Serialization")
                 CHECK(original.entities[0].components[0].componentTypeName ==
                       deserialized.entities[0].components[0].componentTypeName);
 
-                duin::JSONValue origComp = duin::JSONValue::Parse(original.entities[0].components[0].jsonData);
-                duin::JSONValue deserComp = duin::JSONValue::Parse(deserialized.entities[0].components[0].jsonData);
+                duin::JSONValue origComp = duin::JSONValue::Parse(original.entities[0].components[0].ToJSON());
+                duin::JSONValue deserComp = duin::JSONValue::Parse(deserialized.entities[0].components[0].ToJSON());
                 CHECK(origComp["type"].GetString() == deserComp["type"].GetString());
                 CHECK(origComp["position"]["x"].GetDouble() == doctest::Approx(deserComp["position"]["x"].GetDouble()));
             }
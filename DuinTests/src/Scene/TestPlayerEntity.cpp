@@ -167,35 +167,35 @@ TEST_SUITE("Complex Player Entity Tests")
             if (comp.componentTypeName == "Mass")
             {
                 foundMass = true;
-                duin::JSONValue json = duin::JSONValue::Parse(comp.jsonData);
+                duin::JSONValue json = duin::JSONValue::Parse(comp.ToJSON());
                 CHECK(json.HasMember("value"));
                 CHECK(json["value"].GetDouble() == doctest::Approx(80.0));
             }
             else if (comp.componentTypeName == "CanRunComponent")
             {
                 foundCanRun = true;
-                duin::JSONValue json = duin::JSONValue::Parse(comp.jsonData);
+                duin::JSONValue json = duin::JSONValue::Parse(comp.ToJSON());
                 CHECK(json.HasMember("speed"));
                 CHECK(json["speed"].GetDouble() == doctest::Approx(10.0));
             }
             else if (comp.componentTypeName == "CanSprintComponent")
             {
                 foundCanSprint = true;
-                duin::JSONValue json = duin::JSONValue::Parse(comp.jsonData);
+                duin::JSONValue json = duin::JSONValue::Parse(comp.ToJSON());
                 CHECK(json.HasMember("speed"));
                 CHECK(json["speed"].GetDouble() == doctest::Approx(17.5));
             }
             else if (comp.componentTypeName == "CanJumpComponent")
             {
                 foundCanJump = true;
-                duin::JSONValue json = duin::JSONValue::Parse(comp.jsonData);
+                duin::JSONValue json = duin::JSONValue::Parse(comp.ToJSON());
                 CHECK(json.HasMember("impulse"));
                 CHECK(json["impulse"].GetDouble() == doctest::Approx(625.0));
             }
             else if (comp.componentTypeName == "Vec3")
             {
                 foundVec3 = true;
-                duin::JSONValue json = duin::JSONValue::Parse(comp.jsonData);
+                duin::JSONValue json = duin::JSONValue::Parse(comp.ToJSON());
                 CHECK(json["x"].GetDouble() == doctest::Approx(0.0));
                 CHECK(json["y"].GetDouble() == doctest::Approx(50.0));
                 CHECK(json["z"].GetDouble() == doctest::Approx(5.0));
@@ -306,7 +306,7 @@ TEST_SUITE("Complex Player Entity Tests")
             if (comp.componentTypeName == "Vec3")
             {
                 foundCameraRootPos = true;
-                duin::JSONValue json = duin::JSONValue::Parse(comp.jsonData);
+                duin::JSONValue json = duin::JSONValue::Parse(comp.ToJSON());
                 CHECK(json["x"].GetDouble() == doctest::Approx(0.0));
                 CHECK(json["y"].GetDouble() == doctest::Approx(playerHeight));
                 CHECK(json["z"].GetDouble() == doctest::Approx(0.0));
@@ -322,13 +322,13 @@ TEST_SUITE("Complex Player Entity Tests")
             if (comp.componentTypeName == "Camera")
             {
                 foundCamera = true;
-                duin::JSONValue json = duin::JSONValue::Parse(comp.jsonData);
+                duin::JSONValue json = duin::JSONValue::Parse(comp.ToJSON());
                 CHECK(json["fov"].GetDouble() == doctest::Approx(72.0));
             }
             else if (comp.componentTypeName == "VelocityBob")
             {
                 foundVelocityBob = true;
-                duin::JSONValue json = duin::JSONValue::Parse(comp.jsonData);
+                duin::JSONValue json = duin::JSONValue::Parse(comp.ToJSON());
                 CHECK(json["frequency"].GetDouble() == doctest::Approx(10.0));
                 CHECK(json["amplitude"].GetDouble() == doctest::Approx(1.0));
             }
@@ -372,7 +372,7 @@ TEST_SUITE("Complex Player Entity Tests")
             if (comp.componentTypeName == "Mass")
             {
                 foundMass = true;
-                duin::JSONValue compJson = duin::JSONValue::Parse(comp.jsonData);
+                duin::JSONValue compJson = duin::JSONValue::Parse(comp.ToJSON());
                 CHECK(compJson["value"].GetDouble() == doctest::Approx(80.0));
             }
         }
@@ -507,17 +507,17 @@ TEST_SUITE("Complex Player Entity Tests")
         {
             if (comp.componentTypeName == "CanJumpComponent")
             {
-                duin::JSONValue json = duin::JSONValue::Parse(comp.jsonData);
+                duin::JSONValue json = duin::JSONValue::Parse(comp.ToJSON());
                 CHECK(json["impulse"].GetDouble() == doctest::Approx(625.0));
             }
             else if (comp.componentTypeName == "CanRunComponent")
             {
-                duin::JSONValue json = duin::JSONValue::Parse(comp.jsonData);
+                duin::JSONValue json = duin::JSONValue::Parse(comp.ToJSON());
                 CHECK(json["speed"].GetDouble() == doctest::Approx(10.0));
             }
             else if (comp.componentTypeName == "Mass")
             {
-                duin::JSONValue json = duin::JSONValue::Parse(comp.jsonData);
+                duin::JSONValue json = duin::JSONValue::Parse(comp.ToJSON());
                 CHECK(json["value"].GetDouble() == doctest::Approx(80.5));
             }
         }
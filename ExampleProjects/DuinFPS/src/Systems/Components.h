@@ -4,17 +4,20 @@
 #include <Duin/ECS/ECSModule.h>
 #include <Duin/ECS/GameWorld.h>
 #include <Duin/Core/Debug/DebugModule.h>
+#include <Duin/Core/Utils/FixedAccumulator.h>
 
 #include <vector>
 
+// Inline capacity covers the usual per-tick contributions (movement, gravity,
+// jump); anything beyond spills into the world's frame arena.
 struct InputVelocities
 {
-    std::vector<duin::Vector3> vec;
+    duin::FixedAccumulator<duin::Vector3, 8> vec;
 };
 
 struct InputForces
 {
-    std::vector<duin::Vector3> vec;
+    duin::FixedAccumulator<duin::Vector3, 4> vec;
 };
 
 struct InputVelocityDirection
@@ -29,7 +29,7 @@ void ExecuteQueryIdle(duin::GameWorld &world)
                         .Build();
 
     world.DeferBegin();
-    q.Each([](duin::Entity e, InputVelocities &inputVels, const Velocity3D &velocity) {
+    q.Each([&world](duin::Entity e, InputVelocities &inputVels, const Velocity3D &velocity) {
         double delta = duin::GetPhysicsFrameTime();
 
         duin::Vector3 targetVel = duin::Vector3Zero();
@@ -56,7 +56,7 @@ void ExecuteQueryIdle(duin::GameWorld &world)
         outputVel = duin::Vector3Scale(outputVel, friction);
         outputVel = duin::Vector3Scale(outputVel, alpha);
 
-        inputVels.vec.push_back(outputVel);
+        inputVels.vec.Push(outputVel, world.GetFrameArena());
     });
     world.DeferEnd();
 }
@@ -69,7 +69,7 @@ void ExecuteQueryRun(duin::GameWorld &world)
             .Build();
 
     world.DeferBegin();
-    q.Each([](duin::Entity e, InputVelocities &inputVels, InputVelocityDirection &iDir,
+    q.Each([&world](duin::Entity e, InputVelocities &inputVels, InputVelocityDirection &iDir,
               const CanRunComponent &moveSpeed, const Velocity3D &velocity) {
         float acceleration = PlayerConstants::GROUND_ACCELERATION;
         float targetSpeed = moveSpeed.speed;
@@ -103,7 +103,7 @@ void ExecuteQueryRun(duin::GameWorld &world)
         outputVel = duin::Vector3Scale(outputVel, acceleration);
         outputVel = duin::Vector3Scale(outputVel, alpha);
 
-        inputVels.vec.push_back(outputVel);
+        inputVels.vec.Push(outputVel, world.GetFrameArena());
     });
     world.DeferEnd();
 }
@@ -118,7 +118,7 @@ void ExecuteQuerySprint(duin::GameWorld &world)
                         .Build();
 
     world.DeferBegin();
-    q.Each([](duin::Entity e, InputVelocities &inputVels, InputVelocityDirection &iDir,
+    q.Each([&world](duin::Entity e, InputVelocities &inputVels, InputVelocityDirection &iDir,
               const CanRunComponent &runSpeed, const CanSprintComponent &moveSpeed, const Velocity3D &velocity) {
         double delta = duin::GetPhysicsFrameTime();
 
@@ -139,7 +139,7 @@ void ExecuteQuerySprint(duin::GameWorld &world)
         duin::Vector3 outputVel(outputVelX, 0.0f, outputVelZ);
         outputVel = duin::Vector3Scale(outputVel, alpha);
 
-        inputVels.vec.push_back(outputVel);
+        inputVels.vec.Push(outputVel, world.GetFrameArena());
     });
     world.DeferEnd();
 }
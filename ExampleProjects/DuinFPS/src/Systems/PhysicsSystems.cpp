@@ -17,10 +17,10 @@ void ExecuteQueryGravity(duin::GameWorld &world)
             .With<CanGravity>()
             .Build();
 
-    q.Each([](duin::Entity e, InputVelocities &inputVelocities, const CharacterBodyComponent &cb,
+    q.Each([&world](duin::Entity e, InputVelocities &inputVelocities, const CharacterBodyComponent &cb,
               const GravityComponent &gravity, const Mass &mass) {
         duin::Vector3 gravityVel = duin::Vector3Scale(gravity.value, duin::GetPhysicsFrameTime());
-        inputVelocities.vec.push_back(gravityVel);
+        inputVelocities.vec.Push(gravityVel, world.GetFrameArena());
     });
 }
 
@@ -33,10 +33,10 @@ void ExecuteQueryOnGroundJump(duin::GameWorld &world)
             .Build();
 
     world.DeferBegin();
-    q.Each([](duin::Entity e, InputForces &inputForces, const CanJumpComponent &moveSpeed) {
+    q.Each([&world](duin::Entity e, InputForces &inputForces, const CanJumpComponent &moveSpeed) {
         debugConsole.Log("Jumping!");
         duin::Vector3 iForce(0.0f, moveSpeed.impulse, 0.0f);
-        inputForces.vec.push_back(iForce);
+        inputForces.vec.Push(iForce, world.GetFrameArena());
         e.Remove<JumpTag>();
     });
     world.DeferEnd();
@@ -54,10 +54,10 @@ void ExecuteQueryResolveInputVelocities(duin::GameWorld &world)
         }
         velocity.value = duin::Vector3Add(velocity.value, accumVel);
 
-        inputVels.vec.clear();
+        inputVels.vec.Clear();
 
         debugWatchlist.Post("accumVel:", "{ %.2f, %.2f, %.2f }", accumVel.x, accumVel.y, accumVel.z);
-        debugWatchlist.Post("accumVel size:", "%d", inputVels.vec.size());
+        debugWatchlist.Post("accumVel size:", "%d", inputVels.vec.Size());
     });
 }
 
@@ -66,7 +66,7 @@ void ExecuteQueryResolveInputForces(duin::GameWorld &world)
     static duin::Query q =
         world.QueryBuilder<InputForces, InputVelocities, Velocity3D, const Mass>().Cached().Build();
 
-    q.Each([](duin::Entity e, InputForces &inputForces, InputVelocities &inputVelocities, Velocity3D &velocity, const Mass &mass) {
+    q.Each([&world](duin::Entity e, InputForces &inputForces, InputVelocities &inputVelocities, Velocity3D &velocity, const Mass &mass) {
         duin::Vector3 netForce = duin::Vector3Zero();
         for (duin::Vector3 &vec : inputForces.vec)
         {
@@ -76,14 +76,14 @@ void ExecuteQueryResolveInputForces(duin::GameWorld &world)
         duin::Vector3 a(duin::Vector3Scale(netForce, (1.0f / mass_)));
         duin::Vector3Scale(a, duin::GetPhysicsFrameTime());
 
-        if (inputForces.vec.size() > 0)
+        if (inputForces.vec.Size() > 0)
         {
-            inputVelocities.vec.push_back(a);
+            inputVelocities.vec.Push(a, world.GetFrameArena());
         }
 
-        debugWatchlist.Post("Forces size", "%d", inputForces.vec.size());
+        debugWatchlist.Post("Forces size", "%d", inputForces.vec.Size());
         debugWatchlist.Post("Fnet", "%.2f", duin::Vector3Length(a));
 
-        inputForces.vec.clear();
+        inputForces.vec.Clear();
     });
 }
@@ -142,6 +142,8 @@ workspace "Duin"
 
     daslang_dll_src = path.getabsolute("Duin/vendor/daslang/bin/Debug/libDaScriptDyn.dll")
     daslang_runtime_dll_src = path.getabsolute("Duin/vendor/daslang/bin/Debug/libDaScriptDyn_runtime.dll")
+    -- Compiled engine shaders, copied next to each executable and loaded from bin://shaders.
+    duin_shaders_src = path.getabsolute("Duin/src/Duin/Resources/shaders")
 
     -- Debug build size optimisations:
     --   FastLink PDB — references .obj files instead of copying all symbols in.